@@ -8,6 +8,8 @@
 
 #include <math.h>
 #include <vector>
+#include <functional>
+#include <memory>
 #include <intrin.h>
 
 namespace NullX
@@ -19,12 +21,125 @@ namespace NullX
     constexpr float ThirdPi   = Pi / 3.0f;
     constexpr float QuarterPi = Pi / 4.0f;
 
+    /// Output size in bytes above which batch kernels switch to non-temporal stores in StoreMode::Auto
+    extern size_t StreamingThreshold;
+    /// Number of elements ahead of the current one that streaming batch kernels prefetch
+    extern size_t PrefetchDistance;
+
+    /// Selects how batch kernels write their results
+    enum class StoreMode
+    {
+        /// Stream once the output exceeds StreamingThreshold, cache otherwise
+        Auto,
+        /// Regular stores that keep the output in cache
+        Cached,
+        /// Non-temporal stores with software prefetch that bypass the cache
+        Streaming
+    };
+
+    /// Bits written by Matrix4::ProjectPoints, one for each frustum plane a point lies outside of
+    enum class ClipFlag : unsigned char
+    {
+        /// Inside every plane
+        None   = 0,
+        Left   = 1 << 0,
+        Right  = 1 << 1,
+        Bottom = 1 << 2,
+        Top    = 1 << 3,
+        Near   = 1 << 4,
+        Far    = 1 << 5
+    };
+
+    /// Combines the bits of flags1 & flags2
+    ClipFlag operator | (const ClipFlag flags1, const ClipFlag flags2);
+    /// Keeps the bits set in both flags1 & flags2
+    ClipFlag operator & (const ClipFlag flags1, const ClipFlag flags2);
+    /// Flips every plane bit of flags
+    ClipFlag operator ~ (const ClipFlag flags);
+    /// Sets the bits of flags2 in flags1
+    ClipFlag& operator |= (ClipFlag& flags1, const ClipFlag flags2);
+    /// Clears the bits of flags1 not set in flags2
+    ClipFlag& operator &= (ClipFlag& flags1, const ClipFlag flags2);
+
+    /// Selects the curve used to order points in space
+    enum class CurveType
+    {
+        /// Z-order, cheapest to encode
+        Morton,
+        /// Hilbert order, never jumps between distant cells so neighbours in order stay neighbours in space
+        Hilbert
+    };
+
+    /// Selects how a Spline interprets its control points
+    enum class SplineType
+    {
+        /// Cubic Bezier, 3n + 1 points with every third point on the curve
+        Bezier,
+        /// Catmull-Rom, passes through every point except the first & last, which only shape the ends
+        CatmullRom,
+        /// Cubic Hermite, points alternate position & tangent
+        Hermite,
+        /// Uniform cubic B-spline, C2 continuous but does not pass through its points
+        BSpline
+    };
+
+    /// Selects the gradient noise evaluated by Noise
+    enum class NoiseType
+    {
+        /// Improved Perlin noise on the hypercube lattice
+        Perlin,
+        /// Simplex noise, fewer corners per sample & no axis aligned artifacts
+        Simplex
+    };
+
+    /// Selects the convex shape a ConvexShape describes
+    enum class ShapeType
+    {
+        /// Point swept by a radius
+        Sphere,
+        /// Segment swept by a radius
+        Capsule,
+        /// Oriented box
+        Box,
+        /// Convex hull of caller owned points
+        Hull
+    };
+
     // Forward Declarations
     class Vector2;
     class Vector3;
     class Vector4;
+    class Vector2i;
+    class Vector3i;
+    class Vector4i;
     class Matrix4;
     class Quaternion;
+    class Transform;
+    class AABB;
+    class BoundingSphere;
+    class Ray;
+    class RayHit;
+    class BVH;
+    class KDTree;
+    class SpatialHashGrid;
+    class SpaceFillingCurve;
+    class OcclusionBuffer;
+    class ParticleStreams;
+    class ParticleSettings;
+    class ParticleIntegrator;
+    class Spline;
+    class IKSolver;
+    class Color;
+    class Random;
+    class FractalSettings;
+    class Noise;
+    class Mesh;
+    class BroadPhase;
+    class ConvexShape;
+    class ContactManifold;
+    class NarrowPhase;
+    template <typename T> class VectorN;
+    template <typename T> class MatrixN;
 
     /// Contains functionality necessary for performing Vector2 operations
     class __declspec(align(16)) Vector2
@@ -230,6 +345,34 @@ namespace NullX
         /// \return cross product between vec1 & vec2
         static Vector3 Cross(const Vector3& vec1, const Vector3& vec2);
 
+        /// Calculates the sum of count vectors with parallel compensated summation
+        /// \return sum of vecs
+        static Vector3 Sum(const Vector3* vecs, const size_t count);
+
+        /// Calculates the mean of count vectors with parallel compensated summation
+        /// \return centroid of vecs
+        static Vector3 Mean(const Vector3* vecs, const size_t count);
+
+        /// Calculates the mean of count vectors, each scaled by its weight
+        /// \return weighted centroid of vecs
+        static Vector3 Mean(const Vector3* vecs, const float* weights, const size_t count);
+
+        /// Calculates the per-element minimum of count vectors
+        /// \return minimum of vecs along each axis
+        static Vector3 Min(const Vector3* vecs, const size_t count);
+
+        /// Calculates the per-element maximum of count vectors
+        /// \return maximum of vecs along each axis
+        static Vector3 Max(const Vector3* vecs, const size_t count);
+
+        /// Calculates the covariance of count vectors about their mean, divided by count
+        /// \return 3x3 covariance in the upper left of a Matrix4, zero elsewhere
+        static Matrix4 Covariance(const Vector3* vecs, const size_t count);
+
+        /// Calculates the covariance of count vectors about their weighted mean, divided by the total weight
+        /// \return 3x3 covariance in the upper left of a Matrix4, zero elsewhere
+        static Matrix4 Covariance(const Vector3* vecs, const float* weights, const size_t count);
+
         /// Transforms a Vector3 into a Vector2
         /// \return given Vector3 as Vector2
         static Vector2 ToVector2(const Vector3& vec);
@@ -396,6 +539,327 @@ namespace NullX
         Vector4 operator /= (const float num);
     };
 
+    /// Contains functionality necessary for performing Vector2i integer operations on grid & voxel coordinates
+    class __declspec(align(16)) Vector2i
+    {
+    public:
+        union
+        {
+            struct
+            {
+                /// x coordinate
+                int x;
+                /// y coordinate
+                int y;
+            };
+
+            /// Array representing elements of Vector2i -> [0] = x, [1] = y
+            int elements[2];
+
+            /// Vector representing elements of Vector2i used for SIMD functions
+            __m128i elementsSIMD;
+        };
+
+        /// Vector2i Default Constructor.  Initializes elements to 0
+        Vector2i();
+        /// Vector2i Constructor.  Sets elements equal to given values
+        Vector2i(int _x, int _y);
+        /// Vector2i Constructor.  Sets elements equal to given __m128i
+        Vector2i(__m128i vec);
+        /// Vector2i Constructor.  Sets elements equal to given Vector2i
+        Vector2i(const Vector2i& vec);
+
+        /// Rounds each element of vec down to the nearest integer
+        /// \return vec floored
+        static Vector2i Floor(const Vector2& vec);
+
+        /// Rounds each element of vec to the nearest integer, halfway cases up to match NullX::Round
+        /// \return vec rounded
+        static Vector2i Round(const Vector2& vec);
+
+        /// Rounds each element of vec up to the nearest integer
+        /// \return vec rounded up
+        static Vector2i Ceiling(const Vector2& vec);
+
+        /// Transforms a Vector2i into a Vector2
+        /// \return given Vector2i as Vector2
+        static Vector2 ToVector2(const Vector2i& vec);
+
+        /// Floors each of count positions divided by cellSize to the cell containing it, across threads
+        static void     ToCells(const Vector2* positions, Vector2i* cells, const size_t count, const float cellSize);
+
+        /// Calculates the dot product between the given vectors
+        /// \return dot product of vec1 & vec2
+        static int      Dot(const Vector2i& vec1, const Vector2i& vec2);
+
+        /// \return smallest of each element of vec1 & vec2
+        static Vector2i Min(const Vector2i& vec1, const Vector2i& vec2);
+        /// \return largest of each element of vec1 & vec2
+        static Vector2i Max(const Vector2i& vec1, const Vector2i& vec2);
+        /// \return absolute value of each element of vec
+        static Vector2i Abs(const Vector2i& vec);
+
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 is less than vec2, 0 elsewhere
+        static Vector2i LessThan(const Vector2i& vec1, const Vector2i& vec2);
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 is greater than vec2, 0 elsewhere
+        static Vector2i GreaterThan(const Vector2i& vec1, const Vector2i& vec2);
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 equals vec2, 0 elsewhere
+        static Vector2i Equal(const Vector2i& vec1, const Vector2i& vec2);
+
+        /// Compares the elements between two vectors to determine if they are equal
+        /// \return true if all elements are equal, false if not
+        bool operator      == (const Vector2i& vec) const;
+
+        /// Compares the elements between two vectors to determine if they are inequal
+        /// \return true if any elements are inequal, false if not
+        bool operator      != (const Vector2i& vec) const;
+
+        /// Returns the element at the given index
+        /// \return element at index num
+        int operator       [] (const int num) const;
+
+        /// Calculates the addition between this and vec
+        Vector2i operator +  (const Vector2i& vec) const;
+        /// Calculates the difference between this and vec
+        Vector2i operator -  (const Vector2i& vec) const;
+        /// Calculates the multiplication of the elements of this and num
+        Vector2i operator *  (const int num) const;
+        /// Calculates the multiplication of the elements of this and vec
+        Vector2i operator *  (const Vector2i& vec) const;
+        /// Shifts the elements of this left by num bits
+        Vector2i operator << (const int num) const;
+        /// Shifts the elements of this right by num bits, keeping the sign
+        Vector2i operator >> (const int num) const;
+        /// Calculates the addition between this and vec
+        Vector2i operator += (const Vector2i& vec);
+        /// Calculates the difference between this and vec
+        Vector2i operator -= (const Vector2i& vec);
+        /// Calculates the multiplication of the elements of this and num
+        Vector2i operator *= (const int num);
+        /// Shifts the elements of this left by num bits
+        Vector2i operator <<= (const int num);
+        /// Shifts the elements of this right by num bits, keeping the sign
+        Vector2i operator >>= (const int num);
+    };
+
+    /// Contains functionality necessary for performing Vector3i integer operations on grid & voxel coordinates
+    class __declspec(align(16)) Vector3i
+    {
+    public:
+        union
+        {
+            struct
+            {
+                /// x coordinate
+                int x;
+                /// y coordinate
+                int y;
+                /// z coordinate
+                int z;
+            };
+
+            /// Array representing elements of Vector3i -> [0] = x, [1] = y, [2] = z
+            int elements[3];
+
+            /// Vector representing elements of Vector3i used for SIMD functions
+            __m128i elementsSIMD;
+        };
+
+        /// Vector3i Default Constructor.  Initializes elements to 0
+        Vector3i();
+        /// Vector3i Constructor.  Sets elements equal to given values
+        Vector3i(int _x, int _y, int _z);
+        /// Vector3i Constructor.  Sets elements equal to given __m128i
+        Vector3i(__m128i vec);
+        /// Vector3i Constructor.  Sets elements equal to given Vector3i
+        Vector3i(const Vector3i& vec);
+
+        /// Rounds each element of vec down to the nearest integer
+        /// \return vec floored
+        static Vector3i Floor(const Vector3& vec);
+
+        /// Rounds each element of vec to the nearest integer, halfway cases up to match NullX::Round
+        /// \return vec rounded
+        static Vector3i Round(const Vector3& vec);
+
+        /// Rounds each element of vec up to the nearest integer
+        /// \return vec rounded up
+        static Vector3i Ceiling(const Vector3& vec);
+
+        /// Transforms a Vector3i into a Vector3
+        /// \return given Vector3i as Vector3
+        static Vector3 ToVector3(const Vector3i& vec);
+
+        /// Floors each of count positions divided by cellSize to the cell containing it, across threads
+        static void     ToCells(const Vector3* positions, Vector3i* cells, const size_t count, const float cellSize);
+
+        /// Calculates the dot product between the given vectors
+        /// \return dot product of vec1 & vec2
+        static int      Dot(const Vector3i& vec1, const Vector3i& vec2);
+
+        /// \return smallest of each element of vec1 & vec2
+        static Vector3i Min(const Vector3i& vec1, const Vector3i& vec2);
+        /// \return largest of each element of vec1 & vec2
+        static Vector3i Max(const Vector3i& vec1, const Vector3i& vec2);
+        /// \return absolute value of each element of vec
+        static Vector3i Abs(const Vector3i& vec);
+
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 is less than vec2, 0 elsewhere
+        static Vector3i LessThan(const Vector3i& vec1, const Vector3i& vec2);
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 is greater than vec2, 0 elsewhere
+        static Vector3i GreaterThan(const Vector3i& vec1, const Vector3i& vec2);
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 equals vec2, 0 elsewhere
+        static Vector3i Equal(const Vector3i& vec1, const Vector3i& vec2);
+
+        /// Compares the elements between two vectors to determine if they are equal
+        /// \return true if all elements are equal, false if not
+        bool operator      == (const Vector3i& vec) const;
+
+        /// Compares the elements between two vectors to determine if they are inequal
+        /// \return true if any elements are inequal, false if not
+        bool operator      != (const Vector3i& vec) const;
+
+        /// Returns the element at the given index
+        /// \return element at index num
+        int operator       [] (const int num) const;
+
+        /// Calculates the addition between this and vec
+        Vector3i operator +  (const Vector3i& vec) const;
+        /// Calculates the difference between this and vec
+        Vector3i operator -  (const Vector3i& vec) const;
+        /// Calculates the multiplication of the elements of this and num
+        Vector3i operator *  (const int num) const;
+        /// Calculates the multiplication of the elements of this and vec
+        Vector3i operator *  (const Vector3i& vec) const;
+        /// Shifts the elements of this left by num bits
+        Vector3i operator << (const int num) const;
+        /// Shifts the elements of this right by num bits, keeping the sign
+        Vector3i operator >> (const int num) const;
+        /// Calculates the addition between this and vec
+        Vector3i operator += (const Vector3i& vec);
+        /// Calculates the difference between this and vec
+        Vector3i operator -= (const Vector3i& vec);
+        /// Calculates the multiplication of the elements of this and num
+        Vector3i operator *= (const int num);
+        /// Shifts the elements of this left by num bits
+        Vector3i operator <<= (const int num);
+        /// Shifts the elements of this right by num bits, keeping the sign
+        Vector3i operator >>= (const int num);
+    };
+
+    /// Contains functionality necessary for performing Vector4i integer operations on grid & voxel coordinates
+    class __declspec(align(16)) Vector4i
+    {
+    public:
+        union
+        {
+            struct
+            {
+                /// x coordinate
+                int x;
+                /// y coordinate
+                int y;
+                /// z coordinate
+                int z;
+                /// w coordinate
+                int w;
+            };
+
+            /// Array representing elements of Vector4i -> [0] = x, [1] = y, [2] = z, [3] = w
+            int elements[4];
+
+            /// Vector representing elements of Vector4i used for SIMD functions
+            __m128i elementsSIMD;
+        };
+
+        /// Vector4i Default Constructor.  Initializes elements to 0
+        Vector4i();
+        /// Vector4i Constructor.  Sets elements equal to given values
+        Vector4i(int _x, int _y, int _z, int _w);
+        /// Vector4i Constructor.  Sets elements equal to given __m128i
+        Vector4i(__m128i vec);
+        /// Vector4i Constructor.  Sets elements equal to given Vector4i
+        Vector4i(const Vector4i& vec);
+
+        /// Rounds each element of vec down to the nearest integer
+        /// \return vec floored
+        static Vector4i Floor(const Vector4& vec);
+
+        /// Rounds each element of vec to the nearest integer, halfway cases up to match NullX::Round
+        /// \return vec rounded
+        static Vector4i Round(const Vector4& vec);
+
+        /// Rounds each element of vec up to the nearest integer
+        /// \return vec rounded up
+        static Vector4i Ceiling(const Vector4& vec);
+
+        /// Transforms a Vector4i into a Vector4
+        /// \return given Vector4i as Vector4
+        static Vector4 ToVector4(const Vector4i& vec);
+
+        /// Calculates the dot product between the given vectors
+        /// \return dot product of vec1 & vec2
+        static int      Dot(const Vector4i& vec1, const Vector4i& vec2);
+
+        /// \return smallest of each element of vec1 & vec2
+        static Vector4i Min(const Vector4i& vec1, const Vector4i& vec2);
+        /// \return largest of each element of vec1 & vec2
+        static Vector4i Max(const Vector4i& vec1, const Vector4i& vec2);
+        /// \return absolute value of each element of vec
+        static Vector4i Abs(const Vector4i& vec);
+
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 is less than vec2, 0 elsewhere
+        static Vector4i LessThan(const Vector4i& vec1, const Vector4i& vec2);
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 is greater than vec2, 0 elsewhere
+        static Vector4i GreaterThan(const Vector4i& vec1, const Vector4i& vec2);
+        /// Compares each element of vec1 & vec2
+        /// \return -1 in each element where vec1 equals vec2, 0 elsewhere
+        static Vector4i Equal(const Vector4i& vec1, const Vector4i& vec2);
+
+        /// Compares the elements between two vectors to determine if they are equal
+        /// \return true if all elements are equal, false if not
+        bool operator      == (const Vector4i& vec) const;
+
+        /// Compares the elements between two vectors to determine if they are inequal
+        /// \return true if any elements are inequal, false if not
+        bool operator      != (const Vector4i& vec) const;
+
+        /// Returns the element at the given index
+        /// \return element at index num
+        int operator       [] (const int num) const;
+
+        /// Calculates the addition between this and vec
+        Vector4i operator +  (const Vector4i& vec) const;
+        /// Calculates the difference between this and vec
+        Vector4i operator -  (const Vector4i& vec) const;
+        /// Calculates the multiplication of the elements of this and num
+        Vector4i operator *  (const int num) const;
+        /// Calculates the multiplication of the elements of this and vec
+        Vector4i operator *  (const Vector4i& vec) const;
+        /// Shifts the elements of this left by num bits
+        Vector4i operator << (const int num) const;
+        /// Shifts the elements of this right by num bits, keeping the sign
+        Vector4i operator >> (const int num) const;
+        /// Calculates the addition between this and vec
+        Vector4i operator += (const Vector4i& vec);
+        /// Calculates the difference between this and vec
+        Vector4i operator -= (const Vector4i& vec);
+        /// Calculates the multiplication of the elements of this and num
+        Vector4i operator *= (const int num);
+        /// Shifts the elements of this left by num bits
+        Vector4i operator <<= (const int num);
+        /// Shifts the elements of this right by num bits, keeping the sign
+        Vector4i operator >>= (const int num);
+    };
+
     /// Contains functionality necessary for performing 4x4 matrix operations
     class __declspec(align(16)) Matrix4
     {
@@ -448,6 +912,40 @@ namespace NullX
         /// Calculates the LU Decomposition of the given Matrix4
         static std::vector<Matrix4> LUDecomposition(Matrix4& mat);
 
+        /// Calculates the eigenvalues & eigenvectors of the symmetric upper left 3x3 of mat with Jacobi iteration.
+        /// values are sorted largest first and vectors is the rotation whose matrix columns are the matching eigenvectors
+        static void    Eigen(const Matrix4& mat, Vector3& values, Quaternion& vectors);
+        /// Calculates Eigen for count matrices, 4 at a time across SIMD lanes and threads
+        static void    Eigen(const Matrix4* mats, Vector3* values, Quaternion* vectors, const size_t count);
+
+        /// Calculates the singular value decomposition U * diag(sigma) * V^T of the upper left 3x3 of mat.
+        /// U & V are rotations, sigma is sorted by magnitude and its last element is negative when the determinant is
+        static void    SVD(const Matrix4& mat, Quaternion& u, Vector3& sigma, Quaternion& v);
+        /// Calculates SVD for count matrices, 4 at a time across SIMD lanes and threads
+        static void    SVD(const Matrix4* mats, Quaternion* u, Vector3* sigma, Quaternion* v, const size_t count);
+
+        /// Calculates the polar decomposition rotation * stretch of the upper left 3x3 of mat, stretch is symmetric
+        static void    Polar(const Matrix4& mat, Quaternion& rotation, Matrix4& stretch);
+        /// Calculates Polar for count matrices, 4 at a time across SIMD lanes and threads
+        static void    Polar(const Matrix4* mats, Quaternion* rotations, Matrix4* stretches, const size_t count);
+
+        /// Splits mat into translation, rotation & scale so mat = Translate * Rotate * Scale.
+        /// A negative determinant is folded into scale.x so rotation stays proper
+        static void    Decompose(const Matrix4& mat, Vector3& translation, Quaternion& rotation, Vector3& scale);
+        /// Calculates Decompose for count matrices, 4 at a time across SIMD lanes and threads
+        static void    Decompose(const Matrix4* mats, Vector3* translations, Quaternion* rotations, Vector3* scales, const size_t count);
+
+        /// Multiplies every Vector4 in vecs by mat and writes the results to out
+        static void    Transform(const Matrix4& mat, const Vector4* vecs, Vector4* out, const size_t count, const StoreMode mode = StoreMode::Auto);
+
+        /// Multiplies mat by every Matrix4 in mats and writes the results to out
+        static void    Multiply(const Matrix4& mat, const Matrix4* mats, Matrix4* out, const size_t count, const StoreMode mode = StoreMode::Auto);
+
+        /// Projects count points by viewProjection to SoA screen coordinates in the viewport (x, y, width, height) with y down,
+        /// normalized device depth & ClipFlag bits.  Points with any flag set have undefined screen coordinates.  clipFlags may be null
+        static void    ProjectPoints(const Matrix4& viewProjection, const Vector3* points, const size_t count, const Vector4& viewport,
+                                     float* screenX, float* screenY, float* depth, ClipFlag* clipFlags);
+
         /// Creates a 4x4 perspective projection matrix based off of the given parameters
         static Matrix4 Perspective(const float fov, const float width, const float height, const float zNear, const float zFar);
         /// Creates a 4x4 orthographic projection matrix based off of the given parameters
@@ -594,6 +1092,25 @@ namespace NullX
         /// \return Vector3 representing rotations around each axis in radians
         static Vector3 ToEuler(const Quaternion& quat);
 
+        /// Calculates the Quaternion for rotations around each axis, the inverse of ToEuler
+        /// \return Quaternion matching Matrix4::Rotate(euler.x, euler.y, euler.z)
+        static Quaternion FromEuler(const Vector3& euler);
+        /// Calculates FromEuler for count Vector3s, 4 at a time across SIMD lanes and threads
+        static void FromEuler(const Vector3* eulers, Quaternion* out, const size_t count);
+
+        /// Calculates the Quaternion for the rotation in the upper left 3x3 of mat
+        /// \return Quaternion representing the rotation of mat
+        static Quaternion FromMatrix(const Matrix4& mat);
+        /// Calculates FromMatrix for count matrices, 4 at a time across SIMD lanes and threads
+        static void FromMatrix(const Matrix4* mats, Quaternion* out, const size_t count);
+        /// Calculates FromMatrix for 4 rotations stored SoA, rows[i][j] holding element (i, j) of each lane
+        static void FromMatrix(const __m128 rows[3][3], __m128& w, __m128& x, __m128& y, __m128& z);
+
+        /// Rotates count SoA orientations by world space angular velocities over dt with the exponential map & renormalizes them,
+        /// 4 at a time across threads.  matrices, if not null, receives the matching rotation matrices from the same pass
+        static void Integrate(float* w, float* x, float* y, float* z, const float* angularX, const float* angularY, const float* angularZ,
+                              const size_t count, const float dt, Matrix4* matrices = nullptr);
+
         /// Calculates the multiplication of this and quat
         Quaternion operator * (const Quaternion& quat);
         /// Calculates the multiplication of this and num
@@ -608,6 +1125,951 @@ namespace NullX
         Quaternion operator /= (const float num);
     };
 
+    /// Contains position, rotation & scale along with lazily cached local-to-world & world-to-local matrices
+    class __declspec(align(16)) Transform
+    {
+    public:
+        /// Transform Default Constructor.  Initializes to the identity transform
+        Transform();
+        /// Transform Constructor.  Sets position, rotation & scale equal to given values
+        Transform(const Vector3& _position, const Quaternion& _rotation, const Vector3& _scale);
+
+        /// \return position of the Transform
+        const Vector3&    GetPosition() const;
+        /// \return rotation of the Transform
+        const Quaternion& GetRotation() const;
+        /// \return scale of the Transform
+        const Vector3&    GetScale() const;
+
+        /// Sets the position and marks the cached matrices dirty
+        void SetPosition(const Vector3& _position);
+        /// Sets the rotation, normalizing it, and marks the cached matrices dirty
+        void SetRotation(const Quaternion& _rotation);
+        /// Sets the scale and marks the cached matrices dirty
+        void SetScale(const Vector3& _scale);
+
+        /// Offsets the position by offset
+        void Translate(const Vector3& offset);
+        /// Applies quat on top of the current rotation
+        void Rotate(const Quaternion& quat);
+
+        /// Forces the cached matrices to be rebuilt on next access
+        void MarkDirty();
+        /// \return true if the cached matrix is out of date
+        bool IsDirty() const;
+
+        /// Calculates Translate * Rotate * Scale directly from TRS if dirty
+        /// \return cached local-to-world matrix
+        const Matrix4& GetMatrix();
+
+        /// Calculates the inverse of GetMatrix directly from TRS if dirty
+        /// \return cached world-to-local matrix
+        const Matrix4& GetInverse();
+
+        /// Rebuilds the matrices of every dirty Transform in transforms
+        static void UpdateMatrices(Transform* transforms, const size_t count);
+
+    private:
+        // TRS is read every rebuild so it sits at the front, followed by the cached results
+        Vector3    position;
+        Quaternion rotation;
+        Vector3    scale;
+        Matrix4    matrix;
+        Matrix4    inverse;
+        bool       matrixDirty;
+        bool       inverseDirty;
+    };
+
+    /// Contains functionality necessary for axis-aligned bounding box operations
+    class __declspec(align(16)) AABB
+    {
+    public:
+        /// Minimum corner
+        Vector3 min;
+        /// Maximum corner
+        Vector3 max;
+
+        /// AABB Default Constructor.  Initializes to an empty box that any point will expand
+        AABB();
+        /// AABB Constructor.  Sets corners equal to given values
+        AABB(const Vector3& _min, const Vector3& _max);
+
+        /// Expands the box to contain point
+        void Expand(const Vector3& point);
+        /// Expands the box to contain box
+        void Expand(const AABB& box);
+
+        /// \return center of the box
+        Vector3 Center() const;
+        /// \return half the size of the box along each axis
+        Vector3 Extents() const;
+        /// \return true if point lies inside or on the box
+        bool    Contains(const Vector3& point) const;
+        /// \return true if box overlaps this box
+        bool    Intersects(const AABB& box) const;
+
+        /// Calculates the bounds of count points with a parallel SIMD min/max reduction
+        /// \return box containing every point
+        static AABB FromPoints(const Vector3* points, const size_t count);
+
+        /// Calculates the bounds of box after transformation by mat using Arvo's method
+        /// \return box containing box transformed by mat
+        static AABB Transform(const AABB& box, const Matrix4& mat);
+
+        /// Transforms every box in boxes by mat using Arvo's method and writes the results to out
+        static void Transform(const Matrix4& mat, const AABB* boxes, AABB* out, const size_t count);
+    };
+
+    /// Contains functionality necessary for bounding sphere operations
+    class __declspec(align(16)) BoundingSphere
+    {
+    public:
+        /// Center of the sphere
+        Vector3 center;
+        /// Radius of the sphere
+        float   radius;
+
+        /// BoundingSphere Default Constructor.  Initializes to a zero radius sphere at the origin
+        BoundingSphere();
+        /// BoundingSphere Constructor.  Sets center & radius equal to given values
+        BoundingSphere(const Vector3& _center, const float _radius);
+
+        /// \return true if point lies inside or on the sphere
+        bool Contains(const Vector3& point) const;
+        /// \return true if sphere overlaps this sphere
+        bool Intersects(const BoundingSphere& sphere) const;
+
+        /// Fits a sphere around count points with Ritter's method, growing over parallel farthest-point passes
+        /// \return sphere containing every point
+        static BoundingSphere FromPoints(const Vector3* points, const size_t count);
+
+        /// \return sphere circumscribing box
+        static BoundingSphere FromAABB(const AABB& box);
+    };
+
+    /// Contains the origin, direction & maximum distance of a ray
+    class __declspec(align(16)) Ray
+    {
+    public:
+        /// Origin of the ray
+        Vector3 origin;
+        /// Direction of the ray, does not need to be unit length
+        Vector3 direction;
+        /// Maximum distance along direction to look for hits
+        float   tMax;
+
+        /// Ray Default Constructor
+        Ray();
+        /// Ray Constructor.  Sets elements equal to given values
+        Ray(const Vector3& _origin, const Vector3& _direction, const float _tMax);
+    };
+
+    /// Contains the result of a ray intersection query
+    class RayHit
+    {
+    public:
+        /// Distance along the ray to the hit
+        float t;
+        /// First barycentric coordinate of the hit
+        float u;
+        /// Second barycentric coordinate of the hit
+        float v;
+        /// Index of the triangle that was hit, -1 if nothing was hit
+        int   triangle;
+
+        /// RayHit Default Constructor.  Initializes to a miss
+        RayHit();
+    };
+
+    /// 4-wide bounding volume hierarchy over a triangle soup for ray casting
+    class BVH
+    {
+    public:
+        /// Maximum number of triangles placed in a leaf when the SAH allows it
+        static const size_t MaxLeafSize = 4;
+        /// Number of bins used by the SAH split search
+        static const size_t BinCount = 16;
+
+        /// BVH Default Constructor.  Creates an empty hierarchy
+        BVH();
+
+        /// Builds the hierarchy using binned SAH over triangleCount triangles stored as consecutive vertex triples
+        void Build(const Vector3* vertices, const size_t triangleCount);
+
+        /// Finds the closest triangle hit by ray
+        /// \return true if a triangle was hit
+        bool Intersect(const Ray& ray, RayHit& hit) const;
+
+        /// Determines whether any triangle blocks ray, stopping at the first hit
+        /// \return true if a triangle was hit
+        bool Occluded(const Ray& ray) const;
+
+        /// Finds the closest hit for a packet of 4 rays traversed together
+        void IntersectPacket(const Ray* rays, RayHit* hits) const;
+
+        /// Finds the closest hit for each of count rays, traversed as packets across threads
+        void Intersect(const Ray* rays, RayHit* hits, const size_t count) const;
+
+        /// \return number of triangles in the hierarchy
+        size_t TriangleCount() const;
+
+    private:
+        // Bounds of the 4 children in SoA order so a ray can test all of them at once
+        struct __declspec(align(16)) Node
+        {
+            float minX[4], minY[4], minZ[4];
+            float maxX[4], maxY[4], maxZ[4];
+            // >= 0 for inner nodes, ~firstBlock for leaves
+            int   children[4];
+            // Number of triangle blocks in a leaf, 0 for inner nodes, -1 for empty slots
+            int   blockCounts[4];
+        };
+
+        // 4 triangles prepared for Moller-Trumbore in SoA order
+        struct __declspec(align(16)) TriangleBlock
+        {
+            float v0x[4], v0y[4], v0z[4];
+            float e1x[4], e1y[4], e1z[4];
+            float e2x[4], e2y[4], e2z[4];
+            int   ids[4];
+        };
+
+        struct BuildNode;
+        struct BuildContext;
+
+        static std::unique_ptr<BuildNode> Subdivide(BuildContext& context, const size_t begin, const size_t end, const size_t depth);
+        int Flatten(const BuildNode* node, const std::vector<unsigned int>& order, const Vector3* vertices);
+        int FlattenLeaf(const BuildNode* node, const std::vector<unsigned int>& order, const Vector3* vertices);
+        template <bool AnyHit>
+        bool Traverse(const Ray& ray, RayHit& hit) const;
+
+        std::vector<Node>          nodes;
+        std::vector<TriangleBlock> blocks;
+        size_t                     triangleCount;
+    };
+
+    /// Implicit k-d tree over a Vector3 point set for nearest neighbour & radius queries
+    class KDTree
+    {
+    public:
+        /// Maximum number of points stored in a leaf
+        static const size_t LeafSize = 16;
+
+        /// KDTree Default Constructor.  Creates an empty tree
+        KDTree();
+
+        /// Builds the tree over count points, splitting at the median of the widest axis
+        void Build(const Vector3* points, const size_t count);
+
+        /// Finds the k points closest to point, sorted nearest first
+        /// \return number of points written to indices & distancesSqr, less than k only if the tree is smaller than k
+        size_t Nearest(const Vector3& point, const size_t k, unsigned int* indices, float* distancesSqr) const;
+
+        /// Finds the k points closest to each of count points across threads, writing k results per query
+        void   Nearest(const Vector3* points, const size_t count, const size_t k, unsigned int* indices, float* distancesSqr) const;
+
+        /// Appends the index of every point within radius of point to results
+        void   Radius(const Vector3& point, const float radius, std::vector<unsigned int>& results) const;
+
+        /// Finds the points within radius of each of count points across threads, one result list per query
+        void   Radius(const Vector3* points, const size_t count, const float radius, std::vector<std::vector<unsigned int>>& results) const;
+
+        /// \return number of points in the tree
+        size_t Size() const;
+
+    private:
+        void Subdivide(const Vector3* points, const size_t node, const size_t begin, const size_t end, const size_t depth);
+
+        // Points in tree order as SoA, padded by 3 so a leaf starting at any index can be read 4 at a time
+        std::vector<float>         pointsX;
+        std::vector<float>         pointsY;
+        std::vector<float>         pointsZ;
+        std::vector<unsigned int>  ids;
+        // Split planes indexed like a binary heap, children of node n are 2n & 2n + 1
+        std::vector<float>         splitValues;
+        std::vector<unsigned char> splitAxes;
+        size_t                     count;
+        size_t                     parallelDepth;
+    };
+
+    /// Uniform grid hashed into buckets for neighbour searches over points that move every frame
+    class SpatialHashGrid
+    {
+    public:
+        /// SpatialHashGrid Default Constructor.  Creates an empty grid
+        SpatialHashGrid();
+
+        /// Bins count points into cells of cellSize with a parallel counting sort
+        void Build(const Vector3* points, const size_t count, const float cellSize);
+
+        /// Appends the index of every point within radius of point to results
+        void Neighbours(const Vector3& point, const float radius, std::vector<unsigned int>& results) const;
+
+        /// Builds the neighbour list of every point across threads, excluding the point itself.
+        /// Neighbours of point i are neighbours[offsets[i]] to neighbours[offsets[i + 1]]
+        void NeighbourLists(const float radius, std::vector<unsigned int>& offsets, std::vector<unsigned int>& neighbours) const;
+
+        /// \return number of points in the grid
+        size_t Size() const;
+        /// \return x coordinates of the points sorted by cell
+        const float* SortedX() const;
+        /// \return y coordinates of the points sorted by cell
+        const float* SortedY() const;
+        /// \return z coordinates of the points sorted by cell
+        const float* SortedZ() const;
+        /// \return original index of each point sorted by cell
+        const unsigned int* SortedIds() const;
+
+    private:
+        template <bool SkipSelf>
+        void Gather(const Vector3& point, const unsigned int self, const float radius, std::vector<unsigned int>& results) const;
+
+        // Points sorted by bucket as SoA, padded by 3 so a bucket starting at any index can be read 4 at a time
+        std::vector<float>        sortedX;
+        std::vector<float>        sortedY;
+        std::vector<float>        sortedZ;
+        std::vector<unsigned int> sortedIds;
+        // Bucket b holds sorted points bucketStarts[b] to bucketStarts[b + 1]
+        std::vector<unsigned int> bucketStarts;
+        std::vector<unsigned int> pointBuckets;
+        std::vector<unsigned int> histograms;
+        size_t                    count;
+        unsigned int              bucketMask;
+        float                     cellSize;
+        float                     invCellSize;
+    };
+
+    /// Depth-only software rasterizer for occlusion culling, occluders are binned into screen tiles & rasterized across threads
+    class __declspec(align(16)) OcclusionBuffer
+    {
+    public:
+        /// Width of a screen tile in pixels
+        static const int TileWidth = 32;
+        /// Height of a screen tile in pixels
+        static const int TileHeight = 16;
+
+        /// OcclusionBuffer Default Constructor.  Creates an empty buffer
+        OcclusionBuffer();
+        /// OcclusionBuffer Constructor.  Creates a width x height buffer
+        OcclusionBuffer(const int width, const int height);
+
+        /// Resizes the buffer to width x height pixels & clears it
+        void Resize(const int width, const int height);
+
+        /// Clears the depth & sets the world to clip space matrix used by the following occluders & occludees
+        void Clear(const Matrix4& viewProjection);
+
+        /// Rasterizes triangleCount occluder triangles stored as consecutive vertex triples, keeping the nearest depth per pixel.
+        /// Pixels are covered when their centre is inside a triangle.  Triangles crossing the near plane are skipped
+        void RenderOccluders(const Vector3* vertices, const size_t triangleCount);
+
+        /// Tests box against the depth, first against the farthest depth of each tile & then per pixel
+        /// \return false if box is hidden behind occluders or off screen
+        bool IsVisible(const AABB& box) const;
+
+        /// Tests count boxes across threads, visible[i] is 1 where IsVisible(boxes[i]) and 0 elsewhere
+        void TestOccludees(const AABB* boxes, unsigned char* visible, const size_t count) const;
+
+        /// \return width in pixels
+        int Width() const;
+        /// \return height in pixels
+        int Height() const;
+        /// \return row major normalized device depth, Width() padded up to a multiple of TileWidth per row
+        const float* Depth() const;
+
+    private:
+        // Edge functions normalized so the inside is positive, plus the screen space depth plane
+        struct TriangleSetup
+        {
+            float edgeA[3], edgeB[3], edgeC[3];
+            float depth0, depthDx, depthDy;
+            int   minX, minY, maxX, maxY;
+        };
+
+        void RasterizeTile(const int tile);
+
+        Matrix4                                 viewProjection;
+        std::vector<float>                      depth;
+        // Farthest depth in each tile, lets occludees skip the per pixel test
+        std::vector<float>                      tileMax;
+        std::vector<TriangleSetup>              setups;
+        // One triangle list per tile per binning chunk, so binning needs no locks
+        std::vector<std::vector<unsigned int>>  bins;
+        size_t                                  binChunks;
+        int                                     width;
+        int                                     height;
+        int                                     stride;
+        int                                     tilesX;
+        int                                     tilesY;
+    };
+
+    /// Encodes points along Morton & Hilbert curves and sorts them into curve order for locality
+    class SpaceFillingCurve
+    {
+    public:
+        /// Interleaves the low 10 bits of x, y & z, x in the lowest bit
+        /// \return 30 bit Morton code
+        static unsigned int       Morton30(const unsigned int x, const unsigned int y, const unsigned int z);
+        /// Interleaves the low 21 bits of x, y & z, x in the lowest bit
+        /// \return 63 bit Morton code
+        static unsigned long long Morton63(const unsigned int x, const unsigned int y, const unsigned int z);
+        /// Calculates the distance along the Hilbert curve through a 1024^3 grid of the cell x, y, z
+        /// \return 30 bit Hilbert code
+        static unsigned int       Hilbert30(const unsigned int x, const unsigned int y, const unsigned int z);
+        /// Calculates the distance along the Hilbert curve through a 2097152^3 grid of the cell x, y, z
+        /// \return 63 bit Hilbert code
+        static unsigned long long Hilbert63(const unsigned int x, const unsigned int y, const unsigned int z);
+
+        /// Quantizes each point into bounds & calculates its 30 bit code along curve, 4 at a time across threads
+        static void Encode30(const Vector3* points, const size_t count, const AABB& bounds, const CurveType curve, unsigned int* codes);
+        /// Quantizes each point into bounds & calculates its 63 bit code along curve, 4 at a time across threads
+        static void Encode63(const Vector3* points, const size_t count, const AABB& bounds, const CurveType curve, unsigned long long* codes);
+
+        /// Sorts codes ascending with a parallel radix sort. order, if not null, receives the original index of each sorted code
+        static void Sort(unsigned int* codes, unsigned int* order, const size_t count);
+        /// Sorts codes ascending with a parallel radix sort. order, if not null, receives the original index of each sorted code
+        static void Sort(unsigned long long* codes, unsigned int* order, const size_t count);
+
+        /// Reorders points along curve through their bounds. order, if not null, receives the original index of each sorted point
+        static void SortPoints(Vector3* points, const size_t count, const CurveType curve, unsigned int* order = nullptr);
+
+        /// \return true if the CPU supports BMI2, which the scalar encoders & the 63 bit kernels use for pdep
+        static bool HasBMI2();
+    };
+
+    /// Caller owned SoA particle streams of count floats each.  Streams an integrator does not touch may be null
+    class ParticleStreams
+    {
+    public:
+        /// Position streams, read & written by every integrator
+        float*       positionX;
+        float*       positionY;
+        float*       positionZ;
+        /// Velocity streams, read & written by the Euler integrators, written by Verlet if not null
+        float*       velocityX;
+        float*       velocityY;
+        float*       velocityZ;
+        /// Per particle acceleration streams added to gravity, treated as zero if null
+        const float* accelerationX;
+        const float* accelerationY;
+        const float* accelerationZ;
+        /// Positions from the previous step, read & written by Verlet
+        float*       previousX;
+        float*       previousY;
+        float*       previousZ;
+        /// Number of particles in every stream
+        size_t       count;
+
+        /// ParticleStreams Default Constructor.  Initializes every stream to null & count to 0
+        ParticleStreams();
+    };
+
+    /// Forces & constraints shared by every particle during an integration step
+    class __declspec(align(16)) ParticleSettings
+    {
+    public:
+        /// Acceleration applied to every particle
+        Vector3 gravity;
+        /// Collision plane as (normal, distance) with normal unit length, particles are kept where dot(normal, position) + distance >= 0
+        Vector4 plane;
+        /// Fraction of velocity removed per second
+        float   damping;
+        /// Fraction of the velocity into the plane that is reflected on collision
+        float   restitution;
+        /// Whether particles are clamped to the positive side of plane
+        bool    clampToPlane;
+
+        /// ParticleSettings Default Constructor.  No gravity, damping or collision plane
+        ParticleSettings();
+    };
+
+    /// Steps SoA particle streams 4 particles at a time, or 8 with fused multiply adds on AVX2, across threads
+    class ParticleIntegrator
+    {
+    public:
+        /// Explicit Euler, position advances by the old velocity before velocity advances by acceleration
+        static void Euler(const ParticleStreams& streams, const float dt, const ParticleSettings& settings);
+        /// Semi-implicit (symplectic) Euler, velocity advances first & position advances by the new velocity
+        static void SemiImplicitEuler(const ParticleStreams& streams, const float dt, const ParticleSettings& settings);
+        /// Position Verlet, the velocity is implied by position - previous.  Velocity streams, if not null, receive it divided by dt
+        static void Verlet(const ParticleStreams& streams, const float dt, const ParticleSettings& settings);
+    };
+
+    /// Piecewise cubic curve over Vector3 control points, stored as power basis coefficients per segment & parameterized by t in [0, 1] over the whole curve
+    class Spline
+    {
+    public:
+        /// Spline Default Constructor.  Initializes to a curve with no segments
+        Spline();
+        /// Spline Constructor.  Builds the segments of type through count points
+        Spline(const Vector3* points, const size_t count, const SplineType type);
+
+        /// Rebuilds the segments of type through count points, dropping any arc length table.  Too few points leave no segments
+        void Set(const Vector3* points, const size_t count, const SplineType type);
+
+        /// \return number of cubic segments
+        size_t Segments() const;
+
+        /// Calculates the point at t
+        /// \return point on the curve at t
+        Vector3 Evaluate(const float t) const;
+        /// Calculates the first derivative with respect to t
+        /// \return tangent at t
+        Vector3 Derivative(const float t) const;
+        /// Calculates the second derivative with respect to t
+        /// \return curvature vector at t
+        Vector3 SecondDerivative(const float t) const;
+
+        /// Calculates Evaluate at count parameters, locating 4 at a time across SIMD lanes, across threads
+        void Evaluate(const float* parameters, const size_t count, Vector3* out) const;
+        /// Calculates Derivative at count parameters, locating 4 at a time across SIMD lanes, across threads
+        void Derivative(const float* parameters, const size_t count, Vector3* out) const;
+        /// Samples every spline at the same count parameters across threads, out[spline * count + i] holding parameter i of spline
+        static void Evaluate(const Spline* splines, const size_t splineCount, const float* parameters, const size_t count, Vector3* out);
+
+        /// Integrates the length of every segment with Gauss-Legendre quadrature over samplesPerSegment intervals & stores the running totals
+        void BuildArcLengthTable(const size_t samplesPerSegment = 16);
+        /// \return length of the curve, 0 until BuildArcLengthTable is called
+        float Length() const;
+        /// Inverts the arc length table, interpolating linearly between samples
+        /// \return t at distance along the curve, clamped to [0, 1]
+        float ParameterAtDistance(const float distance) const;
+        /// Calculates the points at count distances along the curve across threads, so samples can be spaced evenly
+        void EvaluateAtDistance(const float* distances, const size_t count, Vector3* out) const;
+
+    private:
+        /// Finds the segment containing t & the parameter within it
+        void Locate(const float t, size_t& segment, float& u) const;
+
+        // a, b, c, d of a*u^3 + b*u^2 + c*u + d for each segment, 4 padded floats each
+        std::vector<float> coefficients;
+        // Running length at every table sample, the first entry is 0
+        std::vector<float> arcLengths;
+        size_t             segments;
+        size_t             samplesPerSegment;
+    };
+
+    /// Position based inverse kinematics for many independent chains, 4 chains at a time across SIMD lanes & threads.
+    /// Chains are stored back to back from root to end effector & solved in place, bone lengths are taken from the input pose
+    class IKSolver
+    {
+    public:
+        /// Solves count 3 joint chains (root, middle, end) analytically so the end reaches targets[i] or points at it when out of reach.
+        /// The middle joint bends toward poles[i], or toward its current position if poles is null
+        static void TwoBone(Vector3* chains, const Vector3* targets, const Vector3* poles, const size_t count);
+        /// Solves count chains of jointCount joints with forward & backward reaching passes, keeping each root fixed.
+        /// Stops after iterations passes or once every end effector in a group is within tolerance of its target
+        static void FABRIK(Vector3* chains, const size_t jointCount, const Vector3* targets, const size_t count, const size_t iterations = 10, const float tolerance = 1e-3f);
+        /// Solves count chains of jointCount joints with cyclic coordinate descent, rotating the chain below each joint from the end toward the root.
+        /// Stops after iterations passes or once every end effector in a group is within tolerance of its target
+        static void CCD(Vector3* chains, const size_t jointCount, const Vector3* targets, const size_t count, const size_t iterations = 10, const float tolerance = 1e-3f);
+    };
+
+    /// Batch colour space & pixel format conversions on Vector4 RGBA across threads.  Alpha passes through unchanged & in may equal out
+    class Color
+    {
+    public:
+        /// Decodes the sRGB transfer function from each RGB channel, within 2.4e-6 relative of the exact curve
+        static void SRGBToLinear(const Vector4* in, Vector4* out, const size_t count);
+        /// Encodes each RGB channel with the sRGB transfer function, within 3.6e-6 of the exact curve
+        static void LinearToSRGB(const Vector4* in, Vector4* out, const size_t count);
+
+        /// Converts RGB to full range BT.709 YCbCr, written to x, y & z with Cb & Cr centred on 0.5
+        static void RGBToYCbCr(const Vector4* in, Vector4* out, const size_t count);
+        /// Converts full range BT.709 YCbCr in x, y & z back to RGB
+        static void YCbCrToRGB(const Vector4* in, Vector4* out, const size_t count);
+        /// Converts RGB to hue, saturation & value written to x, y & z, hue in [0, 1)
+        static void RGBToHSV(const Vector4* in, Vector4* out, const size_t count);
+        /// Converts hue, saturation & value in x, y & z back to RGB
+        static void HSVToRGB(const Vector4* in, Vector4* out, const size_t count);
+
+        /// Clamps to [0, 1] & rounds each channel to 8 bits, R in the lowest byte
+        static void PackUnorm8(const Vector4* in, unsigned int* out, const size_t count);
+        /// Expands 8 bit channels, R in the lowest byte, to [0, 1]
+        static void UnpackUnorm8(const unsigned int* in, Vector4* out, const size_t count);
+        /// Encodes linear RGB with the sRGB transfer function before packing like PackUnorm8, alpha stays linear
+        static void PackSRGB8(const Vector4* in, unsigned int* out, const size_t count);
+        /// Decodes sRGB 8 bit channels to linear [0, 1] through a lookup table, alpha stays linear
+        static void UnpackSRGB8(const unsigned int* in, Vector4* out, const size_t count);
+        /// Rounds each channel to the nearest IEEE half, 4 halves per pixel in RGBA order
+        static void PackHalf(const Vector4* in, unsigned short* out, const size_t count);
+        /// Expands 4 IEEE halves per pixel in RGBA order
+        static void UnpackHalf(const unsigned short* in, Vector4* out, const size_t count);
+    };
+
+    /// 4 lane xoshiro128+ generator.  Batch kernels split their output into fixed size blocks, each seeded from this generator,
+    /// so they run across threads & still give the same results for any thread count
+    class __declspec(align(16)) Random
+    {
+    public:
+        /// Random Default Constructor.  Seeds with a fixed value
+        Random();
+        /// Random Constructor.  Seeds every lane from seed with splitmix64
+        Random(const unsigned long long seed);
+
+        /// Reseeds every lane from seed with splitmix64
+        void Seed(const unsigned long long seed);
+
+        /// \return 4 lanes of 32 random bits
+        __m128i NextBits4();
+        /// \return 4 uniform floats in [0, 1)
+        __m128  NextFloat4();
+        /// \return 64 random bits from the first 2 lanes
+        unsigned long long Next64();
+
+        /// Fills out with count uniform floats in [min, max)
+        void Fill(float* out, const size_t count, const float min = 0.0f, const float max = 1.0f);
+        /// Writes count points uniformly distributed inside box
+        void InBox(const AABB& box, Vector3* out, const size_t count);
+        /// Writes count points uniformly distributed inside sphere
+        void InSphere(const BoundingSphere& sphere, Vector3* out, const size_t count);
+        /// Writes count unit vectors uniformly distributed over the sphere
+        void OnSphere(Vector3* out, const size_t count);
+        /// Writes count rotations uniformly distributed over SO(3) with Shoemake's method
+        void Rotations(Quaternion* out, const size_t count);
+        /// Writes count unit vectors about normal with a cosine weighted distribution, for importance sampling diffuse lighting
+        void CosineHemisphere(const Vector3& normal, Vector3* out, const size_t count);
+
+    private:
+        // s0, s1, s2 & s3 of xoshiro128+ for each of the 4 lanes
+        __m128i state[4];
+    };
+
+    /// Octaves summed by Noise::Fractal & the batch evaluators
+    class FractalSettings
+    {
+    public:
+        /// Noise summed at every octave
+        NoiseType type;
+        /// Number of octaves summed
+        int       octaves;
+        /// Frequency of the first octave
+        float     frequency;
+        /// Frequency multiplier between octaves
+        float     lacunarity;
+        /// Amplitude multiplier between octaves
+        float     gain;
+        /// Whether each octave is folded to (1 - |n|)^2 for ridged multifractal terrain
+        bool      ridged;
+
+        /// FractalSettings Default Constructor.  A single octave of simplex noise at frequency 1
+        FractalSettings();
+    };
+
+    /// Seeded gradient noise in 2, 3 & 4 dimensions, 4 samples at a time.  Lattice gradients come from an integer hash rather than a
+    /// permutation table so every lane stays in SIMD registers.  Single octaves return values in about [-1, 1]
+    class Noise
+    {
+    public:
+        /// Noise Default Constructor.  Seed of 0
+        Noise();
+        /// Noise Constructor.  Different seeds give unrelated noise
+        Noise(const unsigned int _seed);
+
+        /// \return Perlin noise at 4 points
+        __m128 Perlin(const __m128 x, const __m128 y) const;
+        /// \return Perlin noise at 4 points
+        __m128 Perlin(const __m128 x, const __m128 y, const __m128 z) const;
+        /// \return Perlin noise at 4 points
+        __m128 Perlin(const __m128 x, const __m128 y, const __m128 z, const __m128 w) const;
+        /// \return simplex noise at 4 points
+        __m128 Simplex(const __m128 x, const __m128 y) const;
+        /// \return simplex noise at 4 points
+        __m128 Simplex(const __m128 x, const __m128 y, const __m128 z) const;
+        /// \return simplex noise at 4 points
+        __m128 Simplex(const __m128 x, const __m128 y, const __m128 z, const __m128 w) const;
+
+        /// \return fBm or ridged octaves at 4 points, normalized by the total amplitude
+        __m128 Fractal(const __m128 x, const __m128 y, const FractalSettings& settings) const;
+        /// \return fBm or ridged octaves at 4 points, normalized by the total amplitude
+        __m128 Fractal(const __m128 x, const __m128 y, const __m128 z, const FractalSettings& settings) const;
+        /// \return fBm or ridged octaves at 4 points, normalized by the total amplitude
+        __m128 Fractal(const __m128 x, const __m128 y, const __m128 z, const __m128 w, const FractalSettings& settings) const;
+
+        /// Evaluates Fractal at count points across threads
+        void Evaluate(const Vector2* points, const size_t count, const FractalSettings& settings, float* out) const;
+        /// Evaluates Fractal at count points across threads
+        void Evaluate(const Vector3* points, const size_t count, const FractalSettings& settings, float* out) const;
+        /// Evaluates Fractal at count points across threads
+        void Evaluate(const Vector4* points, const size_t count, const FractalSettings& settings, float* out) const;
+        /// Evaluates Fractal on a width x height grid of points origin + (x, y) * step across threads, out is row major
+        void Grid(const Vector2& origin, const Vector2& step, const size_t width, const size_t height, const FractalSettings& settings, float* out) const;
+        /// Evaluates Fractal on a width x height x depth grid of points origin + (x, y, z) * step across threads, out is x fastest then y
+        void Grid(const Vector3& origin, const Vector3& step, const size_t width, const size_t height, const size_t depth, const FractalSettings& settings, float* out) const;
+
+    private:
+        unsigned int seed;
+    };
+
+    /// Normal & tangent generation for indexed triangle meshes, 3 indices per triangle with counter clockwise front faces.
+    /// Each thread owns a contiguous range of vertices & accumulates only the corners in it, so no two threads write the same vertex
+    class Mesh
+    {
+    public:
+        /// Calculates the unnormalized normal of each triangle, with length twice its area, across threads
+        static void FaceNormals(const Vector3* positions, const unsigned int* indices, const size_t triangleCount, Vector3* normals);
+        /// Sums the area weighted normals of the triangles around each vertex & normalizes them across threads.  Unused vertices get a zero normal
+        static void VertexNormals(const Vector3* positions, const size_t vertexCount, const unsigned int* indices, const size_t triangleCount, Vector3* normals);
+        /// Calculates tangents from uvs in the style of MikkTSpace, summing each triangle's UV gradients projected onto the vertex normal & weighted
+        /// by corner angle.  xyz is the unit tangent & w the sign that gives the bitangent as w * cross(normal, tangent)
+        static void Tangents(const Vector3* positions, const Vector3* normals, const Vector2* uvs, const size_t vertexCount, const unsigned int* indices,
+                             const size_t triangleCount, Vector4* tangents);
+
+        /// Welds each vertex to the first earlier kept vertex within epsilon, probing a quantized open addressing hash of cells 4 * epsilon wide.
+        /// remap receives the index in unique of every vertex.  An epsilon of 0 welds only identical positions, with -0 & 0 equal
+        /// \return number of unique vertices
+        static size_t Weld(const Vector3* positions, const size_t count, const float epsilon, unsigned int* remap, std::vector<Vector3>& unique);
+    };
+
+    /// Sweep & prune broad phase over AABBs, sorted along x & swept 4 candidates at a time
+    class BroadPhase
+    {
+    public:
+        /// Number of boxes swept per parallel chunk, fixed so the pair list comes out in the same order on every machine
+        static const size_t ChunkSize = 1 << 12;
+
+        /// BroadPhase Default Constructor.  Creates an empty broad phase
+        BroadPhase();
+
+        /// Sorts count boxes by min x with a parallel radix sort & finds every overlapping pair
+        void Build(const AABB* boxes, const size_t count);
+
+        /// Re-sorts count boxes starting from the order of the last call with an insertion sort, close to linear when the boxes moved little,
+        /// & finds every overlapping pair.  Falls back to Build when count changed or the boxes moved too far
+        void Update(const AABB* boxes, const size_t count);
+
+        /// \return number of overlapping pairs found by the last Build or Update
+        size_t PairCount() const;
+        /// \return overlapping pairs as consecutive indices, the lower index of each pair first
+        const unsigned int* Pairs() const;
+        /// \return number of boxes
+        size_t Size() const;
+        /// \return original index of each box sorted by min x
+        const unsigned int* SortedIds() const;
+
+    private:
+        void Gather(const AABB* boxes);
+        void Sweep();
+
+        // Boxes sorted by min x as SoA, padded by 3 so a sweep can read 4 candidates from any box
+        std::vector<float>                     minX;
+        std::vector<float>                     maxX;
+        std::vector<float>                     minY;
+        std::vector<float>                     maxY;
+        std::vector<float>                     minZ;
+        std::vector<float>                     maxZ;
+        std::vector<unsigned int>              sortedIds;
+        // Sortable integer form of each sorted min x, reused by Update
+        std::vector<unsigned int>              keys;
+        // One pair list per chunk, so the sweep needs no locks
+        std::vector<std::vector<unsigned int>> chunkPairs;
+        std::vector<unsigned int>              pairs;
+        size_t                                 count;
+    };
+
+    /// Convex shape in world space for the narrow phase, a core shape grown by radius
+    class __declspec(align(16)) ConvexShape
+    {
+    public:
+        /// Sphere & box centre, capsule segment midpoint or hull origin
+        Vector3        center;
+        /// Orientation as world space unit axes.  A capsule's segment lies along axes[1]
+        Vector3        axes[3];
+        /// Box half size along each axis, y holds half the segment length of a capsule
+        Vector3        extents;
+        /// Hull points in the local space of center & axes, read but not owned by the shape
+        const Vector3* points;
+        /// Number of hull points
+        size_t         pointCount;
+        /// Radius added around the core, 0 for boxes & hulls
+        float          radius;
+        /// Kind of shape
+        ShapeType      type;
+
+        /// ConvexShape Default Constructor.  Creates a point at the origin
+        ConvexShape();
+
+        /// \return sphere of radius around center
+        static ConvexShape Sphere(const Vector3& center, const float radius);
+        /// \return capsule of radius around the segment from point1 to point2
+        static ConvexShape Capsule(const Vector3& point1, const Vector3& point2, const float radius);
+        /// \return box with half sizes extents around center, rotated by rotation
+        static ConvexShape Box(const Vector3& center, const Quaternion& rotation, const Vector3& extents);
+        /// \return hull of count points, rotated by rotation & then moved to position
+        static ConvexShape Hull(const Vector3* points, const size_t count, const Vector3& position, const Quaternion& rotation);
+
+        /// \return point of the core, the shape without its radius, furthest along direction
+        Vector3 CoreSupport(const Vector3& direction) const;
+        /// \return point of the shape furthest along direction
+        Vector3 Support(const Vector3& direction) const;
+    };
+
+    /// Contact points between two shapes, all sharing one normal
+    class __declspec(align(16)) ContactManifold
+    {
+    public:
+        /// Maximum number of contact points kept per manifold
+        static const int MaxPoints = 4;
+
+        /// Unit normal pointing from the first shape to the second
+        Vector3 normal;
+        /// Contact points in world space, midway between the two surfaces
+        Vector3 points[MaxPoints];
+        /// Penetration depth at each point
+        float   depths[MaxPoints];
+        /// Number of contact points, 0 when the shapes are apart
+        int     count;
+
+        /// ContactManifold Default Constructor.  Creates an empty manifold
+        ContactManifold();
+    };
+
+    /// Narrow phase collision between convex shapes using GJK, EPA & box-box SAT
+    class NarrowPhase
+    {
+    public:
+        /// Finds the closest points of the cores of shape1 & shape2 with GJK, point1 & point2 only mean something while the cores are apart
+        /// \return distance between the cores, 0 if they overlap
+        static float Distance(const ConvexShape& shape1, const ConvexShape& shape2, Vector3& point1, Vector3& point2);
+
+        /// Finds how far shape1 & shape2 overlap with GJK & then EPA.  normal points from shape1 to shape2
+        /// \return true if the shapes overlap
+        static bool  Penetration(const ConvexShape& shape1, const ConvexShape& shape2, Vector3& normal, float& depth, Vector3& point1, Vector3& point2);
+
+        /// Tests the 15 separating axes of two boxes at once & clips the incident face against the reference face for up to 4 contacts
+        /// \return true if the boxes overlap
+        static bool  BoxBox(const ConvexShape& box1, const ConvexShape& box2, ContactManifold& manifold);
+
+        /// Builds the manifold of shape1 & shape2, closed form for spheres & capsules, SAT for box pairs & GJK/EPA otherwise
+        /// \return true if the shapes touch
+        static bool  Collide(const ConvexShape& shape1, const ConvexShape& shape2, ContactManifold& manifold);
+
+        /// Builds the manifold of each pair across threads, pairs holding 2 indices into shapes per pair like BroadPhase::Pairs
+        static void  Collide(const ConvexShape* shapes, const unsigned int* pairs, const size_t pairCount, ContactManifold* manifolds);
+    };
+
+    /// Contains functionality necessary for dynamically sized vector operations, instantiated for float & double
+    template <typename T>
+    class VectorN
+    {
+    public:
+        /// VectorN Default Constructor.  Creates an empty vector
+        VectorN();
+        /// VectorN Constructor.  Creates a vector of size elements all equal to value
+        VectorN(const size_t size, const T value = T(0));
+
+        /// \return number of elements
+        size_t   Size() const;
+        /// \return pointer to the contiguous elements
+        T*       Data();
+        /// \return pointer to the contiguous elements
+        const T* Data() const;
+
+        /// Calculates the dot product between the given VectorNs
+        /// \return dot product of vec1 and vec2
+        static T Dot(const VectorN& vec1, const VectorN& vec2);
+
+        /// Calculates the magnitude of the given VectorN
+        /// \return magnitude of vec
+        static T Magnitude(const VectorN& vec);
+
+        /// \return element at index
+        T&       operator [] (const size_t index);
+        /// \return element at index
+        const T& operator [] (const size_t index) const;
+        /// Calculates the addition between this and vec
+        VectorN  operator +  (const VectorN& vec) const;
+        /// Calculates the difference between this and vec
+        VectorN  operator -  (const VectorN& vec) const;
+        /// Calculates the multiplication of the elements of this and num
+        VectorN  operator *  (const T num) const;
+        /// Calculates the addition between this and vec
+        VectorN& operator += (const VectorN& vec);
+        /// Calculates the difference between this and vec
+        VectorN& operator -= (const VectorN& vec);
+        /// Calculates the multiplication of the elements of this and num
+        VectorN& operator *= (const T num);
+
+    private:
+        std::vector<T> elements;
+    };
+
+    /// Contains functionality necessary for dynamically sized row major matrix operations, instantiated for float & double
+    template <typename T>
+    class MatrixN
+    {
+    public:
+        /// MatrixN Default Constructor.  Creates an empty matrix
+        MatrixN();
+        /// MatrixN Constructor.  Creates a rows x cols matrix with every element equal to value
+        MatrixN(const size_t rows, const size_t cols, const T value = T(0));
+
+        /// Creates a size x size Identity matrix
+        static MatrixN Identity(const size_t size);
+
+        /// \return number of rows
+        size_t   Rows() const;
+        /// \return number of columns
+        size_t   Cols() const;
+        /// \return pointer to the contiguous row major elements
+        T*       Data();
+        /// \return pointer to the contiguous row major elements
+        const T* Data() const;
+
+        /// Calculates the the transpose of the given matrix
+        /// \return transpose of mat
+        static MatrixN Transpose(const MatrixN& mat);
+
+        /// Calculates out = alpha * mat1 * mat2 + beta * out with packed, cache tiled SIMD kernels across threads.
+        /// out is resized and zeroed first if it doesn't match
+        static void Multiply(const MatrixN& mat1, const MatrixN& mat2, MatrixN& out, const T alpha = T(1), const T beta = T(0));
+        /// Calculates c = alpha * a * b + beta * c on row major m x k & k x n arrays with the given row strides, on AVX-512, AVX2 or SSE kernels by cpuid
+        /// Calculates c = alpha * a * b + beta * c on row major m x k & k x n arrays with the given row strides
+        static void Gemm(const size_t m, const size_t n, const size_t k, const T alpha, const T* a, const size_t lda,
+                         const T* b, const size_t ldb, const T beta, T* c, const size_t ldc);
+
+        /// Calculates the multiplication of mat and vec across threads
+        /// \return mat * vec
+        static VectorN<T> Multiply(const MatrixN& mat, const VectorN<T>& vec);
+
+        /// Calculates the blocked LU Decomposition with partial pivoting of the square matrix mat in place.
+        /// mat holds U on and above the diagonal & the unit lower L below it, row i was swapped with pivots[i]
+        /// \return false if mat is singular
+        static bool LUFactor(MatrixN& mat, std::vector<size_t>& pivots);
+
+        /// Calculates the LU Decomposition of the given MatrixN with partial pivoting
+        /// \return lower & upper matrices with mat, its rows swapped as given by pivots, equal to lower * upper
+        static std::vector<MatrixN> LUDecomposition(const MatrixN& mat, std::vector<size_t>& pivots);
+
+        /// Solves mat * x = vec given the output of LUFactor
+        /// \return x
+        static VectorN<T> Solve(const MatrixN& lu, const std::vector<size_t>& pivots, const VectorN<T>& vec);
+
+        /// Calculates the determinant of the given matrix
+        /// \return determinant of mat
+        static T Determinant(const MatrixN& mat);
+
+        /// \return pointer to the elements of row
+        T*         operator [] (const size_t row);
+        /// \return pointer to the elements of row
+        const T*   operator [] (const size_t row) const;
+        /// Calculates the addition between this and mat
+        MatrixN    operator +  (const MatrixN& mat) const;
+        /// Calculates the difference between this and mat
+        MatrixN    operator -  (const MatrixN& mat) const;
+        /// Calculates the multiplication of this and mat
+        MatrixN    operator *  (const MatrixN& mat) const;
+        /// Calculates the multiplication of this and vec
+        VectorN<T> operator *  (const VectorN<T>& vec) const;
+        /// Calculates the multiplication of the elements of this and num
+        MatrixN    operator *  (const T num) const;
+
+    private:
+        size_t         rows;
+        size_t         cols;
+        std::vector<T> elements;
+    };
+
     /// Calculates the value of num to the pow power
     /// \return num^pow
     extern constexpr float Pow(const float num, const int pow);
@@ -641,4 +2103,15 @@ namespace NullX
     /// Transforms the given degrees to radians
     /// \return deg in radians
     extern constexpr float ToRadians(const float deg);
+
+    /// Splits [0, count) into contiguous ranges of at least grain elements and runs func on each across the hardware threads
+    void ParallelFor(const size_t count, const size_t grain, const std::function<void(size_t begin, size_t end)>& func);
+
+    /// \return true if the CPU supports AVX2 & FMA & the OS saves YMM state, which the 256 bit kernels need
+    bool HasAVX2();
+    /// \return true if the CPU supports AVX-512F & the OS saves ZMM state, which the 512 bit kernels need
+    bool HasAVX512();
+
+    /// Calculates the sine & cosine of 4 angles in radians at once, accurate to a few ulp for |angle| < 8192
+    void SinCos(const __m128 angles, __m128& sines, __m128& cosines);
 }
@@ -0,0 +1,121 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <float.h>
+#include <mutex>
+
+namespace NullX
+{
+    AABB::AABB() : min(Vector3(FLT_MAX, FLT_MAX, FLT_MAX)), max(Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX))
+    {
+    }
+
+    AABB::AABB(const Vector3& _min, const Vector3& _max) : min(_min), max(_max)
+    {
+    }
+
+    void AABB::Expand(const Vector3& point)
+    {
+        min.elementsSIMD = _mm_min_ps(min.elementsSIMD, point.elementsSIMD);
+        max.elementsSIMD = _mm_max_ps(max.elementsSIMD, point.elementsSIMD);
+    }
+
+    void AABB::Expand(const AABB& box)
+    {
+        min.elementsSIMD = _mm_min_ps(min.elementsSIMD, box.min.elementsSIMD);
+        max.elementsSIMD = _mm_max_ps(max.elementsSIMD, box.max.elementsSIMD);
+    }
+
+    Vector3 AABB::Center() const
+    {
+        return Vector3(_mm_mul_ps(_mm_add_ps(min.elementsSIMD, max.elementsSIMD), _mm_set1_ps(0.5f)));
+    }
+
+    Vector3 AABB::Extents() const
+    {
+        return Vector3(_mm_mul_ps(_mm_sub_ps(max.elementsSIMD, min.elementsSIMD), _mm_set1_ps(0.5f)));
+    }
+
+    bool AABB::Contains(const Vector3& point) const
+    {
+        __m128 inside = _mm_and_ps(_mm_cmpge_ps(point.elementsSIMD, min.elementsSIMD), _mm_cmple_ps(point.elementsSIMD, max.elementsSIMD));
+        return (_mm_movemask_ps(inside) & 0x7) == 0x7;
+    }
+
+    bool AABB::Intersects(const AABB& box) const
+    {
+        __m128 overlap = _mm_and_ps(_mm_cmple_ps(min.elementsSIMD, box.max.elementsSIMD), _mm_cmpge_ps(max.elementsSIMD, box.min.elementsSIMD));
+        return (_mm_movemask_ps(overlap) & 0x7) == 0x7;
+    }
+
+    AABB AABB::FromPoints(const Vector3* points, const size_t count)
+    {
+        AABB toReturn = AABB();
+        std::mutex merge;
+
+        ParallelFor(count, 1 << 16, [&](size_t begin, size_t end)
+        {
+            // Two accumulator pairs hide the latency of the min/max dependency chain
+            __m128 min0 = _mm_set1_ps(FLT_MAX), min1 = min0;
+            __m128 max0 = _mm_set1_ps(-FLT_MAX), max1 = max0;
+            size_t i = begin;
+
+            for (; i + 2 <= end; i += 2)
+            {
+                min0 = _mm_min_ps(min0, points[i].elementsSIMD);
+                max0 = _mm_max_ps(max0, points[i].elementsSIMD);
+                min1 = _mm_min_ps(min1, points[i + 1].elementsSIMD);
+                max1 = _mm_max_ps(max1, points[i + 1].elementsSIMD);
+            }
+
+            for (; i < end; i++)
+            {
+                min0 = _mm_min_ps(min0, points[i].elementsSIMD);
+                max0 = _mm_max_ps(max0, points[i].elementsSIMD);
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+            toReturn.Expand(AABB(Vector3(_mm_min_ps(min0, min1)), Vector3(_mm_max_ps(max0, max1))));
+        });
+
+        return toReturn;
+    }
+
+    AABB AABB::Transform(const AABB& box, const Matrix4& mat)
+    {
+        AABB toReturn = AABB();
+        Transform(mat, &box, &toReturn, 1);
+        return toReturn;
+    }
+
+    void AABB::Transform(const Matrix4& mat, const AABB* boxes, AABB* out, const size_t count)
+    {
+        // Columns of the upper 3x3 and the translation, each holding one entry per output axis
+        __m128 col0 = mat.rowsSIMD[0];
+        __m128 col1 = mat.rowsSIMD[1];
+        __m128 col2 = mat.rowsSIMD[2];
+        __m128 col3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+        col3 = _mm_and_ps(col3, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+
+        for (size_t i = 0; i < count; i++)
+        {
+            // Arvo: each output axis takes whichever corner minimizes or maximizes each term
+            __m128 boxMin = boxes[i].min.elementsSIMD;
+            __m128 boxMax = boxes[i].max.elementsSIMD;
+            __m128 a0 = _mm_mul_ps(col0, _mm_shuffle_ps(boxMin, boxMin, _MM_SHUFFLE(0, 0, 0, 0)));
+            __m128 b0 = _mm_mul_ps(col0, _mm_shuffle_ps(boxMax, boxMax, _MM_SHUFFLE(0, 0, 0, 0)));
+            __m128 a1 = _mm_mul_ps(col1, _mm_shuffle_ps(boxMin, boxMin, _MM_SHUFFLE(1, 1, 1, 1)));
+            __m128 b1 = _mm_mul_ps(col1, _mm_shuffle_ps(boxMax, boxMax, _MM_SHUFFLE(1, 1, 1, 1)));
+            __m128 a2 = _mm_mul_ps(col2, _mm_shuffle_ps(boxMin, boxMin, _MM_SHUFFLE(2, 2, 2, 2)));
+            __m128 b2 = _mm_mul_ps(col2, _mm_shuffle_ps(boxMax, boxMax, _MM_SHUFFLE(2, 2, 2, 2)));
+
+            out[i].min.elementsSIMD = _mm_add_ps(_mm_add_ps(col3, _mm_min_ps(a0, b0)), _mm_add_ps(_mm_min_ps(a1, b1), _mm_min_ps(a2, b2)));
+            out[i].max.elementsSIMD = _mm_add_ps(_mm_add_ps(col3, _mm_max_ps(a0, b0)), _mm_add_ps(_mm_max_ps(a1, b1), _mm_max_ps(a2, b2)));
+        }
+    }
+}
@@ -0,0 +1,810 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+#include <float.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace NullX
+{
+    // Deep enough for a QBVH over hundreds of millions of triangles, Subdivide caps the depth to match
+    static const int    StackSize         = 512;
+    static const size_t MaxBuildDepth     = 128;
+    static const size_t ParallelBinSize   = 1 << 16;
+    static const size_t ParallelSplitSize = 1 << 12;
+
+    // Smallest direction magnitude the slab test divides by, keeps 1 / dir finite for axis aligned rays
+    static const float  MinDirection      = 1e-20f;
+
+    struct BVHBin
+    {
+        __m128 min;
+        __m128 max;
+        size_t count;
+    };
+
+    struct BVH::BuildNode
+    {
+        __m128 min;
+        __m128 max;
+        std::unique_ptr<BuildNode> left;
+        std::unique_ptr<BuildNode> right;
+        size_t begin;
+        size_t count;
+    };
+
+    struct BVH::BuildContext
+    {
+        std::vector<Vector3>      boundsMin;
+        std::vector<Vector3>      boundsMax;
+        std::vector<Vector3>      centroids;
+        std::vector<unsigned int> order;
+        size_t                    parallelDepth;
+    };
+
+    static float HalfArea(const __m128 min, const __m128 max)
+    {
+        __m128 extent = _mm_max_ps(_mm_sub_ps(max, min), _mm_setzero_ps());
+        __m128 rotated = _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(3, 0, 2, 1));
+        return _mm_cvtss_f32(_mm_dp_ps(extent, rotated, 0x71));
+    }
+
+    // Zero components are nudged to MinDirection with their sign kept, so a slab parallel to the ray gives a huge t instead of 0 * inf = NaN
+    static __m128 SlabReciprocal(const __m128 dir)
+    {
+        __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 magnitude = _mm_max_ps(_mm_andnot_ps(signMask, dir), _mm_set1_ps(MinDirection));
+        return _mm_div_ps(_mm_set1_ps(1.0f), _mm_or_ps(magnitude, _mm_and_ps(signMask, dir)));
+    }
+
+    static void ResetBins(BVHBin bins[3][BVH::BinCount])
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (size_t i = 0; i < BVH::BinCount; i++)
+            {
+                bins[axis][i].min = _mm_set1_ps(FLT_MAX);
+                bins[axis][i].max = _mm_set1_ps(-FLT_MAX);
+                bins[axis][i].count = 0;
+            }
+        }
+    }
+
+    static void MergeBins(BVHBin dest[3][BVH::BinCount], const BVHBin src[3][BVH::BinCount])
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (size_t i = 0; i < BVH::BinCount; i++)
+            {
+                dest[axis][i].min = _mm_min_ps(dest[axis][i].min, src[axis][i].min);
+                dest[axis][i].max = _mm_max_ps(dest[axis][i].max, src[axis][i].max);
+                dest[axis][i].count += src[axis][i].count;
+            }
+        }
+    }
+
+    static __m128i BinIndices(const __m128 centroid, const __m128 centroidMin, const __m128 binScale)
+    {
+        __m128i index = _mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(centroid, centroidMin), binScale));
+        return _mm_min_epi32(_mm_max_epi32(index, _mm_setzero_si128()), _mm_set1_epi32(static_cast<int>(BVH::BinCount) - 1));
+    }
+
+    Ray::Ray() : origin(Vector3()), direction(Vector3()), tMax(FLT_MAX)
+    {
+    }
+
+    Ray::Ray(const Vector3& _origin, const Vector3& _direction, const float _tMax) : origin(_origin), direction(_direction), tMax(_tMax)
+    {
+    }
+
+    RayHit::RayHit() : t(FLT_MAX), u(0.0f), v(0.0f), triangle(-1)
+    {
+    }
+
+    BVH::BVH() : triangleCount(0)
+    {
+    }
+
+    void BVH::Build(const Vector3* vertices, const size_t _triangleCount)
+    {
+        nodes.clear();
+        blocks.clear();
+        triangleCount = _triangleCount;
+
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        BuildContext context = BuildContext();
+        context.boundsMin.resize(triangleCount);
+        context.boundsMax.resize(triangleCount);
+        context.centroids.resize(triangleCount);
+        context.order.resize(triangleCount);
+
+        // Splitting into both children on a new thread doubles the workers each level
+        size_t threads = std::thread::hardware_concurrency();
+        context.parallelDepth = 0;
+
+        while ((static_cast<size_t>(1) << context.parallelDepth) < threads)
+        {
+            context.parallelDepth++;
+        }
+
+        ParallelFor(triangleCount, 4096, [&](size_t begin, size_t end)
+        {
+            __m128 half = _mm_set1_ps(0.5f);
+
+            for (size_t i = begin; i < end; i++)
+            {
+                const __m128 v0 = vertices[i * 3 + 0].elementsSIMD;
+                const __m128 v1 = vertices[i * 3 + 1].elementsSIMD;
+                const __m128 v2 = vertices[i * 3 + 2].elementsSIMD;
+                __m128 min = _mm_min_ps(_mm_min_ps(v0, v1), v2);
+                __m128 max = _mm_max_ps(_mm_max_ps(v0, v1), v2);
+
+                context.boundsMin[i].elementsSIMD = min;
+                context.boundsMax[i].elementsSIMD = max;
+                context.centroids[i].elementsSIMD = _mm_mul_ps(_mm_add_ps(min, max), half);
+                context.order[i] = static_cast<unsigned int>(i);
+            }
+        });
+
+        std::unique_ptr<BuildNode> root = Subdivide(context, 0, triangleCount, 0);
+
+        // A QBVH has roughly a third as many nodes as leaves
+        nodes.reserve(triangleCount / MaxLeafSize / 2 + 1);
+        blocks.reserve(triangleCount / MaxLeafSize + 1);
+        Flatten(root.get(), context.order, vertices);
+    }
+
+    std::unique_ptr<BVH::BuildNode> BVH::Subdivide(BuildContext& context, const size_t begin, const size_t end, const size_t depth)
+    {
+        std::unique_ptr<BuildNode> node = std::unique_ptr<BuildNode>(new BuildNode());
+        node->begin = begin;
+        node->count = end - begin;
+
+        // Triangle bounds and centroid bounds, split across threads near the root
+        __m128 min = _mm_set1_ps(FLT_MAX);
+        __m128 max = _mm_set1_ps(-FLT_MAX);
+        __m128 centroidMin = _mm_set1_ps(FLT_MAX);
+        __m128 centroidMax = _mm_set1_ps(-FLT_MAX);
+        std::mutex merge;
+
+        ParallelFor(node->count, ParallelBinSize, [&](size_t first, size_t last)
+        {
+            __m128 localMin = _mm_set1_ps(FLT_MAX);
+            __m128 localMax = _mm_set1_ps(-FLT_MAX);
+            __m128 localCentroidMin = _mm_set1_ps(FLT_MAX);
+            __m128 localCentroidMax = _mm_set1_ps(-FLT_MAX);
+
+            for (size_t i = begin + first; i < begin + last; i++)
+            {
+                unsigned int prim = context.order[i];
+                localMin = _mm_min_ps(localMin, context.boundsMin[prim].elementsSIMD);
+                localMax = _mm_max_ps(localMax, context.boundsMax[prim].elementsSIMD);
+                localCentroidMin = _mm_min_ps(localCentroidMin, context.centroids[prim].elementsSIMD);
+                localCentroidMax = _mm_max_ps(localCentroidMax, context.centroids[prim].elementsSIMD);
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+            min = _mm_min_ps(min, localMin);
+            max = _mm_max_ps(max, localMax);
+            centroidMin = _mm_min_ps(centroidMin, localCentroidMin);
+            centroidMax = _mm_max_ps(centroidMax, localCentroidMax);
+        });
+
+        node->min = min;
+        node->max = max;
+
+        if (node->count <= 1 || depth >= MaxBuildDepth)
+        {
+            return node;
+        }
+
+        // Bin centroids along all three axes at once
+        __m128 centroidExtent = _mm_sub_ps(centroidMax, centroidMin);
+        __m128 degenerate = _mm_cmple_ps(centroidExtent, _mm_set1_ps(1e-12f));
+        __m128 binScale = _mm_div_ps(_mm_set1_ps(BinCount * 0.9999f), centroidExtent);
+        binScale = _mm_andnot_ps(degenerate, binScale);
+
+        BVHBin bins[3][BinCount];
+        ResetBins(bins);
+
+        ParallelFor(node->count, ParallelBinSize, [&](size_t first, size_t last)
+        {
+            BVHBin localBins[3][BinCount];
+            ResetBins(localBins);
+
+            for (size_t i = begin + first; i < begin + last; i++)
+            {
+                unsigned int prim = context.order[i];
+                __m128i index = BinIndices(context.centroids[prim].elementsSIMD, centroidMin, binScale);
+                int binX = _mm_cvtsi128_si32(index);
+                int binY = _mm_extract_epi32(index, 1);
+                int binZ = _mm_extract_epi32(index, 2);
+                __m128 primMin = context.boundsMin[prim].elementsSIMD;
+                __m128 primMax = context.boundsMax[prim].elementsSIMD;
+
+                localBins[0][binX].min = _mm_min_ps(localBins[0][binX].min, primMin);
+                localBins[0][binX].max = _mm_max_ps(localBins[0][binX].max, primMax);
+                localBins[0][binX].count++;
+                localBins[1][binY].min = _mm_min_ps(localBins[1][binY].min, primMin);
+                localBins[1][binY].max = _mm_max_ps(localBins[1][binY].max, primMax);
+                localBins[1][binY].count++;
+                localBins[2][binZ].min = _mm_min_ps(localBins[2][binZ].min, primMin);
+                localBins[2][binZ].max = _mm_max_ps(localBins[2][binZ].max, primMax);
+                localBins[2][binZ].count++;
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+            MergeBins(bins, localBins);
+        });
+
+        // Sweep the bins from both ends to evaluate every split plane
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        size_t bestSplit = 0;
+        int degenerateMask = _mm_movemask_ps(degenerate);
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (degenerateMask & (1 << axis))
+            {
+                continue;
+            }
+
+            float rightArea[BinCount];
+            size_t rightCount[BinCount];
+            __m128 sweepMin = _mm_set1_ps(FLT_MAX);
+            __m128 sweepMax = _mm_set1_ps(-FLT_MAX);
+            size_t sweepCount = 0;
+
+            for (size_t i = BinCount - 1; i > 0; i--)
+            {
+                sweepMin = _mm_min_ps(sweepMin, bins[axis][i].min);
+                sweepMax = _mm_max_ps(sweepMax, bins[axis][i].max);
+                sweepCount += bins[axis][i].count;
+                rightArea[i] = HalfArea(sweepMin, sweepMax);
+                rightCount[i] = sweepCount;
+            }
+
+            sweepMin = _mm_set1_ps(FLT_MAX);
+            sweepMax = _mm_set1_ps(-FLT_MAX);
+            sweepCount = 0;
+
+            for (size_t i = 1; i < BinCount; i++)
+            {
+                sweepMin = _mm_min_ps(sweepMin, bins[axis][i - 1].min);
+                sweepMax = _mm_max_ps(sweepMax, bins[axis][i - 1].max);
+                sweepCount += bins[axis][i - 1].count;
+
+                if (sweepCount == 0 || rightCount[i] == 0)
+                {
+                    continue;
+                }
+
+                float cost = HalfArea(sweepMin, sweepMax) * sweepCount + rightArea[i] * rightCount[i];
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        // SAH with a traversal step costing as much as testing one block of 4 triangles
+        float leafCost = static_cast<float>((node->count + 3) / 4);
+        float splitCost = 1.0f + bestCost / HalfArea(min, max);
+
+        if (node->count <= MaxLeafSize && (bestAxis < 0 || leafCost <= splitCost))
+        {
+            return node;
+        }
+
+        size_t middle = begin + node->count / 2;
+
+        if (bestAxis >= 0)
+        {
+            unsigned int* split = std::partition(context.order.data() + begin, context.order.data() + end, [&](unsigned int prim)
+            {
+                __m128i index = BinIndices(context.centroids[prim].elementsSIMD, centroidMin, binScale);
+                int bin = (bestAxis == 0) ? _mm_cvtsi128_si32(index) : (bestAxis == 1) ? _mm_extract_epi32(index, 1) : _mm_extract_epi32(index, 2);
+                return static_cast<size_t>(bin) < bestSplit;
+            });
+
+            middle = split - context.order.data();
+        }
+
+        // Coincident centroids can't be separated spatially, fall back to an even split of the range
+        if (middle == begin || middle == end)
+        {
+            middle = begin + node->count / 2;
+        }
+
+        if (depth < context.parallelDepth && node->count > ParallelSplitSize)
+        {
+            std::thread worker([&]()
+            {
+                node->left = Subdivide(context, begin, middle, depth + 1);
+            });
+
+            node->right = Subdivide(context, middle, end, depth + 1);
+            worker.join();
+        }
+        else
+        {
+            node->left = Subdivide(context, begin, middle, depth + 1);
+            node->right = Subdivide(context, middle, end, depth + 1);
+        }
+
+        return node;
+    }
+
+    int BVH::Flatten(const BuildNode* node, const std::vector<unsigned int>& order, const Vector3* vertices)
+    {
+        // Pull grandchildren up until the node has 4 children, opening the largest first
+        const BuildNode* slots[4] = { node, nullptr, nullptr, nullptr };
+        int slotCount = 1;
+
+        if (node->left)
+        {
+            slots[0] = node->left.get();
+            slots[1] = node->right.get();
+            slotCount = 2;
+        }
+
+        while (slotCount < 4)
+        {
+            int largest = -1;
+            float largestArea = -1.0f;
+
+            for (int i = 0; i < slotCount; i++)
+            {
+                float area = HalfArea(slots[i]->min, slots[i]->max);
+
+                if (slots[i]->left && area > largestArea)
+                {
+                    largest = i;
+                    largestArea = area;
+                }
+            }
+
+            if (largest < 0)
+            {
+                break;
+            }
+
+            const BuildNode* opened = slots[largest];
+            slots[largest] = opened->left.get();
+            slots[slotCount++] = opened->right.get();
+        }
+
+        int index = static_cast<int>(nodes.size());
+        nodes.push_back(Node());
+
+        for (int i = 0; i < 4; i++)
+        {
+            // Empty slots are flagged with a negative block count and masked out during traversal
+            nodes[index].minX[i] = nodes[index].minY[i] = nodes[index].minZ[i] = 0.0f;
+            nodes[index].maxX[i] = nodes[index].maxY[i] = nodes[index].maxZ[i] = 0.0f;
+            nodes[index].children[i] = 0;
+            nodes[index].blockCounts[i] = -1;
+        }
+
+        for (int i = 0; i < slotCount; i++)
+        {
+            int child = 0;
+            int blockCount = 0;
+
+            if (slots[i]->left)
+            {
+                child = Flatten(slots[i], order, vertices);
+            }
+            else
+            {
+                child = ~FlattenLeaf(slots[i], order, vertices);
+                blockCount = static_cast<int>((slots[i]->count + 3) / 4);
+            }
+
+            // nodes may have been reallocated by the recursion
+            Node& flat = nodes[index];
+            Vector3 min = Vector3(slots[i]->min);
+            Vector3 max = Vector3(slots[i]->max);
+            flat.minX[i] = min.x;
+            flat.minY[i] = min.y;
+            flat.minZ[i] = min.z;
+            flat.maxX[i] = max.x;
+            flat.maxY[i] = max.y;
+            flat.maxZ[i] = max.z;
+            flat.children[i] = child;
+            flat.blockCounts[i] = blockCount;
+        }
+
+        return index;
+    }
+
+    int BVH::FlattenLeaf(const BuildNode* node, const std::vector<unsigned int>& order, const Vector3* vertices)
+    {
+        int first = static_cast<int>(blocks.size());
+
+        for (size_t i = 0; i < node->count; i += 4)
+        {
+            TriangleBlock block;
+            memset(&block, 0, sizeof(TriangleBlock));
+
+            // Unused lanes stay zeroed, a zero determinant never reports a hit
+            for (size_t lane = 0; lane < 4; lane++)
+            {
+                block.ids[lane] = -1;
+
+                if (i + lane >= node->count)
+                {
+                    continue;
+                }
+
+                unsigned int prim = order[node->begin + i + lane];
+                const Vector3& v0 = vertices[prim * 3 + 0];
+                const Vector3& v1 = vertices[prim * 3 + 1];
+                const Vector3& v2 = vertices[prim * 3 + 2];
+
+                block.v0x[lane] = v0.x;
+                block.v0y[lane] = v0.y;
+                block.v0z[lane] = v0.z;
+                block.e1x[lane] = v1.x - v0.x;
+                block.e1y[lane] = v1.y - v0.y;
+                block.e1z[lane] = v1.z - v0.z;
+                block.e2x[lane] = v2.x - v0.x;
+                block.e2y[lane] = v2.y - v0.y;
+                block.e2z[lane] = v2.z - v0.z;
+                block.ids[lane] = static_cast<int>(prim);
+            }
+
+            blocks.push_back(block);
+        }
+
+        return first;
+    }
+
+    template <bool AnyHit>
+    bool BVH::Traverse(const Ray& ray, RayHit& hit) const
+    {
+        if (nodes.empty())
+        {
+            return false;
+        }
+
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 zero = _mm_setzero_ps();
+        __m128 dirX = _mm_set1_ps(ray.direction.x);
+        __m128 dirY = _mm_set1_ps(ray.direction.y);
+        __m128 dirZ = _mm_set1_ps(ray.direction.z);
+        __m128 originX = _mm_set1_ps(ray.origin.x);
+        __m128 originY = _mm_set1_ps(ray.origin.y);
+        __m128 originZ = _mm_set1_ps(ray.origin.z);
+        __m128 invDirX = SlabReciprocal(dirX);
+        __m128 invDirY = SlabReciprocal(dirY);
+        __m128 invDirZ = SlabReciprocal(dirZ);
+
+        float tBest = ray.tMax;
+        bool found = false;
+        int stackChildren[StackSize];
+        int stackBlocks[StackSize];
+        int top = 0;
+
+        stackChildren[top] = 0;
+        stackBlocks[top++] = 0;
+
+        while (top > 0)
+        {
+            top--;
+            int child = stackChildren[top];
+            int blockCount = stackBlocks[top];
+
+            if (blockCount == 0)
+            {
+                const Node& node = nodes[child];
+                __m128 tBestVec = _mm_set1_ps(tBest);
+                __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), originX), invDirX);
+                __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), originX), invDirX);
+                __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), originY), invDirY);
+                __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), originY), invDirY);
+                __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), originZ), invDirZ);
+                __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), originZ), invDirZ);
+                __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), zero));
+                __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_min_ps(_mm_max_ps(z0, z1), tBestVec));
+                __m128 occupied = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(node.blockCounts)), _mm_set1_epi32(-1)));
+                int mask = _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(tNear, tFar), occupied));
+
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                // Push the farthest child first so the nearest is popped next
+                __declspec(align(16)) float distances[4];
+                _mm_store_ps(distances, tNear);
+                int order[4];
+                int hitCount = 0;
+
+                for (int i = 0; i < 4; i++)
+                {
+                    if (mask & (1 << i))
+                    {
+                        int j = hitCount++;
+
+                        while (j > 0 && distances[order[j - 1]] < distances[i])
+                        {
+                            order[j] = order[j - 1];
+                            j--;
+                        }
+
+                        order[j] = i;
+                    }
+                }
+
+                for (int i = 0; i < hitCount; i++)
+                {
+                    stackChildren[top] = node.children[order[i]];
+                    stackBlocks[top++] = node.blockCounts[order[i]];
+                }
+
+                continue;
+            }
+
+            // Moller-Trumbore against 4 triangles per block
+            int firstBlock = ~child;
+
+            for (int b = firstBlock; b < firstBlock + blockCount; b++)
+            {
+                const TriangleBlock& block = blocks[b];
+                __m128 e1x = _mm_load_ps(block.e1x), e1y = _mm_load_ps(block.e1y), e1z = _mm_load_ps(block.e1z);
+                __m128 e2x = _mm_load_ps(block.e2x), e2y = _mm_load_ps(block.e2y), e2z = _mm_load_ps(block.e2z);
+                __m128 px = _mm_sub_ps(_mm_mul_ps(dirY, e2z), _mm_mul_ps(dirZ, e2y));
+                __m128 py = _mm_sub_ps(_mm_mul_ps(dirZ, e2x), _mm_mul_ps(dirX, e2z));
+                __m128 pz = _mm_sub_ps(_mm_mul_ps(dirX, e2y), _mm_mul_ps(dirY, e2x));
+                __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+                __m128 invDet = _mm_div_ps(one, det);
+                __m128 tx = _mm_sub_ps(originX, _mm_load_ps(block.v0x));
+                __m128 ty = _mm_sub_ps(originY, _mm_load_ps(block.v0y));
+                __m128 tz = _mm_sub_ps(originZ, _mm_load_ps(block.v0z));
+                __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+                __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+                __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+                __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+                __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qx), _mm_mul_ps(dirY, qy)), _mm_mul_ps(dirZ, qz)), invDet);
+                __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+                __m128 valid = _mm_cmpneq_ps(det, zero);
+                valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+                valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+                valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+                valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, zero));
+                valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(tBest)));
+                int mask = _mm_movemask_ps(valid);
+
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                if (AnyHit)
+                {
+                    return true;
+                }
+
+                __declspec(align(16)) float tLanes[4], uLanes[4], vLanes[4];
+                _mm_store_ps(tLanes, t);
+                _mm_store_ps(uLanes, u);
+                _mm_store_ps(vLanes, v);
+
+                for (int lane = 0; lane < 4; lane++)
+                {
+                    if ((mask & (1 << lane)) && tLanes[lane] < tBest)
+                    {
+                        tBest = tLanes[lane];
+                        hit.t = tLanes[lane];
+                        hit.u = uLanes[lane];
+                        hit.v = vLanes[lane];
+                        hit.triangle = block.ids[lane];
+                        found = true;
+                    }
+                }
+            }
+        }
+
+        return found;
+    }
+
+    bool BVH::Intersect(const Ray& ray, RayHit& hit) const
+    {
+        return Traverse<false>(ray, hit);
+    }
+
+    bool BVH::Occluded(const Ray& ray) const
+    {
+        RayHit hit = RayHit();
+        return Traverse<true>(ray, hit);
+    }
+
+    void BVH::IntersectPacket(const Ray* rays, RayHit* hits) const
+    {
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 zero = _mm_setzero_ps();
+
+        // Transpose the packet so each register holds one component of all 4 rays
+        __m128 originX = _mm_setr_ps(rays[0].origin.x, rays[1].origin.x, rays[2].origin.x, rays[3].origin.x);
+        __m128 originY = _mm_setr_ps(rays[0].origin.y, rays[1].origin.y, rays[2].origin.y, rays[3].origin.y);
+        __m128 originZ = _mm_setr_ps(rays[0].origin.z, rays[1].origin.z, rays[2].origin.z, rays[3].origin.z);
+        __m128 dirX = _mm_setr_ps(rays[0].direction.x, rays[1].direction.x, rays[2].direction.x, rays[3].direction.x);
+        __m128 dirY = _mm_setr_ps(rays[0].direction.y, rays[1].direction.y, rays[2].direction.y, rays[3].direction.y);
+        __m128 dirZ = _mm_setr_ps(rays[0].direction.z, rays[1].direction.z, rays[2].direction.z, rays[3].direction.z);
+        __m128 invDirX = SlabReciprocal(dirX);
+        __m128 invDirY = SlabReciprocal(dirY);
+        __m128 invDirZ = SlabReciprocal(dirZ);
+
+        __m128 tBest = _mm_setr_ps(rays[0].tMax, rays[1].tMax, rays[2].tMax, rays[3].tMax);
+        __m128 uBest = zero;
+        __m128 vBest = zero;
+        __m128 idBest = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        int stackChildren[StackSize];
+        int stackBlocks[StackSize];
+        int top = 0;
+
+        if (!nodes.empty())
+        {
+            stackChildren[top] = 0;
+            stackBlocks[top++] = 0;
+        }
+
+        while (top > 0)
+        {
+            top--;
+            int child = stackChildren[top];
+            int blockCount = stackBlocks[top];
+
+            if (blockCount == 0)
+            {
+                // Enter a child if any ray in the packet still reaches it
+                const Node& node = nodes[child];
+
+                for (int i = 3; i >= 0; i--)
+                {
+                    if (node.blockCounts[i] < 0)
+                    {
+                        continue;
+                    }
+
+                    __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minX[i]), originX), invDirX);
+                    __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxX[i]), originX), invDirX);
+                    __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minY[i]), originY), invDirY);
+                    __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxY[i]), originY), invDirY);
+                    __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minZ[i]), originZ), invDirZ);
+                    __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxZ[i]), originZ), invDirZ);
+                    __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), zero));
+                    __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_min_ps(_mm_max_ps(z0, z1), tBest));
+
+                    if (_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) != 0)
+                    {
+                        stackChildren[top] = node.children[i];
+                        stackBlocks[top++] = node.blockCounts[i];
+                    }
+                }
+
+                continue;
+            }
+
+            // Moller-Trumbore with each triangle broadcast against the 4 rays
+            int firstBlock = ~child;
+
+            for (int b = firstBlock; b < firstBlock + blockCount; b++)
+            {
+                const TriangleBlock& block = blocks[b];
+
+                for (int lane = 0; lane < 4; lane++)
+                {
+                    if (block.ids[lane] < 0)
+                    {
+                        continue;
+                    }
+
+                    __m128 e1x = _mm_set1_ps(block.e1x[lane]), e1y = _mm_set1_ps(block.e1y[lane]), e1z = _mm_set1_ps(block.e1z[lane]);
+                    __m128 e2x = _mm_set1_ps(block.e2x[lane]), e2y = _mm_set1_ps(block.e2y[lane]), e2z = _mm_set1_ps(block.e2z[lane]);
+                    __m128 px = _mm_sub_ps(_mm_mul_ps(dirY, e2z), _mm_mul_ps(dirZ, e2y));
+                    __m128 py = _mm_sub_ps(_mm_mul_ps(dirZ, e2x), _mm_mul_ps(dirX, e2z));
+                    __m128 pz = _mm_sub_ps(_mm_mul_ps(dirX, e2y), _mm_mul_ps(dirY, e2x));
+                    __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+                    __m128 invDet = _mm_div_ps(one, det);
+                    __m128 tx = _mm_sub_ps(originX, _mm_set1_ps(block.v0x[lane]));
+                    __m128 ty = _mm_sub_ps(originY, _mm_set1_ps(block.v0y[lane]));
+                    __m128 tz = _mm_sub_ps(originZ, _mm_set1_ps(block.v0z[lane]));
+                    __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+                    __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+                    __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+                    __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+                    __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qx), _mm_mul_ps(dirY, qy)), _mm_mul_ps(dirZ, qz)), invDet);
+                    __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+                    __m128 valid = _mm_cmpneq_ps(det, zero);
+                    valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+                    valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+                    valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+                    valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, zero));
+                    valid = _mm_and_ps(valid, _mm_cmplt_ps(t, tBest));
+
+                    tBest = _mm_blendv_ps(tBest, t, valid);
+                    uBest = _mm_blendv_ps(uBest, u, valid);
+                    vBest = _mm_blendv_ps(vBest, v, valid);
+                    idBest = _mm_blendv_ps(idBest, _mm_castsi128_ps(_mm_set1_epi32(block.ids[lane])), valid);
+                }
+            }
+        }
+
+        __declspec(align(16)) float tLanes[4], uLanes[4], vLanes[4];
+        __declspec(align(16)) int idLanes[4];
+        _mm_store_ps(tLanes, tBest);
+        _mm_store_ps(uLanes, uBest);
+        _mm_store_ps(vLanes, vBest);
+        _mm_store_si128(reinterpret_cast<__m128i*>(idLanes), _mm_castps_si128(idBest));
+
+        for (int i = 0; i < 4; i++)
+        {
+            hits[i] = RayHit();
+
+            if (idLanes[i] >= 0)
+            {
+                hits[i].t = tLanes[i];
+                hits[i].u = uLanes[i];
+                hits[i].v = vLanes[i];
+                hits[i].triangle = idLanes[i];
+            }
+        }
+    }
+
+    void BVH::Intersect(const Ray* rays, RayHit* hits, const size_t count) const
+    {
+        size_t packets = (count + 3) / 4;
+
+        ParallelFor(packets, 64, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                if (i * 4 + 4 <= count)
+                {
+                    IntersectPacket(rays + i * 4, hits + i * 4);
+                    continue;
+                }
+
+                // Pad the tail packet with rays that can't hit anything
+                Ray tail[4];
+                RayHit tailHits[4];
+
+                for (size_t j = 0; j < 4; j++)
+                {
+                    tail[j] = (i * 4 + j < count) ? rays[i * 4 + j] : Ray(Vector3(), Vector3::Forward, -1.0f);
+                }
+
+                IntersectPacket(tail, tailHits);
+
+                for (size_t j = 0; i * 4 + j < count; j++)
+                {
+                    hits[i * 4 + j] = tailHits[j];
+                }
+            }
+        });
+    }
+
+    size_t BVH::TriangleCount() const
+    {
+        return triangleCount;
+    }
+}
\ No newline at end of file
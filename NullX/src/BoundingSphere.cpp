@@ -0,0 +1,124 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <float.h>
+#include <mutex>
+
+namespace NullX
+{
+    // Ritter's growth usually settles within a handful of passes
+    static const int SphereMaxPasses = 16;
+
+    static float DistanceSqr(const __m128 a, const __m128 b)
+    {
+        __m128 diff = _mm_sub_ps(a, b);
+        return _mm_cvtss_f32(_mm_dp_ps(diff, diff, 0x71));
+    }
+
+    // Parallel search for the point farthest from center
+    static size_t Farthest(const Vector3* points, const size_t count, const __m128 center, float& distanceSqr)
+    {
+        size_t farthest = 0;
+        distanceSqr = -1.0f;
+        std::mutex merge;
+
+        ParallelFor(count, 1 << 16, [&](size_t begin, size_t end)
+        {
+            size_t localFarthest = begin;
+            float localDistance = -1.0f;
+
+            for (size_t i = begin; i < end; i++)
+            {
+                float distance = DistanceSqr(points[i].elementsSIMD, center);
+
+                if (distance > localDistance)
+                {
+                    localDistance = distance;
+                    localFarthest = i;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+
+            if (localDistance > distanceSqr)
+            {
+                distanceSqr = localDistance;
+                farthest = localFarthest;
+            }
+        });
+
+        return farthest;
+    }
+
+    BoundingSphere::BoundingSphere() : center(Vector3()), radius(0.0f)
+    {
+    }
+
+    BoundingSphere::BoundingSphere(const Vector3& _center, const float _radius) : center(_center), radius(_radius)
+    {
+    }
+
+    bool BoundingSphere::Contains(const Vector3& point) const
+    {
+        return DistanceSqr(point.elementsSIMD, center.elementsSIMD) <= radius * radius;
+    }
+
+    bool BoundingSphere::Intersects(const BoundingSphere& sphere) const
+    {
+        float reach = radius + sphere.radius;
+        return DistanceSqr(sphere.center.elementsSIMD, center.elementsSIMD) <= reach * reach;
+    }
+
+    BoundingSphere BoundingSphere::FromPoints(const Vector3* points, const size_t count)
+    {
+        if (count == 0)
+        {
+            return BoundingSphere();
+        }
+
+        // Start from the most separated pair found by two farthest-point searches
+        float distanceSqr = 0.0f;
+        size_t first = Farthest(points, count, points[0].elementsSIMD, distanceSqr);
+        size_t second = Farthest(points, count, points[first].elementsSIMD, distanceSqr);
+        __m128 center = _mm_mul_ps(_mm_add_ps(points[first].elementsSIMD, points[second].elementsSIMD), _mm_set1_ps(0.5f));
+        float radius = sqrtf(distanceSqr) * 0.5f;
+
+        // Grow toward the farthest outlier until every point is inside
+        for (int pass = 0; pass < SphereMaxPasses; pass++)
+        {
+            size_t outlier = Farthest(points, count, center, distanceSqr);
+
+            if (distanceSqr <= radius * radius)
+            {
+                break;
+            }
+
+            float distance = sqrtf(distanceSqr);
+            float newRadius = (radius + distance) * 0.5f;
+            float shift = (newRadius - radius) / distance;
+            center = _mm_add_ps(center, _mm_mul_ps(_mm_sub_ps(points[outlier].elementsSIMD, center), _mm_set1_ps(shift)));
+            radius = newRadius;
+        }
+
+        // Rounding in the growth steps can leave points a hair outside, so close with the true maximum.
+        // sqrtf may round below it too, so step up until radius * radius covers it the way Contains compares
+        Farthest(points, count, center, distanceSqr);
+        radius = (sqrtf(distanceSqr) > radius) ? sqrtf(distanceSqr) : radius;
+
+        while (radius * radius < distanceSqr)
+        {
+            radius = nextafterf(radius, FLT_MAX);
+        }
+
+        return BoundingSphere(Vector3(center), radius);
+    }
+
+    BoundingSphere BoundingSphere::FromAABB(const AABB& box)
+    {
+        return BoundingSphere(box.Center(), Vector3::Magnitude(box.Extents()));
+    }
+}
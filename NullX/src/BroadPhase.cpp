@@ -0,0 +1,219 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+#include <float.h>
+
+namespace NullX
+{
+    static const size_t BroadPhaseGrain      = 1 << 14;
+    // Update gives up on the insertion sort past this many moves per box, a radix sort is cheaper by then
+    static const size_t BroadPhaseSwapBudget = 8;
+
+    // Flips the sign bit of positive floats & every bit of negative ones so the integers sort like the floats
+    static unsigned int SortableKey(const float value)
+    {
+        unsigned int bits = static_cast<unsigned int>(_mm_cvtsi128_si32(_mm_castps_si128(_mm_set_ss(value))));
+        return bits ^ ((bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000);
+    }
+
+    static int SweepLaneMask(const size_t remaining)
+    {
+        return (remaining >= 4) ? 0xF : (1 << remaining) - 1;
+    }
+
+    BroadPhase::BroadPhase() : count(0)
+    {
+    }
+
+    void BroadPhase::Build(const AABB* boxes, const size_t _count)
+    {
+        count = _count;
+        keys.resize(count);
+        sortedIds.resize(count);
+
+        ParallelFor(count, BroadPhaseGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                keys[i] = SortableKey(boxes[i].min.x);
+            }
+        });
+
+        SpaceFillingCurve::Sort(keys.data(), sortedIds.data(), count);
+        Gather(boxes);
+        Sweep();
+    }
+
+    void BroadPhase::Update(const AABB* boxes, const size_t _count)
+    {
+        if (_count != count)
+        {
+            Build(boxes, _count);
+            return;
+        }
+
+        ParallelFor(count, BroadPhaseGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                keys[i] = SortableKey(boxes[sortedIds[i]].min.x);
+            }
+        });
+
+        // Boxes only move a little between frames, so most are already in place or a few slots away
+        size_t budget = count * BroadPhaseSwapBudget;
+        size_t moves = 0;
+
+        for (size_t i = 1; i < count && moves <= budget; i++)
+        {
+            unsigned int key = keys[i];
+            unsigned int id = sortedIds[i];
+            size_t j = i;
+
+            while (j > 0 && keys[j - 1] > key)
+            {
+                keys[j] = keys[j - 1];
+                sortedIds[j] = sortedIds[j - 1];
+                j--;
+            }
+
+            keys[j] = key;
+            sortedIds[j] = id;
+            moves += i - j;
+        }
+
+        if (moves > budget)
+        {
+            Build(boxes, count);
+            return;
+        }
+
+        Gather(boxes);
+        Sweep();
+    }
+
+    void BroadPhase::Gather(const AABB* boxes)
+    {
+        // A sweep can read 4 candidates from the last box on, the lane masks keep the 3 padding boxes out of it
+        size_t padded = count + 3;
+        minX.assign(padded, FLT_MAX);
+        maxX.assign(padded, -FLT_MAX);
+        minY.assign(padded, FLT_MAX);
+        maxY.assign(padded, -FLT_MAX);
+        minZ.assign(padded, FLT_MAX);
+        maxZ.assign(padded, -FLT_MAX);
+
+        ParallelFor(count, BroadPhaseGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const AABB& box = boxes[sortedIds[i]];
+                minX[i] = box.min.x;
+                maxX[i] = box.max.x;
+                minY[i] = box.min.y;
+                maxY[i] = box.max.y;
+                minZ[i] = box.min.z;
+                maxZ[i] = box.max.z;
+            }
+        });
+    }
+
+    void BroadPhase::Sweep()
+    {
+        size_t chunks = (count + ChunkSize - 1) / ChunkSize;
+        chunkPairs.resize(chunks);
+
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                size_t end = (chunk * ChunkSize + ChunkSize < count) ? chunk * ChunkSize + ChunkSize : count;
+                std::vector<unsigned int>& local = chunkPairs[chunk];
+                local.clear();
+
+                for (size_t i = chunk * ChunkSize; i < end; i++)
+                {
+                    __m128 boxMaxX = _mm_set1_ps(maxX[i]);
+                    __m128 boxMinY = _mm_set1_ps(minY[i]);
+                    __m128 boxMaxY = _mm_set1_ps(maxY[i]);
+                    __m128 boxMinZ = _mm_set1_ps(minZ[i]);
+                    __m128 boxMaxZ = _mm_set1_ps(maxZ[i]);
+                    unsigned int id = sortedIds[i];
+
+                    // Candidates are sorted by min x, so the first one starting past this box's max x ends the sweep
+                    for (size_t j = i + 1; j < count; j += 4)
+                    {
+                        int inX = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&minX[j]), boxMaxX)) & SweepLaneMask(count - j);
+
+                        if (inX == 0)
+                        {
+                            break;
+                        }
+
+                        __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minY[j]), boxMaxY), _mm_cmpge_ps(_mm_loadu_ps(&maxY[j]), boxMinY));
+                        __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minZ[j]), boxMaxZ), _mm_cmpge_ps(_mm_loadu_ps(&maxZ[j]), boxMinZ));
+                        int mask = _mm_movemask_ps(_mm_and_ps(overlapY, overlapZ)) & inX;
+
+                        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+                        {
+                            if (mask & 1)
+                            {
+                                unsigned int other = sortedIds[j + lane];
+                                local.push_back((id < other) ? id : other);
+                                local.push_back((id < other) ? other : id);
+                            }
+                        }
+
+                        if (inX != 0xF)
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+
+        // Chunk lists are concatenated in sweep order
+        std::vector<size_t> offsets = std::vector<size_t>(chunks + 1, 0);
+
+        for (size_t chunk = 0; chunk < chunks; chunk++)
+        {
+            offsets[chunk + 1] = offsets[chunk] + chunkPairs[chunk].size();
+        }
+
+        pairs.resize(offsets[chunks]);
+
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                std::copy(chunkPairs[chunk].begin(), chunkPairs[chunk].end(), pairs.begin() + offsets[chunk]);
+            }
+        });
+    }
+
+    size_t BroadPhase::PairCount() const
+    {
+        return pairs.size() / 2;
+    }
+
+    const unsigned int* BroadPhase::Pairs() const
+    {
+        return pairs.data();
+    }
+
+    size_t BroadPhase::Size() const
+    {
+        return count;
+    }
+
+    const unsigned int* BroadPhase::SortedIds() const
+    {
+        return sortedIds.data();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,477 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    static const size_t ColorGrain = 1 << 12;
+
+    // Full range BT.709, rows of the RGB -> YCbCr matrix & its inverse
+    static const float YCbCrForward[3][3] = { {  0.2126f,          0.7152f,          0.0722f          },
+                                              { -0.2126f / 1.8556f, -0.7152f / 1.8556f, 0.9278f / 1.8556f },
+                                              {  0.7874f / 1.5748f, -0.7152f / 1.5748f, -0.0722f / 1.5748f } };
+    static const float YCbCrInverse[3][3] = { { 1.0f,  0.0f,       1.5748f    },
+                                              { 1.0f, -0.1873243f, -0.4681243f },
+                                              { 1.0f,  1.8556f,     0.0f       } };
+
+    // Splits [0, count) into groups of 4 pixels across threads, the tail group reports how many of its pixels are real
+    template <typename Kernel>
+    static void ForEachGroup(const size_t count, const Kernel& kernel)
+    {
+        ParallelFor((count + 3) / 4, ColorGrain / 4, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                kernel(first, (count - first < 4) ? count - first : 4);
+            }
+        });
+    }
+
+    // Cephes logf for positive x, accurate to about 1 ulp
+    static __m128 Log(const __m128 value)
+    {
+        __m128 x = _mm_max_ps(value, _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+        __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(0x7E));
+        x = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(0.5f));
+        __m128 e = _mm_cvtepi32_ps(exponent);
+
+        // Keep the mantissa in [sqrt(0.5), sqrt(2)) so the polynomial only sees small arguments
+        __m128 small = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+        e = _mm_sub_ps(e, _mm_and_ps(_mm_set1_ps(1.0f), small));
+        x = _mm_add_ps(_mm_sub_ps(x, _mm_set1_ps(1.0f)), _mm_and_ps(x, small));
+
+        __m128 z = _mm_mul_ps(x, x);
+        __m128 y = _mm_set1_ps(7.0376836292e-2f);
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+        y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+        y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+        y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+        return _mm_add_ps(_mm_add_ps(x, y), _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+    }
+
+    // Cephes expf, accurate to about 1 ulp
+    static __m128 Exp(const __m128 value)
+    {
+        __m128 x = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-87.0f)), _mm_set1_ps(88.0f));
+        __m128 fx = _mm_floor_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+        __m128 z = _mm_mul_ps(x, x);
+        __m128 y = _mm_set1_ps(1.9875691500e-4f);
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+        y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f));
+
+        __m128i scale = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7F)), 23);
+        return _mm_mul_ps(y, _mm_castsi128_ps(scale));
+    }
+
+    static __m128 Pow(const __m128 x, const float power)
+    {
+        return Exp(_mm_mul_ps(Log(x), _mm_set1_ps(power)));
+    }
+
+    // Rational minimax fits of the curved segments over [0, 1], reweighted least squares until the error levelled out.  Decode is a (4, 3) fit in c
+    // on [0.04045, 1] within 2.4e-6 relative, encode a (3, 3) fit in sqrt(x) on [0.0031308, 1] within 3.6e-6 absolute
+    static const float DecodeNumerator[5]   = { 0.000835547224f, 0.0393969379f, 0.604904473f, 2.85253525f, 2.58148122f };
+    static const float DecodeDenominator[4] = { 1.0f, 3.7633605f, 1.40789104f, -0.092110157f };
+    static const float EncodeNumerator[4]   = { -0.0489374623f, 1.17473149f, 17.8482704f, 17.944931f };
+    static const float EncodeDenominator[4] = { 1.0f, 14.4695044f, 20.5646286f, 0.884986997f };
+
+    static __m128 Polynomial(const __m128 x, const float* coefficients, const int degree)
+    {
+        __m128 result = _mm_set1_ps(coefficients[degree]);
+
+        for (int i = degree - 1; i >= 0; i--)
+        {
+            result = _mm_add_ps(_mm_mul_ps(result, x), _mm_set1_ps(coefficients[i]));
+        }
+
+        return result;
+    }
+
+    // Both transfer functions work on one channel of 4 pixels.  Channels above 1 are outside the fits & fall back to Pow, which costs a
+    // movemask per register when there are none
+    static __m128 DecodeSRGB(const __m128 color)
+    {
+        __m128 linear = _mm_mul_ps(color, _mm_set1_ps(1.0f / 12.92f));
+        __m128 curve = _mm_div_ps(Polynomial(color, DecodeNumerator, 4), Polynomial(color, DecodeDenominator, 3));
+        __m128 above = _mm_cmpgt_ps(color, _mm_set1_ps(1.0f));
+
+        if (_mm_movemask_ps(above) != 0)
+        {
+            curve = _mm_blendv_ps(curve, Pow(_mm_mul_ps(_mm_add_ps(color, _mm_set1_ps(0.055f)), _mm_set1_ps(1.0f / 1.055f)), 2.4f), above);
+        }
+
+        return _mm_blendv_ps(curve, linear, _mm_cmple_ps(color, _mm_set1_ps(0.04045f)));
+    }
+
+    static __m128 EncodeSRGB(const __m128 color)
+    {
+        __m128 linear = _mm_mul_ps(color, _mm_set1_ps(12.92f));
+        __m128 root = _mm_sqrt_ps(_mm_max_ps(color, _mm_setzero_ps()));
+        __m128 curve = _mm_div_ps(Polynomial(root, EncodeNumerator, 3), Polynomial(root, EncodeDenominator, 3));
+        __m128 above = _mm_cmpgt_ps(color, _mm_set1_ps(1.0f));
+
+        if (_mm_movemask_ps(above) != 0)
+        {
+            curve = _mm_blendv_ps(curve, _mm_sub_ps(_mm_mul_ps(Pow(color, 1.0f / 2.4f), _mm_set1_ps(1.055f)), _mm_set1_ps(0.055f)), above);
+        }
+
+        return _mm_blendv_ps(curve, linear, _mm_cmple_ps(color, _mm_set1_ps(0.0031308f)));
+    }
+
+    // Transposes the group of 4 pixels starting at first into r, g, b & a registers, the tail group repeating its last pixel rather than reading past the end
+    static void LoadGroup(const Vector4* in, const size_t first, const size_t valid, __m128 channels[4])
+    {
+        channels[0] = in[first].elementsSIMD;
+        channels[1] = in[first + ((valid > 1) ? 1 : valid - 1)].elementsSIMD;
+        channels[2] = in[first + ((valid > 2) ? 2 : valid - 1)].elementsSIMD;
+        channels[3] = in[first + valid - 1].elementsSIMD;
+        _MM_TRANSPOSE4_PS(channels[0], channels[1], channels[2], channels[3]);
+    }
+
+    // Transposes r, g, b & a registers back into pixels, writing only the valid ones
+    static void StoreGroup(__m128 channels[4], Vector4* out, const size_t first, const size_t valid)
+    {
+        _MM_TRANSPOSE4_PS(channels[0], channels[1], channels[2], channels[3]);
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            out[first + i].elementsSIMD = channels[i];
+        }
+    }
+
+    // out = rows * rgb + offset on the RGB lanes of one pixel
+    static __m128 Transform3x3(const __m128 color, const __m128 cols[3], const __m128 offset)
+    {
+        __m128 result = _mm_add_ps(_mm_mul_ps(cols[0], _mm_shuffle_ps(color, color, _MM_SHUFFLE(0, 0, 0, 0))),
+                                   _mm_mul_ps(cols[1], _mm_shuffle_ps(color, color, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(_mm_add_ps(result, _mm_mul_ps(cols[2], _mm_shuffle_ps(color, color, _MM_SHUFFLE(2, 2, 2, 2)))), offset);
+        return _mm_blend_ps(result, color, 0x8);
+    }
+
+    static void Columns(const float rows[3][3], __m128 cols[3])
+    {
+        for (int col = 0; col < 3; col++)
+        {
+            cols[col] = _mm_setr_ps(rows[0][col], rows[1][col], rows[2][col], 0.0f);
+        }
+    }
+
+    static __m128i ToUnorm8(const __m128 color)
+    {
+        __m128 clamped = _mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        return _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)));
+    }
+
+    // Packs 4 pixels of 32 bit channels into 4 RGBA8 pixels
+    static __m128i Pack8(const __m128i p0, const __m128i p1, const __m128i p2, const __m128i p3)
+    {
+        return _mm_packus_epi16(_mm_packus_epi32(p0, p1), _mm_packus_epi32(p2, p3));
+    }
+
+    // Round to nearest even after Giesen, denormals go through a float add that lets the FPU do the rounding
+    static __m128i FloatToHalf(const __m128 value)
+    {
+        __m128i bits = _mm_castps_si128(value);
+        __m128i sign = _mm_srli_epi32(_mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000))), 16);
+        __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+        __m128i infNan = _mm_blendv_epi8(_mm_set1_epi32(0x7C00), _mm_set1_epi32(0x7E00), _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7F800000)));
+        __m128i overflow = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(((127 + 16) << 23) - 1));
+
+        __m128 denormMagic = _mm_castsi128_ps(_mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23));
+        __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(magnitude), denormMagic)), _mm_castps_si128(denormMagic));
+        __m128i isDenormal = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(113 << 23));
+
+        __m128i odd = _mm_and_si128(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(1));
+        __m128i normal = _mm_add_epi32(magnitude, _mm_set1_epi32(static_cast<int>((static_cast<unsigned int>(15 - 127) << 23) + 0xFFF)));
+        normal = _mm_srli_epi32(_mm_add_epi32(normal, odd), 13);
+
+        __m128i result = _mm_blendv_epi8(normal, denormal, isDenormal);
+        result = _mm_blendv_epi8(result, infNan, overflow);
+        return _mm_or_si128(result, sign);
+    }
+
+    static __m128 HalfToFloat(const __m128i half)
+    {
+        __m128i magnitude = _mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(half, magnitude), 16);
+        __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+        __m128i infNan = _mm_and_si128(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7BFF)), _mm_set1_epi32(255 << 23));
+
+        // Signalling NaNs come out quiet, as F16C converts them
+        __m128i quiet = _mm_and_si128(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7C00)), _mm_set1_epi32(0x00400000));
+        return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(sign, infNan), quiet)));
+    }
+
+    void Color::SRGBToLinear(const Vector4* in, Vector4* out, const size_t count)
+    {
+        // Working on channels rather than pixels spends no lanes on alpha
+        ForEachGroup(count, [&](size_t first, size_t valid)
+        {
+            __m128 channels[4];
+            LoadGroup(in, first, valid, channels);
+
+            for (int c = 0; c < 3; c++)
+            {
+                channels[c] = DecodeSRGB(channels[c]);
+            }
+
+            StoreGroup(channels, out, first, valid);
+        });
+    }
+
+    void Color::LinearToSRGB(const Vector4* in, Vector4* out, const size_t count)
+    {
+        ForEachGroup(count, [&](size_t first, size_t valid)
+        {
+            __m128 channels[4];
+            LoadGroup(in, first, valid, channels);
+
+            for (int c = 0; c < 3; c++)
+            {
+                channels[c] = EncodeSRGB(channels[c]);
+            }
+
+            StoreGroup(channels, out, first, valid);
+        });
+    }
+
+    void Color::RGBToYCbCr(const Vector4* in, Vector4* out, const size_t count)
+    {
+        __m128 cols[3];
+        Columns(YCbCrForward, cols);
+        __m128 offset = _mm_setr_ps(0.0f, 0.5f, 0.5f, 0.0f);
+
+        ParallelFor(count, ColorGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                out[i].elementsSIMD = Transform3x3(in[i].elementsSIMD, cols, offset);
+            }
+        });
+    }
+
+    void Color::YCbCrToRGB(const Vector4* in, Vector4* out, const size_t count)
+    {
+        // Folding the chroma bias into the offset keeps this a single matrix transform
+        __m128 cols[3];
+        Columns(YCbCrInverse, cols);
+        __m128 offset = _mm_mul_ps(_mm_add_ps(cols[1], cols[2]), _mm_set1_ps(-0.5f));
+
+        ParallelFor(count, ColorGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                out[i].elementsSIMD = Transform3x3(in[i].elementsSIMD, cols, offset);
+            }
+        });
+    }
+
+    void Color::RGBToHSV(const Vector4* in, Vector4* out, const size_t count)
+    {
+        ForEachGroup(count, [&](size_t first, size_t valid)
+        {
+            __m128 channels[4];
+            LoadGroup(in, first, valid, channels);
+            __m128 r = channels[0], g = channels[1], b = channels[2];
+
+            __m128 max = _mm_max_ps(_mm_max_ps(r, g), b);
+            __m128 min = _mm_min_ps(_mm_min_ps(r, g), b);
+            __m128 delta = _mm_sub_ps(max, min);
+            __m128 grey = _mm_cmple_ps(delta, _mm_setzero_ps());
+            __m128 invDelta = _mm_div_ps(_mm_set1_ps(1.0f), _mm_blendv_ps(delta, _mm_set1_ps(1.0f), grey));
+
+            // Sector offset by whichever channel is largest, red taking ties
+            __m128 hue = _mm_add_ps(_mm_set1_ps(4.0f), _mm_mul_ps(_mm_sub_ps(r, g), invDelta));
+            hue = _mm_blendv_ps(hue, _mm_add_ps(_mm_set1_ps(2.0f), _mm_mul_ps(_mm_sub_ps(b, r), invDelta)), _mm_cmpeq_ps(max, g));
+            hue = _mm_blendv_ps(hue, _mm_mul_ps(_mm_sub_ps(g, b), invDelta), _mm_cmpeq_ps(max, r));
+            hue = _mm_mul_ps(hue, _mm_set1_ps(1.0f / 6.0f));
+            hue = _mm_add_ps(hue, _mm_and_ps(_mm_cmplt_ps(hue, _mm_setzero_ps()), _mm_set1_ps(1.0f)));
+            hue = _mm_andnot_ps(grey, hue);
+
+            __m128 positive = _mm_cmpgt_ps(max, _mm_setzero_ps());
+            __m128 saturation = _mm_and_ps(_mm_div_ps(delta, _mm_blendv_ps(_mm_set1_ps(1.0f), max, positive)), positive);
+
+            channels[0] = hue;
+            channels[1] = saturation;
+            channels[2] = max;
+            StoreGroup(channels, out, first, valid);
+        });
+    }
+
+    void Color::HSVToRGB(const Vector4* in, Vector4* out, const size_t count)
+    {
+        ForEachGroup(count, [&](size_t first, size_t valid)
+        {
+            __m128 channels[4];
+            LoadGroup(in, first, valid, channels);
+            __m128 h = channels[0], s = channels[1], v = channels[2];
+
+            // channel(n) = v - v * s * clamp(min(k, 4 - k), 0, 1) with k = (n + 6h) mod 6, n = 5, 3 & 1 for r, g & b
+            __m128 sector = _mm_mul_ps(_mm_sub_ps(h, _mm_floor_ps(h)), _mm_set1_ps(6.0f));
+            __m128 chroma = _mm_mul_ps(v, s);
+            const float offsets[3] = { 5.0f, 3.0f, 1.0f };
+
+            for (int c = 0; c < 3; c++)
+            {
+                __m128 k = _mm_add_ps(sector, _mm_set1_ps(offsets[c]));
+                k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, _mm_set1_ps(6.0f)), _mm_set1_ps(6.0f)));
+                __m128 ramp = _mm_min_ps(_mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.0f), k)), _mm_set1_ps(1.0f));
+                channels[c] = _mm_sub_ps(v, _mm_mul_ps(chroma, _mm_max_ps(ramp, _mm_setzero_ps())));
+            }
+
+            StoreGroup(channels, out, first, valid);
+        });
+    }
+
+    void Color::PackUnorm8(const Vector4* in, unsigned int* out, const size_t count)
+    {
+        ForEachGroup(count, [&](size_t first, size_t valid)
+        {
+            __m128i pixels = Pack8(ToUnorm8(in[first].elementsSIMD), ToUnorm8(in[first + ((valid > 1) ? 1 : valid - 1)].elementsSIMD),
+                                   ToUnorm8(in[first + ((valid > 2) ? 2 : valid - 1)].elementsSIMD), ToUnorm8(in[first + valid - 1].elementsSIMD));
+
+            if (valid == 4)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + first), pixels);
+                return;
+            }
+
+            __declspec(align(16)) unsigned int lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), pixels);
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                out[first + i] = lanes[i];
+            }
+        });
+    }
+
+    void Color::UnpackUnorm8(const unsigned int* in, Vector4* out, const size_t count)
+    {
+        __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+        ParallelFor(count, ColorGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                __m128i channels = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(static_cast<int>(in[i])));
+                out[i].elementsSIMD = _mm_mul_ps(_mm_cvtepi32_ps(channels), scale);
+            }
+        });
+    }
+
+    void Color::PackSRGB8(const Vector4* in, unsigned int* out, const size_t count)
+    {
+        ForEachGroup(count, [&](size_t first, size_t valid)
+        {
+            __m128 channels[4];
+            LoadGroup(in, first, valid, channels);
+
+            for (int c = 0; c < 3; c++)
+            {
+                channels[c] = EncodeSRGB(channels[c]);
+            }
+
+            _MM_TRANSPOSE4_PS(channels[0], channels[1], channels[2], channels[3]);
+            __m128i pixels = Pack8(ToUnorm8(channels[0]), ToUnorm8(channels[1]), ToUnorm8(channels[2]), ToUnorm8(channels[3]));
+
+            if (valid == 4)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + first), pixels);
+                return;
+            }
+
+            __declspec(align(16)) unsigned int lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), pixels);
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                out[first + i] = lanes[i];
+            }
+        });
+    }
+
+    void Color::UnpackSRGB8(const unsigned int* in, Vector4* out, const size_t count)
+    {
+        // 256 exact decodes are cheaper to build once than any polynomial is to run per channel
+        struct DecodeTable
+        {
+            float values[256];
+
+            DecodeTable()
+            {
+                for (int i = 0; i < 256; i++)
+                {
+                    float c = static_cast<float>(i) / 255.0f;
+                    values[i] = (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+                }
+            }
+        };
+
+        static const DecodeTable table;
+
+        ParallelFor(count, ColorGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                unsigned int pixel = in[i];
+                out[i].elementsSIMD = _mm_setr_ps(table.values[pixel & 0xFF], table.values[(pixel >> 8) & 0xFF], table.values[(pixel >> 16) & 0xFF],
+                                                  static_cast<float>(pixel >> 24) * (1.0f / 255.0f));
+            }
+        });
+    }
+
+    void Color::PackHalf(const Vector4* in, unsigned short* out, const size_t count)
+    {
+        ParallelFor((count + 1) / 2, ColorGrain / 2, [&](size_t begin, size_t end)
+        {
+            for (size_t pair = begin; pair < end; pair++)
+            {
+                size_t first = pair * 2;
+                __m128i low = FloatToHalf(in[first].elementsSIMD);
+
+                if (first + 1 < count)
+                {
+                    __m128i halves = _mm_packus_epi32(low, FloatToHalf(in[first + 1].elementsSIMD));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + first * 4), halves);
+                }
+                else
+                {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + first * 4), _mm_packus_epi32(low, low));
+                }
+            }
+        });
+    }
+
+    void Color::UnpackHalf(const unsigned short* in, Vector4* out, const size_t count)
+    {
+        ParallelFor(count, ColorGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                __m128i halves = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i * 4)));
+                out[i].elementsSIMD = HalfToFloat(halves);
+            }
+        });
+    }
+}
\ No newline at end of file
@@ -5,9 +5,15 @@
 /* ********************************** */
 
 #include <NullX.h>
+#include <thread>
 
 namespace NullX
 {
+    // From the Testing streaming sweep: cached stores win by 2-3x through L3 and still lead at 256 MB, the largest output it measures,
+    // so StoreMode::Auto only streams outputs past that.  Prefetching less than a kilobyte ahead of the stream leaves it at half bandwidth
+    size_t StreamingThreshold = 512 * 1024 * 1024;
+    size_t PrefetchDistance   = 64;
+
     float PowRecursive(float num, int pow, float base)
     {
         return (pow > 0) ?
@@ -69,4 +75,149 @@ namespace NullX
     {
         return deg * 0.0174532925f;
     }
+
+    ClipFlag operator | (const ClipFlag flags1, const ClipFlag flags2)
+    {
+        return static_cast<ClipFlag>(static_cast<unsigned char>(flags1) | static_cast<unsigned char>(flags2));
+    }
+
+    ClipFlag operator & (const ClipFlag flags1, const ClipFlag flags2)
+    {
+        return static_cast<ClipFlag>(static_cast<unsigned char>(flags1) & static_cast<unsigned char>(flags2));
+    }
+
+    ClipFlag operator ~ (const ClipFlag flags)
+    {
+        // Only the 6 plane bits flip, so ~ClipFlag::None is every plane rather than a byte of ones
+        return static_cast<ClipFlag>(static_cast<unsigned char>(flags) ^ 0x3F);
+    }
+
+    ClipFlag& operator |= (ClipFlag& flags1, const ClipFlag flags2)
+    {
+        flags1 = flags1 | flags2;
+        return flags1;
+    }
+
+    ClipFlag& operator &= (ClipFlag& flags1, const ClipFlag flags2)
+    {
+        flags1 = flags1 & flags2;
+        return flags1;
+    }
+
+    void ParallelFor(const size_t count, const size_t grain, const std::function<void(size_t begin, size_t end)>& func)
+    {
+        if (count <= grain)
+        {
+            func(0, count);
+            return;
+        }
+
+        // Querying the thread count is a system call on some platforms, so only do it once
+        static const size_t threads = std::thread::hardware_concurrency();
+        size_t chunks = (count + grain - 1) / ((grain > 0) ? grain : 1);
+        chunks = (chunks < threads) ? chunks : threads;
+
+        if (chunks <= 1)
+        {
+            func(0, count);
+            return;
+        }
+
+        // The calling thread takes the first range instead of idling on join
+        size_t chunkSize = (count + chunks - 1) / chunks;
+        std::vector<std::thread> workers = std::vector<std::thread>();
+
+        for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+        {
+            workers.push_back(std::thread(func, begin, (begin + chunkSize < count) ? begin + chunkSize : count));
+        }
+
+        func(0, chunkSize);
+
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            workers[i].join();
+        }
+    }
+
+    // XCR0 bits the OS sets once it saves the registers across context switches, SSE & AVX for YMM plus the 3 AVX-512 states for ZMM
+    static const unsigned long long YMMState = 0x06;
+    static const unsigned long long ZMMState = 0xE6;
+
+    // Leaf 1 ECX bit 27 says xgetbv may be read, without it the OS keeps none of the wider state
+    static unsigned long long SavedState()
+    {
+        int info[4];
+        __cpuidex(info, 1, 0);
+        return (info[2] & (1 << 27)) ? _xgetbv(0) : 0;
+    }
+
+    bool HasAVX2()
+    {
+        // Leaf 1 ECX bits 12 & 28 for FMA & AVX, leaf 7 EBX bit 5 for AVX2, checked once
+        static const bool supported = []()
+        {
+            int info[4];
+            __cpuidex(info, 0, 0);
+
+            if (info[0] < 7 || (SavedState() & YMMState) != YMMState)
+            {
+                return false;
+            }
+
+            __cpuidex(info, 1, 0);
+            bool fma = (info[2] & (1 << 12)) != 0 && (info[2] & (1 << 28)) != 0;
+            __cpuidex(info, 7, 0);
+            return fma && (info[1] & (1 << 5)) != 0;
+        }();
+
+        return supported;
+    }
+
+    bool HasAVX512()
+    {
+        // Leaf 7 EBX bit 16, checked once
+        static const bool supported = []()
+        {
+            int info[4];
+            __cpuidex(info, 0, 0);
+
+            if (info[0] < 7 || (SavedState() & ZMMState) != ZMMState)
+            {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return HasAVX2() && (info[1] & (1 << 16)) != 0;
+        }();
+
+        return supported;
+    }
+
+    void SinCos(const __m128 angles, __m128& sines, __m128& cosines)
+    {
+        // Cody-Waite reduction to [-pi/4, pi/4] by the nearest multiple of pi/2, then the Cephes minimax polynomials
+        __m128 quadrant = _mm_round_ps(_mm_mul_ps(angles, _mm_set1_ps(0.636619772f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m128 r = _mm_sub_ps(angles, _mm_mul_ps(quadrant, _mm_set1_ps(1.5703125f)));
+        r = _mm_sub_ps(r, _mm_mul_ps(quadrant, _mm_set1_ps(4.837512969970703125e-4f)));
+        r = _mm_sub_ps(r, _mm_mul_ps(quadrant, _mm_set1_ps(7.54978995489188216e-8f)));
+        __m128 rSqr = _mm_mul_ps(r, r);
+
+        __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), rSqr), _mm_set1_ps(8.3321608736e-3f));
+        sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, rSqr), _mm_set1_ps(-1.6666654611e-1f));
+        sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, rSqr), r), r);
+
+        __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), rSqr), _mm_set1_ps(-1.388731625493765e-3f));
+        cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, rSqr), _mm_set1_ps(4.166664568298827e-2f));
+        cosPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cosPoly, rSqr), rSqr), _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(rSqr, _mm_set1_ps(0.5f))));
+
+        // Odd quadrants swap sine & cosine, quadrants 2 & 3 negate sine, quadrants 1 & 2 negate cosine
+        __m128i n = _mm_cvtps_epi32(quadrant);
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(n, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(n, _mm_set1_epi32(2)), 30));
+        __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(n, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+        sines = _mm_xor_ps(_mm_blendv_ps(sinPoly, cosPoly, swap), sinSign);
+        cosines = _mm_xor_ps(_mm_blendv_ps(cosPoly, sinPoly, swap), cosSign);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,408 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <float.h>
+
+namespace NullX
+{
+    // Jacobi converges quadratically, 5 sweeps reach float precision on any 3x3
+    static const int JacobiSweeps = 5;
+
+    // Four 3x3 matrices side by side, m[i][j] holds element (i, j) of each lane
+    struct Lanes3x3
+    {
+        __m128 m[3][3];
+    };
+
+    static void LoadLanes(const Matrix4* mats, Lanes3x3& a)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            __m128 r0 = mats[0].rowsSIMD[i];
+            __m128 r1 = mats[1].rowsSIMD[i];
+            __m128 r2 = mats[2].rowsSIMD[i];
+            __m128 r3 = mats[3].rowsSIMD[i];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            a.m[i][0] = r0;
+            a.m[i][1] = r1;
+            a.m[i][2] = r2;
+        }
+    }
+
+    static void SetIdentity(Lanes3x3& a)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                a.m[i][j] = _mm_set1_ps((i == j) ? 1.0f : 0.0f);
+            }
+        }
+    }
+
+    static void StoreVectors(const __m128 x, const __m128 y, const __m128 z, Vector3* out)
+    {
+        __m128 r0 = x, r1 = y, r2 = z, r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        out[0].elementsSIMD = r0;
+        out[1].elementsSIMD = r1;
+        out[2].elementsSIMD = r2;
+        out[3].elementsSIMD = r3;
+    }
+
+    // Converts the rotations in r to quaternions, renormalizing away any drift left in the matrices
+    static void StoreRotations(const Lanes3x3& r, Quaternion* out)
+    {
+        __m128 w, x, y, z;
+        Quaternion::FromMatrix(r.m, w, x, y, z);
+        __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)), _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z)));
+        __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSqr));
+        w = _mm_mul_ps(w, invLength);
+        x = _mm_mul_ps(x, invLength);
+        y = _mm_mul_ps(y, invLength);
+        z = _mm_mul_ps(z, invLength);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        out[0].elementsSIMD = w;
+        out[1].elementsSIMD = x;
+        out[2].elementsSIMD = y;
+        out[3].elementsSIMD = z;
+    }
+
+    // One Jacobi rotation zeroing s(p, q), r is the remaining index.  Numerical Recipes 11.1
+    static void JacobiRotate(Lanes3x3& s, Lanes3x3& v, const int p, const int q, const int r)
+    {
+        __m128 zero = _mm_setzero_ps();
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 spp = s.m[p][p], sqq = s.m[q][q], spq = s.m[p][q];
+
+        // t = sign(diff) * 2spq / (|diff| + sqrt(diff^2 + 4spq^2)) avoids dividing by a vanishing spq
+        __m128 diff = _mm_sub_ps(sqq, spp);
+        __m128 twoSpq = _mm_add_ps(spq, spq);
+        __m128 numerator = _mm_xor_ps(twoSpq, _mm_and_ps(diff, signMask));
+        __m128 denominator = _mm_add_ps(_mm_andnot_ps(signMask, diff), _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(diff, diff), _mm_mul_ps(twoSpq, twoSpq))));
+        __m128 t = _mm_and_ps(_mm_div_ps(numerator, denominator), _mm_cmpneq_ps(denominator, zero));
+        __m128 c = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(one, _mm_mul_ps(t, t))));
+        __m128 sn = _mm_mul_ps(t, c);
+
+        s.m[p][p] = _mm_sub_ps(spp, _mm_mul_ps(t, spq));
+        s.m[q][q] = _mm_add_ps(sqq, _mm_mul_ps(t, spq));
+        s.m[p][q] = s.m[q][p] = zero;
+
+        __m128 srp = s.m[r][p], srq = s.m[r][q];
+        s.m[r][p] = s.m[p][r] = _mm_sub_ps(_mm_mul_ps(c, srp), _mm_mul_ps(sn, srq));
+        s.m[r][q] = s.m[q][r] = _mm_add_ps(_mm_mul_ps(sn, srp), _mm_mul_ps(c, srq));
+
+        for (int i = 0; i < 3; i++)
+        {
+            __m128 vp = v.m[i][p], vq = v.m[i][q];
+            v.m[i][p] = _mm_sub_ps(_mm_mul_ps(c, vp), _mm_mul_ps(sn, vq));
+            v.m[i][q] = _mm_add_ps(_mm_mul_ps(sn, vp), _mm_mul_ps(c, vq));
+        }
+    }
+
+    // Swaps columns p & q of each matrix in lanes where swap is set, negating one to keep the determinant
+    static void SwapColumns(Lanes3x3& a, const int p, const int q, const __m128 swap)
+    {
+        __m128 signMask = _mm_set1_ps(-0.0f);
+
+        for (int i = 0; i < 3; i++)
+        {
+            __m128 ap = a.m[i][p], aq = a.m[i][q];
+            a.m[i][p] = _mm_blendv_ps(ap, aq, swap);
+            a.m[i][q] = _mm_blendv_ps(aq, _mm_xor_ps(ap, signMask), swap);
+        }
+    }
+
+    static void SortDescending(__m128 keys[3], Lanes3x3& a, Lanes3x3& b, const bool sortB)
+    {
+        const int pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+
+        for (int i = 0; i < 3; i++)
+        {
+            int p = pairs[i][0], q = pairs[i][1];
+            __m128 swap = _mm_cmpgt_ps(keys[q], keys[p]);
+            __m128 keyP = keys[p];
+            keys[p] = _mm_blendv_ps(keyP, keys[q], swap);
+            keys[q] = _mm_blendv_ps(keys[q], keyP, swap);
+            SwapColumns(a, p, q, swap);
+
+            if (sortB)
+            {
+                SwapColumns(b, p, q, swap);
+            }
+        }
+    }
+
+    // Diagonalizes s in place, v accumulates the rotations so s = v * diag * v^T
+    static void EigenLanes(Lanes3x3& s, Lanes3x3& v)
+    {
+        SetIdentity(v);
+
+        for (int sweep = 0; sweep < JacobiSweeps; sweep++)
+        {
+            JacobiRotate(s, v, 0, 1, 2);
+            JacobiRotate(s, v, 0, 2, 1);
+            JacobiRotate(s, v, 1, 2, 0);
+        }
+    }
+
+    // Givens rotation on rows p & q of b zeroing b(q, p), mirrored onto q
+    static void GivensRows(Lanes3x3& b, Lanes3x3& q, const int p, const int r)
+    {
+        __m128 a1 = b.m[p][p], a2 = b.m[r][p];
+        __m128 rho = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a1, a1), _mm_mul_ps(a2, a2)));
+        __m128 valid = _mm_cmpgt_ps(rho, _mm_set1_ps(FLT_MIN));
+        __m128 invRho = _mm_div_ps(_mm_set1_ps(1.0f), rho);
+        __m128 c = _mm_blendv_ps(_mm_set1_ps(1.0f), _mm_mul_ps(a1, invRho), valid);
+        __m128 s = _mm_and_ps(_mm_mul_ps(a2, invRho), valid);
+
+        for (int j = 0; j < 3; j++)
+        {
+            __m128 bp = b.m[p][j], br = b.m[r][j];
+            b.m[p][j] = _mm_add_ps(_mm_mul_ps(c, bp), _mm_mul_ps(s, br));
+            b.m[r][j] = _mm_sub_ps(_mm_mul_ps(c, br), _mm_mul_ps(s, bp));
+            __m128 qp = q.m[p][j], qr = q.m[r][j];
+            q.m[p][j] = _mm_add_ps(_mm_mul_ps(c, qp), _mm_mul_ps(s, qr));
+            q.m[r][j] = _mm_sub_ps(_mm_mul_ps(c, qr), _mm_mul_ps(s, qp));
+        }
+    }
+
+    // McAdams et al. 2011: Jacobi on A^T A for V, sort, then QR of A * V by Givens rotations for U & sigma
+    static void SVDLanes(const Lanes3x3& a, Lanes3x3& u, __m128 sigma[3], Lanes3x3& v)
+    {
+        Lanes3x3 s;
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = i; j < 3; j++)
+            {
+                s.m[i][j] = s.m[j][i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.m[0][i], a.m[0][j]), _mm_mul_ps(a.m[1][i], a.m[1][j])), _mm_mul_ps(a.m[2][i], a.m[2][j]));
+            }
+        }
+
+        EigenLanes(s, v);
+
+        Lanes3x3 b;
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                b.m[i][j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.m[i][0], v.m[0][j]), _mm_mul_ps(a.m[i][1], v.m[1][j])), _mm_mul_ps(a.m[i][2], v.m[2][j]));
+            }
+        }
+
+        __m128 norms[3];
+
+        for (int j = 0; j < 3; j++)
+        {
+            norms[j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.m[0][j], b.m[0][j]), _mm_mul_ps(b.m[1][j], b.m[1][j])), _mm_mul_ps(b.m[2][j], b.m[2][j]));
+        }
+
+        SortDescending(norms, b, v, true);
+
+        Lanes3x3 q;
+        SetIdentity(q);
+        GivensRows(b, q, 0, 1);
+        GivensRows(b, q, 0, 2);
+        GivensRows(b, q, 1, 2);
+
+        // q * A * V = R, so U is q transposed
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                u.m[i][j] = q.m[j][i];
+            }
+
+            sigma[i] = b.m[i][i];
+        }
+    }
+
+    // Runs kernel on groups of 4 matrices across threads, padding the tail group with identities
+    template <typename Kernel>
+    static void ForEachGroup(const Matrix4* mats, const size_t count, const Kernel& kernel)
+    {
+        ParallelFor((count + 3) / 4, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                Matrix4 padded[4] = { Matrix4::Identity, Matrix4::Identity, Matrix4::Identity, Matrix4::Identity };
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    padded[i] = mats[first + i];
+                }
+
+                Lanes3x3 a;
+                LoadLanes(padded, a);
+                kernel(a, first, valid);
+            }
+        });
+    }
+
+    void Matrix4::Eigen(const Matrix4& mat, Vector3& values, Quaternion& vectors)
+    {
+        Eigen(&mat, &values, &vectors, 1);
+    }
+
+    void Matrix4::Eigen(const Matrix4* mats, Vector3* values, Quaternion* vectors, const size_t count)
+    {
+        ForEachGroup(mats, count, [&](Lanes3x3& s, size_t first, size_t valid)
+        {
+            Lanes3x3 v;
+            EigenLanes(s, v);
+
+            __m128 keys[3] = { s.m[0][0], s.m[1][1], s.m[2][2] };
+            SortDescending(keys, v, v, false);
+
+            Vector3 laneValues[4];
+            Quaternion laneVectors[4];
+            StoreVectors(keys[0], keys[1], keys[2], laneValues);
+            StoreRotations(v, laneVectors);
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                values[first + i] = laneValues[i];
+                vectors[first + i] = laneVectors[i];
+            }
+        });
+    }
+
+    void Matrix4::SVD(const Matrix4& mat, Quaternion& u, Vector3& sigma, Quaternion& v)
+    {
+        SVD(&mat, &u, &sigma, &v, 1);
+    }
+
+    void Matrix4::SVD(const Matrix4* mats, Quaternion* u, Vector3* sigma, Quaternion* v, const size_t count)
+    {
+        ForEachGroup(mats, count, [&](Lanes3x3& a, size_t first, size_t valid)
+        {
+            Lanes3x3 uLanes, vLanes;
+            __m128 sigmaLanes[3];
+            SVDLanes(a, uLanes, sigmaLanes, vLanes);
+
+            Quaternion laneU[4], laneV[4];
+            Vector3 laneSigma[4];
+            StoreRotations(uLanes, laneU);
+            StoreRotations(vLanes, laneV);
+            StoreVectors(sigmaLanes[0], sigmaLanes[1], sigmaLanes[2], laneSigma);
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                u[first + i] = laneU[i];
+                sigma[first + i] = laneSigma[i];
+                v[first + i] = laneV[i];
+            }
+        });
+    }
+
+    void Matrix4::Polar(const Matrix4& mat, Quaternion& rotation, Matrix4& stretch)
+    {
+        Polar(&mat, &rotation, &stretch, 1);
+    }
+
+    void Matrix4::Polar(const Matrix4* mats, Quaternion* rotations, Matrix4* stretches, const size_t count)
+    {
+        ForEachGroup(mats, count, [&](Lanes3x3& a, size_t first, size_t valid)
+        {
+            Lanes3x3 u, v, r, p;
+            __m128 sigma[3];
+            SVDLanes(a, u, sigma, v);
+
+            // rotation = U * V^T, stretch = V * diag(sigma) * V^T
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                {
+                    r.m[i][j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u.m[i][0], v.m[j][0]), _mm_mul_ps(u.m[i][1], v.m[j][1])), _mm_mul_ps(u.m[i][2], v.m[j][2]));
+                    p.m[i][j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(v.m[i][0], sigma[0]), v.m[j][0]),
+                                                      _mm_mul_ps(_mm_mul_ps(v.m[i][1], sigma[1]), v.m[j][1])),
+                                           _mm_mul_ps(_mm_mul_ps(v.m[i][2], sigma[2]), v.m[j][2]));
+                }
+            }
+
+            Quaternion laneRotations[4];
+            StoreRotations(r, laneRotations);
+
+            __m128 rows[4][4];
+
+            for (int i = 0; i < 3; i++)
+            {
+                __m128 r0 = p.m[i][0], r1 = p.m[i][1], r2 = p.m[i][2], r3 = _mm_setzero_ps();
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                rows[0][i] = r0;
+                rows[1][i] = r1;
+                rows[2][i] = r2;
+                rows[3][i] = r3;
+            }
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                rotations[first + i] = laneRotations[i];
+                stretches[first + i].rowsSIMD[0] = rows[i][0];
+                stretches[first + i].rowsSIMD[1] = rows[i][1];
+                stretches[first + i].rowsSIMD[2] = rows[i][2];
+                stretches[first + i].rowsSIMD[3] = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+            }
+        });
+    }
+    void Matrix4::Decompose(const Matrix4& mat, Vector3& translation, Quaternion& rotation, Vector3& scale)
+    {
+        Decompose(&mat, &translation, &rotation, &scale, 1);
+    }
+
+    void Matrix4::Decompose(const Matrix4* mats, Vector3* translations, Quaternion* rotations, Vector3* scales, const size_t count)
+    {
+        ForEachGroup(mats, count, [&](Lanes3x3& a, size_t first, size_t valid)
+        {
+            // Scale is the length of each column, with a mirrored basis flipping the sign of x
+            __m128 scale[3];
+
+            for (int j = 0; j < 3; j++)
+            {
+                scale[j] = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.m[0][j], a.m[0][j]), _mm_mul_ps(a.m[1][j], a.m[1][j])), _mm_mul_ps(a.m[2][j], a.m[2][j])));
+            }
+
+            __m128 crossX = _mm_sub_ps(_mm_mul_ps(a.m[1][1], a.m[2][2]), _mm_mul_ps(a.m[2][1], a.m[1][2]));
+            __m128 crossY = _mm_sub_ps(_mm_mul_ps(a.m[2][1], a.m[0][2]), _mm_mul_ps(a.m[0][1], a.m[2][2]));
+            __m128 crossZ = _mm_sub_ps(_mm_mul_ps(a.m[0][1], a.m[1][2]), _mm_mul_ps(a.m[1][1], a.m[0][2]));
+            __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.m[0][0], crossX), _mm_mul_ps(a.m[1][0], crossY)), _mm_mul_ps(a.m[2][0], crossZ));
+            scale[0] = _mm_xor_ps(scale[0], _mm_and_ps(det, _mm_set1_ps(-0.0f)));
+
+            // A zero scale leaves a zero column, which still converts to a finite quaternion
+            Lanes3x3 r;
+
+            for (int j = 0; j < 3; j++)
+            {
+                __m128 nonZero = _mm_cmpneq_ps(scale[j], _mm_setzero_ps());
+                __m128 invScale = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), scale[j]), nonZero);
+
+                for (int i = 0; i < 3; i++)
+                {
+                    r.m[i][j] = _mm_mul_ps(a.m[i][j], invScale);
+                }
+            }
+
+            Quaternion laneRotations[4];
+            Vector3 laneScales[4];
+            StoreRotations(r, laneRotations);
+            StoreVectors(scale[0], scale[1], scale[2], laneScales);
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                const Matrix4& mat = mats[first + i];
+                translations[first + i] = Vector3(mat.xw, mat.yw, mat.zw);
+                rotations[first + i] = laneRotations[i];
+                scales[first + i] = laneScales[i];
+            }
+        });
+    }
+}
\ No newline at end of file
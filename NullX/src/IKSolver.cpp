@@ -0,0 +1,290 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    static const size_t IKGrain = 64;
+
+    // One joint of 4 chains, length is the bone from this joint to the next
+    struct __declspec(align(16)) JointLanes
+    {
+        __m128 x, y, z, length;
+    };
+
+    // Gathers one joint from 4 chains stride Vector3s apart, the tail group repeats its last chain
+    static void LoadJoint(const Vector3* chains, const size_t stride, const size_t joint, const size_t first, const size_t valid, JointLanes& out)
+    {
+        __m128 x = chains[first * stride + joint].elementsSIMD;
+        __m128 y = chains[(first + ((valid > 1) ? 1 : valid - 1)) * stride + joint].elementsSIMD;
+        __m128 z = chains[(first + ((valid > 2) ? 2 : valid - 1)) * stride + joint].elementsSIMD;
+        __m128 w = chains[(first + valid - 1) * stride + joint].elementsSIMD;
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        out.x = x;
+        out.y = y;
+        out.z = z;
+    }
+
+    static void StoreJoint(Vector3* chains, const size_t stride, const size_t joint, const size_t first, const size_t valid, const JointLanes& in)
+    {
+        __m128 x = in.x, y = in.y, z = in.z, w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        __m128 lanes[4] = { x, y, z, w };
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            chains[(first + i) * stride + joint].elementsSIMD = lanes[i];
+        }
+    }
+
+    static __m128 Dot(const __m128 ax, const __m128 ay, const __m128 az, const __m128 bx, const __m128 by, const __m128 bz)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+    }
+
+    // rsqrt refined by one Newton-Raphson step, zero length vectors give a large finite scale rather than inf
+    static __m128 InvLength(const __m128 lengthSqr)
+    {
+        __m128 safe = _mm_max_ps(lengthSqr, _mm_set1_ps(1e-24f));
+        __m128 estimate = _mm_rsqrt_ps(safe);
+        return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), estimate), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(safe, estimate), estimate)));
+    }
+
+    static __m128 Length(const __m128 x, const __m128 y, const __m128 z)
+    {
+        return _mm_sqrt_ps(Dot(x, y, z, x, y, z));
+    }
+
+    // Places to at distance length from from along the direction from -> to
+    static void Reach(const JointLanes& from, JointLanes& to, const __m128 length)
+    {
+        __m128 dx = _mm_sub_ps(to.x, from.x);
+        __m128 dy = _mm_sub_ps(to.y, from.y);
+        __m128 dz = _mm_sub_ps(to.z, from.z);
+        __m128 scale = _mm_mul_ps(length, InvLength(Dot(dx, dy, dz, dx, dy, dz)));
+        to.x = _mm_add_ps(from.x, _mm_mul_ps(dx, scale));
+        to.y = _mm_add_ps(from.y, _mm_mul_ps(dy, scale));
+        to.z = _mm_add_ps(from.z, _mm_mul_ps(dz, scale));
+    }
+
+    static bool Converged(const JointLanes& end, const JointLanes& target, const __m128 toleranceSqr)
+    {
+        __m128 dx = _mm_sub_ps(end.x, target.x);
+        __m128 dy = _mm_sub_ps(end.y, target.y);
+        __m128 dz = _mm_sub_ps(end.z, target.z);
+        return _mm_movemask_ps(_mm_cmple_ps(Dot(dx, dy, dz, dx, dy, dz), toleranceSqr)) == 0xF;
+    }
+
+    // Shared driver for the iterative solvers, gathers each group of 4 chains into SoA scratch & measures its bones
+    template <typename Solve>
+    static void SolveChains(Vector3* chains, const size_t jointCount, const Vector3* targets, const size_t count, const Solve& solve)
+    {
+        if (jointCount < 2)
+        {
+            return;
+        }
+
+        ParallelFor((count + 3) / 4, IKGrain, [&](size_t begin, size_t end)
+        {
+            std::vector<JointLanes> joints = std::vector<JointLanes>(jointCount);
+            JointLanes target;
+
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+
+                for (size_t j = 0; j < jointCount; j++)
+                {
+                    LoadJoint(chains, jointCount, j, first, valid, joints[j]);
+                }
+
+                for (size_t j = 0; j + 1 < jointCount; j++)
+                {
+                    joints[j].length = Length(_mm_sub_ps(joints[j + 1].x, joints[j].x), _mm_sub_ps(joints[j + 1].y, joints[j].y), _mm_sub_ps(joints[j + 1].z, joints[j].z));
+                }
+
+                LoadJoint(targets, 1, 0, first, valid, target);
+                solve(joints.data(), target);
+
+                for (size_t j = 1; j < jointCount; j++)
+                {
+                    StoreJoint(chains, jointCount, j, first, valid, joints[j]);
+                }
+            }
+        });
+    }
+
+    void IKSolver::TwoBone(Vector3* chains, const Vector3* targets, const Vector3* poles, const size_t count)
+    {
+        ParallelFor((count + 3) / 4, IKGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                JointLanes root, middle, tip, target, pole;
+                LoadJoint(chains, 3, 0, first, valid, root);
+                LoadJoint(chains, 3, 1, first, valid, middle);
+                LoadJoint(chains, 3, 2, first, valid, tip);
+                LoadJoint(targets, 1, 0, first, valid, target);
+
+                if (poles != nullptr)
+                {
+                    LoadJoint(poles, 1, 0, first, valid, pole);
+                }
+                else
+                {
+                    pole = middle;
+                }
+
+                __m128 upper = Length(_mm_sub_ps(middle.x, root.x), _mm_sub_ps(middle.y, root.y), _mm_sub_ps(middle.z, root.z));
+                __m128 lower = Length(_mm_sub_ps(tip.x, middle.x), _mm_sub_ps(tip.y, middle.y), _mm_sub_ps(tip.z, middle.z));
+
+                __m128 toX = _mm_sub_ps(target.x, root.x);
+                __m128 toY = _mm_sub_ps(target.y, root.y);
+                __m128 toZ = _mm_sub_ps(target.z, root.z);
+                __m128 distSqr = Dot(toX, toY, toZ, toX, toY, toZ);
+                __m128 invDist = InvLength(distSqr);
+                __m128 dirX = _mm_mul_ps(toX, invDist);
+                __m128 dirY = _mm_mul_ps(toY, invDist);
+                __m128 dirZ = _mm_mul_ps(toZ, invDist);
+
+                // Targets out of reach are clamped onto the sphere the chain can touch
+                __m128 reachMin = _mm_max_ps(_mm_sub_ps(upper, lower), _mm_sub_ps(lower, upper));
+                __m128 dist = _mm_min_ps(_mm_max_ps(_mm_mul_ps(distSqr, invDist), reachMin), _mm_add_ps(upper, lower));
+
+                // Law of cosines for the angle at the root
+                __m128 cosine = _mm_div_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(upper, upper), _mm_mul_ps(dist, dist)), _mm_mul_ps(lower, lower)),
+                                           _mm_max_ps(_mm_mul_ps(_mm_set1_ps(2.0f), _mm_mul_ps(upper, dist)), _mm_set1_ps(1e-12f)));
+                cosine = _mm_min_ps(_mm_max_ps(cosine, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+                __m128 sine = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(cosine, cosine)));
+
+                // Bend plane from the pole with the target axis removed, falling back to any perpendicular when the pole is on the axis
+                __m128 px = _mm_sub_ps(pole.x, root.x);
+                __m128 py = _mm_sub_ps(pole.y, root.y);
+                __m128 pz = _mm_sub_ps(pole.z, root.z);
+                __m128 along = Dot(px, py, pz, dirX, dirY, dirZ);
+                __m128 bendX = _mm_sub_ps(px, _mm_mul_ps(dirX, along));
+                __m128 bendY = _mm_sub_ps(py, _mm_mul_ps(dirY, along));
+                __m128 bendZ = _mm_sub_ps(pz, _mm_mul_ps(dirZ, along));
+                __m128 bendSqr = Dot(bendX, bendY, bendZ, bendX, bendY, bendZ);
+                __m128 degenerate = _mm_cmple_ps(bendSqr, _mm_mul_ps(_mm_set1_ps(1e-10f), _mm_max_ps(Dot(px, py, pz, px, py, pz), _mm_set1_ps(1e-12f))));
+
+                // dir x (0, 1, 0), or dir x (1, 0, 0) when dir is vertical
+                __m128 vertical = _mm_cmpgt_ps(_mm_mul_ps(dirY, dirY), _mm_set1_ps(0.99f));
+                __m128 fallbackX = _mm_blendv_ps(_mm_sub_ps(_mm_setzero_ps(), dirZ), _mm_setzero_ps(), vertical);
+                __m128 fallbackY = _mm_blendv_ps(_mm_setzero_ps(), dirZ, vertical);
+                __m128 fallbackZ = _mm_blendv_ps(dirX, _mm_sub_ps(_mm_setzero_ps(), dirY), vertical);
+                bendX = _mm_blendv_ps(bendX, fallbackX, degenerate);
+                bendY = _mm_blendv_ps(bendY, fallbackY, degenerate);
+                bendZ = _mm_blendv_ps(bendZ, fallbackZ, degenerate);
+                __m128 invBend = InvLength(Dot(bendX, bendY, bendZ, bendX, bendY, bendZ));
+
+                __m128 alongDir = _mm_mul_ps(upper, cosine);
+                __m128 alongBend = _mm_mul_ps(_mm_mul_ps(upper, sine), invBend);
+                middle.x = _mm_add_ps(root.x, _mm_add_ps(_mm_mul_ps(dirX, alongDir), _mm_mul_ps(bendX, alongBend)));
+                middle.y = _mm_add_ps(root.y, _mm_add_ps(_mm_mul_ps(dirY, alongDir), _mm_mul_ps(bendY, alongBend)));
+                middle.z = _mm_add_ps(root.z, _mm_add_ps(_mm_mul_ps(dirZ, alongDir), _mm_mul_ps(bendZ, alongBend)));
+                tip.x = _mm_add_ps(root.x, _mm_mul_ps(dirX, dist));
+                tip.y = _mm_add_ps(root.y, _mm_mul_ps(dirY, dist));
+                tip.z = _mm_add_ps(root.z, _mm_mul_ps(dirZ, dist));
+
+                StoreJoint(chains, 3, 1, first, valid, middle);
+                StoreJoint(chains, 3, 2, first, valid, tip);
+            }
+        });
+    }
+
+    void IKSolver::FABRIK(Vector3* chains, const size_t jointCount, const Vector3* targets, const size_t count, const size_t iterations, const float tolerance)
+    {
+        __m128 toleranceSqr = _mm_set1_ps(tolerance * tolerance);
+
+        SolveChains(chains, jointCount, targets, count, [&](JointLanes* joints, const JointLanes& target)
+        {
+            JointLanes root = joints[0];
+            size_t last = jointCount - 1;
+
+            // Out of reach targets need no special case, the passes settle on a straight chain pointing at them
+            for (size_t pass = 0; pass < iterations && !Converged(joints[last], target, toleranceSqr); pass++)
+            {
+                joints[last].x = target.x;
+                joints[last].y = target.y;
+                joints[last].z = target.z;
+
+                for (size_t j = last; j-- > 0;)
+                {
+                    Reach(joints[j + 1], joints[j], joints[j].length);
+                }
+
+                joints[0].x = root.x;
+                joints[0].y = root.y;
+                joints[0].z = root.z;
+
+                for (size_t j = 1; j <= last; j++)
+                {
+                    Reach(joints[j - 1], joints[j], joints[j - 1].length);
+                }
+            }
+        });
+    }
+
+    void IKSolver::CCD(Vector3* chains, const size_t jointCount, const Vector3* targets, const size_t count, const size_t iterations, const float tolerance)
+    {
+        __m128 toleranceSqr = _mm_set1_ps(tolerance * tolerance);
+
+        SolveChains(chains, jointCount, targets, count, [&](JointLanes* joints, const JointLanes& target)
+        {
+            size_t last = jointCount - 1;
+
+            for (size_t pass = 0; pass < iterations && !Converged(joints[last], target, toleranceSqr); pass++)
+            {
+                for (size_t j = last; j-- > 0;)
+                {
+                    const JointLanes& pivot = joints[j];
+                    __m128 ex = _mm_sub_ps(joints[last].x, pivot.x);
+                    __m128 ey = _mm_sub_ps(joints[last].y, pivot.y);
+                    __m128 ez = _mm_sub_ps(joints[last].z, pivot.z);
+                    __m128 tx = _mm_sub_ps(target.x, pivot.x);
+                    __m128 ty = _mm_sub_ps(target.y, pivot.y);
+                    __m128 tz = _mm_sub_ps(target.z, pivot.z);
+
+                    // Shortest arc Quaternion from end to target, (|e||t| + e.t, e x t) normalized. Opposite vectors fall back to identity
+                    __m128 qw = _mm_add_ps(_mm_sqrt_ps(_mm_mul_ps(Dot(ex, ey, ez, ex, ey, ez), Dot(tx, ty, tz, tx, ty, tz))), Dot(ex, ey, ez, tx, ty, tz));
+                    __m128 qx = _mm_sub_ps(_mm_mul_ps(ey, tz), _mm_mul_ps(ez, ty));
+                    __m128 qy = _mm_sub_ps(_mm_mul_ps(ez, tx), _mm_mul_ps(ex, tz));
+                    __m128 qz = _mm_sub_ps(_mm_mul_ps(ex, ty), _mm_mul_ps(ey, tx));
+                    __m128 normSqr = _mm_add_ps(_mm_mul_ps(qw, qw), Dot(qx, qy, qz, qx, qy, qz));
+                    __m128 identity = _mm_cmple_ps(normSqr, _mm_set1_ps(1e-20f));
+                    __m128 invNorm = InvLength(normSqr);
+                    qw = _mm_blendv_ps(_mm_mul_ps(qw, invNorm), _mm_set1_ps(1.0f), identity);
+                    qx = _mm_andnot_ps(identity, _mm_mul_ps(qx, invNorm));
+                    qy = _mm_andnot_ps(identity, _mm_mul_ps(qy, invNorm));
+                    qz = _mm_andnot_ps(identity, _mm_mul_ps(qz, invNorm));
+
+                    // v' = v + 2w(q x v) + 2q x (q x v) for every joint below the pivot
+                    for (size_t k = j + 1; k <= last; k++)
+                    {
+                        __m128 vx = _mm_sub_ps(joints[k].x, pivot.x);
+                        __m128 vy = _mm_sub_ps(joints[k].y, pivot.y);
+                        __m128 vz = _mm_sub_ps(joints[k].z, pivot.z);
+                        __m128 cx = _mm_sub_ps(_mm_mul_ps(qy, vz), _mm_mul_ps(qz, vy));
+                        __m128 cy = _mm_sub_ps(_mm_mul_ps(qz, vx), _mm_mul_ps(qx, vz));
+                        __m128 cz = _mm_sub_ps(_mm_mul_ps(qx, vy), _mm_mul_ps(qy, vx));
+                        __m128 ccx = _mm_sub_ps(_mm_mul_ps(qy, cz), _mm_mul_ps(qz, cy));
+                        __m128 ccy = _mm_sub_ps(_mm_mul_ps(qz, cx), _mm_mul_ps(qx, cz));
+                        __m128 ccz = _mm_sub_ps(_mm_mul_ps(qx, cy), _mm_mul_ps(qy, cx));
+                        __m128 two = _mm_set1_ps(2.0f);
+                        joints[k].x = _mm_add_ps(joints[k].x, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qw, cx), ccx)));
+                        joints[k].y = _mm_add_ps(joints[k].y, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qw, cy), ccy)));
+                        joints[k].z = _mm_add_ps(joints[k].z, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qw, cz), ccz)));
+                    }
+                }
+            }
+        });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,326 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+#include <float.h>
+#include <thread>
+
+namespace NullX
+{
+    static const int    KDStackSize         = 128;
+    static const size_t KDParallelSplitSize = 1 << 14;
+
+    // Masks off the lanes of a 4-wide leaf read that run past the end of the leaf
+    static int LaneMask(const size_t remaining)
+    {
+        return (remaining >= 4) ? 0xF : (1 << remaining) - 1;
+    }
+
+    KDTree::KDTree() : count(0), parallelDepth(0)
+    {
+    }
+
+    void KDTree::Build(const Vector3* points, const size_t _count)
+    {
+        count = _count;
+        ids.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ids[i] = static_cast<unsigned int>(i);
+        }
+
+        // Ranges halve every level, so the deepest leaf sits at the first depth whose ranges fit in a leaf
+        size_t depth = 0;
+
+        while (((count + (static_cast<size_t>(1) << depth) - 1) >> depth) > LeafSize)
+        {
+            depth++;
+        }
+
+        splitValues.assign(static_cast<size_t>(2) << depth, 0.0f);
+        splitAxes.assign(static_cast<size_t>(2) << depth, 0);
+
+        size_t threads = std::thread::hardware_concurrency();
+        parallelDepth = 0;
+
+        while ((static_cast<size_t>(1) << parallelDepth) < threads)
+        {
+            parallelDepth++;
+        }
+
+        Subdivide(points, 1, 0, count, 0);
+
+        // Gather into tree order so each leaf is a contiguous run of SoA floats.  A leaf can start at any index,
+        // so 3 padding points far from every query keep its last 4 wide load inside the arrays
+        size_t padded = count + 3;
+        pointsX.assign(padded, FLT_MAX);
+        pointsY.assign(padded, FLT_MAX);
+        pointsZ.assign(padded, FLT_MAX);
+
+        ParallelFor(count, 1 << 16, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const Vector3& point = points[ids[i]];
+                pointsX[i] = point.x;
+                pointsY[i] = point.y;
+                pointsZ[i] = point.z;
+            }
+        });
+    }
+
+    void KDTree::Subdivide(const Vector3* points, const size_t node, const size_t begin, const size_t end, const size_t depth)
+    {
+        if (end - begin <= LeafSize)
+        {
+            return;
+        }
+
+        __m128 min = _mm_set1_ps(FLT_MAX);
+        __m128 max = _mm_set1_ps(-FLT_MAX);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            min = _mm_min_ps(min, points[ids[i]].elementsSIMD);
+            max = _mm_max_ps(max, points[ids[i]].elementsSIMD);
+        }
+
+        Vector3 extent = Vector3(_mm_sub_ps(max, min));
+        int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z) ? 1 : 2;
+        size_t middle = begin + (end - begin) / 2;
+
+        std::nth_element(ids.begin() + begin, ids.begin() + middle, ids.begin() + end, [&](unsigned int a, unsigned int b)
+        {
+            return points[a].elements[axis] < points[b].elements[axis];
+        });
+
+        splitValues[node] = points[ids[middle]].elements[axis];
+        splitAxes[node] = static_cast<unsigned char>(axis);
+
+        if (depth < parallelDepth && end - begin > KDParallelSplitSize)
+        {
+            std::thread worker([&]()
+            {
+                Subdivide(points, node * 2, begin, middle, depth + 1);
+            });
+
+            Subdivide(points, node * 2 + 1, middle, end, depth + 1);
+            worker.join();
+        }
+        else
+        {
+            Subdivide(points, node * 2, begin, middle, depth + 1);
+            Subdivide(points, node * 2 + 1, middle, end, depth + 1);
+        }
+    }
+
+    size_t KDTree::Nearest(const Vector3& point, const size_t k, unsigned int* indices, float* distancesSqr) const
+    {
+        if (count == 0 || k == 0)
+        {
+            return 0;
+        }
+
+        // indices & distancesSqr double as a sorted list of the best k found so far
+        size_t found = 0;
+        float worst = FLT_MAX;
+        __m128 px = _mm_set1_ps(point.x);
+        __m128 py = _mm_set1_ps(point.y);
+        __m128 pz = _mm_set1_ps(point.z);
+
+        size_t stackNodes[KDStackSize];
+        size_t stackBegins[KDStackSize];
+        size_t stackEnds[KDStackSize];
+        float stackDistances[KDStackSize];
+        int top = 0;
+
+        stackNodes[top] = 1;
+        stackBegins[top] = 0;
+        stackEnds[top] = count;
+        stackDistances[top++] = 0.0f;
+
+        while (top > 0)
+        {
+            top--;
+
+            if (stackDistances[top] > worst)
+            {
+                continue;
+            }
+
+            size_t node = stackNodes[top];
+            size_t begin = stackBegins[top];
+            size_t end = stackEnds[top];
+
+            // Descend to the leaf on the query's side, deferring the far sides
+            while (end - begin > LeafSize)
+            {
+                size_t middle = begin + (end - begin) / 2;
+                float offset = point.elements[splitAxes[node]] - splitValues[node];
+                bool left = offset < 0.0f;
+
+                stackNodes[top] = left ? node * 2 + 1 : node * 2;
+                stackBegins[top] = left ? middle : begin;
+                stackEnds[top] = left ? end : middle;
+                stackDistances[top++] = offset * offset;
+
+                node = left ? node * 2 : node * 2 + 1;
+                end = left ? middle : end;
+                begin = left ? begin : middle;
+            }
+
+            for (size_t i = begin; i < end; i += 4)
+            {
+                __m128 dx = _mm_sub_ps(_mm_loadu_ps(&pointsX[i]), px);
+                __m128 dy = _mm_sub_ps(_mm_loadu_ps(&pointsY[i]), py);
+                __m128 dz = _mm_sub_ps(_mm_loadu_ps(&pointsZ[i]), pz);
+                __m128 distSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                int mask = _mm_movemask_ps(_mm_cmplt_ps(distSqr, _mm_set1_ps(worst))) & LaneMask(end - i);
+
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                __declspec(align(16)) float lanes[4];
+                _mm_store_ps(lanes, distSqr);
+
+                for (int lane = 0; lane < 4; lane++)
+                {
+                    if (!(mask & (1 << lane)) || lanes[lane] >= worst)
+                    {
+                        continue;
+                    }
+
+                    // Insertion into the sorted result list, dropping the current worst once full
+                    size_t j = (found < k) ? found++ : k - 1;
+
+                    while (j > 0 && distancesSqr[j - 1] > lanes[lane])
+                    {
+                        distancesSqr[j] = distancesSqr[j - 1];
+                        indices[j] = indices[j - 1];
+                        j--;
+                    }
+
+                    distancesSqr[j] = lanes[lane];
+                    indices[j] = ids[i + lane];
+                    worst = (found == k) ? distancesSqr[k - 1] : FLT_MAX;
+                }
+            }
+        }
+
+        return found;
+    }
+
+    void KDTree::Nearest(const Vector3* points, const size_t _count, const size_t k, unsigned int* indices, float* distancesSqr) const
+    {
+        ParallelFor(_count, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                size_t found = Nearest(points[i], k, indices + i * k, distancesSqr + i * k);
+
+                for (size_t j = found; j < k; j++)
+                {
+                    indices[i * k + j] = 0xFFFFFFFF;
+                    distancesSqr[i * k + j] = FLT_MAX;
+                }
+            }
+        });
+    }
+
+    void KDTree::Radius(const Vector3& point, const float radius, std::vector<unsigned int>& results) const
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        float radiusSqr = radius * radius;
+        __m128 radiusSqrVec = _mm_set1_ps(radiusSqr);
+        __m128 px = _mm_set1_ps(point.x);
+        __m128 py = _mm_set1_ps(point.y);
+        __m128 pz = _mm_set1_ps(point.z);
+
+        size_t stackNodes[KDStackSize];
+        size_t stackBegins[KDStackSize];
+        size_t stackEnds[KDStackSize];
+        int top = 0;
+
+        stackNodes[top] = 1;
+        stackBegins[top] = 0;
+        stackEnds[top++] = count;
+
+        while (top > 0)
+        {
+            top--;
+            size_t node = stackNodes[top];
+            size_t begin = stackBegins[top];
+            size_t end = stackEnds[top];
+
+            if (end - begin > LeafSize)
+            {
+                size_t middle = begin + (end - begin) / 2;
+                float offset = point.elements[splitAxes[node]] - splitValues[node];
+
+                // Points equal to the split value can land on either side of the median
+                if (offset <= radius)
+                {
+                    stackNodes[top] = node * 2;
+                    stackBegins[top] = begin;
+                    stackEnds[top++] = middle;
+                }
+
+                if (offset >= -radius)
+                {
+                    stackNodes[top] = node * 2 + 1;
+                    stackBegins[top] = middle;
+                    stackEnds[top++] = end;
+                }
+
+                continue;
+            }
+
+            for (size_t i = begin; i < end; i += 4)
+            {
+                __m128 dx = _mm_sub_ps(_mm_loadu_ps(&pointsX[i]), px);
+                __m128 dy = _mm_sub_ps(_mm_loadu_ps(&pointsY[i]), py);
+                __m128 dz = _mm_sub_ps(_mm_loadu_ps(&pointsZ[i]), pz);
+                __m128 distSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                int mask = _mm_movemask_ps(_mm_cmple_ps(distSqr, radiusSqrVec)) & LaneMask(end - i);
+
+                for (int lane = 0; mask != 0; lane++, mask >>= 1)
+                {
+                    if (mask & 1)
+                    {
+                        results.push_back(ids[i + lane]);
+                    }
+                }
+            }
+        }
+    }
+
+    void KDTree::Radius(const Vector3* points, const size_t _count, const float radius, std::vector<std::vector<unsigned int>>& results) const
+    {
+        results.resize(_count);
+
+        ParallelFor(_count, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                results[i].clear();
+                Radius(points[i], radius, results[i]);
+            }
+        });
+    }
+
+    size_t KDTree::Size() const
+    {
+        return count;
+    }
+}
\ No newline at end of file
@@ -9,6 +9,77 @@
 
 namespace NullX
 {
+    static bool ShouldStream(const StoreMode mode, const size_t bytes)
+    {
+        return (mode == StoreMode::Streaming) || (mode == StoreMode::Auto && bytes > StreamingThreshold);
+    }
+
+    // The store kind is a template argument so the batch loops below are written once & never branch per element
+    template <bool Stream>
+    static void Store(float* out, const __m128 value)
+    {
+        if (Stream)
+        {
+            _mm_stream_ps(out, value);
+        }
+        else
+        {
+            _mm_store_ps(out, value);
+        }
+    }
+
+    template <bool Stream>
+    static void TransformVectors(const __m128 cols[4], const Vector4* vecs, Vector4* out, const size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            // Four Vector4s fill a cache line, so only prefetch once per line
+            if (Stream && (i & 3) == 0)
+            {
+                _mm_prefetch(reinterpret_cast<const char*>(vecs + i + PrefetchDistance), _MM_HINT_NTA);
+            }
+
+            __m128 vec = vecs[i].elementsSIMD;
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cols[0], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(0, 0, 0, 0))),
+                                                  _mm_mul_ps(cols[1], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1)))),
+                                       _mm_add_ps(_mm_mul_ps(cols[2], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 2, 2, 2))),
+                                                  _mm_mul_ps(cols[3], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(3, 3, 3, 3)))));
+            Store<Stream>(out[i].elements, result);
+        }
+
+        // Non-temporal stores are weakly ordered, fence so the results are visible to other threads
+        if (Stream)
+        {
+            _mm_sfence();
+        }
+    }
+
+    template <bool Stream>
+    static void MultiplyMatrices(const __m128 lhs[4][4], const Matrix4* mats, Matrix4* out, const size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            // A Matrix4 is a full cache line
+            if (Stream)
+            {
+                _mm_prefetch(reinterpret_cast<const char*>(mats + i + PrefetchDistance), _MM_HINT_NTA);
+            }
+
+            const __m128* rhs = mats[i].rowsSIMD;
+
+            for (int j = 0; j < 4; j++)
+            {
+                Store<Stream>(out[i].matrix[j], _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs[j][0], rhs[0]), _mm_mul_ps(lhs[j][1], rhs[1])),
+                                                           _mm_add_ps(_mm_mul_ps(lhs[j][2], rhs[2]), _mm_mul_ps(lhs[j][3], rhs[3]))));
+            }
+        }
+
+        if (Stream)
+        {
+            _mm_sfence();
+        }
+    }
+
     Matrix4 Matrix4::Identity = Matrix4(1.0f, 0.0f, 0.0f, 0.0f, 
                                         0.0f, 1.0f, 0.0f, 0.0f, 
                                         0.0f, 0.0f, 1.0f, 0.0f, 
@@ -94,6 +165,120 @@ namespace NullX
                (decomp[1].xx * decomp[1].yy * decomp[1].zz * decomp[1].ww));
     }
 
+    void Matrix4::Transform(const Matrix4& mat, const Vector4* vecs, Vector4* out, const size_t count, const StoreMode mode)
+    {
+        // Columns let each result be built from broadcasts instead of four horizontal dot products
+        __m128 cols[4] = { mat.rowsSIMD[0], mat.rowsSIMD[1], mat.rowsSIMD[2], mat.rowsSIMD[3] };
+        _MM_TRANSPOSE4_PS(cols[0], cols[1], cols[2], cols[3]);
+
+        if (ShouldStream(mode, count * sizeof(Vector4)))
+        {
+            TransformVectors<true>(cols, vecs, out, count);
+        }
+        else
+        {
+            TransformVectors<false>(cols, vecs, out, count);
+        }
+    }
+
+    void Matrix4::Multiply(const Matrix4& mat, const Matrix4* mats, Matrix4* out, const size_t count, const StoreMode mode)
+    {
+        __m128 lhs[4][4];
+
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                lhs[i][j] = _mm_set1_ps(mat.matrix[i][j]);
+            }
+        }
+
+        if (ShouldStream(mode, count * sizeof(Matrix4)))
+        {
+            MultiplyMatrices<true>(lhs, mats, out, count);
+        }
+        else
+        {
+            MultiplyMatrices<false>(lhs, mats, out, count);
+        }
+    }
+
+    void Matrix4::ProjectPoints(const Matrix4& viewProjection, const Vector3* points, const size_t count, const Vector4& viewport,
+                                float* screenX, float* screenY, float* depth, ClipFlag* clipFlags)
+    {
+        const Matrix4& m = viewProjection;
+        __m128 halfWidth = _mm_set1_ps(viewport.z * 0.5f);
+        __m128 halfHeight = _mm_set1_ps(viewport.w * 0.5f);
+        __m128 centerX = _mm_set1_ps(viewport.x + viewport.z * 0.5f);
+        __m128 centerY = _mm_set1_ps(viewport.y + viewport.w * 0.5f);
+
+        ParallelFor((count + 3) / 4, 4096, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                // The tail group repeats its last point rather than reading past the end
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                __m128 px = points[first].elementsSIMD;
+                __m128 py = points[first + ((valid > 1) ? 1 : valid - 1)].elementsSIMD;
+                __m128 pz = points[first + ((valid > 2) ? 2 : valid - 1)].elementsSIMD;
+                __m128 pw = points[first + valid - 1].elementsSIMD;
+                _MM_TRANSPOSE4_PS(px, py, pz, pw);
+
+                __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.xx), px), _mm_mul_ps(_mm_set1_ps(m.xy), py)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.xz), pz), _mm_set1_ps(m.xw)));
+                __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.yx), px), _mm_mul_ps(_mm_set1_ps(m.yy), py)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.yz), pz), _mm_set1_ps(m.yw)));
+                __m128 cz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.zx), px), _mm_mul_ps(_mm_set1_ps(m.zy), py)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.zz), pz), _mm_set1_ps(m.zw)));
+                __m128 cw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.wx), px), _mm_mul_ps(_mm_set1_ps(m.wy), py)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.wz), pz), _mm_set1_ps(m.ww)));
+
+                // Reciprocal estimate refined by one Newton-Raphson step is accurate to about 23 bits, well under a pixel
+                __m128 invW = _mm_rcp_ps(cw);
+                invW = _mm_mul_ps(invW, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(cw, invW)));
+
+                __declspec(align(16)) float laneX[4], laneY[4], laneZ[4];
+                _mm_store_ps(laneX, _mm_add_ps(centerX, _mm_mul_ps(_mm_mul_ps(cx, invW), halfWidth)));
+                _mm_store_ps(laneY, _mm_sub_ps(centerY, _mm_mul_ps(_mm_mul_ps(cy, invW), halfHeight)));
+                _mm_store_ps(laneZ, _mm_mul_ps(cz, invW));
+
+                if (valid == 4)
+                {
+                    _mm_storeu_ps(screenX + first, _mm_load_ps(laneX));
+                    _mm_storeu_ps(screenY + first, _mm_load_ps(laneY));
+                    _mm_storeu_ps(depth + first, _mm_load_ps(laneZ));
+                }
+                else
+                {
+                    for (size_t i = 0; i < valid; i++)
+                    {
+                        screenX[first + i] = laneX[i];
+                        screenY[first + i] = laneY[i];
+                        depth[first + i] = laneZ[i];
+                    }
+                }
+
+                if (clipFlags == nullptr)
+                {
+                    continue;
+                }
+
+                // One bit per plane, packed from 32 bit lanes down to a byte per point
+                __m128 negW = _mm_sub_ps(_mm_setzero_ps(), cw);
+                __m128i flags = _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(cx, negW)), _mm_set1_epi32(static_cast<int>(ClipFlag::Left)));
+                flags = _mm_or_si128(flags, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(cx, cw)), _mm_set1_epi32(static_cast<int>(ClipFlag::Right))));
+                flags = _mm_or_si128(flags, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(cy, negW)), _mm_set1_epi32(static_cast<int>(ClipFlag::Bottom))));
+                flags = _mm_or_si128(flags, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(cy, cw)), _mm_set1_epi32(static_cast<int>(ClipFlag::Top))));
+                flags = _mm_or_si128(flags, _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(cz, negW)), _mm_set1_epi32(static_cast<int>(ClipFlag::Near))));
+                flags = _mm_or_si128(flags, _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(cz, cw)), _mm_set1_epi32(static_cast<int>(ClipFlag::Far))));
+                flags = _mm_packus_epi16(_mm_packs_epi32(flags, flags), flags);
+                unsigned int packed = static_cast<unsigned int>(_mm_cvtsi128_si32(flags));
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    clipFlags[first + i] = static_cast<ClipFlag>(static_cast<unsigned char>(packed >> (i * 8)));
+                }
+            }
+        });
+    }
+
     Matrix4 Matrix4::Perspective(const float fov, const float width, const float height, const float zNear, const float zFar)
     {
         // Credit to HatchitMath for formulas
@@ -158,16 +343,14 @@ namespace NullX
 
     Matrix4 Matrix4::Rotate(const Quaternion& quat)
     {
+        // Squares come from the normalized copy so a non unit quat still gives a proper rotation
         Quaternion qNorm = Quaternion::Normalized(quat);
-        float mag = Quaternion::Magnitude(qNorm);
-        float* elementsSqr = _mm_mul_ps(quat.elementsSIMD, quat.elementsSIMD).m128_f32;
-        float wSqr = elementsSqr[0];
-        float xSqr = elementsSqr[1];
-        float ySqr = elementsSqr[2];
-        float zSqr = elementsSqr[3];
+        float xSqr = qNorm.x * qNorm.x;
+        float ySqr = qNorm.y * qNorm.y;
+        float zSqr = qNorm.z * qNorm.z;
 
         return Matrix4(1 - 2 * (ySqr + zSqr), 2 * (qNorm.x * qNorm.y - qNorm.z * qNorm.w), 2 * (qNorm.w * qNorm.y + qNorm.x * qNorm.z), 0,
-                       2 * (qNorm.x * qNorm.z + qNorm.w * qNorm.z), 1 - 2 * (xSqr + zSqr), 2 * (qNorm.y * qNorm.z - qNorm.x * qNorm.w), 0,
+                       2 * (qNorm.x * qNorm.y + qNorm.w * qNorm.z), 1 - 2 * (xSqr + zSqr), 2 * (qNorm.y * qNorm.z - qNorm.x * qNorm.w), 0,
                        2 * (qNorm.x * qNorm.z - qNorm.y * qNorm.w), 2 * (qNorm.w * qNorm.x + qNorm.y * qNorm.z), 1 - 2 * (xSqr + ySqr), 0,
                        0.0f, 0.0f, 0.0f, 1.0f);
     }
@@ -399,8 +582,6 @@ namespace NullX
                                    _mm_dp_ps(rowsSIMD[i], cols[3], 0xF1).m128_f32[0]);
         }
 
-        toReturn[3][3] = 1.0f;
-
         return toReturn;
     }
 
@@ -0,0 +1,704 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+
+namespace NullX
+{
+    // Depth of a packed panel, sized so an A sliver & a B sliver stay in L1 across it
+    static const size_t GemmDepth    = 256;
+    // Columns of B packed per pass, sized so the packed panel stays in L3
+    static const size_t GemmCols     = 2048;
+    // Below this many multiply-adds a single thread finishes before the others would start
+    static const size_t GemmParallel = 1 << 21;
+    static const size_t LUBlockSize  = 64;
+
+    // Per-type & per-width SIMD operations so one GEMM kernel covers float & double on SSE, AVX2 & AVX-512.
+    // The register tile is Rows x 2 registers of C, Rows is as many as the accumulators, 2 B loads & an A broadcast leave room for
+    template <typename T, int Bits = 128>
+    struct GemmLanes;
+
+    template <>
+    struct GemmLanes<float, 128>
+    {
+        typedef __m128 Reg;
+        static const size_t Width = 4;
+        // 12 accumulators in 16 XMM registers
+        static const size_t Rows  = 6;
+        // Rows of A packed per block, a multiple of Rows sized so the block stays in L2
+        static const size_t Block = 96;
+
+        static Reg Zero()                                      { return _mm_setzero_ps(); }
+        static Reg Set(const float num)                        { return _mm_set1_ps(num); }
+        static Reg Load(const float* src)                      { return _mm_loadu_ps(src); }
+        static void Store(float* dst, const Reg r)             { _mm_storeu_ps(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm_add_ps(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm_mul_ps(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    };
+
+    template <>
+    struct GemmLanes<double, 128>
+    {
+        typedef __m128d Reg;
+        static const size_t Width = 2;
+        static const size_t Rows  = 6;
+        static const size_t Block = 48;
+
+        static Reg Zero()                                      { return _mm_setzero_pd(); }
+        static Reg Set(const double num)                       { return _mm_set1_pd(num); }
+        static Reg Load(const double* src)                     { return _mm_loadu_pd(src); }
+        static void Store(double* dst, const Reg r)            { _mm_storeu_pd(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm_add_pd(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm_mul_pd(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    };
+
+    template <>
+    struct GemmLanes<float, 256>
+    {
+        typedef __m256 Reg;
+        static const size_t Width = 8;
+        // 12 accumulators in 16 YMM registers
+        static const size_t Rows  = 6;
+        static const size_t Block = 96;
+
+        static Reg Zero()                                      { return _mm256_setzero_ps(); }
+        static Reg Set(const float num)                        { return _mm256_set1_ps(num); }
+        static Reg Load(const float* src)                      { return _mm256_loadu_ps(src); }
+        static void Store(float* dst, const Reg r)             { _mm256_storeu_ps(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm256_add_ps(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm256_mul_ps(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_ps(a, b, c); }
+    };
+
+    template <>
+    struct GemmLanes<double, 256>
+    {
+        typedef __m256d Reg;
+        static const size_t Width = 4;
+        static const size_t Rows  = 6;
+        static const size_t Block = 48;
+
+        static Reg Zero()                                      { return _mm256_setzero_pd(); }
+        static Reg Set(const double num)                       { return _mm256_set1_pd(num); }
+        static Reg Load(const double* src)                     { return _mm256_loadu_pd(src); }
+        static void Store(double* dst, const Reg r)            { _mm256_storeu_pd(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm256_add_pd(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm256_mul_pd(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_pd(a, b, c); }
+    };
+
+    template <>
+    struct GemmLanes<float, 512>
+    {
+        typedef __m512 Reg;
+        static const size_t Width = 16;
+        // 28 accumulators in 32 ZMM registers
+        static const size_t Rows  = 14;
+        static const size_t Block = 112;
+
+        static Reg Zero()                                      { return _mm512_setzero_ps(); }
+        static Reg Set(const float num)                        { return _mm512_set1_ps(num); }
+        static Reg Load(const float* src)                      { return _mm512_loadu_ps(src); }
+        static void Store(float* dst, const Reg r)             { _mm512_storeu_ps(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm512_add_ps(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm512_mul_ps(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm512_fmadd_ps(a, b, c); }
+    };
+
+    template <>
+    struct GemmLanes<double, 512>
+    {
+        typedef __m512d Reg;
+        static const size_t Width = 8;
+        static const size_t Rows  = 14;
+        static const size_t Block = 56;
+
+        static Reg Zero()                                      { return _mm512_setzero_pd(); }
+        static Reg Set(const double num)                       { return _mm512_set1_pd(num); }
+        static Reg Load(const double* src)                     { return _mm512_loadu_pd(src); }
+        static void Store(double* dst, const Reg r)            { _mm512_storeu_pd(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm512_add_pd(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm512_mul_pd(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm512_fmadd_pd(a, b, c); }
+    };
+
+    // Packs rows x depth of a into slivers of L::Rows rows, column by column, zero padding the last sliver
+    template <typename L, typename T>
+    static void PackA(const T* a, const size_t lda, const size_t rows, const size_t depth, T* packed)
+    {
+        for (size_t i = 0; i < rows; i += L::Rows)
+        {
+            size_t sliverRows = (rows - i < L::Rows) ? rows - i : L::Rows;
+
+            for (size_t p = 0; p < depth; p++)
+            {
+                for (size_t r = 0; r < L::Rows; r++)
+                {
+                    *packed++ = (r < sliverRows) ? a[(i + r) * lda + p] : T(0);
+                }
+            }
+        }
+    }
+
+    // Packs depth x cols of b into slivers of 2 registers of columns, row by row, zero padding the last sliver
+    template <typename L, typename T>
+    static void PackB(const T* b, const size_t ldb, const size_t depth, const size_t cols, const size_t firstSliver, const size_t lastSliver, T* packed)
+    {
+        const size_t sliverCols = L::Width * 2;
+
+        for (size_t s = firstSliver; s < lastSliver; s++)
+        {
+            size_t j = s * sliverCols;
+            size_t valid = (cols - j < sliverCols) ? cols - j : sliverCols;
+            T* dst = packed + s * sliverCols * depth;
+
+            for (size_t p = 0; p < depth; p++)
+            {
+                const T* src = b + p * ldb + j;
+
+                for (size_t c = 0; c < sliverCols; c++)
+                {
+                    *dst++ = (c < valid) ? src[c] : T(0);
+                }
+            }
+        }
+    }
+
+    // c += alpha * a * b for one L::Rows x 2 register tile, only rows x cols of which lies inside c
+    template <typename L, typename T>
+    static void MicroKernel(const size_t depth, const T* a, const T* b, const T alpha, T* c, const size_t ldc, const size_t rows, const size_t cols)
+    {
+        const size_t width = L::Width;
+        typename L::Reg acc[L::Rows][2];
+
+        for (size_t r = 0; r < L::Rows; r++)
+        {
+            acc[r][0] = L::Zero();
+            acc[r][1] = L::Zero();
+        }
+
+        for (size_t p = 0; p < depth; p++)
+        {
+            typename L::Reg b0 = L::Load(b);
+            typename L::Reg b1 = L::Load(b + width);
+
+            for (size_t r = 0; r < L::Rows; r++)
+            {
+                typename L::Reg ar = L::Set(a[r]);
+                acc[r][0] = L::MulAdd(ar, b0, acc[r][0]);
+                acc[r][1] = L::MulAdd(ar, b1, acc[r][1]);
+            }
+
+            a += L::Rows;
+            b += width * 2;
+        }
+
+        typename L::Reg alphaReg = L::Set(alpha);
+
+        if (rows == L::Rows && cols == width * 2)
+        {
+            for (size_t r = 0; r < L::Rows; r++)
+            {
+                T* dst = c + r * ldc;
+                L::Store(dst, L::MulAdd(acc[r][0], alphaReg, L::Load(dst)));
+                L::Store(dst + width, L::MulAdd(acc[r][1], alphaReg, L::Load(dst + width)));
+            }
+
+            return;
+        }
+
+        // Edge tiles go through a scratch tile so nothing outside c is touched
+        T tile[L::Rows][L::Width * 2];
+
+        for (size_t r = 0; r < L::Rows; r++)
+        {
+            L::Store(tile[r], L::Mul(acc[r][0], alphaReg));
+            L::Store(tile[r] + width, L::Mul(acc[r][1], alphaReg));
+        }
+
+        for (size_t r = 0; r < rows; r++)
+        {
+            for (size_t j = 0; j < cols; j++)
+            {
+                c[r * ldc + j] += tile[r][j];
+            }
+        }
+    }
+
+    // c += alpha * a * b in Goto's loop order: a column panel of B is packed once & shared, every thread packs its own row blocks of A
+    template <typename L, typename T>
+    static void GemmPanels(const size_t m, const size_t n, const size_t k, const T alpha, const T* a, const size_t lda, const T* b, const size_t ldb, T* c, const size_t ldc)
+    {
+        const size_t sliverCols = L::Width * 2;
+        const size_t blockRows = L::Block;
+        size_t blocks = (m + blockRows - 1) / blockRows;
+        bool parallel = m * n * k >= GemmParallel;
+        std::vector<T> packedB = std::vector<T>(((GemmCols + sliverCols - 1) / sliverCols) * sliverCols * GemmDepth);
+
+        for (size_t jc = 0; jc < n; jc += GemmCols)
+        {
+            size_t nc = (n - jc < GemmCols) ? n - jc : GemmCols;
+            size_t slivers = (nc + sliverCols - 1) / sliverCols;
+
+            for (size_t pc = 0; pc < k; pc += GemmDepth)
+            {
+                size_t kc = (k - pc < GemmDepth) ? k - pc : GemmDepth;
+
+                ParallelFor(slivers, parallel ? 16 : slivers, [&](size_t begin, size_t end)
+                {
+                    PackB<L>(b + pc * ldb + jc, ldb, kc, nc, begin, end, packedB.data());
+                });
+
+                ParallelFor(blocks, parallel ? 1 : blocks, [&](size_t begin, size_t end)
+                {
+                    std::vector<T> packedA = std::vector<T>(((blockRows + L::Rows - 1) / L::Rows) * L::Rows * kc);
+
+                    for (size_t block = begin; block < end; block++)
+                    {
+                        size_t ic = block * blockRows;
+                        size_t mc = (m - ic < blockRows) ? m - ic : blockRows;
+                        PackA<L>(a + ic * lda + pc, lda, mc, kc, packedA.data());
+
+                        for (size_t jr = 0; jr < nc; jr += sliverCols)
+                        {
+                            const T* sliverB = packedB.data() + (jr / sliverCols) * sliverCols * kc;
+                            size_t tileCols = (nc - jr < sliverCols) ? nc - jr : sliverCols;
+
+                            for (size_t ir = 0; ir < mc; ir += L::Rows)
+                            {
+                                size_t tileRows = (mc - ir < L::Rows) ? mc - ir : L::Rows;
+                                MicroKernel<L>(kc, packedA.data() + ir * kc, sliverB, alpha, c + (ic + ir) * ldc + jc + jr, ldc, tileRows, tileCols);
+                            }
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    template <typename T>
+    MatrixN<T>::MatrixN() : rows(0), cols(0)
+    {
+    }
+
+    template <typename T>
+    MatrixN<T>::MatrixN(const size_t _rows, const size_t _cols, const T value) : rows(_rows), cols(_cols), elements(_rows * _cols, value)
+    {
+    }
+
+    template <typename T>
+    MatrixN<T> MatrixN<T>::Identity(const size_t size)
+    {
+        MatrixN toReturn = MatrixN(size, size);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            toReturn[i][i] = T(1);
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    size_t MatrixN<T>::Rows() const
+    {
+        return rows;
+    }
+
+    template <typename T>
+    size_t MatrixN<T>::Cols() const
+    {
+        return cols;
+    }
+
+    template <typename T>
+    T* MatrixN<T>::Data()
+    {
+        return elements.data();
+    }
+
+    template <typename T>
+    const T* MatrixN<T>::Data() const
+    {
+        return elements.data();
+    }
+
+    template <typename T>
+    MatrixN<T> MatrixN<T>::Transpose(const MatrixN& mat)
+    {
+        // Tiles keep both the rows read & the columns written within cache
+        MatrixN toReturn = MatrixN(mat.cols, mat.rows);
+        const size_t tile = 32;
+
+        for (size_t i0 = 0; i0 < mat.rows; i0 += tile)
+        {
+            for (size_t j0 = 0; j0 < mat.cols; j0 += tile)
+            {
+                size_t iEnd = (i0 + tile < mat.rows) ? i0 + tile : mat.rows;
+                size_t jEnd = (j0 + tile < mat.cols) ? j0 + tile : mat.cols;
+
+                for (size_t i = i0; i < iEnd; i++)
+                {
+                    for (size_t j = j0; j < jEnd; j++)
+                    {
+                        toReturn.elements[j * mat.rows + i] = mat.elements[i * mat.cols + j];
+                    }
+                }
+            }
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    void MatrixN<T>::Multiply(const MatrixN& mat1, const MatrixN& mat2, MatrixN& out, const T alpha, const T beta)
+    {
+        if (out.rows != mat1.rows || out.cols != mat2.cols)
+        {
+            out = MatrixN(mat1.rows, mat2.cols);
+        }
+
+        Gemm(mat1.rows, mat2.cols, mat1.cols, alpha, mat1.Data(), mat1.cols, mat2.Data(), mat2.cols, beta, out.Data(), out.cols);
+    }
+
+    template <typename T>
+    void MatrixN<T>::Gemm(const size_t m, const size_t n, const size_t k, const T alpha, const T* a, const size_t lda,
+                          const T* b, const size_t ldb, const T beta, T* c, const size_t ldc)
+    {
+        // Scale c up front so every panel only has to accumulate, zero is written rather than multiplied to drop NaNs
+        if (beta != T(1))
+        {
+            for (size_t i = 0; i < m; i++)
+            {
+                for (size_t j = 0; j < n; j++)
+                {
+                    c[i * ldc + j] = (beta == T(0)) ? T(0) : c[i * ldc + j] * beta;
+                }
+            }
+        }
+
+        if (m == 0 || n == 0 || k == 0 || alpha == T(0))
+        {
+            return;
+        }
+
+        // The widest kernel the CPU runs, clearing the upper halves afterwards so following SSE code pays no transition penalty
+        if (HasAVX512())
+        {
+            GemmPanels<GemmLanes<T, 512>>(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+            _mm256_zeroupper();
+        }
+        else if (HasAVX2())
+        {
+            GemmPanels<GemmLanes<T, 256>>(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+            _mm256_zeroupper();
+        }
+        else
+        {
+            GemmPanels<GemmLanes<T>>(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+        }
+    }
+
+    template <typename T>
+    VectorN<T> MatrixN<T>::Multiply(const MatrixN& mat, const VectorN<T>& vec)
+    {
+        VectorN<T> toReturn = VectorN<T>(mat.rows);
+        typedef GemmLanes<T> L;
+        const size_t width = L::Width;
+
+        ParallelFor(mat.rows, (mat.rows * mat.cols >= GemmParallel / 16) ? 64 : mat.rows, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const T* row = mat[i];
+                typename L::Reg sum0 = L::Zero(), sum1 = L::Zero();
+                size_t j = 0;
+
+                for (; j + width * 2 <= mat.cols; j += width * 2)
+                {
+                    sum0 = L::Add(sum0, L::Mul(L::Load(row + j), L::Load(vec.Data() + j)));
+                    sum1 = L::Add(sum1, L::Mul(L::Load(row + j + width), L::Load(vec.Data() + j + width)));
+                }
+
+                T lanes[L::Width];
+                L::Store(lanes, L::Add(sum0, sum1));
+                T value = T(0);
+
+                for (size_t lane = 0; lane < width; lane++)
+                {
+                    value += lanes[lane];
+                }
+
+                for (; j < mat.cols; j++)
+                {
+                    value += row[j] * vec[j];
+                }
+
+                toReturn[i] = value;
+            }
+        });
+
+        return toReturn;
+    }
+
+    template <typename T>
+    bool MatrixN<T>::LUFactor(MatrixN& mat, std::vector<size_t>& pivots)
+    {
+        size_t n = mat.rows;
+        T* data = mat.Data();
+        bool nonSingular = (mat.rows == mat.cols);
+        pivots.resize(n);
+
+        if (!nonSingular)
+        {
+            return false;
+        }
+
+        // Right looking blocked LU: factor a panel of columns, solve for the matching rows of U, then update the trailing matrix with GEMM
+        for (size_t k0 = 0; k0 < n; k0 += LUBlockSize)
+        {
+            size_t kb = (n - k0 < LUBlockSize) ? n - k0 : LUBlockSize;
+            size_t kEnd = k0 + kb;
+
+            for (size_t j = k0; j < kEnd; j++)
+            {
+                size_t pivot = j;
+                T largest = T(0);
+
+                for (size_t i = j; i < n; i++)
+                {
+                    T value = data[i * n + j];
+                    value = (value < T(0)) ? -value : value;
+
+                    if (value > largest)
+                    {
+                        largest = value;
+                        pivot = i;
+                    }
+                }
+
+                pivots[j] = pivot;
+
+                if (largest == T(0))
+                {
+                    nonSingular = false;
+                    continue;
+                }
+
+                // Swapping whole rows applies the pivot to the finished L columns & the trailing matrix at once
+                if (pivot != j)
+                {
+                    std::swap_ranges(data + j * n, data + j * n + n, data + pivot * n);
+                }
+
+                T invPivot = T(1) / data[j * n + j];
+
+                for (size_t i = j + 1; i < n; i++)
+                {
+                    T* row = data + i * n;
+                    row[j] *= invPivot;
+                    T factor = row[j];
+
+                    for (size_t c = j + 1; c < kEnd; c++)
+                    {
+                        row[c] -= factor * data[j * n + c];
+                    }
+                }
+            }
+
+            if (kEnd == n)
+            {
+                break;
+            }
+
+            // U12 = L11^-1 * A12 by forward substitution on whole rows
+            for (size_t i = k0 + 1; i < kEnd; i++)
+            {
+                T* row = data + i * n;
+
+                for (size_t r = k0; r < i; r++)
+                {
+                    T factor = row[r];
+                    const T* source = data + r * n;
+
+                    for (size_t c = kEnd; c < n; c++)
+                    {
+                        row[c] -= factor * source[c];
+                    }
+                }
+            }
+
+            // A22 -= L21 * U12
+            Gemm(n - kEnd, n - kEnd, kb, T(-1), data + kEnd * n + k0, n, data + k0 * n + kEnd, n, T(1), data + kEnd * n + kEnd, n);
+        }
+
+        return nonSingular;
+    }
+
+    template <typename T>
+    std::vector<MatrixN<T>> MatrixN<T>::LUDecomposition(const MatrixN& mat, std::vector<size_t>& pivots)
+    {
+        MatrixN lu = MatrixN(mat);
+        LUFactor(lu, pivots);
+
+        MatrixN lower = Identity(mat.rows);
+        MatrixN upper = MatrixN(mat.rows, mat.cols);
+
+        for (size_t i = 0; i < mat.rows; i++)
+        {
+            for (size_t j = 0; j < mat.cols; j++)
+            {
+                if (j < i)
+                {
+                    lower[i][j] = lu[i][j];
+                }
+                else
+                {
+                    upper[i][j] = lu[i][j];
+                }
+            }
+        }
+
+        std::vector<MatrixN> toReturn = std::vector<MatrixN>();
+        toReturn.push_back(lower);
+        toReturn.push_back(upper);
+        return toReturn;
+    }
+
+    template <typename T>
+    VectorN<T> MatrixN<T>::Solve(const MatrixN& lu, const std::vector<size_t>& pivots, const VectorN<T>& vec)
+    {
+        size_t n = lu.rows;
+        VectorN<T> toReturn = VectorN<T>(vec);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            std::swap(toReturn[i], toReturn[pivots[i]]);
+        }
+
+        // Forward substitution
+        for (size_t i = 0; i < n; i++)
+        {
+            const T* row = lu[i];
+            T value = toReturn[i];
+
+            for (size_t j = 0; j < i; j++)
+            {
+                value -= row[j] * toReturn[j];
+            }
+
+            toReturn[i] = value;
+        }
+
+        // Backward substitution
+        for (size_t i = n; i-- > 0;)
+        {
+            const T* row = lu[i];
+            T value = toReturn[i];
+
+            for (size_t j = i + 1; j < n; j++)
+            {
+                value -= row[j] * toReturn[j];
+            }
+
+            toReturn[i] = value / row[i];
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    T MatrixN<T>::Determinant(const MatrixN& mat)
+    {
+        MatrixN lu = MatrixN(mat);
+        std::vector<size_t> pivots = std::vector<size_t>();
+
+        if (!LUFactor(lu, pivots))
+        {
+            return T(0);
+        }
+
+        T toReturn = T(1);
+
+        for (size_t i = 0; i < mat.rows; i++)
+        {
+            toReturn *= (pivots[i] != i) ? -lu[i][i] : lu[i][i];
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    T* MatrixN<T>::operator [] (const size_t row)
+    {
+        return elements.data() + row * cols;
+    }
+
+    template <typename T>
+    const T* MatrixN<T>::operator [] (const size_t row) const
+    {
+        return elements.data() + row * cols;
+    }
+
+    template <typename T>
+    MatrixN<T> MatrixN<T>::operator + (const MatrixN& mat) const
+    {
+        MatrixN toReturn = MatrixN(*this);
+
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            toReturn.elements[i] += mat.elements[i];
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    MatrixN<T> MatrixN<T>::operator - (const MatrixN& mat) const
+    {
+        MatrixN toReturn = MatrixN(*this);
+
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            toReturn.elements[i] -= mat.elements[i];
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    MatrixN<T> MatrixN<T>::operator * (const MatrixN& mat) const
+    {
+        MatrixN toReturn = MatrixN(rows, mat.cols);
+        Multiply(*this, mat, toReturn);
+        return toReturn;
+    }
+
+    template <typename T>
+    VectorN<T> MatrixN<T>::operator * (const VectorN<T>& vec) const
+    {
+        return Multiply(*this, vec);
+    }
+
+    template <typename T>
+    MatrixN<T> MatrixN<T>::operator * (const T num) const
+    {
+        MatrixN toReturn = MatrixN(*this);
+
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            toReturn.elements[i] *= num;
+        }
+
+        return toReturn;
+    }
+
+    template class MatrixN<float>;
+    template class MatrixN<double>;
+}
\ No newline at end of file
@@ -0,0 +1,535 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <thread>
+
+namespace NullX
+{
+    static const size_t       MeshGrain     = 1 << 12;
+    static const unsigned int WeldEmpty     = 0xFFFFFFFF;
+    static const float        WeldCellScale = 4.0f;
+
+    // One occupied cell of the weld hash, first & last bound its list of vertices in index order.  The cell itself is read from the first vertex
+    struct WeldCell
+    {
+        unsigned int first;
+        unsigned int last;
+    };
+
+    // The weld hash is split by the top hash bits into one open addressing table per thread, so each table is built without locks
+    struct WeldTables
+    {
+        std::vector<std::vector<WeldCell>> tables;
+        std::vector<unsigned int>          masks;
+        const Vector3i*                    cells;
+        int                                bits;
+
+        size_t Partition(const unsigned int hash) const
+        {
+            return (bits == 0) ? 0 : hash >> (32 - bits);
+        }
+    };
+
+    // Vertices split into ranges of 1 << shift, with every triangle listed under each range owning one of its corners.
+    // starts[range] begins that range's triangles, which are in index buffer order
+    struct OwnedTriangles
+    {
+        std::vector<unsigned int> triangles;
+        std::vector<size_t>       starts;
+        size_t                    ranges;
+        int                       shift;
+    };
+
+    static __m128 Cross(const __m128 a, const __m128 b)
+    {
+        __m128 result = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(b, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    static __m128 Dot(const __m128 a, const __m128 b)
+    {
+        return _mm_dp_ps(a, b, 0x7F);
+    }
+
+    // Zero length vectors stay zero rather than becoming NaN
+    static __m128 NormalizeOrZero(const __m128 vec)
+    {
+        __m128 lengthSqr = Dot(vec, vec);
+        __m128 nonZero = _mm_cmpgt_ps(lengthSqr, _mm_set1_ps(1e-30f));
+        return _mm_and_ps(_mm_div_ps(vec, _mm_sqrt_ps(_mm_max_ps(lengthSqr, _mm_set1_ps(1e-30f)))), nonZero);
+    }
+
+    // Abramowitz & Stegun 4.4.45, within 7e-5 radians which is plenty for a weight
+    static float AcosApprox(const float x)
+    {
+        float magnitude = (x < 0.0f) ? -x : x;
+        magnitude = (magnitude < 1.0f) ? magnitude : 1.0f;
+        float result = sqrtf(1.0f - magnitude) * (1.5707288f + magnitude * (-0.2121144f + magnitude * (0.0742610f - 0.0187293f * magnitude)));
+        return (x < 0.0f) ? Pi - result : result;
+    }
+
+    // Teschner's primes folded together, then mixed so both the top bits & the low bits are usable
+    static unsigned int WeldHash(const __m128i cell)
+    {
+        __m128i hashed = _mm_mullo_epi32(cell, _mm_setr_epi32(73856093, 19349663, 83492791, 0));
+        hashed = _mm_xor_si128(hashed, _mm_shuffle_epi32(hashed, _MM_SHUFFLE(3, 3, 3, 1)));
+        hashed = _mm_xor_si128(hashed, _mm_shuffle_epi32(hashed, _MM_SHUFFLE(3, 3, 3, 2)));
+        unsigned int hash = static_cast<unsigned int>(_mm_cvtsi128_si32(hashed));
+        hash ^= hash >> 16;
+        hash *= 0x7FEB352D;
+        hash ^= hash >> 15;
+        hash *= 0x846CA68B;
+        return hash ^ (hash >> 16);
+    }
+
+    static bool SameCell(const __m128i cell1, const __m128i cell2)
+    {
+        return (_mm_movemask_epi8(_mm_cmpeq_epi32(cell1, cell2)) & 0xFFF) == 0xFFF;
+    }
+
+    // Linear probe for the slot holding cell, or the empty slot where it belongs
+    static WeldCell& FindCell(WeldTables& hash, const __m128i cell, const unsigned int hashValue)
+    {
+        size_t partition = hash.Partition(hashValue);
+        std::vector<WeldCell>& table = hash.tables[partition];
+        unsigned int mask = hash.masks[partition];
+        unsigned int slot = hashValue & mask;
+
+        while (table[slot].first != WeldEmpty && !SameCell(hash.cells[table[slot].first].elementsSIMD, cell))
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        return table[slot];
+    }
+
+    // Calls add(range) once for each distinct range owning one of the 3 corners
+    template <typename Add>
+    static void ForEachOwner(const unsigned int* corners, const int shift, const Add& add)
+    {
+        unsigned int a = corners[0] >> shift, b = corners[1] >> shift, c = corners[2] >> shift;
+        add(a);
+
+        if (b != a)
+        {
+            add(b);
+        }
+
+        if (c != a && c != b)
+        {
+            add(c);
+        }
+    }
+
+    // One vertex range per thread, binned in two passes over the index buffer so no range has to stream all of it.
+    // Each thread bins its own slice of triangles & the slices are laid out in order, so every bin stays in index buffer order
+    static void BinTriangles(const unsigned int* indices, const size_t triangleCount, const size_t vertexCount, OwnedTriangles& owned)
+    {
+        static const size_t threads = std::thread::hardware_concurrency();
+        size_t ranges = (vertexCount + MeshGrain - 1) / MeshGrain;
+        ranges = (ranges < threads) ? ranges : threads;
+        owned.shift = 0;
+
+        while ((static_cast<size_t>(1) << owned.shift) * ranges < vertexCount)
+        {
+            owned.shift++;
+        }
+
+        owned.ranges = (vertexCount + (static_cast<size_t>(1) << owned.shift) - 1) >> owned.shift;
+        owned.starts.assign(owned.ranges + 1, 0);
+
+        // A single range owns every corner & walks the index buffer directly
+        if (owned.ranges <= 1)
+        {
+            owned.triangles.clear();
+            return;
+        }
+
+        size_t slices = owned.ranges;
+        size_t sliceSize = (triangleCount + slices - 1) / slices;
+        std::vector<size_t> cursors = std::vector<size_t>(slices * owned.ranges, 0);
+
+        ParallelFor(slices, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t slice = begin; slice < end; slice++)
+            {
+                size_t* counts = &cursors[slice * owned.ranges];
+                size_t last = ((slice + 1) * sliceSize < triangleCount) ? (slice + 1) * sliceSize : triangleCount;
+
+                for (size_t t = slice * sliceSize; t < last; t++)
+                {
+                    ForEachOwner(indices + t * 3, owned.shift, [&](unsigned int range) { counts[range]++; });
+                }
+            }
+        });
+
+        // Range major, slice minor, so each range's bin is its slices' triangles one after another
+        size_t total = 0;
+
+        for (size_t range = 0; range < owned.ranges; range++)
+        {
+            owned.starts[range] = total;
+
+            for (size_t slice = 0; slice < slices; slice++)
+            {
+                size_t count = cursors[slice * owned.ranges + range];
+                cursors[slice * owned.ranges + range] = total;
+                total += count;
+            }
+        }
+
+        owned.starts[owned.ranges] = total;
+        owned.triangles.resize(total);
+
+        ParallelFor(slices, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t slice = begin; slice < end; slice++)
+            {
+                size_t* cursor = &cursors[slice * owned.ranges];
+                size_t last = ((slice + 1) * sliceSize < triangleCount) ? (slice + 1) * sliceSize : triangleCount;
+
+                for (size_t t = slice * sliceSize; t < last; t++)
+                {
+                    ForEachOwner(indices + t * 3, owned.shift, [&](unsigned int range) { owned.triangles[cursor[range]++] = static_cast<unsigned int>(t); });
+                }
+            }
+        });
+    }
+
+    // Runs func(range, begin, end) over every vertex range across threads, so each thread accumulates into its own vertices without atomics
+    template <typename Func>
+    static void ForEachVertexRange(const OwnedTriangles& owned, const size_t vertexCount, const Func& func)
+    {
+        ParallelFor(owned.ranges, 1, [&](size_t first, size_t last)
+        {
+            for (size_t range = first; range < last; range++)
+            {
+                size_t begin = range << owned.shift;
+                size_t end = ((range + 1) << owned.shift < vertexCount) ? (range + 1) << owned.shift : vertexCount;
+                func(range, begin, end);
+            }
+        });
+    }
+
+    // Calls visit(triangle, mask) for the triangles binned under range, mask holding a bit per corner in [begin, end), in the same order every run
+    template <typename Visit>
+    static void ForEachOwnedTriangle(const OwnedTriangles& owned, const unsigned int* indices, const size_t triangleCount, const size_t range,
+                                     const size_t begin, const size_t end, const Visit& visit)
+    {
+        if (owned.ranges <= 1)
+        {
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                visit(t, 7);
+            }
+
+            return;
+        }
+
+        unsigned int first = static_cast<unsigned int>(begin);
+        unsigned int span = static_cast<unsigned int>(end - begin);
+
+        for (size_t i = owned.starts[range]; i < owned.starts[range + 1]; i++)
+        {
+            // Unsigned wrap folds the range test into one compare per corner
+            size_t t = owned.triangles[i];
+            visit(t, ((indices[t * 3] - first < span) ? 1 : 0) | ((indices[t * 3 + 1] - first < span) ? 2 : 0) | ((indices[t * 3 + 2] - first < span) ? 4 : 0));
+        }
+    }
+
+    void Mesh::FaceNormals(const Vector3* positions, const unsigned int* indices, const size_t triangleCount, Vector3* normals)
+    {
+        ParallelFor(triangleCount, MeshGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t t = begin; t < end; t++)
+            {
+                __m128 p0 = positions[indices[t * 3]].elementsSIMD;
+                __m128 p1 = positions[indices[t * 3 + 1]].elementsSIMD;
+                __m128 p2 = positions[indices[t * 3 + 2]].elementsSIMD;
+                normals[t].elementsSIMD = _mm_blend_ps(Cross(_mm_sub_ps(p1, p0), _mm_sub_ps(p2, p0)), _mm_setzero_ps(), 0x8);
+            }
+        });
+    }
+
+    void Mesh::VertexNormals(const Vector3* positions, const size_t vertexCount, const unsigned int* indices, const size_t triangleCount, Vector3* normals)
+    {
+        OwnedTriangles owned;
+        BinTriangles(indices, triangleCount, vertexCount, owned);
+
+        ForEachVertexRange(owned, vertexCount, [&](size_t range, size_t begin, size_t end)
+        {
+            for (size_t v = begin; v < end; v++)
+            {
+                normals[v].elementsSIMD = _mm_setzero_ps();
+            }
+
+            ForEachOwnedTriangle(owned, indices, triangleCount, range, begin, end, [&](size_t t, int mask)
+            {
+                // Unnormalized cross products weight each face by its area
+                const unsigned int* corners = indices + t * 3;
+                __m128 p0 = positions[corners[0]].elementsSIMD;
+                __m128 normal = Cross(_mm_sub_ps(positions[corners[1]].elementsSIMD, p0), _mm_sub_ps(positions[corners[2]].elementsSIMD, p0));
+
+                for (int c = 0; c < 3; c++)
+                {
+                    if (mask & (1 << c))
+                    {
+                        normals[corners[c]].elementsSIMD = _mm_add_ps(normals[corners[c]].elementsSIMD, normal);
+                    }
+                }
+            });
+
+            for (size_t v = begin; v < end; v++)
+            {
+                normals[v].elementsSIMD = NormalizeOrZero(normals[v].elementsSIMD);
+            }
+        });
+    }
+
+    void Mesh::Tangents(const Vector3* positions, const Vector3* normals, const Vector2* uvs, const size_t vertexCount, const unsigned int* indices,
+                        const size_t triangleCount, Vector4* tangents)
+    {
+        // The bitangent sums only decide handedness, the tangent sums accumulate straight into the output
+        std::vector<Vector3> bitangents = std::vector<Vector3>(vertexCount);
+        OwnedTriangles owned;
+        BinTriangles(indices, triangleCount, vertexCount, owned);
+
+        ForEachVertexRange(owned, vertexCount, [&](size_t range, size_t begin, size_t end)
+        {
+            for (size_t v = begin; v < end; v++)
+            {
+                tangents[v].elementsSIMD = _mm_setzero_ps();
+            }
+
+            ForEachOwnedTriangle(owned, indices, triangleCount, range, begin, end, [&](size_t t, int mask)
+            {
+                const unsigned int* corners = indices + t * 3;
+                __m128 p[3] = { positions[corners[0]].elementsSIMD, positions[corners[1]].elementsSIMD, positions[corners[2]].elementsSIMD };
+                __m128 edge1 = _mm_sub_ps(p[1], p[0]);
+                __m128 edge2 = _mm_sub_ps(p[2], p[0]);
+                float du1 = uvs[corners[1]].x - uvs[corners[0]].x, dv1 = uvs[corners[1]].y - uvs[corners[0]].y;
+                float du2 = uvs[corners[2]].x - uvs[corners[0]].x, dv2 = uvs[corners[2]].y - uvs[corners[0]].y;
+
+                // The determinant's sign flips the frame for mirrored UVs, its magnitude cancels in the normalize
+                __m128 sign = _mm_set1_ps((du1 * dv2 - du2 * dv1 < 0.0f) ? -1.0f : 1.0f);
+                __m128 faceTangent = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(edge1, _mm_set1_ps(dv2)), _mm_mul_ps(edge2, _mm_set1_ps(dv1))), sign);
+                __m128 faceBitangent = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(edge2, _mm_set1_ps(du1)), _mm_mul_ps(edge1, _mm_set1_ps(du2))), sign);
+
+                // Corner c sits between edges[c] leaving it & edges[c + 2] arriving at it
+                __m128 edges[3] = { NormalizeOrZero(edge1), NormalizeOrZero(_mm_sub_ps(p[2], p[1])), NormalizeOrZero(_mm_sub_ps(p[0], p[2])) };
+
+                for (int c = 0; c < 3; c++)
+                {
+                    if (!(mask & (1 << c)))
+                    {
+                        continue;
+                    }
+
+                    unsigned int v = corners[c];
+                    __m128 angle = _mm_set1_ps(AcosApprox(-_mm_cvtss_f32(Dot(edges[c], edges[(c + 2) % 3]))));
+
+                    // Project into the tangent plane before weighting by corner angle, as MikkTSpace does, so steep faces do not dominate
+                    __m128 normal = normals[v].elementsSIMD;
+                    __m128 tangent = NormalizeOrZero(_mm_sub_ps(faceTangent, _mm_mul_ps(normal, Dot(normal, faceTangent))));
+                    __m128 bitangent = NormalizeOrZero(_mm_sub_ps(faceBitangent, _mm_mul_ps(normal, Dot(normal, faceBitangent))));
+                    tangents[v].elementsSIMD = _mm_add_ps(tangents[v].elementsSIMD, _mm_mul_ps(tangent, angle));
+                    bitangents[v].elementsSIMD = _mm_add_ps(bitangents[v].elementsSIMD, _mm_mul_ps(bitangent, angle));
+                }
+            });
+
+            for (size_t v = begin; v < end; v++)
+            {
+                // Every term is already in the tangent plane, projecting the sum again only removes rounding
+                __m128 normal = normals[v].elementsSIMD;
+                __m128 sum = tangents[v].elementsSIMD;
+                __m128 tangent = NormalizeOrZero(_mm_sub_ps(sum, _mm_mul_ps(normal, Dot(normal, sum))));
+                float handedness = (_mm_cvtss_f32(Dot(Cross(normal, tangent), bitangents[v].elementsSIMD)) < 0.0f) ? -1.0f : 1.0f;
+                tangents[v].elementsSIMD = _mm_blend_ps(tangent, _mm_set1_ps(handedness), 0x8);
+            }
+        });
+    }
+
+    size_t Mesh::Weld(const Vector3* positions, const size_t count, const float epsilon, unsigned int* remap, std::vector<Vector3>& unique)
+    {
+        unique.clear();
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        // Cells at least 2 * epsilon wide put every neighbour within epsilon in the point's own cell or the adjacent one on the nearer side of each axis.
+        // Exact welding keys cells on the position bits instead, adding 0 first so -0 hashes like 0
+        std::vector<Vector3i> cells = std::vector<Vector3i>(count);
+        std::vector<unsigned int> hashes = std::vector<unsigned int>(count);
+        float cellSize = epsilon * WeldCellScale;
+
+        if (epsilon > 0.0f)
+        {
+            Vector3i::ToCells(positions, cells.data(), count, cellSize);
+        }
+
+        ParallelFor(count, MeshGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                if (epsilon <= 0.0f)
+                {
+                    __m128i bits = _mm_castps_si128(_mm_add_ps(positions[i].elementsSIMD, _mm_setzero_ps()));
+                    cells[i].elementsSIMD = _mm_blend_epi16(bits, _mm_setzero_si128(), 0xC0);
+                }
+
+                hashes[i] = WeldHash(cells[i].elementsSIMD);
+            }
+        });
+
+        static const size_t threads = std::thread::hardware_concurrency();
+        WeldTables hash;
+        hash.cells = cells.data();
+        hash.bits = 0;
+
+        while ((static_cast<size_t>(1) << hash.bits) < threads && (static_cast<size_t>(MeshGrain) << hash.bits) < count)
+        {
+            hash.bits++;
+        }
+
+        size_t partitions = static_cast<size_t>(1) << hash.bits;
+        hash.tables.resize(partitions);
+        hash.masks.resize(partitions);
+        std::vector<unsigned int> next = std::vector<unsigned int>(count);
+
+        // Each thread scans every hash but only inserts its own partition's vertices, in index order so every cell list stays sorted
+        ParallelFor(partitions, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t partition = begin; partition < end; partition++)
+            {
+                size_t owned = 0;
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    owned += (hash.Partition(hashes[i]) == partition) ? 1 : 0;
+                }
+
+                // At least twice as many slots as vertices keeps the probes short even when no vertices share a cell
+                size_t slots = 2;
+
+                while (slots < owned * 2)
+                {
+                    slots <<= 1;
+                }
+
+                WeldCell empty;
+                empty.first = WeldEmpty;
+                empty.last = WeldEmpty;
+                hash.tables[partition].assign(slots, empty);
+                hash.masks[partition] = static_cast<unsigned int>(slots - 1);
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    if (hash.Partition(hashes[i]) != partition)
+                    {
+                        continue;
+                    }
+
+                    WeldCell& cell = FindCell(hash, cells[i].elementsSIMD, hashes[i]);
+                    next[i] = WeldEmpty;
+
+                    if (cell.first == WeldEmpty)
+                    {
+                        cell.first = static_cast<unsigned int>(i);
+                    }
+                    else
+                    {
+                        next[cell.last] = static_cast<unsigned int>(i);
+                    }
+
+                    cell.last = static_cast<unsigned int>(i);
+                }
+            }
+        });
+
+        // Each vertex's representative is written to remap first & replaced by its unique index below
+        if (epsilon <= 0.0f)
+        {
+            // Every vertex in an exact cell has the same position, so the head of the list is the representative
+            ParallelFor(count, MeshGrain, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    remap[i] = FindCell(hash, cells[i].elementsSIMD, hashes[i]).first;
+                }
+            });
+        }
+        else
+        {
+            // Welding within epsilon is not transitive, so each vertex must see which earlier vertices were kept. This pass runs in index order
+            __m128 invCellSize = _mm_set1_ps(1.0f / cellSize);
+            float epsilonSqr = epsilon * epsilon;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                __m128 point = positions[i].elementsSIMD;
+                __m128 scaled = _mm_mul_ps(point, invCellSize);
+                __m128i home = cells[i].elementsSIMD;
+
+                // -1 on axes where the point is in the lower half of its cell, +1 otherwise, along with the squared distance to that side
+                __m128 fraction = _mm_sub_ps(scaled, _mm_floor_ps(scaled));
+                __m128i lower = _mm_castps_si128(_mm_cmplt_ps(fraction, _mm_set1_ps(0.5f)));
+                __m128i side = _mm_or_si128(lower, _mm_set1_epi32(1));
+                __m128 gap = _mm_mul_ps(_mm_min_ps(fraction, _mm_sub_ps(_mm_set1_ps(1.0f), fraction)), _mm_set1_ps(cellSize));
+                __declspec(align(16)) float gapSqr[4];
+                _mm_store_ps(gapSqr, _mm_mul_ps(gap, gap));
+                unsigned int best = static_cast<unsigned int>(i);
+
+                for (int probe = 0; probe < 8; probe++)
+                {
+                    // Skip neighbouring cells whose nearest face, edge or corner is already further than epsilon
+                    float reach = ((probe & 1) ? gapSqr[0] : 0.0f) + ((probe & 2) ? gapSqr[1] : 0.0f) + ((probe & 4) ? gapSqr[2] : 0.0f);
+
+                    if (reach > epsilonSqr)
+                    {
+                        continue;
+                    }
+
+                    __m128i step = _mm_and_si128(side, _mm_cmpgt_epi32(_mm_and_si128(_mm_set1_epi32(probe), _mm_setr_epi32(1, 2, 4, 8)), _mm_setzero_si128()));
+                    __m128i cell = _mm_blend_epi16(_mm_add_epi32(home, step), _mm_setzero_si128(), 0xC0);
+                    const WeldCell& found = FindCell(hash, cell, WeldHash(cell));
+
+                    // Lists are in index order, so the first kept vertex within epsilon is the earliest in this cell
+                    for (unsigned int j = found.first; j < best; j = next[j])
+                    {
+                        __m128 delta = _mm_sub_ps(positions[j].elementsSIMD, point);
+
+                        if (remap[j] == j && _mm_cvtss_f32(_mm_dp_ps(delta, delta, 0x71)) <= epsilonSqr)
+                        {
+                            best = j;
+                            break;
+                        }
+                    }
+                }
+
+                remap[i] = best;
+            }
+        }
+
+        // Representatives always come before the vertices welded to them, so one ordered pass numbers them
+        for (size_t i = 0; i < count; i++)
+        {
+            if (remap[i] == i)
+            {
+                remap[i] = static_cast<unsigned int>(unique.size());
+                unique.push_back(positions[i]);
+            }
+            else
+            {
+                remap[i] = remap[remap[i]];
+            }
+        }
+
+        return unique.size();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,1253 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <float.h>
+
+namespace NullX
+{
+    static const size_t NarrowPhaseGrain     = 256;
+    static const int    GJKMaxIterations     = 32;
+    // Relative progress below which GJK stops, also the distance relative to the simplex size treated as touching
+    static const float  GJKTolerance         = 1e-6f;
+    static const int    EPAMaxIterations     = 64;
+    static const int    EPAMaxVertices       = EPAMaxIterations + 4;
+    static const int    EPAMaxFaces          = EPAMaxVertices * 2;
+    static const int    EPAMaxHorizon        = 64;
+    static const float  EPATolerance         = 1e-4f;
+    // Box2 face & edge axes only win over box1's faces when their separation is 5% shallower, so the chosen axis doesn't flicker between frames
+    static const float  SATRelativeTolerance = 0.95f;
+    // Keeps the cross product of near parallel edges from reporting a false separating axis
+    static const float  SATParallelEpsilon   = 1e-6f;
+
+    // Minkowski difference vertex, w = a - b, with the shape points kept to recover the contact
+    struct SupportPoint
+    {
+        __m128 w;
+        __m128 a;
+        __m128 b;
+    };
+
+    struct GJKSimplex
+    {
+        SupportPoint points[4];
+        float        weights[4];
+        int          count;
+    };
+
+    struct EPAFace
+    {
+        __m128 normal;
+        float  distance;
+        int    vertices[3];
+    };
+
+    static __m128 ClearW(const __m128 vec)
+    {
+        return _mm_blend_ps(vec, _mm_setzero_ps(), 0x8);
+    }
+
+    // Shuffles & scalar adds instead of dp_ps, which has a long latency on the chains GJK & EPA build.  The w lane is never read
+    static float Dot(const __m128 a, const __m128 b)
+    {
+        __m128 product = _mm_mul_ps(a, b);
+        return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1))), _mm_movehl_ps(product, product)));
+    }
+
+    static __m128 Cross(const __m128 a, const __m128 b)
+    {
+        __m128 result = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(b, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1))));
+        return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    static __m128 Scale(const __m128 vec, const float scale)
+    {
+        return _mm_mul_ps(vec, _mm_set1_ps(scale));
+    }
+
+    static __m128 Abs(const __m128 vec)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), vec);
+    }
+
+    static __m128 Broadcast(const __m128 vec, const int lane)
+    {
+        switch (lane)
+        {
+        case 0:  return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(0, 0, 0, 0));
+        case 1:  return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1));
+        default: return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 2, 2, 2));
+        }
+    }
+
+    static float Saturate(const float value)
+    {
+        return (value < 0.0f) ? 0.0f : (value > 1.0f) ? 1.0f : value;
+    }
+
+    static float Lane(const __m128 vec, const int lane)
+    {
+        return _mm_cvtss_f32(Broadcast(vec, lane));
+    }
+
+    // Largest of the x, y & z lanes along with its lane
+    static float MaxLane(const __m128 vec, int& lane)
+    {
+        __declspec(align(16)) float lanes[4];
+        _mm_store_ps(lanes, vec);
+        lane = (lanes[1] > lanes[0]) ? 1 : 0;
+        lane = (lanes[2] > lanes[lane]) ? 2 : lane;
+        return lanes[lane];
+    }
+
+    // (dot(axes[0], direction), dot(axes[1], direction), dot(axes[2], direction), 0) with two hadds, the axes keep w at 0
+    static __m128 ToLocal(const ConvexShape& shape, const __m128 direction)
+    {
+        __m128 dots0 = _mm_mul_ps(shape.axes[0].elementsSIMD, direction);
+        __m128 dots1 = _mm_mul_ps(shape.axes[1].elementsSIMD, direction);
+        __m128 dots2 = _mm_mul_ps(shape.axes[2].elementsSIMD, direction);
+        return _mm_hadd_ps(_mm_hadd_ps(dots0, dots1), _mm_hadd_ps(dots2, _mm_setzero_ps()));
+    }
+
+    static __m128 ToWorld(const ConvexShape& shape, const __m128 local)
+    {
+        __m128 world = _mm_add_ps(shape.center.elementsSIMD, _mm_mul_ps(shape.axes[0].elementsSIMD, Broadcast(local, 0)));
+        world = _mm_add_ps(world, _mm_mul_ps(shape.axes[1].elementsSIMD, Broadcast(local, 1)));
+        return _mm_add_ps(world, _mm_mul_ps(shape.axes[2].elementsSIMD, Broadcast(local, 2)));
+    }
+
+    static __m128 CoreSupport(const ConvexShape& shape, const __m128 direction)
+    {
+        switch (shape.type)
+        {
+        case ShapeType::Sphere:
+            return shape.center.elementsSIMD;
+
+        case ShapeType::Capsule:
+        {
+            float half = (Dot(shape.axes[1].elementsSIMD, direction) >= 0.0f) ? shape.extents.y : -shape.extents.y;
+            return _mm_add_ps(shape.center.elementsSIMD, Scale(shape.axes[1].elementsSIMD, half));
+        }
+
+        case ShapeType::Box:
+            // Each extent takes the sign of the direction along its axis
+            return ToWorld(shape, _mm_or_ps(_mm_and_ps(ToLocal(shape, direction), _mm_set1_ps(-0.0f)), shape.extents.elementsSIMD));
+
+        default:
+        {
+            // 4 hull points per step, transposed so the dot products need no horizontal adds
+            __m128 local = ToLocal(shape, direction);
+            __m128 localX = Broadcast(local, 0);
+            __m128 localY = Broadcast(local, 1);
+            __m128 localZ = Broadcast(local, 2);
+            __m128 best = _mm_set1_ps(-FLT_MAX);
+            __m128i bestIndices = _mm_setzero_si128();
+            __m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+            size_t last = shape.pointCount - 1;
+
+            for (size_t i = 0; i < shape.pointCount; i += 4)
+            {
+                __m128 x = shape.points[i].elementsSIMD;
+                __m128 y = shape.points[(i + 1 < last) ? i + 1 : last].elementsSIMD;
+                __m128 z = shape.points[(i + 2 < last) ? i + 2 : last].elementsSIMD;
+                __m128 w = shape.points[(i + 3 < last) ? i + 3 : last].elementsSIMD;
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                __m128 dots = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, localX), _mm_mul_ps(y, localY)), _mm_mul_ps(z, localZ));
+                __m128i better = _mm_castps_si128(_mm_cmpgt_ps(dots, best));
+                best = _mm_max_ps(dots, best);
+                bestIndices = _mm_blendv_epi8(bestIndices, indices, better);
+                indices = _mm_add_epi32(indices, _mm_set1_epi32(4));
+            }
+
+            __declspec(align(16)) float dots[4];
+            __declspec(align(16)) int bestLanes[4];
+            _mm_store_ps(dots, best);
+            _mm_store_si128(reinterpret_cast<__m128i*>(bestLanes), bestIndices);
+            int lane = 0;
+
+            for (int l = 1; l < 4; l++)
+            {
+                lane = (dots[l] > dots[lane]) ? l : lane;
+            }
+
+            size_t index = static_cast<size_t>(bestLanes[lane]);
+            return ToWorld(shape, shape.points[(index < last) ? index : last].elementsSIMD);
+        }
+        }
+    }
+
+    static __m128 Support(const ConvexShape& shape, const __m128 direction)
+    {
+        __m128 core = CoreSupport(shape, direction);
+
+        if (shape.radius <= 0.0f)
+        {
+            return core;
+        }
+
+        float lengthSqr = Dot(direction, direction);
+        return (lengthSqr > 0.0f) ? _mm_add_ps(core, Scale(direction, shape.radius / sqrtf(lengthSqr))) : core;
+    }
+
+    static SupportPoint MinkowskiSupport(const ConvexShape& shape1, const ConvexShape& shape2, const __m128 direction, const bool core)
+    {
+        __m128 negated = _mm_xor_ps(direction, _mm_set1_ps(-0.0f));
+        SupportPoint toReturn;
+        toReturn.a = ClearW(core ? CoreSupport(shape1, direction) : Support(shape1, direction));
+        toReturn.b = ClearW(core ? CoreSupport(shape2, negated) : Support(shape2, negated));
+        toReturn.w = _mm_sub_ps(toReturn.a, toReturn.b);
+        return toReturn;
+    }
+
+    ConvexShape::ConvexShape() : points(nullptr), pointCount(0), radius(0.0f), type(ShapeType::Sphere)
+    {
+        axes[0] = Vector3(1.0f, 0.0f, 0.0f);
+        axes[1] = Vector3(0.0f, 1.0f, 0.0f);
+        axes[2] = Vector3(0.0f, 0.0f, 1.0f);
+        center.elementsSIMD = _mm_setzero_ps();
+        extents.elementsSIMD = _mm_setzero_ps();
+    }
+
+    ConvexShape ConvexShape::Sphere(const Vector3& center, const float radius)
+    {
+        ConvexShape toReturn = ConvexShape();
+        toReturn.center.elementsSIMD = ClearW(center.elementsSIMD);
+        toReturn.radius = radius;
+        return toReturn;
+    }
+
+    ConvexShape ConvexShape::Capsule(const Vector3& point1, const Vector3& point2, const float radius)
+    {
+        ConvexShape toReturn = ConvexShape();
+        __m128 segment = ClearW(_mm_sub_ps(point2.elementsSIMD, point1.elementsSIMD));
+        float length = sqrtf(Dot(segment, segment));
+
+        toReturn.type = ShapeType::Capsule;
+        toReturn.center.elementsSIMD = ClearW(_mm_mul_ps(_mm_add_ps(point1.elementsSIMD, point2.elementsSIMD), _mm_set1_ps(0.5f)));
+        toReturn.axes[1].elementsSIMD = (length > 0.0f) ? Scale(segment, 1.0f / length) : toReturn.axes[1].elementsSIMD;
+        toReturn.extents.elementsSIMD = _mm_setr_ps(0.0f, length * 0.5f, 0.0f, 0.0f);
+        toReturn.radius = radius;
+        return toReturn;
+    }
+
+    ConvexShape ConvexShape::Box(const Vector3& center, const Quaternion& rotation, const Vector3& extents)
+    {
+        ConvexShape toReturn = ConvexShape();
+        Quaternion q = Quaternion::Normalized(rotation);
+
+        toReturn.type = ShapeType::Box;
+        toReturn.center.elementsSIMD = ClearW(center.elementsSIMD);
+        toReturn.axes[0] = Vector3(1.0f - 2.0f * (q.y * q.y + q.z * q.z), 2.0f * (q.x * q.y + q.w * q.z), 2.0f * (q.x * q.z - q.w * q.y));
+        toReturn.axes[1] = Vector3(2.0f * (q.x * q.y - q.w * q.z), 1.0f - 2.0f * (q.x * q.x + q.z * q.z), 2.0f * (q.y * q.z + q.w * q.x));
+        toReturn.axes[2] = Vector3(2.0f * (q.x * q.z + q.w * q.y), 2.0f * (q.y * q.z - q.w * q.x), 1.0f - 2.0f * (q.x * q.x + q.y * q.y));
+        toReturn.extents.elementsSIMD = ClearW(Abs(extents.elementsSIMD));
+
+        for (int i = 0; i < 3; i++)
+        {
+            toReturn.axes[i].elementsSIMD = ClearW(toReturn.axes[i].elementsSIMD);
+        }
+
+        return toReturn;
+    }
+
+    ConvexShape ConvexShape::Hull(const Vector3* points, const size_t count, const Vector3& position, const Quaternion& rotation)
+    {
+        ConvexShape toReturn = Box(position, rotation, Vector3(0.0f, 0.0f, 0.0f));
+        toReturn.type = ShapeType::Hull;
+        toReturn.points = points;
+        toReturn.pointCount = count;
+        return toReturn;
+    }
+
+    Vector3 ConvexShape::CoreSupport(const Vector3& direction) const
+    {
+        return Vector3(NullX::CoreSupport(*this, ClearW(direction.elementsSIMD)));
+    }
+
+    Vector3 ConvexShape::Support(const Vector3& direction) const
+    {
+        return Vector3(NullX::Support(*this, ClearW(direction.elementsSIMD)));
+    }
+
+    ContactManifold::ContactManifold() : count(0)
+    {
+        normal.elementsSIMD = _mm_setzero_ps();
+
+        for (int i = 0; i < MaxPoints; i++)
+        {
+            points[i].elementsSIMD = _mm_setzero_ps();
+            depths[i] = 0.0f;
+        }
+    }
+
+    static float ScaleSqr(const SupportPoint* points, const int count)
+    {
+        float toReturn = FLT_MIN;
+
+        for (int i = 0; i < count; i++)
+        {
+            float lengthSqr = Dot(points[i].w, points[i].w);
+            toReturn = (lengthSqr > toReturn) ? lengthSqr : toReturn;
+        }
+
+        return toReturn;
+    }
+
+    // Closest point to the origin on the triangle a, b, c by Voronoi regions, after Ericson's Real-Time Collision Detection 5.1.5.
+    // out keeps only the vertices of the region the point lies in
+    static void ClosestOnTriangle(const SupportPoint& a, const SupportPoint& b, const SupportPoint& c, GJKSimplex& out, __m128& closest)
+    {
+        __m128 ab = _mm_sub_ps(b.w, a.w);
+        __m128 ac = _mm_sub_ps(c.w, a.w);
+        float d1 = -Dot(ab, a.w);
+        float d2 = -Dot(ac, a.w);
+
+        if (d1 <= 0.0f && d2 <= 0.0f)
+        {
+            out.points[0] = a;
+            out.weights[0] = 1.0f;
+            out.count = 1;
+            closest = a.w;
+            return;
+        }
+
+        float d3 = -Dot(ab, b.w);
+        float d4 = -Dot(ac, b.w);
+
+        if (d3 >= 0.0f && d4 <= d3)
+        {
+            out.points[0] = b;
+            out.weights[0] = 1.0f;
+            out.count = 1;
+            closest = b.w;
+            return;
+        }
+
+        float vc = d1 * d4 - d3 * d2;
+
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        {
+            float t = d1 / (d1 - d3);
+            out.points[0] = a;
+            out.points[1] = b;
+            out.weights[0] = 1.0f - t;
+            out.weights[1] = t;
+            out.count = 2;
+            closest = _mm_add_ps(a.w, Scale(ab, t));
+            return;
+        }
+
+        float d5 = -Dot(ab, c.w);
+        float d6 = -Dot(ac, c.w);
+
+        if (d6 >= 0.0f && d5 <= d6)
+        {
+            out.points[0] = c;
+            out.weights[0] = 1.0f;
+            out.count = 1;
+            closest = c.w;
+            return;
+        }
+
+        float vb = d5 * d2 - d1 * d6;
+
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        {
+            float t = d2 / (d2 - d6);
+            out.points[0] = a;
+            out.points[1] = c;
+            out.weights[0] = 1.0f - t;
+            out.weights[1] = t;
+            out.count = 2;
+            closest = _mm_add_ps(a.w, Scale(ac, t));
+            return;
+        }
+
+        float va = d3 * d6 - d5 * d4;
+
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+        {
+            float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            out.points[0] = b;
+            out.points[1] = c;
+            out.weights[0] = 1.0f - t;
+            out.weights[1] = t;
+            out.count = 2;
+            closest = _mm_add_ps(b.w, Scale(_mm_sub_ps(c.w, b.w), t));
+            return;
+        }
+
+        float sum = va + vb + vc;
+
+        // A degenerate triangle has no face region, its longest side holds the closest point
+        if (sum <= FLT_MIN)
+        {
+            float t = d1 / (d1 - d3 + FLT_MIN);
+            t = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+            out.points[0] = a;
+            out.points[1] = b;
+            out.weights[0] = 1.0f - t;
+            out.weights[1] = t;
+            out.count = 2;
+            closest = _mm_add_ps(a.w, Scale(ab, t));
+            return;
+        }
+
+        float v = vb / sum;
+        float w = vc / sum;
+        out.points[0] = a;
+        out.points[1] = b;
+        out.points[2] = c;
+        out.weights[0] = 1.0f - v - w;
+        out.weights[1] = v;
+        out.weights[2] = w;
+        out.count = 3;
+        closest = _mm_add_ps(a.w, _mm_add_ps(Scale(ab, v), Scale(ac, w)));
+    }
+
+    // Reduces simplex to the vertices nearest the origin & finds the closest point on it.
+    // Returns false if the origin is inside the tetrahedron
+    static bool ClosestOnSimplex(GJKSimplex& simplex, __m128& closest)
+    {
+        if (simplex.count == 2)
+        {
+            const SupportPoint& a = simplex.points[0];
+            const SupportPoint& b = simplex.points[1];
+            __m128 ab = _mm_sub_ps(b.w, a.w);
+            float lengthSqr = Dot(ab, ab);
+            float t = (lengthSqr > FLT_MIN) ? -Dot(a.w, ab) / lengthSqr : 0.0f;
+
+            if (t <= 0.0f)
+            {
+                simplex.count = 1;
+                simplex.weights[0] = 1.0f;
+                closest = a.w;
+            }
+            else if (t >= 1.0f)
+            {
+                simplex.points[0] = b;
+                simplex.count = 1;
+                simplex.weights[0] = 1.0f;
+                closest = b.w;
+            }
+            else
+            {
+                simplex.weights[0] = 1.0f - t;
+                simplex.weights[1] = t;
+                closest = _mm_add_ps(a.w, Scale(ab, t));
+            }
+
+            return true;
+        }
+
+        if (simplex.count == 3)
+        {
+            SupportPoint a = simplex.points[0];
+            SupportPoint b = simplex.points[1];
+            SupportPoint c = simplex.points[2];
+            ClosestOnTriangle(a, b, c, simplex, closest);
+            return true;
+        }
+
+        // The origin is outside a face when it & the opposite vertex lie on different sides of it, the nearest such face holds the closest point
+        static const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+        SupportPoint points[4] = { simplex.points[0], simplex.points[1], simplex.points[2], simplex.points[3] };
+        float volume = Dot(Cross(_mm_sub_ps(points[1].w, points[0].w), _mm_sub_ps(points[2].w, points[0].w)), _mm_sub_ps(points[3].w, points[0].w));
+        float scale = ScaleSqr(points, 4);
+
+        // A flat tetrahedron has no inside, the newest vertex added nothing
+        if (volume * volume <= GJKTolerance * GJKTolerance * scale * scale * scale)
+        {
+            ClosestOnTriangle(points[0], points[1], points[2], simplex, closest);
+            return true;
+        }
+
+        float bestSqr = FLT_MAX;
+        bool inside = true;
+
+        for (int f = 0; f < 4; f++)
+        {
+            const SupportPoint& a = points[faces[f][0]];
+            const SupportPoint& b = points[faces[f][1]];
+            const SupportPoint& c = points[faces[f][2]];
+            __m128 normal = Cross(_mm_sub_ps(b.w, a.w), _mm_sub_ps(c.w, a.w));
+            float originSide = -Dot(normal, a.w);
+            float oppositeSide = Dot(normal, _mm_sub_ps(points[faces[f][3]].w, a.w));
+
+            if (originSide * oppositeSide >= 0.0f)
+            {
+                continue;
+            }
+
+            GJKSimplex candidate;
+            __m128 point;
+            ClosestOnTriangle(a, b, c, candidate, point);
+            float distanceSqr = Dot(point, point);
+            inside = false;
+
+            if (distanceSqr < bestSqr)
+            {
+                bestSqr = distanceSqr;
+                simplex = candidate;
+                closest = point;
+            }
+        }
+
+        if (inside)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                simplex.weights[i] = 0.25f;
+            }
+
+            closest = _mm_setzero_ps();
+        }
+
+        return !inside;
+    }
+
+    // GJK over the Minkowski difference shape1 - shape2, of the cores or of the full shapes.
+    // Returns true if the shapes overlap or touch, simplex then holds the last simplex
+    static bool GJK(const ConvexShape& shape1, const ConvexShape& shape2, const bool core, GJKSimplex& simplex, __m128& closest)
+    {
+        __m128 direction = ClearW(_mm_sub_ps(shape2.center.elementsSIMD, shape1.center.elementsSIMD));
+        direction = (Dot(direction, direction) > FLT_MIN) ? direction : _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+        simplex.points[0] = MinkowskiSupport(shape1, shape2, direction, core);
+        simplex.weights[0] = 1.0f;
+        simplex.count = 1;
+        closest = simplex.points[0].w;
+
+        for (int iteration = 0; iteration < GJKMaxIterations; iteration++)
+        {
+            float closestSqr = Dot(closest, closest);
+
+            if (closestSqr <= GJKTolerance * GJKTolerance * ScaleSqr(simplex.points, simplex.count))
+            {
+                return true;
+            }
+
+            SupportPoint next = MinkowskiSupport(shape1, shape2, _mm_xor_ps(closest, _mm_set1_ps(-0.0f)), core);
+
+            // Nothing further along -closest gets meaningfully nearer the origin, so closest is the answer
+            if (closestSqr - Dot(closest, next.w) <= GJKTolerance * closestSqr)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < simplex.count; i++)
+            {
+                if ((_mm_movemask_ps(_mm_cmpeq_ps(simplex.points[i].w, next.w)) & 0x7) == 0x7)
+                {
+                    return false;
+                }
+            }
+
+            simplex.points[simplex.count] = next;
+            simplex.weights[simplex.count++] = 0.0f;
+
+            if (!ClosestOnSimplex(simplex, closest))
+            {
+                return true;
+            }
+
+            if (Dot(closest, closest) >= closestSqr)
+            {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    static void SimplexPoints(const GJKSimplex& simplex, __m128& point1, __m128& point2)
+    {
+        point1 = _mm_setzero_ps();
+        point2 = _mm_setzero_ps();
+
+        for (int i = 0; i < simplex.count; i++)
+        {
+            point1 = _mm_add_ps(point1, Scale(simplex.points[i].a, simplex.weights[i]));
+            point2 = _mm_add_ps(point2, Scale(simplex.points[i].b, simplex.weights[i]));
+        }
+    }
+
+    // Adds support points off the line or plane of a touching simplex until it spans a volume EPA can expand.
+    // Returns false if the Minkowski difference is flat
+    static bool GrowToTetrahedron(const ConvexShape& shape1, const ConvexShape& shape2, const bool core, SupportPoint* vertices, int& count)
+    {
+        static const float directions[3][4] = { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } };
+
+        for (int i = 0; i < 6 && count == 1; i++)
+        {
+            __m128 direction = Scale(_mm_loadu_ps(directions[i / 2]), (i & 1) ? -1.0f : 1.0f);
+            SupportPoint next = MinkowskiSupport(shape1, shape2, direction, core);
+            __m128 offset = _mm_sub_ps(next.w, vertices[0].w);
+
+            if (Dot(offset, offset) > GJKTolerance * GJKTolerance * ScaleSqr(&next, 1))
+            {
+                vertices[count++] = next;
+            }
+        }
+
+        __m128 line = _mm_sub_ps(vertices[1].w, vertices[0].w);
+
+        for (int i = 0; i < 6 && count == 2; i++)
+        {
+            __m128 direction = Scale(Cross(line, _mm_loadu_ps(directions[i / 2])), (i & 1) ? -1.0f : 1.0f);
+            SupportPoint next = MinkowskiSupport(shape1, shape2, direction, core);
+            __m128 offset = _mm_sub_ps(next.w, vertices[0].w);
+            __m128 normal = Cross(line, offset);
+
+            if (Dot(normal, normal) > GJKTolerance * GJKTolerance * Dot(line, line) * Dot(offset, offset))
+            {
+                vertices[count++] = next;
+            }
+        }
+
+        __m128 normal = Cross(_mm_sub_ps(vertices[1].w, vertices[0].w), _mm_sub_ps(vertices[2].w, vertices[0].w));
+
+        for (int i = 0; i < 2 && count == 3; i++)
+        {
+            SupportPoint next = MinkowskiSupport(shape1, shape2, Scale(normal, (i & 1) ? -1.0f : 1.0f), core);
+            __m128 offset = _mm_sub_ps(next.w, vertices[0].w);
+            float height = Dot(normal, offset);
+
+            if (height * height > GJKTolerance * GJKTolerance * Dot(normal, normal) * Dot(offset, offset))
+            {
+                vertices[count++] = next;
+            }
+        }
+
+        return count == 4;
+    }
+
+    // Outward face of the polytope, or one that can never be closest if it is degenerate
+    static EPAFace MakeFace(const SupportPoint* vertices, const int a, const int b, const int c)
+    {
+        EPAFace toReturn;
+        __m128 normal = Cross(_mm_sub_ps(vertices[b].w, vertices[a].w), _mm_sub_ps(vertices[c].w, vertices[a].w));
+        float lengthSqr = Dot(normal, normal);
+
+        toReturn.vertices[0] = a;
+        toReturn.vertices[1] = b;
+        toReturn.vertices[2] = c;
+        toReturn.normal = (lengthSqr > FLT_MIN) ? Scale(normal, 1.0f / sqrtf(lengthSqr)) : _mm_setzero_ps();
+        toReturn.distance = (lengthSqr > FLT_MIN) ? Dot(toReturn.normal, vertices[a].w) : FLT_MAX;
+        return toReturn;
+    }
+
+    static int ClosestFace(const EPAFace* faces, const int faceCount)
+    {
+        int toReturn = 0;
+
+        for (int f = 1; f < faceCount; f++)
+        {
+            toReturn = (faces[f].distance < faces[toReturn].distance) ? f : toReturn;
+        }
+
+        return toReturn;
+    }
+
+    // Expands the polytope GJK left around the origin towards the face of the Minkowski difference closest to the origin.
+    // Returns false if the difference is flat, when the shapes only just touch & there is nothing to expand
+    static bool EPA(const ConvexShape& shape1, const ConvexShape& shape2, const GJKSimplex& simplex, const bool core, __m128& normal, float& depth, __m128& point1, __m128& point2)
+    {
+        SupportPoint vertices[EPAMaxVertices];
+        EPAFace faces[EPAMaxFaces];
+        int vertexCount = simplex.count;
+
+        for (int i = 0; i < vertexCount; i++)
+        {
+            vertices[i] = simplex.points[i];
+        }
+
+        if (!GrowToTetrahedron(shape1, shape2, core, vertices, vertexCount))
+        {
+            return false;
+        }
+
+        // Wind every face so its normal points away from the opposite vertex
+        static const int tetrahedron[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+        int faceCount = 0;
+
+        for (int f = 0; f < 4; f++)
+        {
+            const int* face = tetrahedron[f];
+            __m128 faceNormal = Cross(_mm_sub_ps(vertices[face[1]].w, vertices[face[0]].w), _mm_sub_ps(vertices[face[2]].w, vertices[face[0]].w));
+            bool flip = Dot(faceNormal, _mm_sub_ps(vertices[face[3]].w, vertices[face[0]].w)) > 0.0f;
+            faces[faceCount++] = flip ? MakeFace(vertices, face[0], face[2], face[1]) : MakeFace(vertices, face[0], face[1], face[2]);
+        }
+
+        float tolerance = EPATolerance * sqrtf(ScaleSqr(vertices, vertexCount));
+
+        for (int iteration = 0; iteration < EPAMaxIterations && vertexCount < EPAMaxVertices; iteration++)
+        {
+            const EPAFace closestFace = faces[ClosestFace(faces, faceCount)];
+            SupportPoint next = MinkowskiSupport(shape1, shape2, closestFace.normal, core);
+
+            if (Dot(next.w, closestFace.normal) - closestFace.distance <= tolerance)
+            {
+                break;
+            }
+
+            // Faces that can see the new vertex are removed, their edges not shared with another removed face form the horizon
+            int horizon[EPAMaxHorizon][2];
+            int horizonCount = 0;
+            int added = vertexCount;
+            vertices[vertexCount++] = next;
+
+            for (int f = faceCount - 1; f >= 0; f--)
+            {
+                if (Dot(faces[f].normal, _mm_sub_ps(next.w, vertices[faces[f].vertices[0]].w)) <= 0.0f)
+                {
+                    continue;
+                }
+
+                for (int e = 0; e < 3; e++)
+                {
+                    int from = faces[f].vertices[e];
+                    int to = faces[f].vertices[(e + 1) % 3];
+                    bool shared = false;
+
+                    for (int h = 0; h < horizonCount; h++)
+                    {
+                        if (horizon[h][0] == to && horizon[h][1] == from)
+                        {
+                            horizon[h][0] = horizon[--horizonCount][0];
+                            horizon[h][1] = horizon[horizonCount][1];
+                            shared = true;
+                            break;
+                        }
+                    }
+
+                    if (!shared && horizonCount < EPAMaxHorizon)
+                    {
+                        horizon[horizonCount][0] = from;
+                        horizon[horizonCount++][1] = to;
+                    }
+                }
+
+                faces[f] = faces[--faceCount];
+            }
+
+            for (int h = 0; h < horizonCount && faceCount < EPAMaxFaces; h++)
+            {
+                faces[faceCount++] = MakeFace(vertices, horizon[h][0], horizon[h][1], added);
+            }
+
+            if (faceCount == 0)
+            {
+                faces[faceCount++] = closestFace;
+                break;
+            }
+        }
+
+        // The origin projected onto the closest face, in barycentric coordinates of its vertices, locates the contact on each shape
+        const EPAFace& face = faces[ClosestFace(faces, faceCount)];
+        const SupportPoint& a = vertices[face.vertices[0]];
+        const SupportPoint& b = vertices[face.vertices[1]];
+        const SupportPoint& c = vertices[face.vertices[2]];
+        __m128 ab = _mm_sub_ps(b.w, a.w);
+        __m128 ac = _mm_sub_ps(c.w, a.w);
+        __m128 ap = _mm_sub_ps(Scale(face.normal, face.distance), a.w);
+        float d00 = Dot(ab, ab);
+        float d01 = Dot(ab, ac);
+        float d11 = Dot(ac, ac);
+        float d20 = Dot(ap, ab);
+        float d21 = Dot(ap, ac);
+        float denominator = d00 * d11 - d01 * d01;
+        float v = (denominator > FLT_MIN) ? (d11 * d20 - d01 * d21) / denominator : 0.0f;
+        float w = (denominator > FLT_MIN) ? (d00 * d21 - d01 * d20) / denominator : 0.0f;
+        float u = 1.0f - v - w;
+
+        normal = face.normal;
+        depth = (face.distance > 0.0f) ? face.distance : 0.0f;
+        point1 = _mm_add_ps(_mm_add_ps(Scale(a.a, u), Scale(b.a, v)), Scale(c.a, w));
+        point2 = _mm_add_ps(_mm_add_ps(Scale(a.b, u), Scale(b.b, v)), Scale(c.b, w));
+        return true;
+    }
+
+    // GJK & then EPA over the full shapes, falling back to a zero depth contact along the line between the centres if they only just touch
+    static bool FullPenetration(const ConvexShape& shape1, const ConvexShape& shape2, __m128& normal, float& depth, __m128& point1, __m128& point2)
+    {
+        GJKSimplex simplex;
+        __m128 closest;
+
+        if (!GJK(shape1, shape2, false, simplex, closest))
+        {
+            return false;
+        }
+
+        if (!EPA(shape1, shape2, simplex, false, normal, depth, point1, point2))
+        {
+            __m128 offset = ClearW(_mm_sub_ps(shape2.center.elementsSIMD, shape1.center.elementsSIMD));
+            float lengthSqr = Dot(offset, offset);
+            normal = (lengthSqr > FLT_MIN) ? Scale(offset, 1.0f / sqrtf(lengthSqr)) : _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f);
+            depth = 0.0f;
+            SimplexPoints(simplex, point1, point2);
+        }
+
+        return true;
+    }
+
+    // Closest points of the segments p1-q1 & p2-q2, after Ericson's Real-Time Collision Detection 5.1.9
+    // Returns the squared distance between them
+    static float ClosestOnSegments(const __m128 p1, const __m128 q1, const __m128 p2, const __m128 q2, __m128& closest1, __m128& closest2)
+    {
+        __m128 d1 = _mm_sub_ps(q1, p1);
+        __m128 d2 = _mm_sub_ps(q2, p2);
+        __m128 r = _mm_sub_ps(p1, p2);
+        float a = Dot(d1, d1);
+        float e = Dot(d2, d2);
+        float f = Dot(d2, r);
+        float s = 0.0f;
+        float t = 0.0f;
+
+        if (a > FLT_MIN && e <= FLT_MIN)
+        {
+            s = Saturate(-Dot(d1, r) / a);
+        }
+        else if (a <= FLT_MIN && e > FLT_MIN)
+        {
+            t = Saturate(f / e);
+        }
+        else if (a > FLT_MIN)
+        {
+            float b = Dot(d1, d2);
+            float c = Dot(d1, r);
+            float denominator = a * e - b * b;
+            s = (denominator > FLT_MIN) ? Saturate((b * f - c * e) / denominator) : 0.0f;
+            t = (b * s + f) / e;
+
+            if (t < 0.0f)
+            {
+                t = 0.0f;
+                s = Saturate(-c / a);
+            }
+            else if (t > 1.0f)
+            {
+                t = 1.0f;
+                s = Saturate((b - c) / a);
+            }
+        }
+
+        closest1 = _mm_add_ps(p1, Scale(d1, s));
+        closest2 = _mm_add_ps(p2, Scale(d2, t));
+        __m128 offset = _mm_sub_ps(closest2, closest1);
+        return Dot(offset, offset);
+    }
+
+    // Sutherland-Hodgman against the plane dot(normal, p) = offset, keeping the side below it
+    static int ClipPolygon(const __m128* in, const int count, const __m128 normal, const float offset, __m128* out)
+    {
+        int toReturn = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            __m128 from = in[i];
+            __m128 to = in[(i + 1) % count];
+            float fromDistance = Dot(normal, from) - offset;
+            float toDistance = Dot(normal, to) - offset;
+
+            if (fromDistance <= 0.0f)
+            {
+                out[toReturn++] = from;
+            }
+
+            if ((fromDistance < 0.0f && toDistance > 0.0f) || (fromDistance > 0.0f && toDistance < 0.0f))
+            {
+                out[toReturn++] = _mm_add_ps(from, Scale(_mm_sub_ps(to, from), fromDistance / (fromDistance - toDistance)));
+            }
+        }
+
+        return toReturn;
+    }
+
+    // Keeps the deepest point, the point furthest from it & the two spanning the most area on either side of that line
+    static void ReduceContacts(const __m128* points, const float* depths, const int count, const __m128 normal, ContactManifold& manifold)
+    {
+        if (count <= ContactManifold::MaxPoints)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                manifold.points[i].elementsSIMD = points[i];
+                manifold.depths[i] = depths[i];
+            }
+
+            manifold.count = count;
+            return;
+        }
+
+        int chosen[4] = { 0, 0, -1, -1 };
+        float furthest = -1.0f;
+        float most = 0.0f;
+        float least = 0.0f;
+
+        for (int i = 1; i < count; i++)
+        {
+            chosen[0] = (depths[i] > depths[chosen[0]]) ? i : chosen[0];
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            __m128 offset = _mm_sub_ps(points[i], points[chosen[0]]);
+            float distanceSqr = Dot(offset, offset);
+            chosen[1] = (distanceSqr > furthest) ? i : chosen[1];
+            furthest = (distanceSqr > furthest) ? distanceSqr : furthest;
+        }
+
+        __m128 line = _mm_sub_ps(points[chosen[1]], points[chosen[0]]);
+
+        for (int i = 0; i < count; i++)
+        {
+            float area = Dot(Cross(line, _mm_sub_ps(points[i], points[chosen[0]])), normal);
+            chosen[2] = (area > most) ? i : chosen[2];
+            most = (area > most) ? area : most;
+            chosen[3] = (area < least) ? i : chosen[3];
+            least = (area < least) ? area : least;
+        }
+
+        manifold.count = 0;
+
+        for (int c = 0; c < 4; c++)
+        {
+            if (chosen[c] >= 0 && (c != 1 || chosen[1] != chosen[0]))
+            {
+                manifold.points[manifold.count].elementsSIMD = points[chosen[c]];
+                manifold.depths[manifold.count++] = depths[chosen[c]];
+            }
+        }
+    }
+
+    // Clips the face of incident most opposed to normal against the side planes of face axis of reference, normal pointing from reference to incident
+    static void FaceContacts(const ConvexShape& reference, const ConvexShape& incident, const int axis, const __m128 normal, ContactManifold& manifold)
+    {
+        __m128 opposition = _mm_setr_ps(Dot(normal, incident.axes[0].elementsSIMD), Dot(normal, incident.axes[1].elementsSIMD), Dot(normal, incident.axes[2].elementsSIMD), 0.0f);
+        int incidentAxis = 0;
+        MaxLane(Abs(opposition), incidentAxis);
+
+        // The incident face points back against normal
+        float side = (Lane(opposition, incidentAxis) > 0.0f) ? -1.0f : 1.0f;
+        int u = (incidentAxis + 1) % 3;
+        int v = (incidentAxis + 2) % 3;
+        __m128 faceCenter = _mm_add_ps(incident.center.elementsSIMD, Scale(incident.axes[incidentAxis].elementsSIMD, side * incident.extents.elements[incidentAxis]));
+        __m128 edgeU = Scale(incident.axes[u].elementsSIMD, incident.extents.elements[u]);
+        __m128 edgeV = Scale(incident.axes[v].elementsSIMD, incident.extents.elements[v]);
+
+        __m128 polygon[8];
+        __m128 clipped[8];
+        polygon[0] = _mm_add_ps(faceCenter, _mm_add_ps(edgeU, edgeV));
+        polygon[1] = _mm_add_ps(faceCenter, _mm_sub_ps(edgeV, edgeU));
+        polygon[2] = _mm_sub_ps(faceCenter, _mm_add_ps(edgeU, edgeV));
+        polygon[3] = _mm_add_ps(faceCenter, _mm_sub_ps(edgeU, edgeV));
+        int count = 4;
+
+        for (int plane = 0; plane < 4 && count > 0; plane++)
+        {
+            int sideAxis = (axis + 1 + (plane >> 1)) % 3;
+            float sign = (plane & 1) ? -1.0f : 1.0f;
+            __m128 planeNormal = Scale(reference.axes[sideAxis].elementsSIMD, sign);
+            float offset = Dot(planeNormal, reference.center.elementsSIMD) + reference.extents.elements[sideAxis];
+            count = ClipPolygon(polygon, count, planeNormal, offset, clipped);
+
+            for (int i = 0; i < count; i++)
+            {
+                polygon[i] = clipped[i];
+            }
+        }
+
+        // Points behind the reference face are in contact, moved halfway back to it
+        float faceOffset = Dot(normal, reference.center.elementsSIMD) + reference.extents.elements[axis];
+        __m128 contacts[8];
+        float depths[8];
+        int contactCount = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            float depth = faceOffset - Dot(normal, polygon[i]);
+
+            if (depth >= 0.0f)
+            {
+                contacts[contactCount] = _mm_add_ps(polygon[i], Scale(normal, depth * 0.5f));
+                depths[contactCount++] = depth;
+            }
+        }
+
+        ReduceContacts(contacts, depths, contactCount, normal, manifold);
+    }
+
+    static void SegmentOf(const ConvexShape& shape, __m128& point1, __m128& point2)
+    {
+        __m128 half = Scale(shape.axes[1].elementsSIMD, (shape.type == ShapeType::Capsule) ? shape.extents.y : 0.0f);
+        point1 = _mm_sub_ps(shape.center.elementsSIMD, half);
+        point2 = _mm_add_ps(shape.center.elementsSIMD, half);
+    }
+
+    // Normal for rounded cores that meet within round off, any direction off the segments separates them by the sum of the radii.
+    // Crossing capsules take the common perpendicular, a capsule otherwise takes the fixed x axis, or y, with its own axis removed
+    static __m128 CoincidentNormal(const ConvexShape& shape1, const ConvexShape& shape2)
+    {
+        bool capsule1 = shape1.type == ShapeType::Capsule;
+        bool capsule2 = shape2.type == ShapeType::Capsule;
+        __m128 toReturn = _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+        if (capsule1 && capsule2)
+        {
+            __m128 across = Cross(shape1.axes[1].elementsSIMD, shape2.axes[1].elementsSIMD);
+            float acrossSqr = Dot(across, across);
+
+            if (acrossSqr > SATParallelEpsilon)
+            {
+                return Scale(across, 1.0f / sqrtf(acrossSqr));
+            }
+        }
+
+        if (capsule1 || capsule2)
+        {
+            __m128 axis = (capsule1 ? shape1 : shape2).axes[1].elementsSIMD;
+            toReturn = (fabsf(Lane(axis, 0)) < 0.9f) ? toReturn : _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+            toReturn = _mm_sub_ps(toReturn, Scale(axis, Dot(axis, toReturn)));
+            toReturn = Scale(toReturn, 1.0f / sqrtf(Dot(toReturn, toReturn)));
+        }
+
+        return toReturn;
+    }
+
+    float NarrowPhase::Distance(const ConvexShape& shape1, const ConvexShape& shape2, Vector3& point1, Vector3& point2)
+    {
+        GJKSimplex simplex;
+        __m128 closest;
+        bool overlap = GJK(shape1, shape2, true, simplex, closest);
+        SimplexPoints(simplex, point1.elementsSIMD, point2.elementsSIMD);
+        return overlap ? 0.0f : sqrtf(Dot(closest, closest));
+    }
+
+    bool NarrowPhase::Penetration(const ConvexShape& shape1, const ConvexShape& shape2, Vector3& normal, float& depth, Vector3& point1, Vector3& point2)
+    {
+        return FullPenetration(shape1, shape2, normal.elementsSIMD, depth, point1.elementsSIMD, point2.elementsSIMD);
+    }
+
+    bool NarrowPhase::BoxBox(const ConvexShape& box1, const ConvexShape& box2, ContactManifold& manifold)
+    {
+        manifold.count = 0;
+
+        // Rows of box2's rotation in box1's frame, row i lane j holding dot(box1 axis i, box2 axis j), built from transposes instead of 9 dot products
+        __m128 axes1X = box1.axes[0].elementsSIMD;
+        __m128 axes1Y = box1.axes[1].elementsSIMD;
+        __m128 axes1Z = box1.axes[2].elementsSIMD;
+        __m128 axes1W = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(axes1X, axes1Y, axes1Z, axes1W);
+        __m128 axes2X = box2.axes[0].elementsSIMD;
+        __m128 axes2Y = box2.axes[1].elementsSIMD;
+        __m128 axes2Z = box2.axes[2].elementsSIMD;
+        __m128 axes2W = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(axes2X, axes2Y, axes2Z, axes2W);
+
+        __m128 rows[3];
+        __m128 absRows[3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            __m128 axis = box1.axes[i].elementsSIMD;
+            rows[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Broadcast(axis, 0), axes2X), _mm_mul_ps(Broadcast(axis, 1), axes2Y)), _mm_mul_ps(Broadcast(axis, 2), axes2Z));
+            absRows[i] = _mm_add_ps(Abs(rows[i]), _mm_set1_ps(SATParallelEpsilon));
+        }
+
+        __m128 absColumn0 = absRows[0];
+        __m128 absColumn1 = absRows[1];
+        __m128 absColumn2 = absRows[2];
+        __m128 absColumn3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(absColumn0, absColumn1, absColumn2, absColumn3);
+
+        __m128 offset = ClearW(_mm_sub_ps(box2.center.elementsSIMD, box1.center.elementsSIMD));
+        __m128 offset1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Broadcast(offset, 0), axes1X), _mm_mul_ps(Broadcast(offset, 1), axes1Y)), _mm_mul_ps(Broadcast(offset, 2), axes1Z));
+        __m128 offset2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Broadcast(offset1, 0), rows[0]), _mm_mul_ps(Broadcast(offset1, 1), rows[1])), _mm_mul_ps(Broadcast(offset1, 2), rows[2]));
+        __m128 extents1 = box1.extents.elementsSIMD;
+        __m128 extents2 = box2.extents.elementsSIMD;
+
+        // Separation along the 3 face axes of each box, one axis per lane
+        __m128 reach2On1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Broadcast(extents2, 0), absColumn0), _mm_mul_ps(Broadcast(extents2, 1), absColumn1)), _mm_mul_ps(Broadcast(extents2, 2), absColumn2));
+        __m128 reach1On2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Broadcast(extents1, 0), absRows[0]), _mm_mul_ps(Broadcast(extents1, 1), absRows[1])), _mm_mul_ps(Broadcast(extents1, 2), absRows[2]));
+        __m128 faces1 = _mm_sub_ps(_mm_sub_ps(Abs(offset1), extents1), reach2On1);
+        __m128 faces2 = _mm_sub_ps(_mm_sub_ps(Abs(offset2), extents2), reach1On2);
+
+        // Separation along box1 axis i cross box2 axis j, lane j of edges[i].  Rotating the lanes lines up the other two box2 axes with each j
+        __m128 extents2Next = _mm_shuffle_ps(extents2, extents2, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 extents2Last = _mm_shuffle_ps(extents2, extents2, _MM_SHUFFLE(3, 1, 0, 2));
+        __m128 edges[3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            int next = (i + 1) % 3;
+            int last = (i + 2) % 3;
+            __m128 distance = Abs(_mm_sub_ps(_mm_mul_ps(Broadcast(offset1, last), rows[next]), _mm_mul_ps(Broadcast(offset1, next), rows[last])));
+            __m128 reach1 = _mm_add_ps(_mm_mul_ps(Broadcast(extents1, next), absRows[last]), _mm_mul_ps(Broadcast(extents1, last), absRows[next]));
+            __m128 reach2 = _mm_add_ps(_mm_mul_ps(extents2Next, _mm_shuffle_ps(absRows[i], absRows[i], _MM_SHUFFLE(3, 1, 0, 2))),
+                                       _mm_mul_ps(extents2Last, _mm_shuffle_ps(absRows[i], absRows[i], _MM_SHUFFLE(3, 0, 2, 1))));
+            edges[i] = _mm_sub_ps(_mm_sub_ps(distance, reach1), reach2);
+        }
+
+        __m128 separated = _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(faces1, _mm_setzero_ps()), _mm_cmpgt_ps(faces2, _mm_setzero_ps())),
+                                     _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(edges[0], _mm_setzero_ps()), _mm_cmpgt_ps(edges[1], _mm_setzero_ps())), _mm_cmpgt_ps(edges[2], _mm_setzero_ps())));
+
+        if (_mm_movemask_ps(separated) & 0x7)
+        {
+            return false;
+        }
+
+        // The shallowest axis is the contact normal.  Edge separations are scaled by 1 / |axis1 x axis2|, near parallel pairs are left to the face axes
+        int face1Axis = 0;
+        int face2Axis = 0;
+        float face1 = MaxLane(faces1, face1Axis);
+        float face2 = MaxLane(faces2, face2Axis);
+        float edge = -FLT_MAX;
+        int edgeAxis1 = 0;
+        int edgeAxis2 = 0;
+
+        for (int i = 0; i < 3; i++)
+        {
+            __m128 lengthSqr = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(rows[i], rows[i]));
+            __m128 valid = _mm_cmpgt_ps(lengthSqr, _mm_set1_ps(1e-6f));
+            __m128 normalized = _mm_blendv_ps(_mm_set1_ps(-FLT_MAX), _mm_div_ps(edges[i], _mm_sqrt_ps(_mm_max_ps(lengthSqr, _mm_set1_ps(1e-6f)))), valid);
+            int lane = 0;
+            float separation = MaxLane(normalized, lane);
+
+            if (separation > edge)
+            {
+                edge = separation;
+                edgeAxis1 = i;
+                edgeAxis2 = lane;
+            }
+        }
+
+        bool reference1 = face2 <= SATRelativeTolerance * face1;
+        float face = reference1 ? face1 : face2;
+
+        if (edge > SATRelativeTolerance * face)
+        {
+            // Edge against edge, one contact between the closest points of the two edges
+            __m128 axis1 = box1.axes[edgeAxis1].elementsSIMD;
+            __m128 axis2 = box2.axes[edgeAxis2].elementsSIMD;
+            __m128 normal = Cross(axis1, axis2);
+            normal = Scale(normal, ((Dot(normal, offset) < 0.0f) ? -1.0f : 1.0f) / sqrtf(Dot(normal, normal)));
+
+            __m128 edge1 = ClearW(_mm_or_ps(_mm_and_ps(ToLocal(box1, normal), _mm_set1_ps(-0.0f)), extents1));
+            __m128 edge2 = ClearW(_mm_or_ps(_mm_and_ps(ToLocal(box2, _mm_xor_ps(normal, _mm_set1_ps(-0.0f))), _mm_set1_ps(-0.0f)), extents2));
+            __m128 lanes = _mm_castsi128_ps(_mm_setr_epi32(0, 1, 2, 3));
+            __m128 point1 = ToWorld(box1, _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(lanes), _mm_set1_epi32(edgeAxis1))), edge1));
+            __m128 point2 = ToWorld(box2, _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(lanes), _mm_set1_epi32(edgeAxis2))), edge2));
+            __m128 closest1;
+            __m128 closest2;
+            float half1 = box1.extents.elements[edgeAxis1];
+            float half2 = box2.extents.elements[edgeAxis2];
+            ClosestOnSegments(_mm_sub_ps(point1, Scale(axis1, half1)), _mm_add_ps(point1, Scale(axis1, half1)),
+                              _mm_sub_ps(point2, Scale(axis2, half2)), _mm_add_ps(point2, Scale(axis2, half2)), closest1, closest2);
+
+            manifold.normal.elementsSIMD = normal;
+            manifold.points[0].elementsSIMD = _mm_mul_ps(_mm_add_ps(closest1, closest2), _mm_set1_ps(0.5f));
+            manifold.depths[0] = -edge;
+            manifold.count = 1;
+            return true;
+        }
+
+        // Face contact, normal from the reference box towards the incident box
+        const ConvexShape& reference = reference1 ? box1 : box2;
+        const ConvexShape& incident = reference1 ? box2 : box1;
+        int axis = reference1 ? face1Axis : face2Axis;
+        float towards = reference1 ? Lane(offset1, axis) : -Lane(offset2, axis);
+        __m128 normal = Scale(reference.axes[axis].elementsSIMD, (towards < 0.0f) ? -1.0f : 1.0f);
+
+        FaceContacts(reference, incident, axis, normal, manifold);
+        manifold.normal.elementsSIMD = reference1 ? normal : _mm_xor_ps(normal, _mm_set1_ps(-0.0f));
+        return manifold.count > 0;
+    }
+
+    bool NarrowPhase::Collide(const ConvexShape& shape1, const ConvexShape& shape2, ContactManifold& manifold)
+    {
+        manifold.count = 0;
+
+        if (shape1.type == ShapeType::Box && shape2.type == ShapeType::Box)
+        {
+            return BoxBox(shape1, shape2, manifold);
+        }
+
+        // Cores closer than the sum of the radii touch, the direction between them is the normal unless the cores overlap
+        float radii = shape1.radius + shape2.radius;
+        bool rounded1 = shape1.type == ShapeType::Sphere || shape1.type == ShapeType::Capsule;
+        bool rounded2 = shape2.type == ShapeType::Sphere || shape2.type == ShapeType::Capsule;
+        GJKSimplex simplex;
+        __m128 core1;
+        __m128 core2;
+        float distance;
+        bool coresOverlap;
+
+        if (rounded1 && rounded2)
+        {
+            __m128 start1, end1, start2, end2;
+            SegmentOf(shape1, start1, end1);
+            SegmentOf(shape2, start2, end2);
+            distance = sqrtf(ClosestOnSegments(start1, end1, start2, end2, core1, core2));
+            coresOverlap = false;
+        }
+        else
+        {
+            __m128 closest;
+            coresOverlap = GJK(shape1, shape2, true, simplex, closest);
+            SimplexPoints(simplex, core1, core2);
+            distance = coresOverlap ? 0.0f : sqrtf(Dot(closest, closest));
+        }
+
+        if (distance > radii)
+        {
+            return false;
+        }
+
+        __m128 normal;
+        __m128 surface1;
+        __m128 surface2;
+        float depth;
+
+        if ((rounded1 && rounded2) || (!coresOverlap && distance > EPATolerance * radii))
+        {
+            // Two spheres or capsules overlap by the radii less the segment distance however close their cores are, EPA over the
+            // full shapes would only approximate the rounded surfaces.  Below the tolerance the direction between the cores is round off
+            normal = (distance > EPATolerance * radii) ? Scale(_mm_sub_ps(core2, core1), 1.0f / distance) : CoincidentNormal(shape1, shape2);
+            depth = radii - distance;
+            surface1 = _mm_add_ps(core1, Scale(normal, shape1.radius));
+            surface2 = _mm_sub_ps(core2, Scale(normal, shape2.radius));
+        }
+        else if (coresOverlap && EPA(shape1, shape2, simplex, true, normal, depth, core1, core2))
+        {
+            // EPA over the cores converges on flat faces where the rounded shapes would take many steps, the radii then add to the depth
+            depth += radii;
+            surface1 = _mm_add_ps(core1, Scale(normal, shape1.radius));
+            surface2 = _mm_sub_ps(core2, Scale(normal, shape2.radius));
+        }
+        else if (!FullPenetration(shape1, shape2, normal, depth, surface1, surface2))
+        {
+            return false;
+        }
+
+        manifold.normal.elementsSIMD = ClearW(normal);
+        manifold.points[0].elementsSIMD = ClearW(_mm_mul_ps(_mm_add_ps(surface1, surface2), _mm_set1_ps(0.5f)));
+        manifold.depths[0] = depth;
+        manifold.count = 1;
+        return true;
+    }
+
+    void NarrowPhase::Collide(const ConvexShape* shapes, const unsigned int* pairs, const size_t pairCount, ContactManifold* manifolds)
+    {
+        ParallelFor(pairCount, NarrowPhaseGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                Collide(shapes[pairs[i * 2]], shapes[pairs[i * 2 + 1]], manifolds[i]);
+            }
+        });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,409 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    static const size_t NoiseGrain = 1 << 12;
+
+    // Large odd constants from xxHash & lowbias32 spread neighbouring cells across the whole 32 bit range
+    static const int HashPrimes[4] = { static_cast<int>(0x8DA6B343), static_cast<int>(0xD8163841), static_cast<int>(0xCB1AB31F), static_cast<int>(0x165667B1) };
+
+    template <int D>
+    static __m128i Hash(const __m128i* cell, const unsigned int seed)
+    {
+        __m128i hash = _mm_set1_epi32(static_cast<int>(seed));
+
+        for (int d = 0; d < D; d++)
+        {
+            hash = _mm_add_epi32(hash, _mm_mullo_epi32(cell[d], _mm_set1_epi32(HashPrimes[d])));
+        }
+
+        hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+        hash = _mm_mullo_epi32(hash, _mm_set1_epi32(0x7FEB352D));
+        hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 15));
+        hash = _mm_mullo_epi32(hash, _mm_set1_epi32(static_cast<int>(0x846CA68B)));
+        return _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+    }
+
+    // Lanes where bit is set in hash
+    static __m128 HasBit(const __m128i hash, const int bit)
+    {
+        __m128i mask = _mm_set1_epi32(bit);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(hash, mask), mask));
+    }
+
+    static __m128 NegateIf(const __m128 value, const __m128 mask)
+    {
+        return _mm_xor_ps(value, _mm_and_ps(mask, _mm_set1_ps(-0.0f)));
+    }
+
+    // Dot product of offset with the lattice gradient picked by hash
+    template <int D>
+    static __m128 Gradient(const __m128i hash, const __m128* offset);
+
+    template <>
+    __m128 Gradient<2>(const __m128i hash, const __m128* offset)
+    {
+        // 8 directions of length sqrt(2), the diagonals & the axes
+        __m128 diagonal = _mm_add_ps(NegateIf(offset[0], HasBit(hash, 1)), NegateIf(offset[1], HasBit(hash, 2)));
+        __m128 axis = NegateIf(_mm_mul_ps(_mm_blendv_ps(offset[0], offset[1], HasBit(hash, 2)), _mm_set1_ps(1.41421356f)), HasBit(hash, 1));
+        return _mm_blendv_ps(diagonal, axis, HasBit(hash, 4));
+    }
+
+    template <>
+    __m128 Gradient<3>(const __m128i hash, const __m128* offset)
+    {
+        // Perlin's 12 cube edge directions, 4 of them repeated to fill 16
+        __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+        __m128 u = _mm_blendv_ps(offset[1], offset[0], _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8))));
+        __m128 xz = _mm_blendv_ps(offset[2], offset[0], _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14)))));
+        __m128 v = _mm_blendv_ps(xz, offset[1], _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4))));
+        return _mm_add_ps(NegateIf(u, HasBit(hash, 1)), NegateIf(v, HasBit(hash, 2)));
+    }
+
+    template <>
+    __m128 Gradient<4>(const __m128i hash, const __m128* offset)
+    {
+        // 32 directions with one zero component & the other 3 at +-1
+        __m128i h = _mm_and_si128(hash, _mm_set1_epi32(31));
+        __m128 u = _mm_blendv_ps(offset[1], offset[0], _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(24))));
+        __m128 v = _mm_blendv_ps(offset[2], offset[1], _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(16))));
+        __m128 w = _mm_blendv_ps(offset[3], offset[2], _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8))));
+        return _mm_add_ps(_mm_add_ps(NegateIf(u, HasBit(hash, 1)), NegateIf(v, HasBit(hash, 2))), NegateIf(w, HasBit(hash, 4)));
+    }
+
+    template <int D>
+    static __m128 PerlinLattice(const __m128* point, const unsigned int seed)
+    {
+        // Scales the extremes of each dimension's sum to about [-1, 1]
+        static const float Scales[5] = { 0.0f, 0.0f, 1.0f, 0.9649f, 0.8344f };
+
+        __m128i cell[D];
+        __m128 fraction[D], fade[D];
+
+        for (int d = 0; d < D; d++)
+        {
+            __m128 floor = _mm_floor_ps(point[d]);
+            cell[d] = _mm_cvttps_epi32(floor);
+            fraction[d] = _mm_sub_ps(point[d], floor);
+
+            // 6t^5 - 15t^4 + 10t^3
+            __m128 t = fraction[d];
+            fade[d] = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f)));
+        }
+
+        __m128 corners[1 << D];
+
+        for (int corner = 0; corner < (1 << D); corner++)
+        {
+            __m128i cornerCell[D];
+            __m128 offset[D];
+
+            for (int d = 0; d < D; d++)
+            {
+                int bit = (corner >> d) & 1;
+                cornerCell[d] = _mm_add_epi32(cell[d], _mm_set1_epi32(bit));
+                offset[d] = _mm_sub_ps(fraction[d], _mm_set1_ps(static_cast<float>(bit)));
+            }
+
+            corners[corner] = Gradient<D>(Hash<D>(cornerCell, seed), offset);
+        }
+
+        // Corner bit d is dimension d, so each pass halves the corners by interpolating along the lowest remaining dimension
+        for (int d = 0, remaining = (1 << D); d < D; d++, remaining >>= 1)
+        {
+            for (int i = 0; i < remaining / 2; i++)
+            {
+                corners[i] = _mm_add_ps(corners[i * 2], _mm_mul_ps(fade[d], _mm_sub_ps(corners[i * 2 + 1], corners[i * 2])));
+            }
+        }
+
+        return _mm_mul_ps(corners[0], _mm_set1_ps(Scales[D]));
+    }
+
+    template <int D>
+    static __m128 SimplexLattice(const __m128* point, const unsigned int seed)
+    {
+        // Radius of each corner's kernel & the scale that brings the sum to about [-1, 1].  Gustavson's 0.6 in 3D & 4D reaches past the
+        // simplices sharing the corner & leaves seams, 0.5 keeps every kernel at zero on the far faces so the sum stays continuous
+        static const float Radii[5] = { 0.0f, 0.0f, 0.5f, 0.5f, 0.5f };
+        static const float Scales[5] = { 0.0f, 0.0f, 70.0f, 76.0f, 62.0f };
+
+        const float root = sqrtf(static_cast<float>(D + 1));
+        const float skew = (root - 1.0f) / D;
+        const float unskew = (1.0f - 1.0f / root) / D;
+
+        __m128 sum = _mm_setzero_ps();
+
+        for (int d = 0; d < D; d++)
+        {
+            sum = _mm_add_ps(sum, point[d]);
+        }
+
+        __m128 skewed = _mm_mul_ps(sum, _mm_set1_ps(skew));
+        __m128i cell[D];
+        __m128 cellSum = _mm_setzero_ps();
+        __m128 floors[D];
+
+        for (int d = 0; d < D; d++)
+        {
+            floors[d] = _mm_floor_ps(_mm_add_ps(point[d], skewed));
+            cell[d] = _mm_cvttps_epi32(floors[d]);
+            cellSum = _mm_add_ps(cellSum, floors[d]);
+        }
+
+        __m128 unskewed = _mm_mul_ps(cellSum, _mm_set1_ps(unskew));
+        __m128 origin[D];
+
+        for (int d = 0; d < D; d++)
+        {
+            origin[d] = _mm_add_ps(_mm_sub_ps(point[d], floors[d]), unskewed);
+        }
+
+        // Ranking the offsets finds the simplex, the largest steps first. Ties go to the later axis so every lane picks consistently
+        __m128i rank[D];
+
+        for (int d = 0; d < D; d++)
+        {
+            rank[d] = _mm_setzero_si128();
+        }
+
+        for (int a = 0; a < D; a++)
+        {
+            for (int b = a + 1; b < D; b++)
+            {
+                __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(origin[a], origin[b]));
+                rank[a] = _mm_sub_epi32(rank[a], greater);
+                rank[b] = _mm_sub_epi32(rank[b], _mm_xor_si128(greater, _mm_set1_epi32(-1)));
+            }
+        }
+
+        __m128 result = _mm_setzero_ps();
+
+        for (int corner = 0; corner <= D; corner++)
+        {
+            __m128i cornerCell[D];
+            __m128 offset[D];
+            __m128 falloff = _mm_set1_ps(Radii[D]);
+
+            for (int d = 0; d < D; d++)
+            {
+                // Corner c steps along the c axes with the highest rank
+                __m128i step = _mm_and_si128(_mm_cmpgt_epi32(rank[d], _mm_set1_epi32(D - corner - 1)), _mm_set1_epi32(1));
+                cornerCell[d] = _mm_add_epi32(cell[d], step);
+                offset[d] = _mm_add_ps(_mm_sub_ps(origin[d], _mm_cvtepi32_ps(step)), _mm_set1_ps(corner * unskew));
+                falloff = _mm_sub_ps(falloff, _mm_mul_ps(offset[d], offset[d]));
+            }
+
+            falloff = _mm_max_ps(falloff, _mm_setzero_ps());
+            falloff = _mm_mul_ps(falloff, falloff);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(falloff, falloff), Gradient<D>(Hash<D>(cornerCell, seed), offset)));
+        }
+
+        return _mm_mul_ps(result, _mm_set1_ps(Scales[D]));
+    }
+
+    template <int D>
+    static __m128 FractalSum(const __m128* point, const unsigned int seed, const FractalSettings& settings)
+    {
+        __m128 result = _mm_setzero_ps();
+        float frequency = settings.frequency;
+        float amplitude = 1.0f;
+        float total = 0.0f;
+
+        for (int octave = 0; octave < settings.octaves; octave++)
+        {
+            // Every octave gets its own seed so the lattice origins do not line up
+            unsigned int octaveSeed = seed + static_cast<unsigned int>(octave) * 0x9E3779B9u;
+            __m128 scaled[D];
+
+            for (int d = 0; d < D; d++)
+            {
+                scaled[d] = _mm_mul_ps(point[d], _mm_set1_ps(frequency));
+            }
+
+            __m128 value = (settings.type == NoiseType::Perlin) ? PerlinLattice<D>(scaled, octaveSeed) : SimplexLattice<D>(scaled, octaveSeed);
+
+            if (settings.ridged)
+            {
+                value = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(_mm_set1_ps(-0.0f), value));
+                value = _mm_mul_ps(value, value);
+            }
+
+            result = _mm_add_ps(result, _mm_mul_ps(value, _mm_set1_ps(amplitude)));
+            total += amplitude;
+            amplitude *= settings.gain;
+            frequency *= settings.lacunarity;
+        }
+
+        return (total > 0.0f) ? _mm_mul_ps(result, _mm_set1_ps(1.0f / total)) : result;
+    }
+
+    // Gathers 4 points, repeating the last in the tail group, & evaluates them as one SIMD batch
+    template <int D, typename Point>
+    static void EvaluatePoints(const Point* points, const size_t count, const unsigned int seed, const FractalSettings& settings, float* out)
+    {
+        ParallelFor((count + 3) / 4, NoiseGrain / 4, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                __m128 p[4] = { points[first].elementsSIMD, points[first + ((valid > 1) ? 1 : valid - 1)].elementsSIMD,
+                                points[first + ((valid > 2) ? 2 : valid - 1)].elementsSIMD, points[first + valid - 1].elementsSIMD };
+                _MM_TRANSPOSE4_PS(p[0], p[1], p[2], p[3]);
+
+                __declspec(align(16)) float lanes[4];
+                _mm_store_ps(lanes, FractalSum<D>(p, seed, settings));
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    out[first + i] = lanes[i];
+                }
+            }
+        });
+    }
+
+    // Evaluates one row of width samples stepping along x from start
+    template <int D>
+    static void EvaluateRow(__m128* start, const float stepX, const size_t width, const unsigned int seed, const FractalSettings& settings, float* out)
+    {
+        __m128 lane = _mm_mul_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_set1_ps(stepX));
+        __m128 originX = start[0];
+
+        for (size_t x = 0; x < width; x += 4)
+        {
+            start[0] = _mm_add_ps(_mm_add_ps(originX, _mm_set1_ps(static_cast<float>(x) * stepX)), lane);
+            __m128 values = FractalSum<D>(start, seed, settings);
+
+            if (x + 4 <= width)
+            {
+                _mm_storeu_ps(out + x, values);
+                continue;
+            }
+
+            __declspec(align(16)) float lanes[4];
+            _mm_store_ps(lanes, values);
+
+            for (size_t i = 0; x + i < width; i++)
+            {
+                out[x + i] = lanes[i];
+            }
+        }
+    }
+
+    FractalSettings::FractalSettings() : type(NoiseType::Simplex), octaves(1), frequency(1.0f), lacunarity(2.0f), gain(0.5f), ridged(false)
+    {
+    }
+
+    Noise::Noise() : seed(0)
+    {
+    }
+
+    Noise::Noise(const unsigned int _seed) : seed(_seed)
+    {
+    }
+
+    __m128 Noise::Perlin(const __m128 x, const __m128 y) const
+    {
+        __m128 point[2] = { x, y };
+        return PerlinLattice<2>(point, seed);
+    }
+
+    __m128 Noise::Perlin(const __m128 x, const __m128 y, const __m128 z) const
+    {
+        __m128 point[3] = { x, y, z };
+        return PerlinLattice<3>(point, seed);
+    }
+
+    __m128 Noise::Perlin(const __m128 x, const __m128 y, const __m128 z, const __m128 w) const
+    {
+        __m128 point[4] = { x, y, z, w };
+        return PerlinLattice<4>(point, seed);
+    }
+
+    __m128 Noise::Simplex(const __m128 x, const __m128 y) const
+    {
+        __m128 point[2] = { x, y };
+        return SimplexLattice<2>(point, seed);
+    }
+
+    __m128 Noise::Simplex(const __m128 x, const __m128 y, const __m128 z) const
+    {
+        __m128 point[3] = { x, y, z };
+        return SimplexLattice<3>(point, seed);
+    }
+
+    __m128 Noise::Simplex(const __m128 x, const __m128 y, const __m128 z, const __m128 w) const
+    {
+        __m128 point[4] = { x, y, z, w };
+        return SimplexLattice<4>(point, seed);
+    }
+
+    __m128 Noise::Fractal(const __m128 x, const __m128 y, const FractalSettings& settings) const
+    {
+        __m128 point[2] = { x, y };
+        return FractalSum<2>(point, seed, settings);
+    }
+
+    __m128 Noise::Fractal(const __m128 x, const __m128 y, const __m128 z, const FractalSettings& settings) const
+    {
+        __m128 point[3] = { x, y, z };
+        return FractalSum<3>(point, seed, settings);
+    }
+
+    __m128 Noise::Fractal(const __m128 x, const __m128 y, const __m128 z, const __m128 w, const FractalSettings& settings) const
+    {
+        __m128 point[4] = { x, y, z, w };
+        return FractalSum<4>(point, seed, settings);
+    }
+
+    void Noise::Evaluate(const Vector2* points, const size_t count, const FractalSettings& settings, float* out) const
+    {
+        EvaluatePoints<2>(points, count, seed, settings, out);
+    }
+
+    void Noise::Evaluate(const Vector3* points, const size_t count, const FractalSettings& settings, float* out) const
+    {
+        EvaluatePoints<3>(points, count, seed, settings, out);
+    }
+
+    void Noise::Evaluate(const Vector4* points, const size_t count, const FractalSettings& settings, float* out) const
+    {
+        EvaluatePoints<4>(points, count, seed, settings, out);
+    }
+
+    void Noise::Grid(const Vector2& origin, const Vector2& step, const size_t width, const size_t height, const FractalSettings& settings, float* out) const
+    {
+        size_t grain = (width < NoiseGrain) ? NoiseGrain / ((width > 0) ? width : 1) : 1;
+
+        ParallelFor(height, grain, [&](size_t begin, size_t end)
+        {
+            for (size_t row = begin; row < end; row++)
+            {
+                __m128 start[2] = { _mm_set1_ps(origin.x), _mm_set1_ps(origin.y + static_cast<float>(row) * step.y) };
+                EvaluateRow<2>(start, step.x, width, seed, settings, out + row * width);
+            }
+        });
+    }
+
+    void Noise::Grid(const Vector3& origin, const Vector3& step, const size_t width, const size_t height, const size_t depth, const FractalSettings& settings, float* out) const
+    {
+        size_t grain = (width < NoiseGrain) ? NoiseGrain / ((width > 0) ? width : 1) : 1;
+
+        ParallelFor(height * depth, grain, [&](size_t begin, size_t end)
+        {
+            for (size_t row = begin; row < end; row++)
+            {
+                __m128 start[3] = { _mm_set1_ps(origin.x), _mm_set1_ps(origin.y + static_cast<float>(row % height) * step.y),
+                                    _mm_set1_ps(origin.z + static_cast<float>(row / height) * step.z) };
+                EvaluateRow<3>(start, step.x, width, seed, settings, out + row * width);
+            }
+        });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,366 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+#include <float.h>
+#include <thread>
+
+namespace NullX
+{
+    static const size_t OcclusionChunkSize = 1 << 12;
+
+    // Clip space position of point from the columns of the view projection matrix
+    static __m128 ToClip(const __m128 point, const __m128 cols[4])
+    {
+        __m128 clip = _mm_mul_ps(cols[0], _mm_shuffle_ps(point, point, _MM_SHUFFLE(0, 0, 0, 0)));
+        clip = _mm_add_ps(clip, _mm_mul_ps(cols[1], _mm_shuffle_ps(point, point, _MM_SHUFFLE(1, 1, 1, 1))));
+        clip = _mm_add_ps(clip, _mm_mul_ps(cols[2], _mm_shuffle_ps(point, point, _MM_SHUFFLE(2, 2, 2, 2))));
+        return _mm_add_ps(clip, cols[3]);
+    }
+
+    static void Columns(const Matrix4& mat, __m128 cols[4])
+    {
+        cols[0] = mat.rowsSIMD[0];
+        cols[1] = mat.rowsSIMD[1];
+        cols[2] = mat.rowsSIMD[2];
+        cols[3] = mat.rowsSIMD[3];
+        _MM_TRANSPOSE4_PS(cols[0], cols[1], cols[2], cols[3]);
+    }
+
+    // Screen x & y with y down, normalized device depth in z.  False if the point is behind the near plane
+    static bool ToScreen(const __m128 clip, const __m128 viewport, Vector4& screen)
+    {
+        screen.elementsSIMD = clip;
+
+        if (!(screen.w > 0.0f && screen.z >= -screen.w))
+        {
+            return false;
+        }
+
+        __m128 ndc = _mm_div_ps(clip, _mm_shuffle_ps(clip, clip, _MM_SHUFFLE(3, 3, 3, 3)));
+        __m128 half = _mm_setr_ps(0.5f, -0.5f, 1.0f, 1.0f);
+        __m128 offset = _mm_setr_ps(0.5f, 0.5f, 0.0f, 0.0f);
+        screen.elementsSIMD = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ndc, half), offset), viewport);
+        return true;
+    }
+
+    OcclusionBuffer::OcclusionBuffer() : binChunks(0), width(0), height(0), stride(0), tilesX(0), tilesY(0)
+    {
+    }
+
+    OcclusionBuffer::OcclusionBuffer(const int _width, const int _height) : binChunks(0)
+    {
+        Resize(_width, _height);
+    }
+
+    void OcclusionBuffer::Resize(const int _width, const int _height)
+    {
+        width = _width;
+        height = _height;
+        tilesX = (width + TileWidth - 1) / TileWidth;
+        tilesY = (height + TileHeight - 1) / TileHeight;
+        stride = tilesX * TileWidth;
+        depth.resize(static_cast<size_t>(stride) * tilesY * TileHeight);
+        tileMax.resize(static_cast<size_t>(tilesX) * tilesY);
+        Clear(Matrix4::Identity);
+    }
+
+    void OcclusionBuffer::Clear(const Matrix4& _viewProjection)
+    {
+        viewProjection = _viewProjection;
+        std::fill(depth.begin(), depth.end(), FLT_MAX);
+        std::fill(tileMax.begin(), tileMax.end(), FLT_MAX);
+    }
+
+    void OcclusionBuffer::RenderOccluders(const Vector3* vertices, const size_t triangleCount)
+    {
+        static const size_t threads = std::thread::hardware_concurrency();
+        size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+        size_t chunks = (triangleCount + OcclusionChunkSize - 1) / OcclusionChunkSize;
+        chunks = (chunks < threads) ? chunks : threads;
+        chunks = (chunks > 0) ? chunks : 1;
+        size_t chunkSize = (triangleCount + chunks - 1) / chunks;
+
+        binChunks = chunks;
+        bins.resize(chunks * tileCount);
+        setups.resize(triangleCount);
+
+        for (size_t i = 0; i < bins.size(); i++)
+        {
+            bins[i].clear();
+        }
+
+        __m128 cols[4];
+        Columns(viewProjection, cols);
+        __m128 viewport = _mm_setr_ps(static_cast<float>(width), static_cast<float>(height), 1.0f, 1.0f);
+
+        // Project & set up every triangle, binning it into each tile its bounds touch
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                size_t end = (chunk * chunkSize + chunkSize < triangleCount) ? chunk * chunkSize + chunkSize : triangleCount;
+
+                for (size_t t = chunk * chunkSize; t < end; t++)
+                {
+                    Vector4 v[3];
+
+                    if (!ToScreen(ToClip(vertices[t * 3].elementsSIMD, cols), viewport, v[0]) ||
+                        !ToScreen(ToClip(vertices[t * 3 + 1].elementsSIMD, cols), viewport, v[1]) ||
+                        !ToScreen(ToClip(vertices[t * 3 + 2].elementsSIMD, cols), viewport, v[2]))
+                    {
+                        continue;
+                    }
+
+                    // Twice the signed area, both windings are drawn by flipping the edges of one
+                    float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[1].y - v[0].y) * (v[2].x - v[0].x);
+
+                    if (fabsf(area) < 1e-8f)
+                    {
+                        continue;
+                    }
+
+                    TriangleSetup& setup = setups[t];
+                    float sign = (area > 0.0f) ? 1.0f : -1.0f;
+
+                    for (int e = 0; e < 3; e++)
+                    {
+                        const Vector4& a = v[e];
+                        const Vector4& b = v[(e + 1) % 3];
+                        setup.edgeA[e] = (a.y - b.y) * sign;
+                        setup.edgeB[e] = (b.x - a.x) * sign;
+                        setup.edgeC[e] = -(setup.edgeA[e] * a.x + setup.edgeB[e] * a.y);
+                    }
+
+                    setup.depthDx = ((v[1].z - v[0].z) * (v[2].y - v[0].y) - (v[2].z - v[0].z) * (v[1].y - v[0].y)) / area;
+                    setup.depthDy = ((v[2].z - v[0].z) * (v[1].x - v[0].x) - (v[1].z - v[0].z) * (v[2].x - v[0].x)) / area;
+                    setup.depth0 = v[0].z - setup.depthDx * v[0].x - setup.depthDy * v[0].y;
+
+                    float minX = fminf(v[0].x, fminf(v[1].x, v[2].x)), maxX = fmaxf(v[0].x, fmaxf(v[1].x, v[2].x));
+                    float minY = fminf(v[0].y, fminf(v[1].y, v[2].y)), maxY = fmaxf(v[0].y, fmaxf(v[1].y, v[2].y));
+
+                    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+                    {
+                        continue;
+                    }
+
+                    setup.minX = static_cast<int>(fmaxf(minX, 0.0f));
+                    setup.minY = static_cast<int>(fmaxf(minY, 0.0f));
+                    setup.maxX = static_cast<int>(fminf(maxX, static_cast<float>(width - 1)));
+                    setup.maxY = static_cast<int>(fminf(maxY, static_cast<float>(height - 1)));
+
+                    for (int ty = setup.minY / TileHeight; ty <= setup.maxY / TileHeight; ty++)
+                    {
+                        for (int tx = setup.minX / TileWidth; tx <= setup.maxX / TileWidth; tx++)
+                        {
+                            bins[chunk * tileCount + ty * tilesX + tx].push_back(static_cast<unsigned int>(t));
+                        }
+                    }
+                }
+            }
+        });
+
+        ParallelFor(tileCount, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t tile = begin; tile < end; tile++)
+            {
+                RasterizeTile(static_cast<int>(tile));
+            }
+        });
+    }
+
+    void OcclusionBuffer::RasterizeTile(const int tile)
+    {
+        size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+        int tileX = (tile % tilesX) * TileWidth;
+        int tileY = (tile / tilesX) * TileHeight;
+        bool touched = false;
+
+        for (size_t chunk = 0; chunk < binChunks; chunk++)
+        {
+            const std::vector<unsigned int>& bin = bins[chunk * tileCount + tile];
+
+            for (size_t i = 0; i < bin.size(); i++)
+            {
+                const TriangleSetup& setup = setups[bin[i]];
+                int x0 = std::max(setup.minX, tileX) & ~3;
+                int x1 = std::min(setup.maxX, tileX + TileWidth - 1);
+                int y0 = std::max(setup.minY, tileY);
+                int y1 = std::min(setup.maxY, tileY + TileHeight - 1);
+                touched = true;
+
+                // Edge & depth values step across 4 pixel centres per register
+                __m128 centres = _mm_add_ps(_mm_set1_ps(static_cast<float>(x0)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                __m128 stepX[3], rowStart[3];
+                __m128 depthStep = _mm_set1_ps(setup.depthDx * 4.0f);
+
+                for (int e = 0; e < 3; e++)
+                {
+                    stepX[e] = _mm_set1_ps(setup.edgeA[e] * 4.0f);
+                    rowStart[e] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.edgeA[e]), centres), _mm_set1_ps(setup.edgeB[e] * (y0 + 0.5f) + setup.edgeC[e]));
+                }
+
+                __m128 depthStart = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.depthDx), centres), _mm_set1_ps(setup.depthDy * (y0 + 0.5f) + setup.depth0));
+
+                for (int y = y0; y <= y1; y++)
+                {
+                    __m128 e0 = rowStart[0], e1 = rowStart[1], e2 = rowStart[2];
+                    __m128 z = depthStart;
+                    float* row = &depth[static_cast<size_t>(y) * stride];
+
+                    for (int x = x0; x <= x1; x += 4)
+                    {
+                        __m128 inside = _mm_cmpge_ps(_mm_min_ps(e0, _mm_min_ps(e1, e2)), _mm_setzero_ps());
+
+                        if (_mm_movemask_ps(inside) != 0)
+                        {
+                            __m128 current = _mm_loadu_ps(row + x);
+                            _mm_storeu_ps(row + x, _mm_blendv_ps(current, _mm_min_ps(current, z), inside));
+                        }
+
+                        e0 = _mm_add_ps(e0, stepX[0]);
+                        e1 = _mm_add_ps(e1, stepX[1]);
+                        e2 = _mm_add_ps(e2, stepX[2]);
+                        z = _mm_add_ps(z, depthStep);
+                    }
+
+                    rowStart[0] = _mm_add_ps(rowStart[0], _mm_set1_ps(setup.edgeB[0]));
+                    rowStart[1] = _mm_add_ps(rowStart[1], _mm_set1_ps(setup.edgeB[1]));
+                    rowStart[2] = _mm_add_ps(rowStart[2], _mm_set1_ps(setup.edgeB[2]));
+                    depthStart = _mm_add_ps(depthStart, _mm_set1_ps(setup.depthDy));
+                }
+            }
+        }
+
+        if (!touched)
+        {
+            return;
+        }
+
+        // Pixels past the right & bottom edges stay at FLT_MAX, so only the visible part counts toward the maximum.
+        // The tile sizes are compared by value, std::min would bind them by reference & need an out of class definition
+        __m128 farthest = _mm_set1_ps(-FLT_MAX);
+        int rows = (height - tileY < TileHeight) ? height - tileY : TileHeight;
+        int cols = (width - tileX < TileWidth) ? width - tileX : TileWidth;
+
+        for (int y = 0; y < rows; y++)
+        {
+            const float* row = &depth[static_cast<size_t>(tileY + y) * stride + tileX];
+
+            for (int x = 0; x < cols; x += 4)
+            {
+                __m128 values = _mm_loadu_ps(row + x);
+                __m128 valid = _mm_cmplt_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_set1_ps(static_cast<float>(cols - x)));
+                farthest = _mm_max_ps(farthest, _mm_blendv_ps(_mm_set1_ps(-FLT_MAX), values, valid));
+            }
+        }
+
+        farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+        farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+        tileMax[tile] = _mm_cvtss_f32(farthest);
+    }
+
+    bool OcclusionBuffer::IsVisible(const AABB& box) const
+    {
+        __m128 cols[4];
+        Columns(viewProjection, cols);
+        __m128 viewport = _mm_setr_ps(static_cast<float>(width), static_cast<float>(height), 1.0f, 1.0f);
+        __m128 minScreen = _mm_set1_ps(FLT_MAX);
+        __m128 maxScreen = _mm_set1_ps(-FLT_MAX);
+
+        // Any corner behind the near plane means the box surrounds the camera
+        for (int corner = 0; corner < 8; corner++)
+        {
+            __m128 point = _mm_blendv_ps(box.min.elementsSIMD, box.max.elementsSIMD,
+                                         _mm_castsi128_ps(_mm_setr_epi32((corner & 1) ? -1 : 0, (corner & 2) ? -1 : 0, (corner & 4) ? -1 : 0, 0)));
+            Vector4 screen;
+
+            if (!ToScreen(ToClip(point, cols), viewport, screen))
+            {
+                return true;
+            }
+
+            minScreen = _mm_min_ps(minScreen, screen.elementsSIMD);
+            maxScreen = _mm_max_ps(maxScreen, screen.elementsSIMD);
+        }
+
+        Vector4 low = Vector4(), high = Vector4();
+        low.elementsSIMD = minScreen;
+        high.elementsSIMD = maxScreen;
+
+        if (high.x < 0.0f || high.y < 0.0f || low.x >= width || low.y >= height)
+        {
+            return false;
+        }
+
+        int x0 = static_cast<int>(fmaxf(low.x, 0.0f));
+        int y0 = static_cast<int>(fmaxf(low.y, 0.0f));
+        int x1 = static_cast<int>(fminf(high.x, static_cast<float>(width - 1)));
+        int y1 = static_cast<int>(fminf(high.y, static_cast<float>(height - 1)));
+        __m128 nearest = _mm_set1_ps(low.z);
+
+        for (int ty = y0 / TileHeight; ty <= y1 / TileHeight; ty++)
+        {
+            for (int tx = x0 / TileWidth; tx <= x1 / TileWidth; tx++)
+            {
+                // Every occluder in the tile is in front of the box
+                if (tileMax[ty * tilesX + tx] < low.z)
+                {
+                    continue;
+                }
+
+                int rowStart = std::max(y0, ty * TileHeight), rowEnd = std::min(y1, ty * TileHeight + TileHeight - 1);
+                int colStart = std::max(x0, tx * TileWidth), colEnd = std::min(x1, tx * TileWidth + TileWidth - 1);
+
+                for (int y = rowStart; y <= rowEnd; y++)
+                {
+                    const float* row = &depth[static_cast<size_t>(y) * stride];
+
+                    for (int x = colStart & ~3; x <= colEnd; x += 4)
+                    {
+                        __m128 lane = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+                        __m128 covered = _mm_and_ps(_mm_cmpge_ps(lane, _mm_set1_ps(static_cast<float>(colStart))),
+                                                    _mm_cmple_ps(lane, _mm_set1_ps(static_cast<float>(colEnd))));
+
+                        if (_mm_movemask_ps(_mm_and_ps(covered, _mm_cmpge_ps(_mm_loadu_ps(row + x), nearest))) != 0)
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void OcclusionBuffer::TestOccludees(const AABB* boxes, unsigned char* visible, const size_t count) const
+    {
+        ParallelFor(count, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                visible[i] = IsVisible(boxes[i]) ? 1 : 0;
+            }
+        });
+    }
+
+    int OcclusionBuffer::Width() const
+    {
+        return width;
+    }
+
+    int OcclusionBuffer::Height() const
+    {
+        return height;
+    }
+
+    const float* OcclusionBuffer::Depth() const
+    {
+        return depth.data();
+    }
+}
\ No newline at end of file
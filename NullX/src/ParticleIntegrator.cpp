@@ -0,0 +1,258 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    static const size_t ParticleGrain = 1024;
+
+    enum class Integration
+    {
+        Euler,
+        SemiImplicitEuler,
+        Verlet
+    };
+
+    // The operations Integrate needs at one register width.  The AVX2 lanes fuse every multiply add, which rounds once instead of twice
+    template <int Bits>
+    struct ParticleLanes;
+
+    template <>
+    struct ParticleLanes<128>
+    {
+        typedef __m128 Reg;
+        static const size_t Width = 4;
+
+        static Reg Zero()                                      { return _mm_setzero_ps(); }
+        static Reg Set(const float num)                        { return _mm_set1_ps(num); }
+        static Reg Load(const float* src)                      { return _mm_loadu_ps(src); }
+        static void Store(float* dst, const Reg r)             { _mm_storeu_ps(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm_add_ps(a, b); }
+        static Reg Sub(const Reg a, const Reg b)               { return _mm_sub_ps(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm_mul_ps(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Reg And(const Reg a, const Reg b)               { return _mm_and_ps(a, b); }
+        static Reg Less(const Reg a, const Reg b)              { return _mm_cmplt_ps(a, b); }
+    };
+
+    template <>
+    struct ParticleLanes<256>
+    {
+        typedef __m256 Reg;
+        static const size_t Width = 8;
+
+        static Reg Zero()                                      { return _mm256_setzero_ps(); }
+        static Reg Set(const float num)                        { return _mm256_set1_ps(num); }
+        static Reg Load(const float* src)                      { return _mm256_loadu_ps(src); }
+        static void Store(float* dst, const Reg r)             { _mm256_storeu_ps(dst, r); }
+        static Reg Add(const Reg a, const Reg b)               { return _mm256_add_ps(a, b); }
+        static Reg Sub(const Reg a, const Reg b)               { return _mm256_sub_ps(a, b); }
+        static Reg Mul(const Reg a, const Reg b)               { return _mm256_mul_ps(a, b); }
+        static Reg MulAdd(const Reg a, const Reg b, const Reg c) { return _mm256_fmadd_ps(a, b, c); }
+        static Reg And(const Reg a, const Reg b)               { return _mm256_and_ps(a, b); }
+        static Reg Less(const Reg a, const Reg b)              { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    };
+
+    // Full groups read straight from the stream, the tail group is padded with zeros
+    template <typename L>
+    static typename L::Reg LoadLanes(const float* stream, const size_t first, const size_t valid)
+    {
+        if (stream == nullptr)
+        {
+            return L::Zero();
+        }
+
+        if (valid == L::Width)
+        {
+            return L::Load(stream + first);
+        }
+
+        float lanes[L::Width] = {};
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            lanes[i] = stream[first + i];
+        }
+
+        return L::Load(lanes);
+    }
+
+    template <typename L>
+    static void StoreLanes(float* stream, const size_t first, const size_t valid, const typename L::Reg values)
+    {
+        if (valid == L::Width)
+        {
+            L::Store(stream + first, values);
+            return;
+        }
+
+        float lanes[L::Width];
+        L::Store(lanes, values);
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            stream[first + i] = lanes[i];
+        }
+    }
+
+    template <Integration Scheme, typename L>
+    static void Integrate(const ParticleStreams& streams, const float dt, const ParticleSettings& settings)
+    {
+        // Damping is applied as a linear falloff per step, clamped so a long step never reverses velocity
+        float keep = 1.0f - settings.damping * dt;
+        keep = (keep > 0.0f) ? keep : 0.0f;
+
+        typename L::Reg step = L::Set(dt);
+        typename L::Reg stepSqr = L::Set(dt * dt);
+        typename L::Reg invStep = L::Set((dt != 0.0f) ? 1.0f / dt : 0.0f);
+        typename L::Reg retain = L::Set(keep);
+        typename L::Reg gravityX = L::Set(settings.gravity.x);
+        typename L::Reg gravityY = L::Set(settings.gravity.y);
+        typename L::Reg gravityZ = L::Set(settings.gravity.z);
+        typename L::Reg normalX = L::Set(settings.plane.x);
+        typename L::Reg normalY = L::Set(settings.plane.y);
+        typename L::Reg normalZ = L::Set(settings.plane.z);
+        typename L::Reg distance = L::Set(settings.plane.w);
+        typename L::Reg bounce = L::Set(1.0f + settings.restitution);
+        bool writeVelocity = streams.velocityX != nullptr;
+
+        ParallelFor((streams.count + L::Width - 1) / L::Width, ParticleGrain / L::Width, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * L::Width;
+                size_t valid = (streams.count - first < L::Width) ? streams.count - first : L::Width;
+
+                typename L::Reg px = LoadLanes<L>(streams.positionX, first, valid);
+                typename L::Reg py = LoadLanes<L>(streams.positionY, first, valid);
+                typename L::Reg pz = LoadLanes<L>(streams.positionZ, first, valid);
+                typename L::Reg ax = L::Add(LoadLanes<L>(streams.accelerationX, first, valid), gravityX);
+                typename L::Reg ay = L::Add(LoadLanes<L>(streams.accelerationY, first, valid), gravityY);
+                typename L::Reg az = L::Add(LoadLanes<L>(streams.accelerationZ, first, valid), gravityZ);
+                typename L::Reg vx, vy, vz;
+
+                if (Scheme == Integration::Verlet)
+                {
+                    // x' = x + (x - previous) * retain + a * dt^2, the velocity here is per step rather than per second
+                    typename L::Reg ox = LoadLanes<L>(streams.previousX, first, valid);
+                    typename L::Reg oy = LoadLanes<L>(streams.previousY, first, valid);
+                    typename L::Reg oz = LoadLanes<L>(streams.previousZ, first, valid);
+                    vx = L::MulAdd(L::Sub(px, ox), retain, L::Mul(ax, stepSqr));
+                    vy = L::MulAdd(L::Sub(py, oy), retain, L::Mul(ay, stepSqr));
+                    vz = L::MulAdd(L::Sub(pz, oz), retain, L::Mul(az, stepSqr));
+                    px = L::Add(px, vx);
+                    py = L::Add(py, vy);
+                    pz = L::Add(pz, vz);
+                }
+                else
+                {
+                    vx = LoadLanes<L>(streams.velocityX, first, valid);
+                    vy = LoadLanes<L>(streams.velocityY, first, valid);
+                    vz = LoadLanes<L>(streams.velocityZ, first, valid);
+
+                    if (Scheme == Integration::Euler)
+                    {
+                        px = L::MulAdd(vx, step, px);
+                        py = L::MulAdd(vy, step, py);
+                        pz = L::MulAdd(vz, step, pz);
+                    }
+
+                    vx = L::Mul(L::MulAdd(ax, step, vx), retain);
+                    vy = L::Mul(L::MulAdd(ay, step, vy), retain);
+                    vz = L::Mul(L::MulAdd(az, step, vz), retain);
+
+                    if (Scheme == Integration::SemiImplicitEuler)
+                    {
+                        px = L::MulAdd(vx, step, px);
+                        py = L::MulAdd(vy, step, py);
+                        pz = L::MulAdd(vz, step, pz);
+                    }
+                }
+
+                if (settings.clampToPlane)
+                {
+                    // Push penetrating particles back onto the plane & reflect the part of their velocity heading into it
+                    typename L::Reg depth = L::MulAdd(normalX, px, L::MulAdd(normalY, py, L::MulAdd(normalZ, pz, distance)));
+                    typename L::Reg inside = L::Less(depth, L::Zero());
+                    depth = L::And(depth, inside);
+                    px = L::Sub(px, L::Mul(normalX, depth));
+                    py = L::Sub(py, L::Mul(normalY, depth));
+                    pz = L::Sub(pz, L::Mul(normalZ, depth));
+
+                    typename L::Reg approach = L::MulAdd(normalX, vx, L::MulAdd(normalY, vy, L::Mul(normalZ, vz)));
+                    approach = L::And(L::Mul(approach, bounce), L::And(inside, L::Less(approach, L::Zero())));
+                    vx = L::Sub(vx, L::Mul(normalX, approach));
+                    vy = L::Sub(vy, L::Mul(normalY, approach));
+                    vz = L::Sub(vz, L::Mul(normalZ, approach));
+                }
+
+                if (Scheme == Integration::Verlet)
+                {
+                    // Previous is rebuilt from the clamped position so a reflection carries into the next step
+                    StoreLanes<L>(streams.previousX, first, valid, L::Sub(px, vx));
+                    StoreLanes<L>(streams.previousY, first, valid, L::Sub(py, vy));
+                    StoreLanes<L>(streams.previousZ, first, valid, L::Sub(pz, vz));
+                    vx = L::Mul(vx, invStep);
+                    vy = L::Mul(vy, invStep);
+                    vz = L::Mul(vz, invStep);
+                }
+
+                StoreLanes<L>(streams.positionX, first, valid, px);
+                StoreLanes<L>(streams.positionY, first, valid, py);
+                StoreLanes<L>(streams.positionZ, first, valid, pz);
+
+                if (writeVelocity)
+                {
+                    StoreLanes<L>(streams.velocityX, first, valid, vx);
+                    StoreLanes<L>(streams.velocityY, first, valid, vy);
+                    StoreLanes<L>(streams.velocityZ, first, valid, vz);
+                }
+            }
+        });
+    }
+
+    // The widest kernel the CPU runs, clearing the upper halves afterwards so following SSE code pays no transition penalty
+    template <Integration Scheme>
+    static void Dispatch(const ParticleStreams& streams, const float dt, const ParticleSettings& settings)
+    {
+        if (HasAVX2())
+        {
+            Integrate<Scheme, ParticleLanes<256>>(streams, dt, settings);
+            _mm256_zeroupper();
+        }
+        else
+        {
+            Integrate<Scheme, ParticleLanes<128>>(streams, dt, settings);
+        }
+    }
+
+    ParticleStreams::ParticleStreams() : positionX(nullptr), positionY(nullptr), positionZ(nullptr),
+                                         velocityX(nullptr), velocityY(nullptr), velocityZ(nullptr),
+                                         accelerationX(nullptr), accelerationY(nullptr), accelerationZ(nullptr),
+                                         previousX(nullptr), previousY(nullptr), previousZ(nullptr), count(0)
+    {
+    }
+
+    ParticleSettings::ParticleSettings() : gravity(Vector3()), plane(Vector4(0.0f, 1.0f, 0.0f, 0.0f)), damping(0.0f), restitution(0.0f), clampToPlane(false)
+    {
+    }
+
+    void ParticleIntegrator::Euler(const ParticleStreams& streams, const float dt, const ParticleSettings& settings)
+    {
+        Dispatch<Integration::Euler>(streams, dt, settings);
+    }
+
+    void ParticleIntegrator::SemiImplicitEuler(const ParticleStreams& streams, const float dt, const ParticleSettings& settings)
+    {
+        Dispatch<Integration::SemiImplicitEuler>(streams, dt, settings);
+    }
+
+    void ParticleIntegrator::Verlet(const ParticleStreams& streams, const float dt, const ParticleSettings& settings)
+    {
+        Dispatch<Integration::Verlet>(streams, dt, settings);
+    }
+}
\ No newline at end of file
@@ -8,6 +8,41 @@
 
 namespace NullX
 {
+    // Full groups read straight from the stream, the tail group is padded with the identity value
+    static __m128 LoadStream(const float* stream, const size_t first, const size_t valid, const float pad)
+    {
+        if (valid == 4)
+        {
+            return _mm_loadu_ps(stream + first);
+        }
+
+        __declspec(align(16)) float lanes[4] = { pad, pad, pad, pad };
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            lanes[i] = stream[first + i];
+        }
+
+        return _mm_load_ps(lanes);
+    }
+
+    static void StoreStream(float* stream, const size_t first, const size_t valid, const __m128 values)
+    {
+        if (valid == 4)
+        {
+            _mm_storeu_ps(stream + first, values);
+            return;
+        }
+
+        __declspec(align(16)) float lanes[4];
+        _mm_store_ps(lanes, values);
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            stream[first + i] = lanes[i];
+        }
+    }
+
     Quaternion::Quaternion() : elementsSIMD(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f))
     {
     }
@@ -82,6 +117,238 @@ namespace NullX
         return toReturn;
     }
 
+    Quaternion Quaternion::FromEuler(const Vector3& euler)
+    {
+        // Rotate applies x, then y, then z, so the product is qx * qy * qz expanded
+        float sx = sinf(euler.x / 2), cx = cosf(euler.x / 2);
+        float sy = sinf(euler.y / 2), cy = cosf(euler.y / 2);
+        float sz = sinf(euler.z / 2), cz = cosf(euler.z / 2);
+        Quaternion toReturn = Quaternion();
+        toReturn.elementsSIMD = _mm_setr_ps(cx * cy * cz - sx * sy * sz,
+                                            sx * cy * cz + cx * sy * sz,
+                                            cx * sy * cz - sx * cy * sz,
+                                            cx * cy * sz + sx * sy * cz);
+        return toReturn;
+    }
+
+    void Quaternion::FromEuler(const Vector3* eulers, Quaternion* out, const size_t count)
+    {
+        ParallelFor((count + 3) / 4, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                // The tail group repeats its last element rather than reading past the end
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                __m128 ex = eulers[first].elementsSIMD;
+                __m128 ey = eulers[first + ((valid > 1) ? 1 : valid - 1)].elementsSIMD;
+                __m128 ez = eulers[first + ((valid > 2) ? 2 : valid - 1)].elementsSIMD;
+                __m128 ew = eulers[first + valid - 1].elementsSIMD;
+                _MM_TRANSPOSE4_PS(ex, ey, ez, ew);
+
+                __m128 half = _mm_set1_ps(0.5f);
+                __m128 sx, cx, sy, cy, sz, cz;
+                SinCos(_mm_mul_ps(ex, half), sx, cx);
+                SinCos(_mm_mul_ps(ey, half), sy, cy);
+                SinCos(_mm_mul_ps(ez, half), sz, cz);
+
+                __m128 cxcy = _mm_mul_ps(cx, cy), sxsy = _mm_mul_ps(sx, sy);
+                __m128 sxcy = _mm_mul_ps(sx, cy), cxsy = _mm_mul_ps(cx, sy);
+                __m128 w = _mm_sub_ps(_mm_mul_ps(cxcy, cz), _mm_mul_ps(sxsy, sz));
+                __m128 x = _mm_add_ps(_mm_mul_ps(sxcy, cz), _mm_mul_ps(cxsy, sz));
+                __m128 y = _mm_sub_ps(_mm_mul_ps(cxsy, cz), _mm_mul_ps(sxcy, sz));
+                __m128 z = _mm_add_ps(_mm_mul_ps(cxcy, sz), _mm_mul_ps(sxsy, cz));
+                _MM_TRANSPOSE4_PS(w, x, y, z);
+
+                __m128 lanes[4] = { w, x, y, z };
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    out[first + i].elementsSIMD = lanes[i];
+                }
+            }
+        });
+    }
+
+    Quaternion Quaternion::FromMatrix(const Matrix4& mat)
+    {
+        __m128 rows[3][3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                rows[i][j] = _mm_set1_ps(mat.matrix[i][j]);
+            }
+        }
+
+        __m128 w, x, y, z;
+        FromMatrix(rows, w, x, y, z);
+        Quaternion toReturn = Quaternion();
+        toReturn.elementsSIMD = _mm_unpacklo_ps(_mm_unpacklo_ps(w, y), _mm_unpacklo_ps(x, z));
+        return toReturn;
+    }
+
+    void Quaternion::FromMatrix(const Matrix4* mats, Quaternion* out, const size_t count)
+    {
+        ParallelFor((count + 3) / 4, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                const Matrix4& mat0 = mats[first];
+                const Matrix4& mat1 = mats[first + ((valid > 1) ? 1 : valid - 1)];
+                const Matrix4& mat2 = mats[first + ((valid > 2) ? 2 : valid - 1)];
+                const Matrix4& mat3 = mats[first + valid - 1];
+                __m128 rows[3][3];
+
+                for (int i = 0; i < 3; i++)
+                {
+                    __m128 r0 = mat0.rowsSIMD[i], r1 = mat1.rowsSIMD[i], r2 = mat2.rowsSIMD[i], r3 = mat3.rowsSIMD[i];
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    rows[i][0] = r0;
+                    rows[i][1] = r1;
+                    rows[i][2] = r2;
+                }
+
+                __m128 w, x, y, z;
+                FromMatrix(rows, w, x, y, z);
+                _MM_TRANSPOSE4_PS(w, x, y, z);
+
+                __m128 lanes[4] = { w, x, y, z };
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    out[first + i].elementsSIMD = lanes[i];
+                }
+            }
+        });
+    }
+
+    void Quaternion::FromMatrix(const __m128 rows[3][3], __m128& w, __m128& x, __m128& y, __m128& z)
+    {
+        // Every lane builds from the largest of 4w^2, 4x^2, 4y^2 & 4z^2 so the divide is never near zero, selected by blends instead of branches
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 m00 = rows[0][0], m11 = rows[1][1], m22 = rows[2][2];
+        __m128 tw = _mm_add_ps(one, _mm_add_ps(m00, _mm_add_ps(m11, m22)));
+        __m128 tx = _mm_add_ps(one, _mm_sub_ps(m00, _mm_add_ps(m11, m22)));
+        __m128 ty = _mm_add_ps(one, _mm_sub_ps(m11, _mm_add_ps(m00, m22)));
+        __m128 tz = _mm_add_ps(one, _mm_sub_ps(m22, _mm_add_ps(m00, m11)));
+        __m128 a = _mm_sub_ps(rows[2][1], rows[1][2]);
+        __m128 b = _mm_sub_ps(rows[0][2], rows[2][0]);
+        __m128 c = _mm_sub_ps(rows[1][0], rows[0][1]);
+        __m128 d = _mm_add_ps(rows[0][1], rows[1][0]);
+        __m128 e = _mm_add_ps(rows[0][2], rows[2][0]);
+        __m128 f = _mm_add_ps(rows[1][2], rows[2][1]);
+
+        __m128 t = tw;
+        w = tw, x = a, y = b, z = c;
+        __m128 useX = _mm_cmpgt_ps(tx, t);
+        t = _mm_blendv_ps(t, tx, useX);
+        w = _mm_blendv_ps(w, a, useX);
+        x = _mm_blendv_ps(x, tx, useX);
+        y = _mm_blendv_ps(y, d, useX);
+        z = _mm_blendv_ps(z, e, useX);
+        __m128 useY = _mm_cmpgt_ps(ty, t);
+        t = _mm_blendv_ps(t, ty, useY);
+        w = _mm_blendv_ps(w, b, useY);
+        x = _mm_blendv_ps(x, d, useY);
+        y = _mm_blendv_ps(y, ty, useY);
+        z = _mm_blendv_ps(z, f, useY);
+        __m128 useZ = _mm_cmpgt_ps(tz, t);
+        t = _mm_blendv_ps(t, tz, useZ);
+        w = _mm_blendv_ps(w, c, useZ);
+        x = _mm_blendv_ps(x, e, useZ);
+        y = _mm_blendv_ps(y, f, useZ);
+        z = _mm_blendv_ps(z, tz, useZ);
+
+        // The radicands sum to 4, so the largest is at least 1
+        __m128 scale = _mm_div_ps(_mm_set1_ps(0.5f), _mm_sqrt_ps(t));
+        w = _mm_mul_ps(w, scale);
+        x = _mm_mul_ps(x, scale);
+        y = _mm_mul_ps(y, scale);
+        z = _mm_mul_ps(z, scale);
+    }
+
+    void Quaternion::Integrate(float* w, float* x, float* y, float* z, const float* angularX, const float* angularY, const float* angularZ,
+                               const size_t count, const float dt, Matrix4* matrices)
+    {
+        ParallelFor((count + 3) / 4, 256, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                __m128 qw = LoadStream(w, first, valid, 1.0f);
+                __m128 qx = LoadStream(x, first, valid, 0.0f);
+                __m128 qy = LoadStream(y, first, valid, 0.0f);
+                __m128 qz = LoadStream(z, first, valid, 0.0f);
+                __m128 ox = LoadStream(angularX, first, valid, 0.0f);
+                __m128 oy = LoadStream(angularY, first, valid, 0.0f);
+                __m128 oz = LoadStream(angularZ, first, valid, 0.0f);
+
+                // exp(omega * dt / 2) = (cos(|omega| dt / 2), sin(|omega| dt / 2) * omega / |omega|), the scale tends to dt / 2 as |omega| -> 0
+                __m128 speedSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)), _mm_mul_ps(oz, oz));
+                __m128 speed = _mm_sqrt_ps(speedSqr);
+                __m128 sine, cosine;
+                SinCos(_mm_mul_ps(speed, _mm_set1_ps(dt * 0.5f)), sine, cosine);
+                __m128 still = _mm_cmplt_ps(speedSqr, _mm_set1_ps(1e-12f));
+                __m128 scale = _mm_blendv_ps(_mm_div_ps(sine, _mm_blendv_ps(speed, _mm_set1_ps(1.0f), still)), _mm_set1_ps(dt * 0.5f), still);
+                __m128 dw = cosine;
+                __m128 dx = _mm_mul_ps(ox, scale);
+                __m128 dy = _mm_mul_ps(oy, scale);
+                __m128 dz = _mm_mul_ps(oz, scale);
+
+                // World space angular velocity pre-multiplies, delta * q
+                __m128 rw = _mm_sub_ps(_mm_mul_ps(dw, qw), _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+                __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dw, qx), _mm_mul_ps(dx, qw)), _mm_sub_ps(_mm_mul_ps(dy, qz), _mm_mul_ps(dz, qy)));
+                __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dw, qy), _mm_mul_ps(dy, qw)), _mm_sub_ps(_mm_mul_ps(dz, qx), _mm_mul_ps(dx, qz)));
+                __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dw, qz), _mm_mul_ps(dz, qw)), _mm_sub_ps(_mm_mul_ps(dx, qy), _mm_mul_ps(dy, qx)));
+
+                // rsqrt refined by one Newton-Raphson step, the length is already close to 1 so this removes the drift
+                __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, rw), _mm_mul_ps(rx, rx)), _mm_add_ps(_mm_mul_ps(ry, ry), _mm_mul_ps(rz, rz)));
+                __m128 invLength = _mm_rsqrt_ps(lengthSqr);
+                invLength = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), invLength), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(lengthSqr, invLength), invLength)));
+                rw = _mm_mul_ps(rw, invLength);
+                rx = _mm_mul_ps(rx, invLength);
+                ry = _mm_mul_ps(ry, invLength);
+                rz = _mm_mul_ps(rz, invLength);
+
+                StoreStream(w, first, valid, rw);
+                StoreStream(x, first, valid, rx);
+                StoreStream(y, first, valid, ry);
+                StoreStream(z, first, valid, rz);
+
+                if (matrices == nullptr)
+                {
+                    continue;
+                }
+
+                __m128 two = _mm_set1_ps(2.0f);
+                __m128 one = _mm_set1_ps(1.0f);
+                __m128 xx = _mm_mul_ps(rx, rx), yy = _mm_mul_ps(ry, ry), zz = _mm_mul_ps(rz, rz);
+                __m128 xy = _mm_mul_ps(rx, ry), xz = _mm_mul_ps(rx, rz), yz = _mm_mul_ps(ry, rz);
+                __m128 wx = _mm_mul_ps(rw, rx), wy = _mm_mul_ps(rw, ry), wz = _mm_mul_ps(rw, rz);
+
+                __m128 row0[4] = { _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_mul_ps(two, _mm_add_ps(xz, wy)), _mm_setzero_ps() };
+                __m128 row1[4] = { _mm_mul_ps(two, _mm_add_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), _mm_mul_ps(two, _mm_sub_ps(yz, wx)), _mm_setzero_ps() };
+                __m128 row2[4] = { _mm_mul_ps(two, _mm_sub_ps(xz, wy)), _mm_mul_ps(two, _mm_add_ps(yz, wx)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), _mm_setzero_ps() };
+                _MM_TRANSPOSE4_PS(row0[0], row0[1], row0[2], row0[3]);
+                _MM_TRANSPOSE4_PS(row1[0], row1[1], row1[2], row1[3]);
+                _MM_TRANSPOSE4_PS(row2[0], row2[1], row2[2], row2[3]);
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    _mm_store_ps(matrices[first + i].matrix[0], row0[i]);
+                    _mm_store_ps(matrices[first + i].matrix[1], row1[i]);
+                    _mm_store_ps(matrices[first + i].matrix[2], row2[i]);
+                    _mm_store_ps(matrices[first + i].matrix[3], _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+                }
+            }
+        });
+    }
+
     Quaternion Quaternion::operator * (const Quaternion& quat)
     {
         Quaternion toReturn = Quaternion();
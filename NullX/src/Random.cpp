@@ -0,0 +1,269 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    // Fixed so a seed gives the same output whatever the thread count
+    static const size_t RandomBlockSize = 1 << 12;
+
+    static unsigned long long SplitMix64(unsigned long long& state)
+    {
+        unsigned long long z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    static __m128i RotateLeft(const __m128i value, const int bits)
+    {
+        return _mm_or_si128(_mm_slli_epi32(value, bits), _mm_srli_epi32(value, 32 - bits));
+    }
+
+    // Runs kernel over groups of 4 outputs, each block with its own generator seeded from the parent
+    template <typename Kernel>
+    static void ForEachBlock(Random& parent, const size_t count, const Kernel& kernel)
+    {
+        unsigned long long base = parent.Next64();
+
+        ParallelFor((count + RandomBlockSize - 1) / RandomBlockSize, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t block = begin; block < end; block++)
+            {
+                Random generator = Random(base + block * 0xD1B54A32D192ED03ull);
+                size_t last = (block * RandomBlockSize + RandomBlockSize < count) ? block * RandomBlockSize + RandomBlockSize : count;
+
+                for (size_t first = block * RandomBlockSize; first < last; first += 4)
+                {
+                    kernel(generator, first, (last - first < 4) ? last - first : 4);
+                }
+            }
+        });
+    }
+
+    static void StoreVectors(Vector3* out, const size_t first, const size_t valid, __m128 x, __m128 y, __m128 z)
+    {
+        __m128 w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        __m128 lanes[4] = { x, y, z, w };
+
+        for (size_t i = 0; i < valid; i++)
+        {
+            out[first + i].elementsSIMD = lanes[i];
+        }
+    }
+
+    // Uniform direction from z = 1 - 2u & phi = 2 pi v
+    static void UnitVectors(Random& generator, __m128& x, __m128& y, __m128& z)
+    {
+        z = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(generator.NextFloat4(), _mm_set1_ps(2.0f)));
+        __m128 radius = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, z)), _mm_setzero_ps()));
+        __m128 sine, cosine;
+        SinCos(_mm_mul_ps(generator.NextFloat4(), _mm_set1_ps(TwoPi)), sine, cosine);
+        x = _mm_mul_ps(radius, cosine);
+        y = _mm_mul_ps(radius, sine);
+    }
+
+    // Cube root by an exponent third guess & 3 Newton steps, y' = (2y + u / y^2) / 3
+    static __m128 CubeRoot(const __m128 value)
+    {
+        __m128 bits = _mm_cvtepi32_ps(_mm_castps_si128(value));
+        __m128 y = _mm_castsi128_ps(_mm_add_epi32(_mm_cvtps_epi32(_mm_mul_ps(bits, _mm_set1_ps(1.0f / 3.0f))), _mm_set1_epi32(709921077)));
+        __m128 third = _mm_set1_ps(1.0f / 3.0f);
+
+        for (int i = 0; i < 3; i++)
+        {
+            y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(value, _mm_mul_ps(y, y))), third);
+        }
+
+        return y;
+    }
+
+    Random::Random()
+    {
+        Seed(0x853C49E6748FEA9Bull);
+    }
+
+    Random::Random(const unsigned long long seed)
+    {
+        Seed(seed);
+    }
+
+    void Random::Seed(const unsigned long long seed)
+    {
+        unsigned long long mix = seed;
+
+        for (int i = 0; i < 4; i++)
+        {
+            unsigned long long low = SplitMix64(mix);
+            unsigned long long high = SplitMix64(mix);
+            state[i] = _mm_set_epi64x(static_cast<long long>(high), static_cast<long long>(low));
+        }
+    }
+
+    __m128i Random::NextBits4()
+    {
+        __m128i result = _mm_add_epi32(state[0], state[3]);
+        __m128i shifted = _mm_slli_epi32(state[1], 9);
+
+        state[2] = _mm_xor_si128(state[2], state[0]);
+        state[3] = _mm_xor_si128(state[3], state[1]);
+        state[1] = _mm_xor_si128(state[1], state[2]);
+        state[0] = _mm_xor_si128(state[0], state[3]);
+        state[2] = _mm_xor_si128(state[2], shifted);
+        state[3] = RotateLeft(state[3], 11);
+
+        return result;
+    }
+
+    __m128 Random::NextFloat4()
+    {
+        // The low bits of xoshiro128+ are weakest, so build the mantissa from the top 23
+        __m128i mantissa = _mm_or_si128(_mm_srli_epi32(NextBits4(), 9), _mm_set1_epi32(0x3F800000));
+        return _mm_sub_ps(_mm_castsi128_ps(mantissa), _mm_set1_ps(1.0f));
+    }
+
+    unsigned long long Random::Next64()
+    {
+        __m128i bits = NextBits4();
+        return static_cast<unsigned long long>(static_cast<unsigned int>(_mm_cvtsi128_si32(bits))) |
+               (static_cast<unsigned long long>(static_cast<unsigned int>(_mm_extract_epi32(bits, 1))) << 32);
+    }
+
+    void Random::Fill(float* out, const size_t count, const float min, const float max)
+    {
+        __m128 offset = _mm_set1_ps(min);
+        __m128 scale = _mm_set1_ps(max - min);
+
+        ForEachBlock(*this, count, [&](Random& generator, size_t first, size_t valid)
+        {
+            __m128 values = _mm_add_ps(_mm_mul_ps(generator.NextFloat4(), scale), offset);
+
+            if (valid == 4)
+            {
+                _mm_storeu_ps(out + first, values);
+                return;
+            }
+
+            __declspec(align(16)) float lanes[4];
+            _mm_store_ps(lanes, values);
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                out[first + i] = lanes[i];
+            }
+        });
+    }
+
+    void Random::InBox(const AABB& box, Vector3* out, const size_t count)
+    {
+        // Each lane draws its own x, y & z so the box can be applied as one AoS multiply-add per point
+        __m128 offset = box.min.elementsSIMD;
+        __m128 scale = _mm_sub_ps(box.max.elementsSIMD, box.min.elementsSIMD);
+
+        ForEachBlock(*this, count, [&](Random& generator, size_t first, size_t valid)
+        {
+            __m128 x = generator.NextFloat4();
+            __m128 y = generator.NextFloat4();
+            __m128 z = generator.NextFloat4();
+            __m128 w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            __m128 lanes[4] = { x, y, z, w };
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                out[first + i].elementsSIMD = _mm_blend_ps(_mm_add_ps(_mm_mul_ps(lanes[i], scale), offset), _mm_setzero_ps(), 0x8);
+            }
+        });
+    }
+
+    void Random::InSphere(const BoundingSphere& sphere, Vector3* out, const size_t count)
+    {
+        __m128 centerX = _mm_set1_ps(sphere.center.x);
+        __m128 centerY = _mm_set1_ps(sphere.center.y);
+        __m128 centerZ = _mm_set1_ps(sphere.center.z);
+        __m128 radius = _mm_set1_ps(sphere.radius);
+
+        ForEachBlock(*this, count, [&](Random& generator, size_t first, size_t valid)
+        {
+            // Volume grows with r^3, so the radius is the cube root of a uniform draw
+            __m128 x, y, z;
+            UnitVectors(generator, x, y, z);
+            __m128 distance = _mm_mul_ps(CubeRoot(generator.NextFloat4()), radius);
+            StoreVectors(out, first, valid, _mm_add_ps(_mm_mul_ps(x, distance), centerX), _mm_add_ps(_mm_mul_ps(y, distance), centerY), _mm_add_ps(_mm_mul_ps(z, distance), centerZ));
+        });
+    }
+
+    void Random::OnSphere(Vector3* out, const size_t count)
+    {
+        ForEachBlock(*this, count, [&](Random& generator, size_t first, size_t valid)
+        {
+            __m128 x, y, z;
+            UnitVectors(generator, x, y, z);
+            StoreVectors(out, first, valid, x, y, z);
+        });
+    }
+
+    void Random::Rotations(Quaternion* out, const size_t count)
+    {
+        ForEachBlock(*this, count, [&](Random& generator, size_t first, size_t valid)
+        {
+            __m128 u = generator.NextFloat4();
+            __m128 low = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), u));
+            __m128 high = _mm_sqrt_ps(u);
+            __m128 sine1, cosine1, sine2, cosine2;
+            SinCos(_mm_mul_ps(generator.NextFloat4(), _mm_set1_ps(TwoPi)), sine1, cosine1);
+            SinCos(_mm_mul_ps(generator.NextFloat4(), _mm_set1_ps(TwoPi)), sine2, cosine2);
+
+            __m128 w = _mm_mul_ps(high, cosine2);
+            __m128 x = _mm_mul_ps(low, sine1);
+            __m128 y = _mm_mul_ps(low, cosine1);
+            __m128 z = _mm_mul_ps(high, sine2);
+            _MM_TRANSPOSE4_PS(w, x, y, z);
+            __m128 lanes[4] = { w, x, y, z };
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                out[first + i].elementsSIMD = lanes[i];
+            }
+        });
+    }
+
+    void Random::CosineHemisphere(const Vector3& normal, Vector3* out, const size_t count)
+    {
+        // Branchless orthonormal basis around normal from Duff et al.
+        float sign = (normal.z >= 0.0f) ? 1.0f : -1.0f;
+        float a = -1.0f / (sign + normal.z);
+        float b = normal.x * normal.y * a;
+        __m128 tangent = _mm_setr_ps(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x, 0.0f);
+        __m128 bitangent = _mm_setr_ps(b, sign + normal.y * normal.y * a, -normal.y, 0.0f);
+        __m128 up = _mm_blend_ps(normal.elementsSIMD, _mm_setzero_ps(), 0x8);
+
+        ForEachBlock(*this, count, [&](Random& generator, size_t first, size_t valid)
+        {
+            // Malley's method, uniform points on the disc projected up onto the hemisphere
+            __m128 u = generator.NextFloat4();
+            __m128 radius = _mm_sqrt_ps(u);
+            __m128 sine, cosine;
+            SinCos(_mm_mul_ps(generator.NextFloat4(), _mm_set1_ps(TwoPi)), sine, cosine);
+            __m128 x = _mm_mul_ps(radius, cosine);
+            __m128 y = _mm_mul_ps(radius, sine);
+            __m128 z = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), u), _mm_setzero_ps()));
+            __m128 w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            __m128 lanes[4] = { x, y, z, w };
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                __m128 local = lanes[i];
+                out[first + i].elementsSIMD = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tangent, _mm_shuffle_ps(local, local, _MM_SHUFFLE(0, 0, 0, 0))),
+                                                                    _mm_mul_ps(bitangent, _mm_shuffle_ps(local, local, _MM_SHUFFLE(1, 1, 1, 1)))),
+                                                         _mm_mul_ps(up, _mm_shuffle_ps(local, local, _MM_SHUFFLE(2, 2, 2, 2))));
+            }
+        });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,410 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+#include <thread>
+
+namespace NullX
+{
+    static const size_t CurveGroupGrain  = 1 << 12;
+    static const size_t CurveChunkSize   = 1 << 16;
+    static const size_t CurveRadixBits   = 8;
+    static const size_t CurveRadixDigits = 1 << CurveRadixBits;
+
+    // Magic bit spreading, each step halves the run length & doubles the gap between runs
+    static unsigned int Spread10(unsigned int v)
+    {
+        v &= 0x3FF;
+        v = (v | (v << 16)) & 0x030000FF;
+        v = (v | (v << 8))  & 0x0300F00F;
+        v = (v | (v << 4))  & 0x030C30C3;
+        v = (v | (v << 2))  & 0x09249249;
+        return v;
+    }
+
+    static unsigned long long Spread21(unsigned long long v)
+    {
+        v &= 0x1FFFFF;
+        v = (v | (v << 32)) & 0x001F00000000FFFFull;
+        v = (v | (v << 16)) & 0x001F0000FF0000FFull;
+        v = (v | (v << 8))  & 0x100F00F00F00F00Full;
+        v = (v | (v << 4))  & 0x10C30C30C30C30C3ull;
+        v = (v | (v << 2))  & 0x1249249249249249ull;
+        return v;
+    }
+
+    static __m128i Spread10(__m128i v)
+    {
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 16)), _mm_set1_epi32(0x030000FF));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 8)),  _mm_set1_epi32(0x0300F00F));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 4)),  _mm_set1_epi32(0x030C30C3));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 2)),  _mm_set1_epi32(0x09249249));
+        return v;
+    }
+
+    // Two 64 bit lanes at a time
+    static __m128i Spread21(__m128i v)
+    {
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 32)), _mm_set1_epi64x(0x001F00000000FFFFll));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 16)), _mm_set1_epi64x(0x001F0000FF0000FFll));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 8)),  _mm_set1_epi64x(0x100F00F00F00F00Fll));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 4)),  _mm_set1_epi64x(0x10C30C30C30C30C3ll));
+        v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 2)),  _mm_set1_epi64x(0x1249249249249249ll));
+        return v;
+    }
+
+    static unsigned long long Interleave63(const unsigned int x, const unsigned int y, const unsigned int z)
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        if (SpaceFillingCurve::HasBMI2())
+        {
+            return _pdep_u64(x, 0x1249249249249249ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x4924924924924924ull);
+        }
+#endif
+
+        return Spread21(x) | (Spread21(y) << 1) | (Spread21(z) << 2);
+    }
+
+    // Skilling's transform from axes to the transposed Hilbert index, interleaving the result gives the code.
+    // Both of its branches are done with masks so 4 cells go through at once
+    static void HilbertTranspose(__m128i& x, __m128i& y, __m128i& z, const int bits)
+    {
+        __m128i* axes[3] = { &x, &y, &z };
+
+        for (unsigned int q = 1u << (bits - 1); q > 1; q >>= 1)
+        {
+            __m128i bit = _mm_set1_epi32(q);
+            __m128i low = _mm_set1_epi32(q - 1);
+
+            for (int i = 0; i < 3; i++)
+            {
+                // Where axis i has the bit set the low bits of x are inverted, elsewhere they're exchanged with axis i
+                __m128i set = _mm_cmpeq_epi32(_mm_and_si128(*axes[i], bit), bit);
+                x = _mm_xor_si128(x, _mm_and_si128(low, set));
+                __m128i swap = _mm_andnot_si128(set, _mm_and_si128(_mm_xor_si128(x, *axes[i]), low));
+                x = _mm_xor_si128(x, swap);
+                *axes[i] = _mm_xor_si128(*axes[i], swap);
+            }
+        }
+
+        // Gray encode
+        y = _mm_xor_si128(y, x);
+        z = _mm_xor_si128(z, y);
+        __m128i flip = _mm_setzero_si128();
+
+        for (unsigned int q = 1u << (bits - 1); q > 1; q >>= 1)
+        {
+            __m128i bit = _mm_set1_epi32(q);
+            flip = _mm_xor_si128(flip, _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(z, bit), bit), _mm_set1_epi32(q - 1)));
+        }
+
+        x = _mm_xor_si128(x, flip);
+        y = _mm_xor_si128(y, flip);
+        z = _mm_xor_si128(z, flip);
+    }
+
+    // Quantizes 4 points to cells in [0, maxCell] as SoA, the tail group repeats its last point
+    static void Quantize(const Vector3* points, const size_t first, const size_t valid, const __m128 min, const __m128 scale, const __m128 maxCell,
+                         __m128i& x, __m128i& y, __m128i& z)
+    {
+        __m128 cells[4];
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            __m128 cell = _mm_mul_ps(_mm_sub_ps(points[first + ((i < valid) ? i : valid - 1)].elementsSIMD, min), scale);
+            cells[i] = _mm_castsi128_ps(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(cell, _mm_setzero_ps()), maxCell)));
+        }
+
+        _MM_TRANSPOSE4_PS(cells[0], cells[1], cells[2], cells[3]);
+        x = _mm_castps_si128(cells[0]);
+        y = _mm_castps_si128(cells[1]);
+        z = _mm_castps_si128(cells[2]);
+    }
+
+    // Cells per unit length on each axis, a flat axis maps everything to cell 0
+    static __m128 CellScale(const AABB& bounds, const int bits)
+    {
+        __m128 extent = _mm_sub_ps(bounds.max.elementsSIMD, bounds.min.elementsSIMD);
+        __m128 scale = _mm_div_ps(_mm_set1_ps(static_cast<float>(1 << bits)), extent);
+        return _mm_and_ps(scale, _mm_cmpgt_ps(extent, _mm_setzero_ps()));
+    }
+
+    template <typename Key>
+    static void RadixSort(Key* keys, unsigned int* order, const size_t count)
+    {
+        std::vector<unsigned int> indices = std::vector<unsigned int>(order ? 0 : count);
+        unsigned int* values = order ? order : indices.data();
+        std::vector<Key> keyScratch = std::vector<Key>(count);
+        std::vector<unsigned int> valueScratch = std::vector<unsigned int>(count);
+
+        ParallelFor(count, CurveChunkSize, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                values[i] = static_cast<unsigned int>(i);
+            }
+        });
+
+        static const size_t threads = std::thread::hardware_concurrency();
+        size_t chunks = (count + CurveChunkSize - 1) / CurveChunkSize;
+        chunks = (chunks < threads) ? chunks : threads;
+        chunks = (chunks > 0) ? chunks : 1;
+        size_t chunkSize = (count + chunks - 1) / chunks;
+        std::vector<size_t> histograms = std::vector<size_t>(chunks * CurveRadixDigits);
+
+        Key* sourceKeys = keys;
+        Key* destKeys = keyScratch.data();
+        unsigned int* sourceValues = values;
+        unsigned int* destValues = valueScratch.data();
+
+        // LSD passes over 8 bit digits, each a stable counting sort with one histogram per chunk like SpatialHashGrid::Build
+        for (size_t shift = 0; shift < sizeof(Key) * 8; shift += CurveRadixBits)
+        {
+            std::fill(histograms.begin(), histograms.end(), 0);
+
+            ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+            {
+                for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                {
+                    size_t* histogram = &histograms[chunk * CurveRadixDigits];
+                    size_t end = (chunk * chunkSize + chunkSize < count) ? chunk * chunkSize + chunkSize : count;
+
+                    for (size_t i = chunk * chunkSize; i < end; i++)
+                    {
+                        histogram[(sourceKeys[i] >> shift) & (CurveRadixDigits - 1)]++;
+                    }
+                }
+            });
+
+            // A digit shared by every key leaves the order unchanged, common in the high bits of 63 bit codes
+            bool uniform = false;
+            size_t offset = 0;
+
+            for (size_t digit = 0; digit < CurveRadixDigits; digit++)
+            {
+                size_t total = 0;
+
+                for (size_t chunk = 0; chunk < chunks; chunk++)
+                {
+                    size_t digitCount = histograms[chunk * CurveRadixDigits + digit];
+                    histograms[chunk * CurveRadixDigits + digit] = offset;
+                    offset += digitCount;
+                    total += digitCount;
+                }
+
+                uniform = uniform || (total == count);
+            }
+
+            if (uniform)
+            {
+                continue;
+            }
+
+            ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+            {
+                for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+                {
+                    size_t* offsets = &histograms[chunk * CurveRadixDigits];
+                    size_t end = (chunk * chunkSize + chunkSize < count) ? chunk * chunkSize + chunkSize : count;
+
+                    for (size_t i = chunk * chunkSize; i < end; i++)
+                    {
+                        size_t slot = offsets[(sourceKeys[i] >> shift) & (CurveRadixDigits - 1)]++;
+                        destKeys[slot] = sourceKeys[i];
+                        destValues[slot] = sourceValues[i];
+                    }
+                }
+            });
+
+            std::swap(sourceKeys, destKeys);
+            std::swap(sourceValues, destValues);
+        }
+
+        if (sourceKeys != keys)
+        {
+            ParallelFor(count, CurveChunkSize, [&](size_t begin, size_t end)
+            {
+                std::copy(sourceKeys + begin, sourceKeys + end, keys + begin);
+                std::copy(sourceValues + begin, sourceValues + end, values + begin);
+            });
+        }
+    }
+
+    unsigned int SpaceFillingCurve::Morton30(const unsigned int x, const unsigned int y, const unsigned int z)
+    {
+        if (HasBMI2())
+        {
+            return _pdep_u32(x, 0x09249249) | _pdep_u32(y, 0x12492492) | _pdep_u32(z, 0x24924924);
+        }
+
+        return Spread10(x) | (Spread10(y) << 1) | (Spread10(z) << 2);
+    }
+
+    unsigned long long SpaceFillingCurve::Morton63(const unsigned int x, const unsigned int y, const unsigned int z)
+    {
+        return Interleave63(x & 0x1FFFFF, y & 0x1FFFFF, z & 0x1FFFFF);
+    }
+
+    unsigned int SpaceFillingCurve::Hilbert30(const unsigned int x, const unsigned int y, const unsigned int z)
+    {
+        __m128i hx = _mm_set1_epi32(x & 0x3FF), hy = _mm_set1_epi32(y & 0x3FF), hz = _mm_set1_epi32(z & 0x3FF);
+        HilbertTranspose(hx, hy, hz, 10);
+        return Morton30(_mm_cvtsi128_si32(hz), _mm_cvtsi128_si32(hy), _mm_cvtsi128_si32(hx));
+    }
+
+    unsigned long long SpaceFillingCurve::Hilbert63(const unsigned int x, const unsigned int y, const unsigned int z)
+    {
+        __m128i hx = _mm_set1_epi32(x & 0x1FFFFF), hy = _mm_set1_epi32(y & 0x1FFFFF), hz = _mm_set1_epi32(z & 0x1FFFFF);
+        HilbertTranspose(hx, hy, hz, 21);
+        return Interleave63(_mm_cvtsi128_si32(hz), _mm_cvtsi128_si32(hy), _mm_cvtsi128_si32(hx));
+    }
+
+    void SpaceFillingCurve::Encode30(const Vector3* points, const size_t count, const AABB& bounds, const CurveType curve, unsigned int* codes)
+    {
+        __m128 min = bounds.min.elementsSIMD;
+        __m128 scale = CellScale(bounds, 10);
+        __m128 maxCell = _mm_set1_ps(1023.0f);
+
+        ParallelFor((count + 3) / 4, CurveGroupGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                __m128i x, y, z;
+                Quantize(points, first, valid, min, scale, maxCell, x, y, z);
+
+                // The Hilbert transform leaves the most significant axis in x, so it goes in the highest bit of each triple
+                if (curve == CurveType::Hilbert)
+                {
+                    HilbertTranspose(x, y, z, 10);
+                    std::swap(x, z);
+                }
+
+                __m128i code = _mm_or_si128(Spread10(x), _mm_or_si128(_mm_slli_epi32(Spread10(y), 1), _mm_slli_epi32(Spread10(z), 2)));
+                __declspec(align(16)) unsigned int lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), code);
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    codes[first + i] = lanes[i];
+                }
+            }
+        });
+    }
+
+    void SpaceFillingCurve::Encode63(const Vector3* points, const size_t count, const AABB& bounds, const CurveType curve, unsigned long long* codes)
+    {
+        __m128 min = bounds.min.elementsSIMD;
+        __m128 scale = CellScale(bounds, 21);
+        __m128 maxCell = _mm_set1_ps(2097151.0f);
+        bool bmi2 = HasBMI2();
+
+        ParallelFor((count + 3) / 4, CurveGroupGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; group++)
+            {
+                size_t first = group * 4;
+                size_t valid = (count - first < 4) ? count - first : 4;
+                __m128i x, y, z;
+                Quantize(points, first, valid, min, scale, maxCell, x, y, z);
+
+                if (curve == CurveType::Hilbert)
+                {
+                    HilbertTranspose(x, y, z, 21);
+                    std::swap(x, z);
+                }
+
+                __declspec(align(16)) unsigned long long lanes[4];
+
+                if (bmi2)
+                {
+                    __declspec(align(16)) unsigned int laneX[4], laneY[4], laneZ[4];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(laneX), x);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(laneY), y);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(laneZ), z);
+
+                    for (size_t i = 0; i < 4; i++)
+                    {
+                        lanes[i] = Interleave63(laneX[i], laneY[i], laneZ[i]);
+                    }
+                }
+                else
+                {
+                    // Widen each half to 64 bit lanes & spread 2 codes per register
+                    for (int half = 0; half < 2; half++)
+                    {
+                        __m128i wideX = _mm_cvtepu32_epi64(x), wideY = _mm_cvtepu32_epi64(y), wideZ = _mm_cvtepu32_epi64(z);
+                        __m128i code = _mm_or_si128(Spread21(wideX), _mm_or_si128(_mm_slli_epi64(Spread21(wideY), 1), _mm_slli_epi64(Spread21(wideZ), 2)));
+                        _mm_store_si128(reinterpret_cast<__m128i*>(lanes + half * 2), code);
+                        x = _mm_srli_si128(x, 8);
+                        y = _mm_srli_si128(y, 8);
+                        z = _mm_srli_si128(z, 8);
+                    }
+                }
+
+                for (size_t i = 0; i < valid; i++)
+                {
+                    codes[first + i] = lanes[i];
+                }
+            }
+        });
+    }
+
+    void SpaceFillingCurve::Sort(unsigned int* codes, unsigned int* order, const size_t count)
+    {
+        RadixSort(codes, order, count);
+    }
+
+    void SpaceFillingCurve::Sort(unsigned long long* codes, unsigned int* order, const size_t count)
+    {
+        RadixSort(codes, order, count);
+    }
+
+    void SpaceFillingCurve::SortPoints(Vector3* points, const size_t count, const CurveType curve, unsigned int* order)
+    {
+        AABB bounds = AABB::FromPoints(points, count);
+        std::vector<unsigned long long> codes = std::vector<unsigned long long>(count);
+        std::vector<unsigned int> indices = std::vector<unsigned int>(order ? 0 : count);
+        unsigned int* permutation = order ? order : indices.data();
+
+        Encode63(points, count, bounds, curve, codes.data());
+        Sort(codes.data(), permutation, count);
+
+        std::vector<Vector3> sorted = std::vector<Vector3>(count);
+
+        ParallelFor(count, CurveChunkSize, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                sorted[i] = points[permutation[i]];
+            }
+        });
+
+        std::copy(sorted.begin(), sorted.end(), points);
+    }
+
+    bool SpaceFillingCurve::HasBMI2()
+    {
+        // Leaf 7 EBX bit 8, checked once
+        static const bool supported = []()
+        {
+            int info[4];
+            __cpuidex(info, 0, 0);
+
+            if (info[0] < 7)
+            {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 8)) != 0;
+        }();
+
+        return supported;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,327 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+#include <float.h>
+#include <thread>
+
+namespace NullX
+{
+    static const size_t GridChunkSize     = 1 << 14;
+    static const size_t GridScanRangeSize = 1 << 16;
+
+    // Cells are grouped into 16 x 2 x 2 blocks, the block is hashed with the large primes from Teschner et al. & the cell's place in its block
+    // picks one of the block's 64 consecutive buckets, x fastest.  Cells side by side in x then sort next to each other & their buckets merge into
+    // one scan, long x runs measured fastest against 4 x 4 x 4 & 8 x 4 x 2 blocks
+    static unsigned int CellHash(const __m128i cell, const unsigned int mask)
+    {
+        __m128i block = _mm_blend_epi16(_mm_srai_epi32(cell, 1), _mm_srai_epi32(cell, 4), 0x03);
+        __m128i hashed = _mm_mullo_epi32(block, _mm_setr_epi32(73856093, 19349663, 83492791, 0));
+        hashed = _mm_xor_si128(hashed, _mm_shuffle_epi32(hashed, _MM_SHUFFLE(3, 3, 3, 1)));
+        hashed = _mm_xor_si128(hashed, _mm_shuffle_epi32(hashed, _MM_SHUFFLE(3, 3, 3, 2)));
+        __m128i local = _mm_mullo_epi32(_mm_and_si128(cell, _mm_setr_epi32(15, 1, 1, 0)), _mm_setr_epi32(1, 16, 32, 0));
+        local = _mm_add_epi32(local, _mm_shuffle_epi32(local, _MM_SHUFFLE(3, 3, 3, 1)));
+        local = _mm_add_epi32(local, _mm_shuffle_epi32(local, _MM_SHUFFLE(3, 3, 3, 2)));
+        return ((static_cast<unsigned int>(_mm_cvtsi128_si32(hashed)) << 6) | static_cast<unsigned int>(_mm_cvtsi128_si32(local))) & mask;
+    }
+
+    static __m128i CellOf(const __m128 point, const __m128 invCellSize)
+    {
+        return _mm_cvtps_epi32(_mm_floor_ps(_mm_mul_ps(point, invCellSize)));
+    }
+
+    static int GridLaneMask(const size_t remaining)
+    {
+        return (remaining >= 4) ? 0xF : (1 << remaining) - 1;
+    }
+
+    SpatialHashGrid::SpatialHashGrid() : count(0), bucketMask(0), cellSize(1.0f), invCellSize(1.0f)
+    {
+    }
+
+    void SpatialHashGrid::Build(const Vector3* points, const size_t _count, const float _cellSize)
+    {
+        count = _count;
+        cellSize = _cellSize;
+        invCellSize = 1.0f / _cellSize;
+
+        // At least one bucket per point keeps the load factor at or below 1, & a whole block of 64 keeps the hash's cell bits
+        size_t bucketCount = 64;
+
+        while (bucketCount < count)
+        {
+            bucketCount <<= 1;
+        }
+
+        bucketMask = static_cast<unsigned int>(bucketCount - 1);
+
+        static const size_t threads = std::thread::hardware_concurrency();
+        size_t chunks = (count + GridChunkSize - 1) / GridChunkSize;
+        chunks = (chunks < threads) ? chunks : threads;
+        chunks = (chunks > 0) ? chunks : 1;
+        size_t chunkSize = (count + chunks - 1) / chunks;
+
+        // Buckets start at any index, 3 padding points far from every query keep the last 4 wide load of a bucket inside the arrays
+        size_t padded = count + 3;
+        sortedX.assign(padded, FLT_MAX);
+        sortedY.assign(padded, FLT_MAX);
+        sortedZ.assign(padded, FLT_MAX);
+        sortedIds.resize(padded);
+        pointBuckets.resize(count);
+        bucketStarts.resize(bucketCount + 1);
+        histograms.assign(chunks * bucketCount, 0);
+
+        // Count points per bucket, one histogram per chunk so no counter is shared
+        __m128 invCell = _mm_set1_ps(invCellSize);
+
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                unsigned int* histogram = &histograms[chunk * bucketCount];
+                size_t end = (chunk * chunkSize + chunkSize < count) ? chunk * chunkSize + chunkSize : count;
+
+                for (size_t i = chunk * chunkSize; i < end; i++)
+                {
+                    unsigned int bucket = CellHash(CellOf(points[i].elementsSIMD, invCell), bucketMask);
+                    pointBuckets[i] = bucket;
+                    histogram[bucket]++;
+                }
+            }
+        });
+
+        // Exclusive scan over buckets, then chunks within a bucket, so the sort stays stable
+        size_t ranges = (bucketCount + GridScanRangeSize - 1) / GridScanRangeSize;
+        std::vector<unsigned int> rangeTotals = std::vector<unsigned int>(ranges, 0);
+
+        ParallelFor(ranges, 1, [&](size_t firstRange, size_t lastRange)
+        {
+            for (size_t range = firstRange; range < lastRange; range++)
+            {
+                size_t end = (range * GridScanRangeSize + GridScanRangeSize < bucketCount) ? range * GridScanRangeSize + GridScanRangeSize : bucketCount;
+                unsigned int total = 0;
+
+                for (size_t chunk = 0; chunk < chunks; chunk++)
+                {
+                    const unsigned int* histogram = &histograms[chunk * bucketCount];
+
+                    for (size_t bucket = range * GridScanRangeSize; bucket < end; bucket++)
+                    {
+                        total += histogram[bucket];
+                    }
+                }
+
+                rangeTotals[range] = total;
+            }
+        });
+
+        unsigned int running = 0;
+
+        for (size_t range = 0; range < ranges; range++)
+        {
+            unsigned int total = rangeTotals[range];
+            rangeTotals[range] = running;
+            running += total;
+        }
+
+        ParallelFor(ranges, 1, [&](size_t firstRange, size_t lastRange)
+        {
+            for (size_t range = firstRange; range < lastRange; range++)
+            {
+                size_t end = (range * GridScanRangeSize + GridScanRangeSize < bucketCount) ? range * GridScanRangeSize + GridScanRangeSize : bucketCount;
+                unsigned int offset = rangeTotals[range];
+
+                for (size_t bucket = range * GridScanRangeSize; bucket < end; bucket++)
+                {
+                    bucketStarts[bucket] = offset;
+
+                    for (size_t chunk = 0; chunk < chunks; chunk++)
+                    {
+                        unsigned int bucketCountInChunk = histograms[chunk * bucketCount + bucket];
+                        histograms[chunk * bucketCount + bucket] = offset;
+                        offset += bucketCountInChunk;
+                    }
+                }
+            }
+        });
+
+        bucketStarts[bucketCount] = static_cast<unsigned int>(count);
+
+        // Scatter into the sorted SoA arrays, each chunk owns its slots within every bucket
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                unsigned int* offsets = &histograms[chunk * bucketCount];
+                size_t end = (chunk * chunkSize + chunkSize < count) ? chunk * chunkSize + chunkSize : count;
+
+                for (size_t i = chunk * chunkSize; i < end; i++)
+                {
+                    unsigned int slot = offsets[pointBuckets[i]]++;
+                    sortedX[slot] = points[i].x;
+                    sortedY[slot] = points[i].y;
+                    sortedZ[slot] = points[i].z;
+                    sortedIds[slot] = static_cast<unsigned int>(i);
+                }
+            }
+        });
+    }
+
+    template <bool SkipSelf>
+    void SpatialHashGrid::Gather(const Vector3& point, const unsigned int self, const float radius, std::vector<unsigned int>& results) const
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        int reach = static_cast<int>(ceilf(radius * invCellSize));
+        int width = reach * 2 + 1;
+        size_t cells = static_cast<size_t>(width) * width * width;
+
+        // Neighbouring cells can hash into the same bucket, so dedupe before scanning
+        unsigned int localBuckets[125];
+        std::vector<unsigned int> heapBuckets;
+        unsigned int* buckets = localBuckets;
+
+        if (cells > 125)
+        {
+            heapBuckets.resize(cells);
+            buckets = heapBuckets.data();
+        }
+
+        __m128i center = CellOf(point.elementsSIMD, _mm_set1_ps(invCellSize));
+        size_t bucketCount = 0;
+
+        for (int z = -reach; z <= reach; z++)
+        {
+            for (int y = -reach; y <= reach; y++)
+            {
+                for (int x = -reach; x <= reach; x++)
+                {
+                    buckets[bucketCount++] = CellHash(_mm_add_epi32(center, _mm_setr_epi32(x, y, z, 0)), bucketMask);
+                }
+            }
+        }
+
+        std::sort(buckets, buckets + bucketCount);
+        bucketCount = std::unique(buckets, buckets + bucketCount) - buckets;
+
+        __m128 px = _mm_set1_ps(point.x);
+        __m128 py = _mm_set1_ps(point.y);
+        __m128 pz = _mm_set1_ps(point.z);
+        __m128 radiusSqr = _mm_set1_ps(radius * radius);
+
+        for (size_t b = 0; b < bucketCount; b++)
+        {
+            // Consecutive buckets are consecutive runs of points, so cells side by side in x are scanned as one
+            size_t begin = bucketStarts[buckets[b]];
+
+            while (b + 1 < bucketCount && buckets[b + 1] == buckets[b] + 1)
+            {
+                b++;
+            }
+
+            size_t end = bucketStarts[buckets[b] + 1];
+
+            for (size_t i = begin; i < end; i += 4)
+            {
+                __m128 dx = _mm_sub_ps(_mm_loadu_ps(&sortedX[i]), px);
+                __m128 dy = _mm_sub_ps(_mm_loadu_ps(&sortedY[i]), py);
+                __m128 dz = _mm_sub_ps(_mm_loadu_ps(&sortedZ[i]), pz);
+                __m128 distSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                int mask = _mm_movemask_ps(_mm_cmple_ps(distSqr, radiusSqr)) & GridLaneMask(end - i);
+
+                for (int lane = 0; mask != 0; lane++, mask >>= 1)
+                {
+                    if ((mask & 1) && !(SkipSelf && sortedIds[i + lane] == self))
+                    {
+                        results.push_back(sortedIds[i + lane]);
+                    }
+                }
+            }
+        }
+    }
+
+    void SpatialHashGrid::Neighbours(const Vector3& point, const float radius, std::vector<unsigned int>& results) const
+    {
+        Gather<false>(point, 0, radius, results);
+    }
+
+    void SpatialHashGrid::NeighbourLists(const float radius, std::vector<unsigned int>& offsets, std::vector<unsigned int>& neighbours) const
+    {
+        // Walk the points in sorted order so consecutive queries hit the same buckets
+        size_t chunks = (count + GridChunkSize - 1) / GridChunkSize;
+        std::vector<std::vector<unsigned int>> chunkNeighbours = std::vector<std::vector<unsigned int>>(chunks);
+        std::vector<unsigned int> localStarts = std::vector<unsigned int>(count);
+        offsets.assign(count + 1, 0);
+
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                size_t end = (chunk * GridChunkSize + GridChunkSize < count) ? chunk * GridChunkSize + GridChunkSize : count;
+                std::vector<unsigned int>& local = chunkNeighbours[chunk];
+
+                for (size_t i = chunk * GridChunkSize; i < end; i++)
+                {
+                    unsigned int id = sortedIds[i];
+                    localStarts[i] = static_cast<unsigned int>(local.size());
+                    Gather<true>(Vector3(sortedX[i], sortedY[i], sortedZ[i]), id, radius, local);
+                    offsets[id + 1] = static_cast<unsigned int>(local.size()) - localStarts[i];
+                }
+            }
+        });
+
+        for (size_t i = 0; i < count; i++)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+
+        neighbours.resize(offsets[count]);
+
+        ParallelFor(chunks, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t chunk = firstChunk; chunk < lastChunk; chunk++)
+            {
+                size_t end = (chunk * GridChunkSize + GridChunkSize < count) ? chunk * GridChunkSize + GridChunkSize : count;
+                const std::vector<unsigned int>& local = chunkNeighbours[chunk];
+
+                for (size_t i = chunk * GridChunkSize; i < end; i++)
+                {
+                    unsigned int id = sortedIds[i];
+                    std::copy(local.begin() + localStarts[i], local.begin() + localStarts[i] + (offsets[id + 1] - offsets[id]), neighbours.begin() + offsets[id]);
+                }
+            }
+        });
+    }
+
+    size_t SpatialHashGrid::Size() const
+    {
+        return count;
+    }
+
+    const float* SpatialHashGrid::SortedX() const
+    {
+        return sortedX.data();
+    }
+
+    const float* SpatialHashGrid::SortedY() const
+    {
+        return sortedY.data();
+    }
+
+    const float* SpatialHashGrid::SortedZ() const
+    {
+        return sortedZ.data();
+    }
+
+    const unsigned int* SpatialHashGrid::SortedIds() const
+    {
+        return sortedIds.data();
+    }
+}
\ No newline at end of file
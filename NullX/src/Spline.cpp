@@ -0,0 +1,331 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+#include <algorithm>
+
+namespace NullX
+{
+    static const size_t SplineGrain = 1024;
+
+    // Rows map the 4 control points of a segment to the a, b, c & d power basis coefficients
+    static const float BezierBasis[4][4]     = { { -1.0f,  3.0f, -3.0f,  1.0f },
+                                                 {  3.0f, -6.0f,  3.0f,  0.0f },
+                                                 { -3.0f,  3.0f,  0.0f,  0.0f },
+                                                 {  1.0f,  0.0f,  0.0f,  0.0f } };
+    static const float CatmullRomBasis[4][4] = { { -0.5f,  1.5f, -1.5f,  0.5f },
+                                                 {  1.0f, -2.5f,  2.0f, -0.5f },
+                                                 { -0.5f,  0.0f,  0.5f,  0.0f },
+                                                 {  0.0f,  1.0f,  0.0f,  0.0f } };
+    static const float HermiteBasis[4][4]    = { {  2.0f,  1.0f, -2.0f,  1.0f },
+                                                 { -3.0f, -2.0f,  3.0f, -1.0f },
+                                                 {  0.0f,  1.0f,  0.0f,  0.0f },
+                                                 {  1.0f,  0.0f,  0.0f,  0.0f } };
+    static const float BSplineBasis[4][4]    = { { -1.0f / 6.0f,  3.0f / 6.0f, -3.0f / 6.0f, 1.0f / 6.0f },
+                                                 {  3.0f / 6.0f, -6.0f / 6.0f,  3.0f / 6.0f, 0.0f },
+                                                 { -3.0f / 6.0f,  0.0f,         3.0f / 6.0f, 0.0f },
+                                                 {  1.0f / 6.0f,  4.0f / 6.0f,  1.0f / 6.0f, 0.0f } };
+
+    // 5 point Gauss-Legendre nodes on [0, 1] & their weights
+    static const float GaussNodes[5]   = { 0.0469100770f, 0.2307653449f, 0.5f, 0.7692346551f, 0.9530899230f };
+    static const float GaussWeights[5] = { 0.1184634425f, 0.2393143352f, 0.2844444444f, 0.2393143352f, 0.1184634425f };
+
+    // Horner's rule on the xyz lanes of one segment with u broadcast to every lane, the padded w lanes stay 0
+    static __m128 Horner(const float* segment, const __m128 param)
+    {
+        __m128 result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(segment), param), _mm_loadu_ps(segment + 4));
+        result = _mm_add_ps(_mm_mul_ps(result, param), _mm_loadu_ps(segment + 8));
+        return _mm_add_ps(_mm_mul_ps(result, param), _mm_loadu_ps(segment + 12));
+    }
+
+    static __m128 HornerDerivative(const float* segment, const __m128 param)
+    {
+        __m128 result = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(segment), _mm_set1_ps(3.0f)), param), _mm_mul_ps(_mm_loadu_ps(segment + 4), _mm_set1_ps(2.0f)));
+        return _mm_add_ps(_mm_mul_ps(result, param), _mm_loadu_ps(segment + 8));
+    }
+
+    // Finds the segment & local parameter of 4 parameters at once the way Spline::Locate does, NaN & negative t landing at the start of the
+    // first segment.  offsets receives where each lane's coefficients start
+    static __m128 Locate4(const __m128 t, const size_t segments, int offsets[4])
+    {
+        __m128 scaled = _mm_max_ps(_mm_mul_ps(t, _mm_set1_ps(static_cast<float>(segments))), _mm_setzero_ps());
+        __m128 segment = _mm_min_ps(_mm_floor_ps(scaled), _mm_set1_ps(static_cast<float>(segments - 1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(offsets), _mm_slli_epi32(_mm_cvttps_epi32(segment), 4));
+        return _mm_sub_ps(scaled, segment);
+    }
+
+    // Points (Derivative false) or tangents with respect to t of count parameters.  The segment search runs on 4 parameters per register, then
+    // each lane's u is broadcast into Horner's rule on its own segment.  Transposing 4 segments' coefficients into lanes instead measured
+    // 35% slower, as the gathers & the transpose back to Vector3s cost more than the 3 lanes of arithmetic they save
+    template <bool Derivative>
+    static void EvaluateRange(const float* coefficients, const size_t segments, const float* parameters, const size_t count, Vector3* out)
+    {
+        __m128 scale = _mm_set1_ps(static_cast<float>(segments));
+
+        for (size_t first = 0; first < count; first += 4)
+        {
+            // The tail group repeats its last parameter rather than reading past the end
+            size_t valid = (count - first < 4) ? count - first : 4;
+            __m128 t = (valid == 4) ? _mm_loadu_ps(parameters + first) :
+                                      _mm_setr_ps(parameters[first], parameters[first + ((valid > 1) ? 1 : valid - 1)],
+                                                  parameters[first + ((valid > 2) ? 2 : valid - 1)], parameters[first + valid - 1]);
+            int offsets[4];
+            __m128 u = Locate4(t, segments, offsets);
+            __m128 params[4] = { _mm_shuffle_ps(u, u, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(u, u, _MM_SHUFFLE(1, 1, 1, 1)),
+                                 _mm_shuffle_ps(u, u, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 3, 3, 3)) };
+
+            for (size_t i = 0; i < valid; i++)
+            {
+                out[first + i].elementsSIMD = Derivative ? _mm_mul_ps(HornerDerivative(coefficients + offsets[i], params[i]), scale) :
+                                                           Horner(coefficients + offsets[i], params[i]);
+            }
+        }
+    }
+
+    static float Speed(const float* segment, const float u)
+    {
+        __m128 tangent = HornerDerivative(segment, _mm_set1_ps(u));
+        return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(tangent, tangent, 0x71)));
+    }
+
+    Spline::Spline() : segments(0), samplesPerSegment(0)
+    {
+    }
+
+    Spline::Spline(const Vector3* points, const size_t count, const SplineType type) : segments(0), samplesPerSegment(0)
+    {
+        Set(points, count, type);
+    }
+
+    void Spline::Set(const Vector3* points, const size_t count, const SplineType type)
+    {
+        const float (*basis)[4] = BezierBasis;
+        size_t stride = 3;
+        segments = 0;
+
+        switch (type)
+        {
+        case SplineType::Bezier:
+            segments = (count >= 4) ? (count - 1) / 3 : 0;
+            break;
+        case SplineType::CatmullRom:
+            basis = CatmullRomBasis;
+            stride = 1;
+            segments = (count >= 4) ? count - 3 : 0;
+            break;
+        case SplineType::Hermite:
+            basis = HermiteBasis;
+            stride = 2;
+            segments = (count >= 4) ? count / 2 - 1 : 0;
+            break;
+        case SplineType::BSpline:
+            basis = BSplineBasis;
+            stride = 1;
+            segments = (count >= 4) ? count - 3 : 0;
+            break;
+        }
+
+        coefficients.assign(segments * 16, 0.0f);
+        arcLengths.clear();
+        samplesPerSegment = 0;
+
+        // Converting once to power basis leaves Horner's rule as the only per sample work whatever the type
+        for (size_t segment = 0; segment < segments; segment++)
+        {
+            const Vector3* window = points + segment * stride;
+            float* out = &coefficients[segment * 16];
+
+            for (int row = 0; row < 4; row++)
+            {
+                __m128 sum = _mm_setzero_ps();
+
+                for (int col = 0; col < 4; col++)
+                {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(basis[row][col]), window[col].elementsSIMD));
+                }
+
+                _mm_storeu_ps(out + row * 4, _mm_blend_ps(sum, _mm_setzero_ps(), 0x8));
+            }
+        }
+    }
+
+    size_t Spline::Segments() const
+    {
+        return segments;
+    }
+
+    void Spline::Locate(const float t, size_t& segment, float& u) const
+    {
+        float scaled = t * static_cast<float>(segments);
+        scaled = (scaled > 0.0f) ? scaled : 0.0f;
+        segment = static_cast<size_t>(scaled);
+        segment = (segment < segments) ? segment : segments - 1;
+        u = scaled - static_cast<float>(segment);
+    }
+
+    Vector3 Spline::Evaluate(const float t) const
+    {
+        if (segments == 0)
+        {
+            return Vector3();
+        }
+
+        size_t segment;
+        float u;
+        Locate(t, segment, u);
+        return Vector3(Horner(&coefficients[segment * 16], _mm_set1_ps(u)));
+    }
+
+    Vector3 Spline::Derivative(const float t) const
+    {
+        if (segments == 0)
+        {
+            return Vector3();
+        }
+
+        // Each segment spans 1 / segments of t, so d/dt = segments * d/du
+        size_t segment;
+        float u;
+        Locate(t, segment, u);
+        return Vector3(_mm_mul_ps(HornerDerivative(&coefficients[segment * 16], _mm_set1_ps(u)), _mm_set1_ps(static_cast<float>(segments))));
+    }
+
+    Vector3 Spline::SecondDerivative(const float t) const
+    {
+        if (segments == 0)
+        {
+            return Vector3();
+        }
+
+        size_t segment;
+        float u;
+        Locate(t, segment, u);
+        const float* coeffs = &coefficients[segment * 16];
+        __m128 result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(coeffs), _mm_set1_ps(6.0f * u)), _mm_mul_ps(_mm_loadu_ps(coeffs + 4), _mm_set1_ps(2.0f)));
+        float scale = static_cast<float>(segments);
+        return Vector3(_mm_mul_ps(result, _mm_set1_ps(scale * scale)));
+    }
+
+    void Spline::Evaluate(const float* parameters, const size_t count, Vector3* out) const
+    {
+        if (segments == 0)
+        {
+            std::fill(out, out + count, Vector3());
+            return;
+        }
+
+        ParallelFor(count, SplineGrain, [&](size_t begin, size_t end)
+        {
+            EvaluateRange<false>(coefficients.data(), segments, parameters + begin, end - begin, out + begin);
+        });
+    }
+
+    void Spline::Derivative(const float* parameters, const size_t count, Vector3* out) const
+    {
+        if (segments == 0)
+        {
+            std::fill(out, out + count, Vector3());
+            return;
+        }
+
+        ParallelFor(count, SplineGrain, [&](size_t begin, size_t end)
+        {
+            EvaluateRange<true>(coefficients.data(), segments, parameters + begin, end - begin, out + begin);
+        });
+    }
+
+    void Spline::Evaluate(const Spline* splines, const size_t splineCount, const float* parameters, const size_t count, Vector3* out)
+    {
+        // Split over splines so each thread keeps one curve's coefficients in cache while it samples
+        size_t grain = (count < SplineGrain) ? (SplineGrain + count - 1) / ((count > 0) ? count : 1) : 1;
+
+        ParallelFor(splineCount, grain, [&](size_t begin, size_t end)
+        {
+            for (size_t spline = begin; spline < end; spline++)
+            {
+                const Spline& curve = splines[spline];
+
+                if (curve.segments == 0)
+                {
+                    std::fill(out + spline * count, out + (spline + 1) * count, Vector3());
+                    continue;
+                }
+
+                EvaluateRange<false>(curve.coefficients.data(), curve.segments, parameters, count, out + spline * count);
+            }
+        });
+    }
+
+    void Spline::BuildArcLengthTable(const size_t _samplesPerSegment)
+    {
+        samplesPerSegment = (_samplesPerSegment > 0) ? _samplesPerSegment : 1;
+        size_t samples = segments * samplesPerSegment;
+        arcLengths.assign(samples + 1, 0.0f);
+        float width = 1.0f / static_cast<float>(samplesPerSegment);
+
+        ParallelFor(samples, SplineGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const float* coeffs = &coefficients[(i / samplesPerSegment) * 16];
+                float start = static_cast<float>(i % samplesPerSegment) * width;
+                float length = 0.0f;
+
+                for (int node = 0; node < 5; node++)
+                {
+                    length += GaussWeights[node] * Speed(coeffs, start + GaussNodes[node] * width);
+                }
+
+                arcLengths[i + 1] = length * width;
+            }
+        });
+
+        for (size_t i = 0; i < samples; i++)
+        {
+            arcLengths[i + 1] += arcLengths[i];
+        }
+    }
+
+    float Spline::Length() const
+    {
+        return arcLengths.empty() ? 0.0f : arcLengths.back();
+    }
+
+    float Spline::ParameterAtDistance(const float distance) const
+    {
+        if (arcLengths.size() < 2)
+        {
+            return 0.0f;
+        }
+
+        if (distance <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        if (distance >= arcLengths.back())
+        {
+            return 1.0f;
+        }
+
+        size_t upper = std::upper_bound(arcLengths.begin(), arcLengths.end(), distance) - arcLengths.begin();
+        float lower = arcLengths[upper - 1];
+        float span = arcLengths[upper] - lower;
+        float fraction = (span > 0.0f) ? (distance - lower) / span : 0.0f;
+        return (static_cast<float>(upper - 1) + fraction) / static_cast<float>(arcLengths.size() - 1);
+    }
+
+    void Spline::EvaluateAtDistance(const float* distances, const size_t count, Vector3* out) const
+    {
+        ParallelFor(count, SplineGrain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                out[i] = Evaluate(ParameterAtDistance(distances[i]));
+            }
+        });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    Transform::Transform() : position(Vector3()), rotation(Quaternion()), scale(Vector3(1.0f, 1.0f, 1.0f)),
+                             matrix(Matrix4::Identity), inverse(Matrix4::Identity), matrixDirty(false), inverseDirty(false)
+    {
+    }
+
+    Transform::Transform(const Vector3& _position, const Quaternion& _rotation, const Vector3& _scale) :
+        position(_position), rotation(Quaternion::Normalized(_rotation)), scale(_scale), matrixDirty(true), inverseDirty(true)
+    {
+    }
+
+    const Vector3& Transform::GetPosition() const
+    {
+        return position;
+    }
+
+    const Quaternion& Transform::GetRotation() const
+    {
+        return rotation;
+    }
+
+    const Vector3& Transform::GetScale() const
+    {
+        return scale;
+    }
+
+    void Transform::SetPosition(const Vector3& _position)
+    {
+        position = _position;
+        MarkDirty();
+    }
+
+    void Transform::SetRotation(const Quaternion& _rotation)
+    {
+        rotation = Quaternion::Normalized(_rotation);
+        MarkDirty();
+    }
+
+    void Transform::SetScale(const Vector3& _scale)
+    {
+        scale = _scale;
+        MarkDirty();
+    }
+
+    void Transform::Translate(const Vector3& offset)
+    {
+        position.elementsSIMD = _mm_add_ps(position.elementsSIMD, offset.elementsSIMD);
+        MarkDirty();
+    }
+
+    void Transform::Rotate(const Quaternion& quat)
+    {
+        Quaternion lhs = Quaternion(quat);
+        SetRotation(lhs * rotation);
+    }
+
+    void Transform::MarkDirty()
+    {
+        matrixDirty = true;
+        inverseDirty = true;
+    }
+
+    bool Transform::IsDirty() const
+    {
+        return matrixDirty;
+    }
+
+    const Matrix4& Transform::GetMatrix()
+    {
+        if (matrixDirty)
+        {
+            // Rotation matrix columns scaled by scale, translation in the last column
+            float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+            float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+            float wx = rotation.w * rotation.x, wy = rotation.w * rotation.y, wz = rotation.w * rotation.z;
+            __m128 scaleRow = _mm_setr_ps(scale.x, scale.y, scale.z, 1.0f);
+
+            matrix.rowsSIMD[0] = _mm_mul_ps(_mm_setr_ps(1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy), 0.0f), scaleRow);
+            matrix.rowsSIMD[1] = _mm_mul_ps(_mm_setr_ps(2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx), 0.0f), scaleRow);
+            matrix.rowsSIMD[2] = _mm_mul_ps(_mm_setr_ps(2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy), 0.0f), scaleRow);
+            matrix.rowsSIMD[3] = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+            matrix.xw = position.x;
+            matrix.yw = position.y;
+            matrix.zw = position.z;
+            matrixDirty = false;
+        }
+
+        return matrix;
+    }
+
+    const Matrix4& Transform::GetInverse()
+    {
+        if (inverseDirty)
+        {
+            // (T * R * S)^-1 = S^-1 * R^T * T^-1, so row i of R^T is divided by scale i
+            const Matrix4& local = GetMatrix();
+            __m128 invScaleSqr = _mm_div_ps(_mm_set1_ps(1.0f), _mm_setr_ps(scale.x * scale.x, scale.y * scale.y, scale.z * scale.z, 1.0f));
+            __m128 row0 = local.rowsSIMD[0];
+            __m128 row1 = local.rowsSIMD[1];
+            __m128 row2 = local.rowsSIMD[2];
+            __m128 row3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+            // Transposing R * S gives S * R^T, dividing by scale squared leaves S^-1 * R^T
+            inverse.rowsSIMD[0] = _mm_mul_ps(row0, _mm_shuffle_ps(invScaleSqr, invScaleSqr, _MM_SHUFFLE(0, 0, 0, 0)));
+            inverse.rowsSIMD[1] = _mm_mul_ps(row1, _mm_shuffle_ps(invScaleSqr, invScaleSqr, _MM_SHUFFLE(1, 1, 1, 1)));
+            inverse.rowsSIMD[2] = _mm_mul_ps(row2, _mm_shuffle_ps(invScaleSqr, invScaleSqr, _MM_SHUFFLE(2, 2, 2, 2)));
+            inverse.rowsSIMD[3] = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+            // Translation column is -(S^-1 * R^T) * position
+            __m128 translation = _mm_mul_ps(position.elementsSIMD, _mm_set1_ps(-1.0f));
+            inverse.xw = _mm_cvtss_f32(_mm_dp_ps(inverse.rowsSIMD[0], translation, 0x71));
+            inverse.yw = _mm_cvtss_f32(_mm_dp_ps(inverse.rowsSIMD[1], translation, 0x71));
+            inverse.zw = _mm_cvtss_f32(_mm_dp_ps(inverse.rowsSIMD[2], translation, 0x71));
+            inverseDirty = false;
+        }
+
+        return inverse;
+    }
+
+    void Transform::UpdateMatrices(Transform* transforms, const size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            transforms[i].GetMatrix();
+            transforms[i].GetInverse();
+        }
+    }
+}
\ No newline at end of file
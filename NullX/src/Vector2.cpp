@@ -100,10 +100,11 @@ namespace NullX
 
     bool Vector2::operator == (const Vector2& vec)
     {
+        // Only x & y are compared, the padding lanes hold whatever the last SIMD operation left there
         __m128 compare = _mm_cmpeq_ps(elementsSIMD, vec.elementsSIMD);
-        int mask = _mm_movemask_ps(compare);
+        int mask = _mm_movemask_ps(compare) & 0x3;
 
-        return (mask == 0xF) ? true : false;
+        return (mask == 0x3) ? true : false;
     }
 
     bool Vector2::operator != (const Vector2& vec)
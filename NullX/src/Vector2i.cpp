@@ -0,0 +1,184 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    // Keeps the unused lanes zero so comparisons & dot products can read the whole register
+    static __m128i ClearUnused2(const __m128i vec)
+    {
+        return _mm_blend_epi16(vec, _mm_setzero_si128(), 0xF0);
+    }
+
+    Vector2i::Vector2i() : elementsSIMD(_mm_setzero_si128())
+    {
+    }
+
+    Vector2i::Vector2i(int _x, int _y) : elementsSIMD(_mm_setr_epi32(_x, _y, 0, 0))
+    {
+    }
+
+    Vector2i::Vector2i(__m128i vec) : elementsSIMD(vec)
+    {
+    }
+
+    Vector2i::Vector2i(const Vector2i& vec) : elementsSIMD(vec.elementsSIMD)
+    {
+    }
+
+    Vector2i Vector2i::Floor(const Vector2& vec)
+    {
+        return Vector2i(ClearUnused2(_mm_cvtps_epi32(_mm_floor_ps(vec.elementsSIMD))));
+    }
+
+    Vector2i Vector2i::Round(const Vector2& vec)
+    {
+        // x - floor(x) is exact, so testing it against 0.5 rounds correctly where floor(x + 0.5) rounds 0.49999997 up & odd integers past 2^23 to the next even
+        __m128 down = _mm_floor_ps(vec.elementsSIMD);
+        __m128 up = _mm_cmpge_ps(_mm_sub_ps(vec.elementsSIMD, down), _mm_set1_ps(0.5f));
+        return Vector2i(ClearUnused2(_mm_sub_epi32(_mm_cvtps_epi32(down), _mm_castps_si128(up))));
+    }
+
+    Vector2i Vector2i::Ceiling(const Vector2& vec)
+    {
+        return Vector2i(ClearUnused2(_mm_cvtps_epi32(_mm_ceil_ps(vec.elementsSIMD))));
+    }
+
+    Vector2 Vector2i::ToVector2(const Vector2i& vec)
+    {
+        return Vector2(_mm_cvtepi32_ps(vec.elementsSIMD));
+    }
+
+    void Vector2i::ToCells(const Vector2* positions, Vector2i* cells, const size_t count, const float cellSize)
+    {
+        __m128 invCellSize = _mm_set1_ps(1.0f / cellSize);
+
+        ParallelFor(count, 1 << 14, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                cells[i].elementsSIMD = ClearUnused2(_mm_cvtps_epi32(_mm_floor_ps(_mm_mul_ps(positions[i].elementsSIMD, invCellSize))));
+            }
+        });
+    }
+
+    int Vector2i::Dot(const Vector2i& vec1, const Vector2i& vec2)
+    {
+        __m128i products = ClearUnused2(_mm_mullo_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+        products = _mm_hadd_epi32(products, products);
+        products = _mm_hadd_epi32(products, products);
+        return _mm_cvtsi128_si32(products);
+    }
+
+    Vector2i Vector2i::Min(const Vector2i& vec1, const Vector2i& vec2)
+    {
+        return Vector2i(_mm_min_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector2i Vector2i::Max(const Vector2i& vec1, const Vector2i& vec2)
+    {
+        return Vector2i(_mm_max_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector2i Vector2i::Abs(const Vector2i& vec)
+    {
+        return Vector2i(_mm_abs_epi32(vec.elementsSIMD));
+    }
+
+    Vector2i Vector2i::LessThan(const Vector2i& vec1, const Vector2i& vec2)
+    {
+        return Vector2i(ClearUnused2(_mm_cmplt_epi32(vec1.elementsSIMD, vec2.elementsSIMD)));
+    }
+
+    Vector2i Vector2i::GreaterThan(const Vector2i& vec1, const Vector2i& vec2)
+    {
+        return Vector2i(ClearUnused2(_mm_cmpgt_epi32(vec1.elementsSIMD, vec2.elementsSIMD)));
+    }
+
+    Vector2i Vector2i::Equal(const Vector2i& vec1, const Vector2i& vec2)
+    {
+        return Vector2i(ClearUnused2(_mm_cmpeq_epi32(vec1.elementsSIMD, vec2.elementsSIMD)));
+    }
+
+    bool Vector2i::operator == (const Vector2i& vec) const
+    {
+        __m128i compare = _mm_cmpeq_epi32(elementsSIMD, vec.elementsSIMD);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(compare)) & 0x3;
+
+        return (mask == 0x3) ? true : false;
+    }
+
+    bool Vector2i::operator != (const Vector2i& vec) const
+    {
+        return !(*this == vec);
+    }
+
+    int Vector2i::operator [] (const int num) const
+    {
+        return elements[num];
+    }
+
+    Vector2i Vector2i::operator + (const Vector2i& vec) const
+    {
+        return Vector2i(_mm_add_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector2i Vector2i::operator - (const Vector2i& vec) const
+    {
+        return Vector2i(_mm_sub_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector2i Vector2i::operator * (const int num) const
+    {
+        return Vector2i(_mm_mullo_epi32(elementsSIMD, _mm_set1_epi32(num)));
+    }
+
+    Vector2i Vector2i::operator * (const Vector2i& vec) const
+    {
+        return Vector2i(_mm_mullo_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector2i Vector2i::operator << (const int num) const
+    {
+        return Vector2i(_mm_sll_epi32(elementsSIMD, _mm_cvtsi32_si128(num)));
+    }
+
+    Vector2i Vector2i::operator >> (const int num) const
+    {
+        return Vector2i(_mm_sra_epi32(elementsSIMD, _mm_cvtsi32_si128(num)));
+    }
+
+    Vector2i Vector2i::operator += (const Vector2i& vec)
+    {
+        *this = *this + vec;
+        return *this;
+    }
+
+    Vector2i Vector2i::operator -= (const Vector2i& vec)
+    {
+        *this = *this - vec;
+        return *this;
+    }
+
+    Vector2i Vector2i::operator *= (const int num)
+    {
+        *this = *this * num;
+        return *this;
+    }
+
+    Vector2i Vector2i::operator <<= (const int num)
+    {
+        *this = *this << num;
+        return *this;
+    }
+
+    Vector2i Vector2i::operator >>= (const int num)
+    {
+        *this = *this >> num;
+        return *this;
+    }
+}
\ No newline at end of file
@@ -5,9 +5,65 @@
 /* ********************************** */
 
 #include <NullX.h>
+#include <mutex>
 
 namespace NullX
 {
+    // Sums up to two __m128 terms per element with per-lane Kahan compensation on each thread,
+    // then merges the per-thread partials in double precision
+    template <int Terms, typename Term>
+    static void CompensatedSum(const size_t count, const Term& term, double totals[Terms * 4])
+    {
+        std::mutex merge;
+
+        for (int i = 0; i < Terms * 4; i++)
+        {
+            totals[i] = 0.0;
+        }
+
+        ParallelFor(count, 1 << 16, [&](size_t begin, size_t end)
+        {
+            __m128 sums[Terms];
+            __m128 compensation[Terms];
+            __m128 values[Terms];
+
+            for (int t = 0; t < Terms; t++)
+            {
+                sums[t] = _mm_setzero_ps();
+                compensation[t] = _mm_setzero_ps();
+            }
+
+            for (size_t i = begin; i < end; i++)
+            {
+                term(i, values);
+
+                for (int t = 0; t < Terms; t++)
+                {
+                    __m128 y = _mm_sub_ps(values[t], compensation[t]);
+                    __m128 sum = _mm_add_ps(sums[t], y);
+                    compensation[t] = _mm_sub_ps(_mm_sub_ps(sum, sums[t]), y);
+                    sums[t] = sum;
+                }
+            }
+
+            __declspec(align(16)) float lanes[Terms * 4];
+            __declspec(align(16)) float lost[Terms * 4];
+
+            for (int t = 0; t < Terms; t++)
+            {
+                _mm_store_ps(lanes + t * 4, sums[t]);
+                _mm_store_ps(lost + t * 4, compensation[t]);
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+
+            for (int i = 0; i < Terms * 4; i++)
+            {
+                totals[i] += static_cast<double>(lanes[i]) - static_cast<double>(lost[i]);
+            }
+        });
+    }
+
     Vector3 Vector3::Up = Vector3(0.0f, 1.0f, 0.0f);
     Vector3 Vector3::Down = Vector3(0.0f, -1.0f, 0.0f);
     Vector3 Vector3::Left = Vector3(-1.0f, 0.0f, 0.0f);
@@ -94,6 +150,99 @@ namespace NullX
         return Vector3(_mm_sub_ps(v1, v2));
     }
 
+    Vector3 Vector3::Sum(const Vector3* vecs, const size_t count)
+    {
+        double totals[4];
+        CompensatedSum<1>(count, [&](size_t i, __m128* values)
+        {
+            values[0] = vecs[i].elementsSIMD;
+        }, totals);
+
+        return Vector3(static_cast<float>(totals[0]), static_cast<float>(totals[1]), static_cast<float>(totals[2]));
+    }
+
+    Vector3 Vector3::Mean(const Vector3* vecs, const size_t count)
+    {
+        double totals[4];
+        CompensatedSum<1>(count, [&](size_t i, __m128* values)
+        {
+            values[0] = vecs[i].elementsSIMD;
+        }, totals);
+
+        double scale = (count > 0) ? 1.0 / count : 0.0;
+        return Vector3(static_cast<float>(totals[0] * scale), static_cast<float>(totals[1] * scale), static_cast<float>(totals[2] * scale));
+    }
+
+    Vector3 Vector3::Mean(const Vector3* vecs, const float* weights, const size_t count)
+    {
+        // The total weight rides along in the unused w lane
+        double totals[4];
+        CompensatedSum<1>(count, [&](size_t i, __m128* values)
+        {
+            __m128 weight = _mm_set1_ps(weights[i]);
+            values[0] = _mm_blend_ps(_mm_mul_ps(vecs[i].elementsSIMD, weight), weight, 0x8);
+        }, totals);
+
+        double scale = (totals[3] != 0.0) ? 1.0 / totals[3] : 0.0;
+        return Vector3(static_cast<float>(totals[0] * scale), static_cast<float>(totals[1] * scale), static_cast<float>(totals[2] * scale));
+    }
+
+    Vector3 Vector3::Min(const Vector3* vecs, const size_t count)
+    {
+        return AABB::FromPoints(vecs, count).min;
+    }
+
+    Vector3 Vector3::Max(const Vector3* vecs, const size_t count)
+    {
+        return AABB::FromPoints(vecs, count).max;
+    }
+
+    Matrix4 Vector3::Covariance(const Vector3* vecs, const size_t count)
+    {
+        // Two passes, products are taken about the mean so large offsets don't cancel
+        __m128 mean = Mean(vecs, count).elementsSIMD;
+        double totals[8];
+        CompensatedSum<2>(count, [&](size_t i, __m128* values)
+        {
+            __m128 diff = _mm_sub_ps(vecs[i].elementsSIMD, mean);
+            values[0] = _mm_mul_ps(diff, diff);
+            values[1] = _mm_mul_ps(diff, _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(3, 0, 2, 1)));
+        }, totals);
+
+        // totals holds xx, yy, zz, _ then xy, yz, zx, _
+        float scale = (count > 0) ? static_cast<float>(1.0 / count) : 0.0f;
+        float xx = static_cast<float>(totals[0]) * scale, yy = static_cast<float>(totals[1]) * scale, zz = static_cast<float>(totals[2]) * scale;
+        float xy = static_cast<float>(totals[4]) * scale, yz = static_cast<float>(totals[5]) * scale, zx = static_cast<float>(totals[6]) * scale;
+
+        return Matrix4(xx, xy, zx, 0.0f,
+                       xy, yy, yz, 0.0f,
+                       zx, yz, zz, 0.0f,
+                       0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    Matrix4 Vector3::Covariance(const Vector3* vecs, const float* weights, const size_t count)
+    {
+        __m128 mean = Mean(vecs, weights, count).elementsSIMD;
+        double totals[8];
+        CompensatedSum<2>(count, [&](size_t i, __m128* values)
+        {
+            __m128 weight = _mm_set1_ps(weights[i]);
+            __m128 diff = _mm_sub_ps(vecs[i].elementsSIMD, mean);
+            __m128 weighted = _mm_mul_ps(diff, weight);
+            values[0] = _mm_blend_ps(_mm_mul_ps(weighted, diff), weight, 0x8);
+            values[1] = _mm_mul_ps(weighted, _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(3, 0, 2, 1)));
+        }, totals);
+
+        float scale = (totals[3] != 0.0) ? static_cast<float>(1.0 / totals[3]) : 0.0f;
+        float xx = static_cast<float>(totals[0]) * scale, yy = static_cast<float>(totals[1]) * scale, zz = static_cast<float>(totals[2]) * scale;
+        float xy = static_cast<float>(totals[4]) * scale, yz = static_cast<float>(totals[5]) * scale, zx = static_cast<float>(totals[6]) * scale;
+
+        return Matrix4(xx, xy, zx, 0.0f,
+                       xy, yy, yz, 0.0f,
+                       zx, yz, zz, 0.0f,
+                       0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
     Vector2 Vector3::ToVector2(const Vector3& vec)
     {
         return Vector2(vec.x, vec.y);
@@ -106,10 +255,11 @@ namespace NullX
 
     bool Vector3::operator == (const Vector3& vec)
     {
+        // Only x, y & z are compared, the padding lane holds whatever the last SIMD operation left there
         __m128 compare = _mm_cmpeq_ps(elementsSIMD, vec.elementsSIMD);
-        int mask = _mm_movemask_ps(compare);
+        int mask = _mm_movemask_ps(compare) & 0x7;
 
-        return (mask == 0xF) ? true : false;
+        return (mask == 0x7) ? true : false;
     }
 
     bool Vector3::operator != (const Vector3& vec)
@@ -0,0 +1,184 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    // Keeps the unused lanes zero so comparisons & dot products can read the whole register
+    static __m128i ClearUnused3(const __m128i vec)
+    {
+        return _mm_blend_epi16(vec, _mm_setzero_si128(), 0xC0);
+    }
+
+    Vector3i::Vector3i() : elementsSIMD(_mm_setzero_si128())
+    {
+    }
+
+    Vector3i::Vector3i(int _x, int _y, int _z) : elementsSIMD(_mm_setr_epi32(_x, _y, _z, 0))
+    {
+    }
+
+    Vector3i::Vector3i(__m128i vec) : elementsSIMD(vec)
+    {
+    }
+
+    Vector3i::Vector3i(const Vector3i& vec) : elementsSIMD(vec.elementsSIMD)
+    {
+    }
+
+    Vector3i Vector3i::Floor(const Vector3& vec)
+    {
+        return Vector3i(ClearUnused3(_mm_cvtps_epi32(_mm_floor_ps(vec.elementsSIMD))));
+    }
+
+    Vector3i Vector3i::Round(const Vector3& vec)
+    {
+        // Exact halfway test on x - floor(x), as in Vector2i::Round
+        __m128 down = _mm_floor_ps(vec.elementsSIMD);
+        __m128 up = _mm_cmpge_ps(_mm_sub_ps(vec.elementsSIMD, down), _mm_set1_ps(0.5f));
+        return Vector3i(ClearUnused3(_mm_sub_epi32(_mm_cvtps_epi32(down), _mm_castps_si128(up))));
+    }
+
+    Vector3i Vector3i::Ceiling(const Vector3& vec)
+    {
+        return Vector3i(ClearUnused3(_mm_cvtps_epi32(_mm_ceil_ps(vec.elementsSIMD))));
+    }
+
+    Vector3 Vector3i::ToVector3(const Vector3i& vec)
+    {
+        return Vector3(_mm_cvtepi32_ps(vec.elementsSIMD));
+    }
+
+    void Vector3i::ToCells(const Vector3* positions, Vector3i* cells, const size_t count, const float cellSize)
+    {
+        __m128 invCellSize = _mm_set1_ps(1.0f / cellSize);
+
+        ParallelFor(count, 1 << 14, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                cells[i].elementsSIMD = ClearUnused3(_mm_cvtps_epi32(_mm_floor_ps(_mm_mul_ps(positions[i].elementsSIMD, invCellSize))));
+            }
+        });
+    }
+
+    int Vector3i::Dot(const Vector3i& vec1, const Vector3i& vec2)
+    {
+        __m128i products = ClearUnused3(_mm_mullo_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+        products = _mm_hadd_epi32(products, products);
+        products = _mm_hadd_epi32(products, products);
+        return _mm_cvtsi128_si32(products);
+    }
+
+    Vector3i Vector3i::Min(const Vector3i& vec1, const Vector3i& vec2)
+    {
+        return Vector3i(_mm_min_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector3i Vector3i::Max(const Vector3i& vec1, const Vector3i& vec2)
+    {
+        return Vector3i(_mm_max_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector3i Vector3i::Abs(const Vector3i& vec)
+    {
+        return Vector3i(_mm_abs_epi32(vec.elementsSIMD));
+    }
+
+    Vector3i Vector3i::LessThan(const Vector3i& vec1, const Vector3i& vec2)
+    {
+        return Vector3i(ClearUnused3(_mm_cmplt_epi32(vec1.elementsSIMD, vec2.elementsSIMD)));
+    }
+
+    Vector3i Vector3i::GreaterThan(const Vector3i& vec1, const Vector3i& vec2)
+    {
+        return Vector3i(ClearUnused3(_mm_cmpgt_epi32(vec1.elementsSIMD, vec2.elementsSIMD)));
+    }
+
+    Vector3i Vector3i::Equal(const Vector3i& vec1, const Vector3i& vec2)
+    {
+        return Vector3i(ClearUnused3(_mm_cmpeq_epi32(vec1.elementsSIMD, vec2.elementsSIMD)));
+    }
+
+    bool Vector3i::operator == (const Vector3i& vec) const
+    {
+        __m128i compare = _mm_cmpeq_epi32(elementsSIMD, vec.elementsSIMD);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(compare)) & 0x7;
+
+        return (mask == 0x7) ? true : false;
+    }
+
+    bool Vector3i::operator != (const Vector3i& vec) const
+    {
+        return !(*this == vec);
+    }
+
+    int Vector3i::operator [] (const int num) const
+    {
+        return elements[num];
+    }
+
+    Vector3i Vector3i::operator + (const Vector3i& vec) const
+    {
+        return Vector3i(_mm_add_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector3i Vector3i::operator - (const Vector3i& vec) const
+    {
+        return Vector3i(_mm_sub_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector3i Vector3i::operator * (const int num) const
+    {
+        return Vector3i(_mm_mullo_epi32(elementsSIMD, _mm_set1_epi32(num)));
+    }
+
+    Vector3i Vector3i::operator * (const Vector3i& vec) const
+    {
+        return Vector3i(_mm_mullo_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector3i Vector3i::operator << (const int num) const
+    {
+        return Vector3i(_mm_sll_epi32(elementsSIMD, _mm_cvtsi32_si128(num)));
+    }
+
+    Vector3i Vector3i::operator >> (const int num) const
+    {
+        return Vector3i(_mm_sra_epi32(elementsSIMD, _mm_cvtsi32_si128(num)));
+    }
+
+    Vector3i Vector3i::operator += (const Vector3i& vec)
+    {
+        *this = *this + vec;
+        return *this;
+    }
+
+    Vector3i Vector3i::operator -= (const Vector3i& vec)
+    {
+        *this = *this - vec;
+        return *this;
+    }
+
+    Vector3i Vector3i::operator *= (const int num)
+    {
+        *this = *this * num;
+        return *this;
+    }
+
+    Vector3i Vector3i::operator <<= (const int num)
+    {
+        *this = *this << num;
+        return *this;
+    }
+
+    Vector3i Vector3i::operator >>= (const int num)
+    {
+        *this = *this >> num;
+        return *this;
+    }
+}
\ No newline at end of file
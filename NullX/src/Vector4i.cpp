@@ -0,0 +1,167 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    Vector4i::Vector4i() : elementsSIMD(_mm_setzero_si128())
+    {
+    }
+
+    Vector4i::Vector4i(int _x, int _y, int _z, int _w) : elementsSIMD(_mm_setr_epi32(_x, _y, _z, _w))
+    {
+    }
+
+    Vector4i::Vector4i(__m128i vec) : elementsSIMD(vec)
+    {
+    }
+
+    Vector4i::Vector4i(const Vector4i& vec) : elementsSIMD(vec.elementsSIMD)
+    {
+    }
+
+    Vector4i Vector4i::Floor(const Vector4& vec)
+    {
+        return Vector4i(_mm_cvtps_epi32(_mm_floor_ps(vec.elementsSIMD)));
+    }
+
+    Vector4i Vector4i::Round(const Vector4& vec)
+    {
+        // Exact halfway test on x - floor(x), as in Vector2i::Round
+        __m128 down = _mm_floor_ps(vec.elementsSIMD);
+        __m128 up = _mm_cmpge_ps(_mm_sub_ps(vec.elementsSIMD, down), _mm_set1_ps(0.5f));
+        return Vector4i(_mm_sub_epi32(_mm_cvtps_epi32(down), _mm_castps_si128(up)));
+    }
+
+    Vector4i Vector4i::Ceiling(const Vector4& vec)
+    {
+        return Vector4i(_mm_cvtps_epi32(_mm_ceil_ps(vec.elementsSIMD)));
+    }
+
+    Vector4 Vector4i::ToVector4(const Vector4i& vec)
+    {
+        Vector4 toReturn = Vector4();
+        toReturn.elementsSIMD = _mm_cvtepi32_ps(vec.elementsSIMD);
+        return toReturn;
+    }
+
+    int Vector4i::Dot(const Vector4i& vec1, const Vector4i& vec2)
+    {
+        __m128i products = _mm_mullo_epi32(vec1.elementsSIMD, vec2.elementsSIMD);
+        products = _mm_hadd_epi32(products, products);
+        products = _mm_hadd_epi32(products, products);
+        return _mm_cvtsi128_si32(products);
+    }
+
+    Vector4i Vector4i::Min(const Vector4i& vec1, const Vector4i& vec2)
+    {
+        return Vector4i(_mm_min_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector4i Vector4i::Max(const Vector4i& vec1, const Vector4i& vec2)
+    {
+        return Vector4i(_mm_max_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector4i Vector4i::Abs(const Vector4i& vec)
+    {
+        return Vector4i(_mm_abs_epi32(vec.elementsSIMD));
+    }
+
+    Vector4i Vector4i::LessThan(const Vector4i& vec1, const Vector4i& vec2)
+    {
+        return Vector4i(_mm_cmplt_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector4i Vector4i::GreaterThan(const Vector4i& vec1, const Vector4i& vec2)
+    {
+        return Vector4i(_mm_cmpgt_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    Vector4i Vector4i::Equal(const Vector4i& vec1, const Vector4i& vec2)
+    {
+        return Vector4i(_mm_cmpeq_epi32(vec1.elementsSIMD, vec2.elementsSIMD));
+    }
+
+    bool Vector4i::operator == (const Vector4i& vec) const
+    {
+        __m128i compare = _mm_cmpeq_epi32(elementsSIMD, vec.elementsSIMD);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(compare)) & 0xF;
+
+        return (mask == 0xF) ? true : false;
+    }
+
+    bool Vector4i::operator != (const Vector4i& vec) const
+    {
+        return !(*this == vec);
+    }
+
+    int Vector4i::operator [] (const int num) const
+    {
+        return elements[num];
+    }
+
+    Vector4i Vector4i::operator + (const Vector4i& vec) const
+    {
+        return Vector4i(_mm_add_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector4i Vector4i::operator - (const Vector4i& vec) const
+    {
+        return Vector4i(_mm_sub_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector4i Vector4i::operator * (const int num) const
+    {
+        return Vector4i(_mm_mullo_epi32(elementsSIMD, _mm_set1_epi32(num)));
+    }
+
+    Vector4i Vector4i::operator * (const Vector4i& vec) const
+    {
+        return Vector4i(_mm_mullo_epi32(elementsSIMD, vec.elementsSIMD));
+    }
+
+    Vector4i Vector4i::operator << (const int num) const
+    {
+        return Vector4i(_mm_sll_epi32(elementsSIMD, _mm_cvtsi32_si128(num)));
+    }
+
+    Vector4i Vector4i::operator >> (const int num) const
+    {
+        return Vector4i(_mm_sra_epi32(elementsSIMD, _mm_cvtsi32_si128(num)));
+    }
+
+    Vector4i Vector4i::operator += (const Vector4i& vec)
+    {
+        *this = *this + vec;
+        return *this;
+    }
+
+    Vector4i Vector4i::operator -= (const Vector4i& vec)
+    {
+        *this = *this - vec;
+        return *this;
+    }
+
+    Vector4i Vector4i::operator *= (const int num)
+    {
+        *this = *this * num;
+        return *this;
+    }
+
+    Vector4i Vector4i::operator <<= (const int num)
+    {
+        *this = *this << num;
+        return *this;
+    }
+
+    Vector4i Vector4i::operator >>= (const int num)
+    {
+        *this = *this >> num;
+        return *this;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <NullX.h>
+
+namespace NullX
+{
+    template <typename T>
+    VectorN<T>::VectorN()
+    {
+    }
+
+    template <typename T>
+    VectorN<T>::VectorN(const size_t size, const T value) : elements(size, value)
+    {
+    }
+
+    template <typename T>
+    size_t VectorN<T>::Size() const
+    {
+        return elements.size();
+    }
+
+    template <typename T>
+    T* VectorN<T>::Data()
+    {
+        return elements.data();
+    }
+
+    template <typename T>
+    const T* VectorN<T>::Data() const
+    {
+        return elements.data();
+    }
+
+    template <typename T>
+    T VectorN<T>::Dot(const VectorN& vec1, const VectorN& vec2)
+    {
+        // Four running sums break the dependency chain so the adds can overlap
+        T sums[4] = { T(0), T(0), T(0), T(0) };
+        size_t size = vec1.Size();
+        size_t i = 0;
+
+        for (; i + 4 <= size; i += 4)
+        {
+            sums[0] += vec1.elements[i] * vec2.elements[i];
+            sums[1] += vec1.elements[i + 1] * vec2.elements[i + 1];
+            sums[2] += vec1.elements[i + 2] * vec2.elements[i + 2];
+            sums[3] += vec1.elements[i + 3] * vec2.elements[i + 3];
+        }
+
+        for (; i < size; i++)
+        {
+            sums[0] += vec1.elements[i] * vec2.elements[i];
+        }
+
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    template <typename T>
+    T VectorN<T>::Magnitude(const VectorN& vec)
+    {
+        return sqrt(Dot(vec, vec));
+    }
+
+    template <typename T>
+    T& VectorN<T>::operator [] (const size_t index)
+    {
+        return elements[index];
+    }
+
+    template <typename T>
+    const T& VectorN<T>::operator [] (const size_t index) const
+    {
+        return elements[index];
+    }
+
+    template <typename T>
+    VectorN<T> VectorN<T>::operator + (const VectorN& vec) const
+    {
+        VectorN toReturn = VectorN(*this);
+        toReturn += vec;
+        return toReturn;
+    }
+
+    template <typename T>
+    VectorN<T> VectorN<T>::operator - (const VectorN& vec) const
+    {
+        VectorN toReturn = VectorN(*this);
+        toReturn -= vec;
+        return toReturn;
+    }
+
+    template <typename T>
+    VectorN<T> VectorN<T>::operator * (const T num) const
+    {
+        VectorN toReturn = VectorN(*this);
+        toReturn *= num;
+        return toReturn;
+    }
+
+    template <typename T>
+    VectorN<T>& VectorN<T>::operator += (const VectorN& vec)
+    {
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            elements[i] += vec.elements[i];
+        }
+
+        return *this;
+    }
+
+    template <typename T>
+    VectorN<T>& VectorN<T>::operator -= (const VectorN& vec)
+    {
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            elements[i] -= vec.elements[i];
+        }
+
+        return *this;
+    }
+
+    template <typename T>
+    VectorN<T>& VectorN<T>::operator *= (const T num)
+    {
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            elements[i] *= num;
+        }
+
+        return *this;
+    }
+
+    template class VectorN<float>;
+    template class VectorN<double>;
+}
\ No newline at end of file
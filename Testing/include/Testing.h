@@ -0,0 +1,109 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#pragma once
+
+#include <NullX.h>
+#include <chrono>
+
+namespace Testing
+{
+    /// Counts a failure & prints the printf style message if condition is false
+    /// \return condition
+    bool Check(const bool condition, const char* format, ...);
+
+    /// \return number of failed checks so far
+    int  Failures();
+
+    /// \return uniformly distributed float in [min, max) from a fixed seed, so runs are repeatable
+    float RandomFloat(const float min, const float max);
+
+    /// \return Vector3 with each element drawn from RandomFloat(min, max)
+    NullX::Vector3 RandomVector3(const float min, const float max);
+
+    /// Prints count / seconds as a throughput figure in millions of unit per second
+    void Report(const char* name, const double count, const double seconds, const char* unit);
+
+    /// Wall clock stopwatch, started on construction
+    class Timer
+    {
+    public:
+        /// Timer Default Constructor.  Starts the timer
+        Timer();
+
+        /// Starts the timer again from zero
+        void   Restart();
+
+        /// \return seconds since construction or the last Restart
+        double Seconds() const;
+
+    private:
+        std::chrono::high_resolution_clock::time_point start;
+    };
+
+    /// Checks streamed against cached stores & sweeps output sizes from L1 to DRAM for the streaming crossover
+    void TestStreaming();
+
+    /// Checks BVH hits against brute force Moller-Trumbore, axis aligned rays included, & times rays per second
+    void TestBVH();
+
+    /// Checks KDTree nearest & radius queries against brute force & times build and query rates
+    void TestKDTree();
+
+    /// Checks SpatialHashGrid neighbour queries & lists against brute force & times rebuilds
+    void TestSpatialHashGrid();
+
+    /// Checks AABB & BoundingSphere fits contain their input points & times the parallel fits
+    void TestBounds();
+
+    /// Checks Eigen, SVD, Polar & Decompose reconstruct their input & times the batches
+    void TestDecomposition();
+
+    /// Checks MatrixN Gemm against a naive product & LU solves by their residual, & times both
+    void TestMatrixN();
+
+    /// Checks OcclusionBuffer depth against a reference rasterizer & occludee culling for false positives, & times a frame
+    void TestOcclusionBuffer();
+
+    /// Checks every ParticleIntegrator scheme against a scalar reference & Verlet against free fall, & times particles per second
+    void TestParticleIntegrator();
+
+    /// Checks IKSolver chains keep their bones & roots & reach their targets, & times chains per second
+    void TestIKSolver();
+
+    /// Checks Noise range, continuity, lane independence & seeding, Grid & Evaluate against Fractal, & times samples per second
+    void TestNoise();
+
+    /// Checks Mesh normals against a scalar sum & a sphere, tangents for orthogonality & handedness, Weld against brute force, & times triangles per second
+    void TestMesh();
+
+    /// Checks BroadPhase pairs against brute force after Build & Update, on a touching lattice, & times boxes per second
+    void TestBroadPhase();
+
+    /// Checks NarrowPhase sphere, capsule & box contacts against closed forms, SAT against EPA, & times pairs per second
+    void TestNarrowPhase();
+
+    /// Checks Floor, Round & Ceiling on every integer vector against exact halfway rounding, ToCells against the floored product, & times both
+    void TestIntVectors();
+
+    /// Checks the sRGB transfer functions against a double reference, 8 bit & half packing against exact rounding & F16C, & times pixels per second
+    void TestColor();
+
+    /// Checks Spline batches against closed form Bezier & Hermite curves & single evaluation, arc length against a polyline, & times points per second
+    void TestSpline();
+    /// Checks Rotate, FromMatrix, FromEuler & ToEuler round trips, single & batch, & Integrate against the exponential map
+    void TestQuaternion();
+    /// Checks Morton codes against a bit by bit interleave, Hilbert codes for adjacency, the batch encoders & the radix sort order, & times the sort
+    void TestSpaceFillingCurve();
+    /// Checks ProjectPoints against Matrix4 * Vector4 & the viewport transform, its clip flags on every side & every tail length
+    void TestMatrix4();
+    /// Checks Random for repeatable seeds & the moments of its sphere, ball, hemisphere & rotation samplers, & times them
+    void TestRandom();
+    /// Checks the cached Transform matrix & inverse against TRS products, the dirty flags after every edit, & times UpdateMatrices
+    void TestTransform();
+    /// Checks the compensated Vector3 sum, means & covariances against double on ill-conditioned points, min & max against a scan
+    void TestVector3();
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Scalar Moller-Trumbore in double over every triangle, the reference the BVH has to agree with
+    static bool BruteForce(const std::vector<Vector3>& vertices, const Ray& ray, RayHit& hit)
+    {
+        double best = ray.tMax;
+        hit = RayHit();
+
+        for (size_t i = 0; i + 2 < vertices.size(); i += 3)
+        {
+            const Vector3& a = vertices[i];
+            double e1[3] = { vertices[i + 1].x - a.x, vertices[i + 1].y - a.y, vertices[i + 1].z - a.z };
+            double e2[3] = { vertices[i + 2].x - a.x, vertices[i + 2].y - a.y, vertices[i + 2].z - a.z };
+            double d[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+            double s[3] = { ray.origin.x - a.x, ray.origin.y - a.y, ray.origin.z - a.z };
+            double p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+            double q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+            double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+
+            if (fabs(det) < 1e-12)
+            {
+                continue;
+            }
+
+            double u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+            double v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+            double t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+
+            if (u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t >= 0.0 && t < best)
+            {
+                best = t;
+                hit.t = static_cast<float>(t);
+                hit.u = static_cast<float>(u);
+                hit.v = static_cast<float>(v);
+                hit.triangle = static_cast<int>(i / 3);
+            }
+        }
+
+        return hit.triangle >= 0;
+    }
+
+    // Triangles hit within float round off of each other may legitimately swap, so compare distances rather than ids
+    static bool SameHit(const RayHit& hit, const RayHit& reference)
+    {
+        if (hit.triangle < 0 || reference.triangle < 0)
+        {
+            return hit.triangle == reference.triangle;
+        }
+
+        return fabsf(hit.t - reference.t) <= 1e-4f * (1.0f + reference.t);
+    }
+
+    static std::vector<Vector3> RandomTriangles(const size_t count, const float extent, const float size)
+    {
+        std::vector<Vector3> vertices = std::vector<Vector3>(count * 3);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Vector3 center = RandomVector3(-extent, extent);
+
+            for (int j = 0; j < 3; j++)
+            {
+                Vector3 offset = RandomVector3(-size, size);
+                vertices[i * 3 + j] = Vector3(center.x + offset.x, center.y + offset.y, center.z + offset.z);
+            }
+        }
+
+        return vertices;
+    }
+
+    static void CheckRays(const BVH& bvh, const std::vector<Vector3>& vertices, const std::vector<Ray>& rays, const char* name)
+    {
+        std::vector<RayHit> batch = std::vector<RayHit>(rays.size());
+        bvh.Intersect(rays.data(), batch.data(), rays.size());
+        int mismatches = 0;
+        int hits = 0;
+
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            RayHit reference = RayHit();
+            RayHit single = RayHit();
+            bool expected = BruteForce(vertices, rays[i], reference);
+            bool found = bvh.Intersect(rays[i], single);
+            bool blocked = bvh.Occluded(rays[i]);
+            hits += expected ? 1 : 0;
+            mismatches += (found != expected || blocked != expected || !SameHit(single, reference) || !SameHit(batch[i], reference)) ? 1 : 0;
+        }
+
+        for (size_t i = 0; i + 3 < rays.size(); i += 4)
+        {
+            RayHit packet[4];
+            bvh.IntersectPacket(&rays[i], packet);
+
+            for (int j = 0; j < 4; j++)
+            {
+                RayHit reference = RayHit();
+                BruteForce(vertices, rays[i + j], reference);
+                mismatches += SameHit(packet[j], reference) ? 0 : 1;
+            }
+        }
+
+        Check(hits > 0, "%s rays never hit anything", name);
+        Check(mismatches == 0, "%d of %zu %s rays disagree with brute force", mismatches, rays.size(), name);
+    }
+
+    void TestBVH()
+    {
+        printf("BVH\n");
+
+        std::vector<Vector3> vertices = RandomTriangles(2000, 10.0f, 1.0f);
+        BVH bvh = BVH();
+        bvh.Build(vertices.data(), vertices.size() / 3);
+        Check(bvh.TriangleCount() == vertices.size() / 3, "BVH holds %zu triangles", bvh.TriangleCount());
+
+        // Zero direction components are where the slab test produced NaN
+        const Vector3 axes[6] = { Vector3(1.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f),
+                                  Vector3(0.0f, -1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f) };
+        std::vector<Ray> aligned = std::vector<Ray>();
+
+        for (int axis = 0; axis < 6; axis++)
+        {
+            for (int i = 0; i < 200; i++)
+            {
+                Vector3 origin = RandomVector3(-10.0f, 10.0f);
+                aligned.push_back(Ray(Vector3(origin.x - axes[axis].x * 15.0f, origin.y - axes[axis].y * 15.0f, origin.z - axes[axis].z * 15.0f), axes[axis], 100.0f));
+            }
+        }
+
+        CheckRays(bvh, vertices, aligned, "axis aligned");
+
+        std::vector<Ray> random = std::vector<Ray>();
+
+        for (int i = 0; i < 2000; i++)
+        {
+            random.push_back(Ray(RandomVector3(-15.0f, 15.0f), RandomVector3(-1.0f, 1.0f), RandomFloat(5.0f, 40.0f)));
+        }
+
+        CheckRays(bvh, vertices, random, "random");
+
+        // Throughput over a scene too big for the caches
+        std::vector<Vector3> scene = RandomTriangles(1000000, 100.0f, 1.0f);
+        std::vector<Ray> rays = std::vector<Ray>(1000000);
+        std::vector<RayHit> hits = std::vector<RayHit>(rays.size());
+
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            rays[i] = Ray(RandomVector3(-100.0f, 100.0f), RandomVector3(-1.0f, 1.0f), 1000.0f);
+        }
+
+        Timer timer = Timer();
+        bvh.Build(scene.data(), scene.size() / 3);
+        Report("Build 1M triangles", static_cast<double>(scene.size() / 3), timer.Seconds(), "tri");
+
+        timer.Restart();
+        bvh.Intersect(rays.data(), hits.data(), rays.size());
+        Report("Intersect batch", static_cast<double>(rays.size()), timer.Seconds(), "ray");
+
+        timer.Restart();
+
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            bvh.Occluded(rays[i]);
+        }
+
+        Report("Occluded single", static_cast<double>(rays.size()), timer.Seconds(), "ray");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    void TestBounds()
+    {
+        printf("Bounds\n");
+
+        // Every fit has to contain its own input points exactly as Contains tests them
+        int sphereMisses = 0;
+        int boxMisses = 0;
+        int boxLoose = 0;
+
+        for (int fit = 0; fit < 2000; fit++)
+        {
+            std::vector<Vector3> points = std::vector<Vector3>(1 + fit % 200);
+            Vector3 offset = RandomVector3(-1000.0f, 1000.0f);
+            float scale = RandomFloat(0.001f, 100.0f);
+
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                Vector3 point = RandomVector3(-scale, scale);
+                points[i] = Vector3(point.x + offset.x, point.y + offset.y, point.z + offset.z);
+            }
+
+            BoundingSphere sphere = BoundingSphere::FromPoints(points.data(), points.size());
+            AABB box = AABB::FromPoints(points.data(), points.size());
+            AABB expected = AABB();
+            bool sphereContains = true;
+            bool boxContains = true;
+
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                sphereContains = sphereContains && sphere.Contains(points[i]);
+                boxContains = boxContains && box.Contains(points[i]);
+                expected.Expand(points[i]);
+            }
+
+            sphereMisses += sphereContains ? 0 : 1;
+            boxMisses += boxContains ? 0 : 1;
+            boxLoose += (box.min == expected.min && box.max == expected.max) ? 0 : 1;
+        }
+
+        Check(sphereMisses == 0, "%d of 2000 BoundingSphere fits leave an input point outside", sphereMisses);
+        Check(boxMisses == 0, "%d of 2000 AABB fits leave an input point outside", boxMisses);
+        Check(boxLoose == 0, "%d of 2000 AABB fits differ from the serial Expand bounds", boxLoose);
+
+        // Parallel fitting rates over a point cloud bigger than the caches
+        std::vector<Vector3> cloud = std::vector<Vector3>(10000000);
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            cloud[i] = RandomVector3(-100.0f, 100.0f);
+        }
+
+        Timer timer = Timer();
+        AABB box = AABB::FromPoints(cloud.data(), cloud.size());
+        Report("AABB::FromPoints", static_cast<double>(cloud.size()), timer.Seconds(), "point");
+
+        timer.Restart();
+        BoundingSphere sphere = BoundingSphere::FromPoints(cloud.data(), cloud.size());
+        Report("BoundingSphere::FromPoints", static_cast<double>(cloud.size()), timer.Seconds(), "point");
+        Check(box.Contains(cloud[0]) && sphere.Contains(cloud[0]), "fits over the cloud miss its first point");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <algorithm>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Every overlapping pair by brute force, touching boxes included, lower index first & sorted
+    static std::vector<unsigned long long> ReferencePairs(const std::vector<AABB>& boxes)
+    {
+        std::vector<unsigned long long> toReturn = std::vector<unsigned long long>();
+
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            for (size_t j = i + 1; j < boxes.size(); j++)
+            {
+                if (boxes[i].min.x <= boxes[j].max.x && boxes[j].min.x <= boxes[i].max.x &&
+                    boxes[i].min.y <= boxes[j].max.y && boxes[j].min.y <= boxes[i].max.y &&
+                    boxes[i].min.z <= boxes[j].max.z && boxes[j].min.z <= boxes[i].max.z)
+                {
+                    toReturn.push_back((static_cast<unsigned long long>(i) << 32) | j);
+                }
+            }
+        }
+
+        return toReturn;
+    }
+
+    // Pairs as sorted keys, with any pair not stored lower index first made invalid so it can't match
+    static std::vector<unsigned long long> FoundPairs(const BroadPhase& broadPhase)
+    {
+        std::vector<unsigned long long> toReturn = std::vector<unsigned long long>(broadPhase.PairCount());
+
+        for (size_t i = 0; i < broadPhase.PairCount(); i++)
+        {
+            unsigned int lower = broadPhase.Pairs()[i * 2];
+            unsigned int upper = broadPhase.Pairs()[i * 2 + 1];
+            toReturn[i] = (lower < upper) ? (static_cast<unsigned long long>(lower) << 32) | upper : ~0ull;
+        }
+
+        std::sort(toReturn.begin(), toReturn.end());
+        return toReturn;
+    }
+
+    static bool SortedByMinX(const BroadPhase& broadPhase, const std::vector<AABB>& boxes)
+    {
+        std::vector<unsigned int> ids = std::vector<unsigned int>(broadPhase.SortedIds(), broadPhase.SortedIds() + broadPhase.Size());
+        bool toReturn = broadPhase.Size() == boxes.size();
+
+        for (size_t i = 1; toReturn && i < ids.size(); i++)
+        {
+            toReturn = boxes[ids[i - 1]].min.x <= boxes[ids[i]].min.x;
+        }
+
+        std::sort(ids.begin(), ids.end());
+
+        for (size_t i = 0; toReturn && i < ids.size(); i++)
+        {
+            toReturn = ids[i] == i;
+        }
+
+        return toReturn;
+    }
+
+    static AABB RandomBox(const float range, const float maxExtent)
+    {
+        Vector3 centre = RandomVector3(-range, range);
+        Vector3 extent = RandomVector3(0.0f, maxExtent);
+        return AABB(Vector3(centre.x - extent.x, centre.y - extent.y, centre.z - extent.z), Vector3(centre.x + extent.x, centre.y + extent.y, centre.z + extent.z));
+    }
+
+    void TestBroadPhase()
+    {
+        printf("BroadPhase\n");
+
+        // More than one sweep chunk, negative & positive x, a few large boxes & some exact duplicates
+        std::vector<AABB> boxes = std::vector<AABB>(3 * BroadPhase::ChunkSize + 123);
+
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            boxes[i] = RandomBox(50.0f, (i % 100 == 0) ? 8.0f : 1.0f);
+        }
+
+        for (size_t i = 0; i < 50; i++)
+        {
+            boxes[boxes.size() - 1 - i] = boxes[i * 3];
+        }
+
+        BroadPhase broadPhase = BroadPhase();
+        broadPhase.Build(boxes.data(), boxes.size());
+        std::vector<unsigned long long> expected = ReferencePairs(boxes);
+        std::vector<unsigned int> firstOrder = std::vector<unsigned int>(broadPhase.Pairs(), broadPhase.Pairs() + broadPhase.PairCount() * 2);
+        Check(SortedByMinX(broadPhase, boxes), "Build SortedIds isn't a permutation sorted by min x");
+        Check(FoundPairs(broadPhase) == expected, "Build found %zu pairs, brute force %zu", broadPhase.PairCount(), expected.size());
+
+        broadPhase.Build(boxes.data(), boxes.size());
+        Check(std::vector<unsigned int>(broadPhase.Pairs(), broadPhase.Pairs() + broadPhase.PairCount() * 2) == firstOrder, "Build pair order changed between runs");
+
+        // Small moves take the insertion sort path, large ones fall back to Build, both have to match brute force
+        const float moves[2] = { 0.05f, 60.0f };
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (size_t i = 0; i < boxes.size(); i++)
+            {
+                Vector3 offset = RandomVector3(-moves[pass], moves[pass]);
+                boxes[i] = AABB(Vector3(boxes[i].min.x + offset.x, boxes[i].min.y + offset.y, boxes[i].min.z + offset.z),
+                                Vector3(boxes[i].max.x + offset.x, boxes[i].max.y + offset.y, boxes[i].max.z + offset.z));
+            }
+
+            broadPhase.Update(boxes.data(), boxes.size());
+            expected = ReferencePairs(boxes);
+            Check(SortedByMinX(broadPhase, boxes), "Update moving %g left SortedIds unsorted", moves[pass]);
+            Check(FoundPairs(broadPhase) == expected, "Update moving %g found %zu pairs, brute force %zu", moves[pass], broadPhase.PairCount(), expected.size());
+        }
+
+        // Count changes rebuild
+        boxes.resize(boxes.size() - 1000);
+        broadPhase.Update(boxes.data(), boxes.size());
+        expected = ReferencePairs(boxes);
+        Check(FoundPairs(broadPhase) == expected, "Update after shrinking found %zu pairs, brute force %zu", broadPhase.PairCount(), expected.size());
+
+        // Unit cubes on a 10^3 lattice touch all 26 neighbours & nothing else
+        const int side = 10;
+        std::vector<AABB> lattice = std::vector<AABB>();
+
+        for (int x = 0; x < side; x++)
+        {
+            for (int y = 0; y < side; y++)
+            {
+                for (int z = 0; z < side; z++)
+                {
+                    lattice.push_back(AABB(Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)),
+                                           Vector3(x + 1.0f, y + 1.0f, z + 1.0f)));
+                }
+            }
+        }
+
+        // Neighbouring pairs along each of the 13 directions with a positive first non zero component
+        size_t latticePairs = 3 * (side - 1) * side * side + 6 * (side - 1) * (side - 1) * side + 4 * (side - 1) * (side - 1) * (side - 1);
+        broadPhase.Build(lattice.data(), lattice.size());
+        Check(broadPhase.PairCount() == latticePairs, "touching lattice gave %zu pairs, expected %zu", broadPhase.PairCount(), latticePairs);
+        broadPhase.Build(nullptr, 0);
+        Check(broadPhase.PairCount() == 0 && broadPhase.Size() == 0, "empty Build left %zu pairs", broadPhase.PairCount());
+
+        // 200k sparse boxes, where the cost is the x sweep rather than the pairs, then a frame of small moves
+        std::vector<AABB> scene = std::vector<AABB>(200000);
+
+        for (size_t i = 0; i < scene.size(); i++)
+        {
+            scene[i] = RandomBox(500.0f, 3.0f);
+        }
+
+        Timer timer = Timer();
+        broadPhase.Build(scene.data(), scene.size());
+        Report("Build 200k boxes", static_cast<double>(scene.size()), timer.Seconds(), "box");
+
+        for (size_t i = 0; i < scene.size(); i++)
+        {
+            float offset = RandomFloat(-0.1f, 0.1f);
+            scene[i] = AABB(Vector3(scene[i].min.x + offset, scene[i].min.y, scene[i].min.z), Vector3(scene[i].max.x + offset, scene[i].max.y, scene[i].max.z));
+        }
+
+        timer.Restart();
+        broadPhase.Update(scene.data(), scene.size());
+        Report("Update 200k boxes", static_cast<double>(scene.size()), timer.Seconds(), "box");
+    }
+}
\ No newline at end of file
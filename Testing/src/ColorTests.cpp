@@ -0,0 +1,233 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static double DecodeReference(const double c)
+    {
+        return (c <= 0.04045) ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+    }
+
+    static double EncodeReference(const double x)
+    {
+        return (x <= 0.0031308) ? x * 12.92 : 1.055 * pow(x, 1.0 / 2.4) - 0.055;
+    }
+
+    // Pixels with RGB spread over [min, max] & a random alpha, a count that leaves a tail group
+    static std::vector<Vector4> RandomPixels(const size_t count, const float min, const float max)
+    {
+        std::vector<Vector4> toReturn = std::vector<Vector4>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            toReturn[i] = Vector4(RandomFloat(min, max), RandomFloat(min, max), RandomFloat(min, max), RandomFloat(0.0f, 1.0f));
+        }
+
+        return toReturn;
+    }
+
+    // Largest error of the RGB channels of out against reference(in), relative to max(|reference|, floor), & whether every alpha came through bit for bit
+    static double ChannelError(const std::vector<Vector4>& in, const std::vector<Vector4>& out, double (*reference)(const double), const double floor, bool& alphaKept)
+    {
+        double toReturn = 0.0;
+        alphaKept = true;
+
+        for (size_t i = 0; i < in.size(); i++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                double expected = reference(in[i].elements[c]);
+                double error = fabs(out[i].elements[c] - expected) / fmax(fabs(expected), floor);
+                toReturn = (error > toReturn) ? error : toReturn;
+            }
+
+            alphaKept = alphaKept && memcmp(&in[i].w, &out[i].w, sizeof(float)) == 0;
+        }
+
+        return toReturn;
+    }
+
+    static void CheckTransferFunctions()
+    {
+        // Every representable channel in [0, 1] at a stride, then random pixels with some channels above 1 to reach the Pow fallback
+        std::vector<Vector4> sweep = std::vector<Vector4>();
+
+        for (unsigned int bits = 0; bits <= 0x3F800000; bits += 97)
+        {
+            float c;
+            memcpy(&c, &bits, sizeof(float));
+            sweep.push_back(Vector4(c, 1.0f - c, c * 0.5f, c));
+        }
+
+        std::vector<Vector4> mixed = RandomPixels(100003, -0.01f, 1.3f);
+        std::vector<Vector4> out = std::vector<Vector4>(sweep.size());
+        bool alphaKept = false;
+
+        Color::SRGBToLinear(sweep.data(), out.data(), sweep.size());
+        double decodeError = ChannelError(sweep, out, DecodeReference, 1e-30, alphaKept);
+        Check(decodeError < 5e-6 && alphaKept, "SRGBToLinear relative error %g on [0, 1] or alpha changed", decodeError);
+
+        Color::LinearToSRGB(sweep.data(), out.data(), sweep.size());
+        double encodeError = ChannelError(sweep, out, EncodeReference, 1.0, alphaKept);
+        Check(encodeError < 5e-6 && alphaKept, "LinearToSRGB absolute error %g on [0, 1] or alpha changed", encodeError);
+        printf("  sRGB decode relative error %.2g, encode absolute error %.2g\n", decodeError, encodeError);
+
+        out.resize(mixed.size());
+        Color::SRGBToLinear(mixed.data(), out.data(), mixed.size());
+        double mixedDecode = ChannelError(mixed, out, DecodeReference, 1e-30, alphaKept);
+        Check(mixedDecode < 5e-6 && alphaKept, "SRGBToLinear relative error %g with channels above 1", mixedDecode);
+
+        Color::LinearToSRGB(mixed.data(), out.data(), mixed.size());
+        double mixedEncode = ChannelError(mixed, out, EncodeReference, 1.0, alphaKept);
+        Check(mixedEncode < 5e-6 && alphaKept, "LinearToSRGB error %g with channels above 1", mixedEncode);
+
+        // Converting in place has to give the same as converting out of place
+        std::vector<Vector4> inPlace = mixed;
+        Color::LinearToSRGB(inPlace.data(), inPlace.data(), inPlace.size());
+        Check(memcmp(inPlace.data(), out.data(), out.size() * sizeof(Vector4)) == 0, "LinearToSRGB in place differs from out of place");
+    }
+
+    static void CheckPacking()
+    {
+        // Every 8 bit sRGB code decodes & re-encodes to itself
+        std::vector<unsigned int> codes = std::vector<unsigned int>(256);
+        std::vector<unsigned int> repacked = std::vector<unsigned int>(256);
+        std::vector<Vector4> decoded = std::vector<Vector4>(256);
+
+        for (unsigned int i = 0; i < 256; i++)
+        {
+            codes[i] = i | ((255 - i) << 8) | (((i * 7) & 0xFF) << 16) | (i << 24);
+        }
+
+        Color::UnpackSRGB8(codes.data(), decoded.data(), codes.size());
+        Color::PackSRGB8(decoded.data(), repacked.data(), codes.size());
+        Check(codes == repacked, "PackSRGB8 does not invert UnpackSRGB8 on every code");
+
+        // Encoded channels round like the double reference, except within the fit error of a rounding boundary
+        std::vector<Vector4> pixels = RandomPixels(200003, -0.1f, 1.1f);
+        std::vector<unsigned int> packed = std::vector<unsigned int>(pixels.size());
+        Color::PackSRGB8(pixels.data(), packed.data(), pixels.size());
+        size_t misses = 0;
+
+        for (size_t i = 0; i < pixels.size(); i++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                double value = (c < 3) ? EncodeReference(pixels[i].elements[c]) : pixels[i].elements[c];
+                double scaled = fmin(fmax(value, 0.0), 1.0) * 255.0;
+                unsigned int expected = static_cast<unsigned int>(floor(scaled + 0.5));
+                bool boundary = fabs(scaled - floor(scaled) - 0.5) < 255.0 * 5e-6;
+                misses += (((packed[i] >> (c * 8)) & 0xFF) == expected || boundary) ? 0 : 1;
+            }
+        }
+
+        Check(misses == 0, "%zu PackSRGB8 channels round differently from the reference", misses);
+
+        // The half conversions have to match F16C bit for bit, every AVX2 CPU has it
+        if (!HasAVX2())
+        {
+            return;
+        }
+
+        std::vector<unsigned short> halves = std::vector<unsigned short>(65536);
+        std::vector<Vector4> expanded = std::vector<Vector4>(65536 / 4);
+
+        for (size_t i = 0; i < halves.size(); i++)
+        {
+            halves[i] = static_cast<unsigned short>(i);
+        }
+
+        Color::UnpackHalf(halves.data(), expanded.data(), expanded.size());
+        size_t unpackMisses = 0;
+
+        for (size_t i = 0; i < expanded.size(); i++)
+        {
+            __m128 expected = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(halves.data() + i * 4)));
+            unpackMisses += (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_castps_si128(expected), _mm_castps_si128(expanded[i].elementsSIMD))) == 0xFFFF) ? 0 : 1;
+        }
+
+        // Random bit patterns cover denormals, overflow, infinities & NaNs as well as ordinary values
+        std::vector<Vector4> floats = std::vector<Vector4>(100001);
+        std::vector<unsigned short> narrowed = std::vector<unsigned short>(floats.size() * 4);
+
+        for (size_t i = 0; i < floats.size(); i++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                float scale = powf(2.0f, RandomFloat(-30.0f, 20.0f));
+                floats[i].elements[c] = (i % 7 == 0) ? RandomFloat(-scale, scale) : RandomFloat(-70000.0f, 70000.0f);
+            }
+        }
+
+        floats[0] = Vector4(INFINITY, -INFINITY, NAN, -0.0f);
+        Color::PackHalf(floats.data(), narrowed.data(), floats.size());
+        size_t packMisses = 0;
+
+        for (size_t i = 0; i < floats.size(); i++)
+        {
+            __m128i expected = _mm_cvtps_ph(floats[i].elementsSIMD, _MM_FROUND_TO_NEAREST_INT);
+            packMisses += (memcmp(&expected, narrowed.data() + i * 4, 4 * sizeof(unsigned short)) == 0) ? 0 : 1;
+        }
+
+        Check(unpackMisses == 0 && packMisses == 0, "%zu UnpackHalf & %zu PackHalf pixels differ from F16C", unpackMisses, packMisses);
+    }
+
+    void TestColor()
+    {
+        printf("Color\n");
+
+        CheckTransferFunctions();
+        CheckPacking();
+
+        // Conversion rates over an image bigger than the caches
+        const size_t count = 1 << 22;
+        std::vector<Vector4> pixels = RandomPixels(count, 0.0f, 1.0f);
+        std::vector<Vector4> out = std::vector<Vector4>(count);
+        std::vector<unsigned int> packed = std::vector<unsigned int>(count);
+
+        Timer timer = Timer();
+        Color::SRGBToLinear(pixels.data(), out.data(), count);
+        Report("SRGBToLinear", static_cast<double>(count), timer.Seconds(), "pixel");
+
+        timer.Restart();
+        Color::LinearToSRGB(pixels.data(), out.data(), count);
+        Report("LinearToSRGB", static_cast<double>(count), timer.Seconds(), "pixel");
+
+        // The transfer functions alone, on a block that stays in L2, where bandwidth doesn't hide their cost
+        const size_t block = 1 << 14;
+        timer.Restart();
+
+        for (size_t offset = 0; offset < count; offset += block)
+        {
+            Color::SRGBToLinear(pixels.data(), out.data(), block);
+        }
+
+        Report("SRGBToLinear in cache", static_cast<double>(count), timer.Seconds(), "pixel");
+        timer.Restart();
+
+        for (size_t offset = 0; offset < count; offset += block)
+        {
+            Color::LinearToSRGB(pixels.data(), out.data(), block);
+        }
+
+        Report("LinearToSRGB in cache", static_cast<double>(count), timer.Seconds(), "pixel");
+
+        timer.Restart();
+        Color::PackSRGB8(pixels.data(), packed.data(), count);
+        Report("PackSRGB8", static_cast<double>(count), timer.Seconds(), "pixel");
+
+        timer.Restart();
+        Color::UnpackSRGB8(packed.data(), out.data(), count);
+        Report("UnpackSRGB8", static_cast<double>(count), timer.Seconds(), "pixel");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Reconstruction is done in double so the error measured is the decomposition's alone
+    struct Matrix3d
+    {
+        double m[3][3];
+    };
+
+    static Matrix3d FromQuaternion(const Quaternion& quat)
+    {
+        double w = quat.w, x = quat.x, y = quat.y, z = quat.z;
+        double scale = 2.0 / (w * w + x * x + y * y + z * z);
+        Matrix3d toReturn = {{{ 1.0 - scale * (y * y + z * z), scale * (x * y - w * z), scale * (x * z + w * y) },
+                              { scale * (x * y + w * z), 1.0 - scale * (x * x + z * z), scale * (y * z - w * x) },
+                              { scale * (x * z - w * y), scale * (y * z + w * x), 1.0 - scale * (x * x + y * y) }}};
+        return toReturn;
+    }
+
+    static Matrix3d FromMatrix4(const Matrix4& mat)
+    {
+        Matrix3d toReturn = Matrix3d();
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                toReturn.m[i][j] = mat.matrix[i][j];
+            }
+        }
+
+        return toReturn;
+    }
+
+    // a * diag(scale) * b^T, or a * b when scale is null
+    static Matrix3d Product(const Matrix3d& a, const double* scale, const Matrix3d& b, const bool transposeB)
+    {
+        Matrix3d toReturn = Matrix3d();
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                double sum = 0.0;
+
+                for (int k = 0; k < 3; k++)
+                {
+                    sum += a.m[i][k] * (scale ? scale[k] : 1.0) * (transposeB ? b.m[j][k] : b.m[k][j]);
+                }
+
+                toReturn.m[i][j] = sum;
+            }
+        }
+
+        return toReturn;
+    }
+
+    // Frobenius norm of a - b relative to the norm of a
+    static double RelativeError(const Matrix3d& a, const Matrix3d& b)
+    {
+        double error = 0.0;
+        double norm = 0.0;
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                error += (a.m[i][j] - b.m[i][j]) * (a.m[i][j] - b.m[i][j]);
+                norm += a.m[i][j] * a.m[i][j];
+            }
+        }
+
+        return sqrt(error) / ((norm > 0.0) ? sqrt(norm) : 1.0);
+    }
+
+    // Repeated values only come out equal to within round off, so order is checked relative to the magnitude
+    static bool Ordered(const float first, const float second, const float magnitude)
+    {
+        return first >= second - 1e-6f * fabsf(magnitude);
+    }
+
+    static Matrix4 RandomMatrix(const int kind)
+    {
+        float scale = RandomFloat(0.01f, 100.0f);
+        Matrix4 toReturn = Matrix4();
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                toReturn.matrix[i][j] = RandomFloat(-scale, scale);
+            }
+        }
+
+        // Rank deficient, repeated singular values & reflections are the cases Jacobi is most likely to get wrong
+        if (kind == 1)
+        {
+            toReturn.matrix[0][2] = toReturn.matrix[1][2] = toReturn.matrix[2][2] = 0.0f;
+        }
+        else if (kind == 2)
+        {
+            toReturn = Matrix4();
+            toReturn.matrix[0][0] = toReturn.matrix[1][1] = scale;
+            toReturn.matrix[2][2] = -scale;
+        }
+        else if (kind == 3)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                toReturn.matrix[2][j] = toReturn.matrix[0][j] * 2.0f;
+            }
+        }
+
+        return toReturn;
+    }
+
+    static Matrix4 Symmetric(const Matrix4& mat)
+    {
+        Matrix4 toReturn = mat;
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                toReturn.matrix[i][j] = (mat.matrix[i][j] + mat.matrix[j][i]) * 0.5f;
+            }
+        }
+
+        return toReturn;
+    }
+
+    // Decompose of Translate * Rotate * Scale has to rebuild the matrix, with mirrored inputs moving their sign onto scale.x
+    static void CheckDecompose()
+    {
+        const size_t count = 1003;
+        std::vector<Matrix4> mats = std::vector<Matrix4>(count);
+        std::vector<Quaternion> inRotations = std::vector<Quaternion>(count);
+        std::vector<Vector3> inScales = std::vector<Vector3>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Vector3 axis = RandomVector3(-1.0f, 1.0f);
+            inRotations[i].elementsSIMD = _mm_setr_ps(RandomFloat(-1.0f, 1.0f), axis.x, axis.y, axis.z);
+            inRotations[i] = Quaternion::Normalized(inRotations[i]);
+
+            // Odd matrices are mirrored along one axis
+            float scale[3] = { RandomFloat(0.2f, 5.0f), RandomFloat(0.2f, 5.0f), RandomFloat(0.2f, 5.0f) };
+            scale[(i / 2) % 3] *= (i % 2 == 1) ? -1.0f : 1.0f;
+            inScales[i] = Vector3(scale[0], scale[1], scale[2]);
+
+            Matrix4 rotation = Matrix4::Rotate(inRotations[i]);
+            Matrix4 scaling = Matrix4::Scale(inScales[i]);
+            Matrix4 translation = Matrix4::Translate(RandomVector3(-100.0f, 100.0f));
+            mats[i] = translation * rotation * scaling;
+        }
+
+        std::vector<Vector3> translations = std::vector<Vector3>(count);
+        std::vector<Quaternion> rotations = std::vector<Quaternion>(count);
+        std::vector<Vector3> scales = std::vector<Vector3>(count);
+        Matrix4::Decompose(mats.data(), translations.data(), rotations.data(), scales.data(), count);
+        double rebuildError = 0.0, rotationError = 0.0, scaleError = 0.0;
+        int wrongSign = 0, batchMismatches = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double s[3] = { scales[i].x, scales[i].y, scales[i].z };
+            double in[3] = { inScales[i].x, inScales[i].y, inScales[i].z };
+            bool mirrored = in[0] * in[1] * in[2] < 0.0;
+            Matrix3d rebuilt = Product(FromQuaternion(rotations[i]), s, Matrix3d{ { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } } }, false);
+            double error = RelativeError(FromMatrix4(mats[i]), rebuilt) + fabs(translations[i].x - mats[i].matrix[0][3]) +
+                           fabs(translations[i].y - mats[i].matrix[1][3]) + fabs(translations[i].z - mats[i].matrix[2][3]);
+            rebuildError = (error > rebuildError) ? error : rebuildError;
+
+            // The expected rotation is the input with the mirrored column moved onto x
+            Matrix3d expected = FromQuaternion(inRotations[i]);
+
+            for (int r = 0; r < 3; r++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    expected.m[r][c] *= ((in[c] < 0.0) ? -1.0 : 1.0) * ((c == 0 && mirrored) ? -1.0 : 1.0);
+                }
+            }
+
+            error = RelativeError(expected, FromQuaternion(rotations[i]));
+            rotationError = (error > rotationError) ? error : rotationError;
+
+            for (int k = 0; k < 3; k++)
+            {
+                error = fabs(fabs(s[k]) - fabs(in[k])) / fabs(in[k]);
+                scaleError = (error > scaleError) ? error : scaleError;
+            }
+
+            wrongSign += ((s[0] < 0.0) == mirrored && s[1] > 0.0 && s[2] > 0.0) ? 0 : 1;
+
+            Vector3 singleTranslation = Vector3(), singleScale = Vector3();
+            Quaternion singleRotation = Quaternion();
+            Matrix4::Decompose(mats[i], singleTranslation, singleRotation, singleScale);
+            batchMismatches += (fabsf(singleScale.x - scales[i].x) + fabsf(singleScale.y - scales[i].y) + fabsf(singleScale.z - scales[i].z) <= 1e-6f * fabsf(scales[i].x) &&
+                                RelativeError(FromQuaternion(singleRotation), FromQuaternion(rotations[i])) < 1e-6) ? 0 : 1;
+        }
+
+        Check(rebuildError < 1e-4, "Decompose rebuild error %g", rebuildError);
+        Check(rotationError < 1e-5, "Decompose rotation error %g", rotationError);
+        Check(scaleError < 1e-5, "Decompose scale error %g", scaleError);
+        Check(wrongSign == 0, "%d Decompose scales have the wrong sign for their determinant", wrongSign);
+        Check(batchMismatches == 0, "%d single Decompose results differ from the batch", batchMismatches);
+        printf("  worst Decompose error: rebuild %.2g, rotation %.2g, scale %.2g\n", rebuildError, rotationError, scaleError);
+    }
+
+    void TestDecomposition()
+    {
+        printf("Eigen, SVD, Polar & Decompose\n");
+
+        const size_t count = 4003;
+        std::vector<Matrix4> mats = std::vector<Matrix4>(count);
+        std::vector<Matrix4> symmetric = std::vector<Matrix4>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            mats[i] = RandomMatrix(static_cast<int>(i % 8));
+            symmetric[i] = Symmetric(mats[i]);
+        }
+
+        std::vector<Vector3> values = std::vector<Vector3>(count);
+        std::vector<Quaternion> vectors = std::vector<Quaternion>(count);
+        std::vector<Quaternion> u = std::vector<Quaternion>(count);
+        std::vector<Vector3> sigma = std::vector<Vector3>(count);
+        std::vector<Quaternion> v = std::vector<Quaternion>(count);
+        std::vector<Quaternion> rotations = std::vector<Quaternion>(count);
+        std::vector<Matrix4> stretches = std::vector<Matrix4>(count);
+        Matrix4::Eigen(symmetric.data(), values.data(), vectors.data(), count);
+        Matrix4::SVD(mats.data(), u.data(), sigma.data(), v.data(), count);
+        Matrix4::Polar(mats.data(), rotations.data(), stretches.data(), count);
+
+        double eigenError = 0.0, svdError = 0.0, polarError = 0.0;
+        int unsorted = 0, asymmetric = 0, batchMismatches = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double eigenValues[3] = { values[i].x, values[i].y, values[i].z };
+            double singularValues[3] = { sigma[i].x, sigma[i].y, sigma[i].z };
+            Matrix3d eigenVectors = FromQuaternion(vectors[i]);
+            Matrix3d stretch = FromMatrix4(stretches[i]);
+            double error = RelativeError(FromMatrix4(symmetric[i]), Product(eigenVectors, eigenValues, eigenVectors, true));
+            eigenError = (error > eigenError) ? error : eigenError;
+            error = RelativeError(FromMatrix4(mats[i]), Product(FromQuaternion(u[i]), singularValues, FromQuaternion(v[i]), true));
+            svdError = (error > svdError) ? error : svdError;
+            error = RelativeError(FromMatrix4(mats[i]), Product(FromQuaternion(rotations[i]), nullptr, stretch, false));
+            polarError = (error > polarError) ? error : polarError;
+
+            unsorted += (Ordered(values[i].x, values[i].y, fabsf(values[i].x) + fabsf(values[i].z)) && Ordered(values[i].y, values[i].z, fabsf(values[i].x) + fabsf(values[i].z)) &&
+                         Ordered(fabsf(sigma[i].x), fabsf(sigma[i].y), sigma[i].x) && Ordered(fabsf(sigma[i].y), fabsf(sigma[i].z), sigma[i].x)) ? 0 : 1;
+            asymmetric += (fabs(stretch.m[0][1] - stretch.m[1][0]) + fabs(stretch.m[0][2] - stretch.m[2][0]) + fabs(stretch.m[1][2] - stretch.m[2][1]) <=
+                           1e-5 * (fabs(stretch.m[0][0]) + fabs(stretch.m[1][1]) + fabs(stretch.m[2][2]) + 1e-30)) ? 0 : 1;
+
+            // The single matrix entry points have to agree with the batches
+            Vector3 singleValues = Vector3();
+            Quaternion singleVectors = Quaternion();
+            Matrix4::Eigen(symmetric[i], singleValues, singleVectors);
+            batchMismatches += (fabsf(singleValues.x - values[i].x) + fabsf(singleValues.y - values[i].y) + fabsf(singleValues.z - values[i].z) <=
+                                1e-5f * (fabsf(values[i].x) + fabsf(values[i].z))) ? 0 : 1;
+        }
+
+        Check(eigenError < 1e-5, "Eigen reconstruction error %g", eigenError);
+        Check(svdError < 1e-5, "SVD reconstruction error %g", svdError);
+        Check(polarError < 1e-5, "Polar reconstruction error %g", polarError);
+        Check(unsorted == 0, "%d eigenvalue or singular value triples out of order", unsorted);
+        Check(asymmetric == 0, "%d polar stretches are not symmetric", asymmetric);
+        Check(batchMismatches == 0, "%d single Eigen results differ from the batch", batchMismatches);
+        printf("  worst relative error: eigen %.2g, svd %.2g, polar %.2g\n", eigenError, svdError, polarError);
+        CheckDecompose();
+
+        // Throughput over enough matrices to spread across every thread
+        const size_t timedCount = 1000000;
+        std::vector<Matrix4> timed = std::vector<Matrix4>(timedCount);
+
+        for (size_t i = 0; i < timedCount; i++)
+        {
+            timed[i] = mats[i % count];
+        }
+
+        values.resize(timedCount);
+        vectors.resize(timedCount);
+        u.resize(timedCount);
+        sigma.resize(timedCount);
+        v.resize(timedCount);
+        rotations.resize(timedCount);
+        stretches.resize(timedCount);
+
+        Timer timer = Timer();
+        Matrix4::Eigen(timed.data(), values.data(), vectors.data(), timedCount);
+        Report("Eigen batch", static_cast<double>(timedCount), timer.Seconds(), "mat");
+
+        timer.Restart();
+        Matrix4::SVD(timed.data(), u.data(), sigma.data(), v.data(), timedCount);
+        Report("SVD batch", static_cast<double>(timedCount), timer.Seconds(), "mat");
+
+        timer.Restart();
+        Matrix4::Polar(timed.data(), rotations.data(), stretches.data(), timedCount);
+        Report("Polar batch", static_cast<double>(timedCount), timer.Seconds(), "mat");
+    }
+}
\ No newline at end of file
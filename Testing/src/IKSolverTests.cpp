@@ -0,0 +1,177 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static float Distance3(const Vector3& point1, const Vector3& point2)
+    {
+        float x = point1.x - point2.x;
+        float y = point1.y - point2.y;
+        float z = point1.z - point2.z;
+        return sqrtf(x * x + y * y + z * z);
+    }
+
+    static Vector3 RandomDirection()
+    {
+        Vector3 toReturn = RandomVector3(-1.0f, 1.0f);
+
+        while (Vector3::MagnitudeSqr(toReturn) < 0.01f)
+        {
+            toReturn = RandomVector3(-1.0f, 1.0f);
+        }
+
+        return Vector3::Normalized(toReturn);
+    }
+
+    // Random chains with bones of 0.5 to 1.5 & a second pose of the same bones whose end effector becomes the target,
+    // so every target with reachable set is known to be reachable.  The rest are placed past the chain's full length
+    static void RandomChains(std::vector<Vector3>& chains, std::vector<Vector3>& targets, std::vector<unsigned char>& reachable, const size_t jointCount, const size_t count)
+    {
+        chains.resize(jointCount * count);
+        targets.resize(count);
+        reachable.resize(count);
+
+        for (size_t c = 0; c < count; c++)
+        {
+            Vector3* chain = &chains[c * jointCount];
+            chain[0] = RandomVector3(-10.0f, 10.0f);
+            Vector3 end = chain[0];
+            float total = 0.0f;
+
+            for (size_t j = 1; j < jointCount; j++)
+            {
+                float length = RandomFloat(0.5f, 1.5f);
+                Vector3 direction = RandomDirection();
+                Vector3 other = RandomDirection();
+                chain[j] = Vector3(chain[j - 1].x + direction.x * length, chain[j - 1].y + direction.y * length, chain[j - 1].z + direction.z * length);
+                end = Vector3(end.x + other.x * length, end.y + other.y * length, end.z + other.z * length);
+                total += length;
+            }
+
+            reachable[c] = (c % 4 != 3) ? 1 : 0;
+            Vector3 away = RandomDirection();
+            targets[c] = reachable[c] ? end : Vector3(chain[0].x + away.x * total * 1.5f, chain[0].y + away.y * total * 1.5f, chain[0].z + away.z * total * 1.5f);
+        }
+    }
+
+    // Counts chains that stretched a bone, moved the root, missed a reachable target or didn't point at an unreachable one
+    static void CheckChains(const char* name, const std::vector<Vector3>& before, const std::vector<Vector3>& after, const std::vector<Vector3>& targets,
+                            const std::vector<unsigned char>& reachable, const size_t jointCount, const float tolerance)
+    {
+        int stretched = 0, moved = 0, missed = 0;
+        size_t count = targets.size();
+
+        for (size_t c = 0; c < count; c++)
+        {
+            const Vector3* chain0 = &before[c * jointCount];
+            const Vector3* chain1 = &after[c * jointCount];
+            float total = 0.0f;
+            bool sameLengths = true;
+
+            for (size_t j = 1; j < jointCount; j++)
+            {
+                float length = Distance3(chain0[j], chain0[j - 1]);
+                sameLengths = sameLengths && fabsf(Distance3(chain1[j], chain1[j - 1]) - length) <= 1e-3f * length;
+                total += length;
+            }
+
+            stretched += sameLengths ? 0 : 1;
+            moved += (Distance3(chain0[0], chain1[0]) <= 1e-5f * (1.0f + Distance3(chain0[0], Vector3()))) ? 0 : 1;
+
+            const Vector3& end = chain1[jointCount - 1];
+
+            if (reachable[c])
+            {
+                missed += (Distance3(end, targets[c]) <= tolerance) ? 0 : 1;
+            }
+            else
+            {
+                // Fully extended along the root to target line
+                float along = Distance3(targets[c], chain1[0]);
+                Vector3 expected = Vector3(chain1[0].x + (targets[c].x - chain1[0].x) * total / along,
+                                           chain1[0].y + (targets[c].y - chain1[0].y) * total / along,
+                                           chain1[0].z + (targets[c].z - chain1[0].z) * total / along);
+                missed += (Distance3(end, expected) <= 1e-2f * total) ? 0 : 1;
+            }
+        }
+
+        Check(stretched == 0, "%s changed bone lengths in %d of %zu chains", name, stretched, count);
+        Check(moved == 0, "%s moved the root of %d chains", name, moved);
+        Check(missed == 0, "%s missed the target of %d of %zu chains", name, missed, count);
+    }
+
+    void TestIKSolver()
+    {
+        printf("IKSolver\n");
+
+        // 1003 chains leave a partial SIMD group at the end
+        std::vector<Vector3> chains, targets;
+        std::vector<unsigned char> reachable;
+        RandomChains(chains, targets, reachable, 3, 1003);
+        std::vector<Vector3> solved = chains;
+        IKSolver::TwoBone(solved.data(), targets.data(), nullptr, targets.size());
+        CheckChains("TwoBone", chains, solved, targets, reachable, 3, 1e-3f);
+
+        // The middle joint has to end up on the pole's side of the root to target line
+        std::vector<Vector3> poles = std::vector<Vector3>(targets.size());
+        int wrongSide = 0;
+
+        for (size_t c = 0; c < targets.size(); c++)
+        {
+            poles[c] = RandomVector3(-20.0f, 20.0f);
+        }
+
+        solved = chains;
+        IKSolver::TwoBone(solved.data(), targets.data(), poles.data(), targets.size());
+
+        for (size_t c = 0; c < targets.size(); c++)
+        {
+            Vector3 root = solved[c * 3], middle = solved[c * 3 + 1];
+            Vector3 axis = Vector3::Normalized(Vector3(targets[c].x - root.x, targets[c].y - root.y, targets[c].z - root.z));
+            Vector3 bend = Vector3(middle.x - root.x, middle.y - root.y, middle.z - root.z);
+            Vector3 pole = Vector3(poles[c].x - root.x, poles[c].y - root.y, poles[c].z - root.z);
+            float bendAlong = Vector3::Dot(bend, axis), poleAlong = Vector3::Dot(pole, axis);
+            float side = (bend.x - axis.x * bendAlong) * (pole.x - axis.x * poleAlong) + (bend.y - axis.y * bendAlong) * (pole.y - axis.y * poleAlong) +
+                         (bend.z - axis.z * bendAlong) * (pole.z - axis.z * poleAlong);
+            wrongSide += (reachable[c] && side < -1e-4f) ? 1 : 0;
+        }
+
+        CheckChains("TwoBone with poles", chains, solved, targets, reachable, 3, 1e-3f);
+        Check(wrongSide == 0, "TwoBone bent %d chains away from their pole", wrongSide);
+
+        RandomChains(chains, targets, reachable, 5, 1003);
+        solved = chains;
+        IKSolver::FABRIK(solved.data(), 5, targets.data(), targets.size(), 200, 1e-4f);
+        CheckChains("FABRIK", chains, solved, targets, reachable, 5, 1e-2f);
+
+        solved = chains;
+        IKSolver::CCD(solved.data(), 5, targets.data(), targets.size(), 200, 1e-4f);
+        CheckChains("CCD", chains, solved, targets, reachable, 5, 1e-2f);
+
+        // Chains per millisecond for a crowd sized batch
+        const size_t count = 100000;
+        RandomChains(chains, targets, reachable, 3, count);
+        Timer timer = Timer();
+        IKSolver::TwoBone(chains.data(), targets.data(), nullptr, count);
+        Report("TwoBone 100k chains", static_cast<double>(count), timer.Seconds(), "chain");
+
+        RandomChains(chains, targets, reachable, 5, count);
+        solved = chains;
+        timer.Restart();
+        IKSolver::FABRIK(solved.data(), 5, targets.data(), count);
+        Report("FABRIK 5 joints, 10 passes", static_cast<double>(count), timer.Seconds(), "chain");
+
+        timer.Restart();
+        IKSolver::CCD(chains.data(), 5, targets.data(), count);
+        Report("CCD 5 joints, 10 passes", static_cast<double>(count), timer.Seconds(), "chain");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // All four lanes of an integer vector, so the unused ones of Vector2i & Vector3i can be checked for zero too
+    static void Lanes(const __m128i vec, int lanes[4])
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), vec);
+    }
+
+    // Floor, Round & Ceiling of x in double, where x - floor(x) is exact & halfway cases go up
+    static void Reference(const float x, int expected[3])
+    {
+        double down = floor(static_cast<double>(x));
+        expected[0] = static_cast<int>(down);
+        expected[1] = static_cast<int>(down + ((x - down >= 0.5) ? 1.0 : 0.0));
+        expected[2] = static_cast<int>(ceil(static_cast<double>(x)));
+    }
+
+    // Counts the lanes of Floor, Round & Ceiling on Vector2i, Vector3i & Vector4i that disagree with Reference, & nonzero unused lanes
+    static int RoundingMisses(const float values[4])
+    {
+        Vector2 vec2 = Vector2(values[0], values[1]);
+        Vector3 vec3 = Vector3(values[0], values[1], values[2]);
+        Vector4 vec4 = Vector4(values[0], values[1], values[2], values[3]);
+        __m128i results[3][3] = { { Vector2i::Floor(vec2).elementsSIMD, Vector2i::Round(vec2).elementsSIMD, Vector2i::Ceiling(vec2).elementsSIMD },
+                                  { Vector3i::Floor(vec3).elementsSIMD, Vector3i::Round(vec3).elementsSIMD, Vector3i::Ceiling(vec3).elementsSIMD },
+                                  { Vector4i::Floor(vec4).elementsSIMD, Vector4i::Round(vec4).elementsSIMD, Vector4i::Ceiling(vec4).elementsSIMD } };
+        int misses = 0;
+
+        for (int size = 0; size < 3; size++)
+        {
+            for (int op = 0; op < 3; op++)
+            {
+                int lanes[4];
+                Lanes(results[size][op], lanes);
+
+                for (int i = 0; i < 4; i++)
+                {
+                    int expected[3];
+                    Reference(values[i], expected);
+                    misses += (i < size + 2) ? (lanes[i] != expected[op]) : (lanes[i] != 0);
+                }
+            }
+        }
+
+        return misses;
+    }
+
+    void TestIntVectors()
+    {
+        printf("Integer vectors\n");
+
+        // Values floor(x + 0.5) gets wrong, halfway cases of both signs, tiny values & the largest odd integers a float holds
+        const float edges[] = { 0.49999997f, -0.49999997f, 0.5f, -0.5f, 1.5f, -1.5f, 2.5f, -2.5f, 8388609.0f, -8388609.0f, 8388607.5f, -8388607.5f,
+                                4194304.5f, 16777215.0f, 1e-30f, -1e-30f, -0.0f, 0.0f, 1.0f, -1.0f };
+        const size_t edgeCount = sizeof(edges) / sizeof(edges[0]);
+        int edgeMisses = 0;
+
+        for (size_t i = 0; i < edgeCount; i++)
+        {
+            // Every edge in every lane
+            const float values[4] = { edges[i], edges[(i + 1) % edgeCount], edges[(i + 2) % edgeCount], edges[(i + 3) % edgeCount] };
+            edgeMisses += RoundingMisses(values);
+        }
+
+        Check(edgeMisses == 0, "%d Floor, Round or Ceiling lanes wrong on edge values", edgeMisses);
+
+        // Random values across magnitudes, every other one snapped to a halfway case
+        int randomMisses = 0;
+
+        for (int i = 0; i < 100000; i++)
+        {
+            float values[4];
+
+            for (int j = 0; j < 4; j++)
+            {
+                float scale = powf(10.0f, RandomFloat(-3.0f, 6.0f));
+                values[j] = RandomFloat(-scale, scale);
+                values[j] = (j & 1) ? floorf(values[j]) + 0.5f : values[j];
+            }
+
+            randomMisses += RoundingMisses(values);
+        }
+
+        Check(randomMisses == 0, "%d Floor, Round or Ceiling lanes wrong on random values", randomMisses);
+
+        // ToCells floors position * (1 / cellSize), so cells must match that product floored exactly, across thread boundaries
+        const size_t count = 1000001;
+        const float cellSize = 0.37f;
+        const float invCellSize = 1.0f / cellSize;
+        std::vector<Vector2> positions2 = std::vector<Vector2>(count);
+        std::vector<Vector3> positions3 = std::vector<Vector3>(count);
+        std::vector<Vector2i> cells2 = std::vector<Vector2i>(count);
+        std::vector<Vector3i> cells3 = std::vector<Vector3i>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            positions3[i] = RandomVector3(-500.0f, 500.0f);
+            positions2[i] = Vector2(positions3[i].z, positions3[i].x);
+        }
+
+        Vector2i::ToCells(positions2.data(), cells2.data(), count, cellSize);
+        Vector3i::ToCells(positions3.data(), cells3.data(), count, cellSize);
+        size_t cellMisses = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            int lanes2[4];
+            int lanes3[4];
+            Lanes(cells2[i].elementsSIMD, lanes2);
+            Lanes(cells3[i].elementsSIMD, lanes3);
+            bool same = lanes2[0] == static_cast<int>(floorf(positions2[i].x * invCellSize)) && lanes2[1] == static_cast<int>(floorf(positions2[i].y * invCellSize)) &&
+                        lanes2[2] == 0 && lanes2[3] == 0 &&
+                        lanes3[0] == static_cast<int>(floorf(positions3[i].x * invCellSize)) && lanes3[1] == static_cast<int>(floorf(positions3[i].y * invCellSize)) &&
+                        lanes3[2] == static_cast<int>(floorf(positions3[i].z * invCellSize)) && lanes3[3] == 0;
+            cellMisses += same ? 0 : 1;
+        }
+
+        Check(cellMisses == 0, "%zu of %zu ToCells results differ from the floored product", cellMisses, count);
+
+        Timer timer = Timer();
+        Vector3i::ToCells(positions3.data(), cells3.data(), count, cellSize);
+        Report("Vector3i::ToCells", static_cast<double>(count), timer.Seconds(), "point");
+
+        std::vector<Vector3i> rounded = std::vector<Vector3i>(count);
+        timer.Restart();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            rounded[i] = Vector3i::Round(positions3[i]);
+        }
+
+        Report("Vector3i::Round", static_cast<double>(count), timer.Seconds(), "point");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static float DistanceSqr(const Vector3& point1, const Vector3& point2)
+    {
+        float x = point1.x - point2.x;
+        float y = point1.y - point2.y;
+        float z = point1.z - point2.z;
+        return x * x + y * y + z * z;
+    }
+
+    // Points within float round off of the radius may fall either side, only the rest have to match exactly
+    static bool SameRadiusSet(const std::vector<Vector3>& points, const Vector3& point, const float radius, std::vector<unsigned int> found)
+    {
+        float radiusSqr = radius * radius;
+        std::vector<unsigned int> expected = std::vector<unsigned int>();
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            float distSqr = DistanceSqr(points[i], point);
+
+            if (distSqr <= radiusSqr * (1.0f - 1e-5f))
+            {
+                expected.push_back(static_cast<unsigned int>(i));
+            }
+        }
+
+        found.erase(std::remove_if(found.begin(), found.end(), [&](const unsigned int i)
+        {
+            return DistanceSqr(points[i], point) > radiusSqr * (1.0f - 1e-5f) && DistanceSqr(points[i], point) <= radiusSqr * (1.0f + 1e-5f);
+        }), found.end());
+        std::sort(found.begin(), found.end());
+        return found == expected;
+    }
+
+    void TestKDTree()
+    {
+        printf("KDTree\n");
+
+        const size_t k = 8;
+        std::vector<Vector3> points = std::vector<Vector3>(20000);
+        std::vector<Vector3> queries = std::vector<Vector3>(500);
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            points[i] = RandomVector3(-10.0f, 10.0f);
+        }
+
+        // A few duplicates so ties & coincident points are exercised
+        for (size_t i = 0; i < 100; i++)
+        {
+            points[points.size() - 1 - i] = points[i];
+        }
+
+        for (size_t i = 0; i < queries.size(); i++)
+        {
+            queries[i] = (i % 5 == 0) ? points[i * 7] : RandomVector3(-12.0f, 12.0f);
+        }
+
+        KDTree tree = KDTree();
+        tree.Build(points.data(), points.size());
+        Check(tree.Size() == points.size(), "KDTree holds %zu points", tree.Size());
+
+        std::vector<unsigned int> batchIndices = std::vector<unsigned int>(queries.size() * k);
+        std::vector<float> batchDistances = std::vector<float>(queries.size() * k);
+        std::vector<std::vector<unsigned int>> batchRadius = std::vector<std::vector<unsigned int>>();
+        tree.Nearest(queries.data(), queries.size(), k, batchIndices.data(), batchDistances.data());
+        tree.Radius(queries.data(), queries.size(), 1.5f, batchRadius);
+        int nearestMismatches = 0;
+        int radiusMismatches = 0;
+
+        for (size_t q = 0; q < queries.size(); q++)
+        {
+            // Distances rather than ids are compared, equidistant points may come back in either order
+            std::vector<float> expected = std::vector<float>(points.size());
+
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                expected[i] = DistanceSqr(points[i], queries[q]);
+            }
+
+            std::partial_sort(expected.begin(), expected.begin() + k, expected.end());
+            unsigned int indices[k];
+            float distancesSqr[k];
+            size_t found = tree.Nearest(queries[q], k, indices, distancesSqr);
+            bool same = (found == k);
+
+            for (size_t i = 0; i < found && same; i++)
+            {
+                same = fabsf(distancesSqr[i] - expected[i]) <= 1e-5f * (1.0f + expected[i]) &&
+                       fabsf(DistanceSqr(points[indices[i]], queries[q]) - distancesSqr[i]) <= 1e-5f * (1.0f + expected[i]) &&
+                       batchIndices[q * k + i] == indices[i];
+            }
+
+            nearestMismatches += same ? 0 : 1;
+
+            std::vector<unsigned int> results = std::vector<unsigned int>();
+            tree.Radius(queries[q], 1.5f, results);
+            radiusMismatches += (SameRadiusSet(points, queries[q], 1.5f, results) && SameRadiusSet(points, queries[q], 1.5f, batchRadius[q])) ? 0 : 1;
+        }
+
+        Check(nearestMismatches == 0, "%d of %zu nearest queries disagree with brute force", nearestMismatches, queries.size());
+        Check(radiusMismatches == 0, "%d of %zu radius queries disagree with brute force", radiusMismatches, queries.size());
+
+        // Counts that aren't a multiple of 4 leave leaves starting at any index, so the last leaf's loads run past the final point
+        int smallMismatches = 0;
+
+        for (size_t count = 33; count <= 40; count++)
+        {
+            KDTree small = KDTree();
+            small.Build(points.data(), count);
+            std::vector<Vector3> subset = std::vector<Vector3>(points.begin(), points.begin() + count);
+
+            for (size_t q = 0; q < 50; q++)
+            {
+                std::vector<float> expected = std::vector<float>(count);
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    expected[i] = DistanceSqr(subset[i], queries[q]);
+                }
+
+                std::sort(expected.begin(), expected.end());
+                unsigned int indices[k];
+                float distancesSqr[k];
+                bool same = small.Nearest(queries[q], k, indices, distancesSqr) == k;
+
+                for (size_t i = 0; i < k && same; i++)
+                {
+                    same = fabsf(distancesSqr[i] - expected[i]) <= 1e-5f * (1.0f + expected[i]);
+                }
+
+                std::vector<unsigned int> results = std::vector<unsigned int>();
+                small.Radius(queries[q], 6.0f, results);
+                smallMismatches += (same && SameRadiusSet(subset, queries[q], 6.0f, results)) ? 0 : 1;
+            }
+        }
+
+        Check(smallMismatches == 0, "%d queries on 33 to 40 point trees disagree with brute force", smallMismatches);
+
+        unsigned int index = 0;
+        float distanceSqr = 0.0f;
+        KDTree small = KDTree();
+        small.Build(points.data(), 3);
+        Check(small.Nearest(queries[0], k, batchIndices.data(), batchDistances.data()) == 3, "Nearest on a 3 point tree returns more than 3");
+        Check(KDTree().Nearest(queries[0], 1, &index, &distanceSqr) == 0, "Nearest on an empty tree found a point");
+
+        // Throughput at a size where the tree no longer fits in cache
+        std::vector<Vector3> cloud = std::vector<Vector3>(1000000);
+        std::vector<unsigned int> indices = std::vector<unsigned int>(cloud.size() * k);
+        std::vector<float> distances = std::vector<float>(cloud.size() * k);
+        std::vector<std::vector<unsigned int>> neighbours = std::vector<std::vector<unsigned int>>();
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            cloud[i] = RandomVector3(-100.0f, 100.0f);
+        }
+
+        Timer timer = Timer();
+        tree.Build(cloud.data(), cloud.size());
+        Report("Build 1M points", static_cast<double>(cloud.size()), timer.Seconds(), "point");
+
+        timer.Restart();
+        tree.Nearest(cloud.data(), cloud.size(), k, indices.data(), distances.data());
+        Report("Nearest 8 batch", static_cast<double>(cloud.size()), timer.Seconds(), "query");
+
+        timer.Restart();
+        tree.Radius(cloud.data(), cloud.size(), 2.0f, neighbours);
+        Report("Radius batch, ~4 neighbours", static_cast<double>(cloud.size()), timer.Seconds(), "query");
+    }
+}
\ No newline at end of file
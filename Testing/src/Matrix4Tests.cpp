@@ -0,0 +1,161 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // What ProjectPoints replaces: Matrix4 * Vector4, the divide by w & the viewport transform, with the flags from the clip coordinates
+    static ClipFlag ReferenceProject(Matrix4& viewProjection, const Vector3& point, const Vector4& viewport, float& screenX, float& screenY, float& depth, bool& ambiguous)
+    {
+        Vector4 homogeneous = Vector4(point.x, point.y, point.z, 1.0f);
+        Vector4 clip = viewProjection * homogeneous;
+        screenX = viewport.x + viewport.z * 0.5f + clip.x / clip.w * viewport.z * 0.5f;
+        screenY = viewport.y + viewport.w * 0.5f - clip.y / clip.w * viewport.w * 0.5f;
+        depth = clip.z / clip.w;
+
+        // Points this close to a plane can land on either side depending on rounding
+        float tolerance = 1e-5f * (fabsf(clip.x) + fabsf(clip.y) + fabsf(clip.z) + fabsf(clip.w));
+        ambiguous = fabsf(fabsf(clip.x) - fabsf(clip.w)) < tolerance || fabsf(fabsf(clip.y) - fabsf(clip.w)) < tolerance || fabsf(fabsf(clip.z) - fabsf(clip.w)) < tolerance;
+
+        ClipFlag toReturn = ClipFlag::None;
+        toReturn |= (clip.x < -clip.w) ? ClipFlag::Left : ClipFlag::None;
+        toReturn |= (clip.x > clip.w) ? ClipFlag::Right : ClipFlag::None;
+        toReturn |= (clip.y < -clip.w) ? ClipFlag::Bottom : ClipFlag::None;
+        toReturn |= (clip.y > clip.w) ? ClipFlag::Top : ClipFlag::None;
+        toReturn |= (clip.z < -clip.w) ? ClipFlag::Near : ClipFlag::None;
+        toReturn |= (clip.z > clip.w) ? ClipFlag::Far : ClipFlag::None;
+        return toReturn;
+    }
+
+    void TestMatrix4()
+    {
+        printf("Matrix4\n");
+
+        // With the identity, clip space is the point itself & w is 1, so each side of the cube sets exactly its own flag
+        const Vector3 sides[8] = { Vector3(-2.0f, 0.0f, 0.0f), Vector3(2.0f, 0.0f, 0.0f), Vector3(0.0f, -2.0f, 0.0f), Vector3(0.0f, 2.0f, 0.0f),
+                                   Vector3(0.0f, 0.0f, -2.0f), Vector3(0.0f, 0.0f, 2.0f), Vector3(0.5f, -0.5f, 0.9f), Vector3(2.0f, 2.0f, 2.0f) };
+        const ClipFlag expectedSides[8] = { ClipFlag::Left, ClipFlag::Right, ClipFlag::Bottom, ClipFlag::Top, ClipFlag::Near, ClipFlag::Far, ClipFlag::None,
+                                            ClipFlag::Right | ClipFlag::Top | ClipFlag::Far };
+        float sideX[8], sideY[8], sideDepth[8];
+        ClipFlag sideFlags[8];
+        Matrix4::ProjectPoints(Matrix4::Identity, sides, 8, Vector4(0.0f, 0.0f, 100.0f, 50.0f), sideX, sideY, sideDepth, sideFlags);
+
+        for (int i = 0; i < 8; i++)
+        {
+            Check(sideFlags[i] == expectedSides[i], "point %d outside the identity frustum got flags 0x%02X, expected 0x%02X", i,
+                  static_cast<unsigned int>(sideFlags[i]), static_cast<unsigned int>(expectedSides[i]));
+        }
+
+        Check(fabsf(sideX[6] - 75.0f) < 1e-4f && fabsf(sideY[6] - 37.5f) < 1e-4f && fabsf(sideDepth[6] - 0.9f) < 1e-6f, "inside point projected to (%g, %g, %g)",
+              sideX[6], sideY[6], sideDepth[6]);
+
+        // A perspective camera away from the origin, with points all around it including behind it, in an offset viewport
+        Matrix4 projection = Matrix4::Perspective(1.2f, 1920.0f, 1080.0f, 0.5f, 200.0f);
+        Matrix4 rotation = Matrix4::Rotate(0.2f, -0.4f, 0.1f);
+        Matrix4 translation = Matrix4::Translate(-3.0f, 1.0f, 20.0f);
+        Matrix4 view = rotation * translation;
+        Matrix4 viewProjection = projection * view;
+        Matrix4 batchProduct = Matrix4();
+        Matrix4::Multiply(projection, &view, &batchProduct, 1, StoreMode::Cached);
+        float productError = 0.0f;
+
+        for (int i = 0; i < 16; i++)
+        {
+            productError = fmaxf(productError, fabsf(viewProjection.matrix[i / 4][i % 4] - batchProduct.matrix[i / 4][i % 4]));
+        }
+
+        // The bottom row of a perspective product carries w, so operator * has to keep it like the batch Multiply does
+        Check(productError < 1e-5f && viewProjection.matrix[3][3] != 1.0f, "projection * view differs from Multiply by %g, [3][3] is %g", productError, viewProjection.matrix[3][3]);
+        Vector4 viewport = Vector4(100.0f, 50.0f, 1920.0f, 1080.0f);
+        const size_t count = 100003;
+        std::vector<Vector3> points = std::vector<Vector3>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            points[i] = RandomVector3(-300.0f, 300.0f);
+        }
+
+        std::vector<float> screenX = std::vector<float>(count), screenY = std::vector<float>(count), depth = std::vector<float>(count);
+        std::vector<ClipFlag> flags = std::vector<ClipFlag>(count);
+        Matrix4::ProjectPoints(viewProjection, points.data(), count, viewport, screenX.data(), screenY.data(), depth.data(), flags.data());
+
+        double screenError = 0.0, depthError = 0.0;
+        int flagMismatches = 0, visible = 0, perSide[6] = { 0, 0, 0, 0, 0, 0 };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            float x, y, z;
+            bool ambiguous;
+            ClipFlag expected = ReferenceProject(viewProjection, points[i], viewport, x, y, z, ambiguous);
+
+            if (ambiguous)
+            {
+                continue;
+            }
+
+            flagMismatches += (flags[i] == expected) ? 0 : 1;
+
+            for (int side = 0; side < 6; side++)
+            {
+                perSide[side] += ((expected & static_cast<ClipFlag>(1 << side)) != ClipFlag::None) ? 1 : 0;
+            }
+
+            // Screen coordinates are only defined inside the frustum
+            if (expected == ClipFlag::None)
+            {
+                visible++;
+                double error = (fabs(screenX[i] - x) + fabs(screenY[i] - y)) / viewport.z;
+                screenError = (error > screenError) ? error : screenError;
+                error = fabs(depth[i] - z);
+                depthError = (error > depthError) ? error : depthError;
+            }
+        }
+
+        Check(flagMismatches == 0, "%d ProjectPoints clip flags differ from the clip coordinates", flagMismatches);
+        Check(visible > 100 && perSide[0] > 0 && perSide[1] > 0 && perSide[2] > 0 && perSide[3] > 0 && perSide[4] > 0 && perSide[5] > 0,
+              "projection test points don't reach every side, %d visible", visible);
+        Check(screenError < 1e-6 && depthError < 1e-5, "ProjectPoints differs from Matrix4 * Vector4 by %g of the viewport & %g in depth", screenError, depthError);
+        printf("  %d of %zu points visible, worst error %.2g of the viewport & %.2g in depth\n", visible, count, screenError, depthError);
+
+        // Every tail length has to match the full run & leave the entries past count alone, with & without clipFlags
+        int tailMismatches = 0;
+
+        for (size_t tail = 1; tail <= 9; tail++)
+        {
+            float tailX[10], tailY[10], tailDepth[10];
+            ClipFlag tailFlags[10];
+
+            for (int i = 0; i < 10; i++)
+            {
+                tailX[i] = tailY[i] = tailDepth[i] = -12345.0f;
+                tailFlags[i] = static_cast<ClipFlag>(0xFF);
+            }
+
+            Matrix4::ProjectPoints(viewProjection, points.data(), tail, viewport, tailX, tailY, tailDepth, tailFlags);
+
+            for (size_t i = 0; i < 10; i++)
+            {
+                bool same = (i < tail) ? (tailFlags[i] == flags[i] && (flags[i] != ClipFlag::None || (tailX[i] == screenX[i] && tailY[i] == screenY[i] && tailDepth[i] == depth[i])))
+                                       : (tailX[i] == -12345.0f && tailY[i] == -12345.0f && tailDepth[i] == -12345.0f && tailFlags[i] == static_cast<ClipFlag>(0xFF));
+                tailMismatches += same ? 0 : 1;
+            }
+
+            Matrix4::ProjectPoints(viewProjection, points.data() + 1, tail, viewport, tailX, tailY, tailDepth, nullptr);
+            tailMismatches += (flags[tail] != ClipFlag::None || tailX[tail - 1] == screenX[tail]) ? 0 : 1;
+        }
+
+        Check(tailMismatches == 0, "%d ProjectPoints results differ in tails of 1 to 9 points", tailMismatches);
+
+        Timer timer = Timer();
+        Matrix4::ProjectPoints(viewProjection, points.data(), count, viewport, screenX.data(), screenY.data(), depth.data(), flags.data());
+        Report("ProjectPoints 100k points", static_cast<double>(count), timer.Seconds(), "point");
+    }
+}
\ No newline at end of file
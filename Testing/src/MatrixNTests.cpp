@@ -0,0 +1,192 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    template <typename T>
+    static MatrixN<T> RandomMatrixN(const size_t rows, const size_t cols)
+    {
+        MatrixN<T> toReturn = MatrixN<T>(rows, cols);
+
+        for (size_t i = 0; i < rows * cols; i++)
+        {
+            toReturn.Data()[i] = static_cast<T>(RandomFloat(-1.0f, 1.0f));
+        }
+
+        return toReturn;
+    }
+
+    // Largest difference between Gemm & a naive triple loop accumulated in double, relative to the sum of |a||b| it came from
+    template <typename T>
+    static double GemmError(const size_t m, const size_t n, const size_t k, const T alpha, const T beta)
+    {
+        // Strides wider than the matrices so the kernels can't assume packed rows
+        const size_t lda = k + 3, ldb = n + 1, ldc = n + 5;
+        MatrixN<T> a = RandomMatrixN<T>(m, lda);
+        MatrixN<T> b = RandomMatrixN<T>(k, ldb);
+        MatrixN<T> c = RandomMatrixN<T>(m, ldc);
+        MatrixN<T> original = c;
+        MatrixN<T>::Gemm(m, n, k, alpha, a.Data(), lda, b.Data(), ldb, beta, c.Data(), ldc);
+        double toReturn = 0.0;
+
+        for (size_t i = 0; i < m; i++)
+        {
+            for (size_t j = 0; j < ldc; j++)
+            {
+                double sum = 0.0;
+                double magnitude = 1e-30;
+
+                for (size_t p = 0; p < k && j < n; p++)
+                {
+                    sum += static_cast<double>(a.Data()[i * lda + p]) * b.Data()[p * ldb + j];
+                    magnitude += fabs(static_cast<double>(a.Data()[i * lda + p]) * b.Data()[p * ldb + j]);
+                }
+
+                // Columns past n have to be left untouched
+                double expected = (j < n) ? alpha * sum + beta * static_cast<double>(original.Data()[i * ldc + j]) : original.Data()[i * ldc + j];
+                double error = fabs(c.Data()[i * ldc + j] - expected) / (fabs(alpha) * magnitude + fabs(beta) + 1.0);
+                toReturn = (error > toReturn) ? error : toReturn;
+            }
+        }
+
+        return toReturn;
+    }
+
+    template <typename T>
+    static void CheckGemm(const char* type, const double tolerance)
+    {
+        // Edge sizes around the register & cache tiles of the SSE, AVX2 & AVX-512 kernels, plus empty and single element products
+        const size_t sizes[][3] = { { 1, 1, 1 }, { 0, 5, 3 }, { 5, 7, 0 }, { 7, 13, 5 }, { 17, 3, 64 }, { 29, 33, 17 }, { 67, 129, 33 }, { 113, 97, 260 },
+                                    { 130, 67, 300 }, { 257, 255, 129 } };
+        double worst = 0.0;
+
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        {
+            double error = GemmError<T>(sizes[s][0], sizes[s][1], sizes[s][2], T(1), T(0));
+            double scaled = GemmError<T>(sizes[s][0], sizes[s][1], sizes[s][2], T(-0.5), T(2));
+            worst = (error > worst) ? error : worst;
+            worst = (scaled > worst) ? scaled : worst;
+        }
+
+        Check(worst < tolerance, "%s Gemm error %g against naive", type, worst);
+        printf("  %s Gemm worst relative error %.2g\n", type, worst);
+    }
+
+    template <typename T>
+    static void CheckLU(const char* type, const size_t size, const double tolerance)
+    {
+        MatrixN<T> mat = RandomMatrixN<T>(size, size);
+        MatrixN<T> lu = mat;
+        std::vector<size_t> pivots = std::vector<size_t>();
+        VectorN<T> expected = VectorN<T>(size);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            expected[i] = static_cast<T>(RandomFloat(-1.0f, 1.0f));
+        }
+
+        VectorN<T> rhs = MatrixN<T>::Multiply(mat, expected);
+        bool factored = MatrixN<T>::LUFactor(lu, pivots);
+        VectorN<T> solved = MatrixN<T>::Solve(lu, pivots, rhs);
+
+        // Backward error |mat * x - rhs| / (|mat| |x|) is what partial pivoting bounds
+        VectorN<T> residual = MatrixN<T>::Multiply(mat, solved) - rhs;
+        double matNorm = 0.0;
+
+        for (size_t i = 0; i < size * size; i++)
+        {
+            matNorm += static_cast<double>(mat.Data()[i]) * mat.Data()[i];
+        }
+
+        double error = VectorN<T>::Magnitude(residual) / (sqrt(matNorm) * VectorN<T>::Magnitude(solved));
+        Check(factored && error < tolerance, "%s LU %zu backward error %g", type, size, error);
+
+        // Small integers keep the elimination exact, so the dependent row has to leave an exactly zero pivot
+        MatrixN<T> singular = MatrixN<T>(3, 3);
+        const T elements[9] = { T(2), T(1), T(1), T(4), T(2), T(2), T(1), T(3), T(5) };
+
+        for (size_t i = 0; i < 9; i++)
+        {
+            singular.Data()[i] = elements[i];
+        }
+
+        Check(MatrixN<T>::Determinant(singular) == T(0) && !MatrixN<T>::LUFactor(singular, pivots), "%s LU missed a dependent row", type);
+    }
+
+    template <typename T>
+    static void TimeGemm(const char* name, const size_t size)
+    {
+        MatrixN<T> a = RandomMatrixN<T>(size, size);
+        MatrixN<T> b = RandomMatrixN<T>(size, size);
+        MatrixN<T> c = MatrixN<T>(size, size);
+        MatrixN<T>::Multiply(a, b, c);
+
+        Timer timer = Timer();
+        MatrixN<T>::Multiply(a, b, c);
+        Report(name, 2.0 * size * size * size, timer.Seconds(), "FLOP");
+    }
+
+    void TestMatrixN()
+    {
+        printf("MatrixN\n");
+        printf("  Gemm kernel %s\n", HasAVX512() ? "AVX-512" : HasAVX2() ? "AVX2 & FMA" : "SSE");
+
+        CheckGemm<float>("float", 1e-6);
+        CheckGemm<double>("double", 1e-14);
+        CheckLU<float>("float", 200, 1e-5);
+        CheckLU<double>("double", 300, 1e-13);
+
+        MatrixN<double> identity = MatrixN<double>::Identity(33);
+        MatrixN<double> mat = RandomMatrixN<double>(33, 47);
+        MatrixN<double> product = MatrixN<double>();
+        MatrixN<double>::Multiply(identity, mat, product);
+        bool same = product.Rows() == 33 && product.Cols() == 47;
+
+        for (size_t i = 0; i < 33 * 47 && same; i++)
+        {
+            same = product.Data()[i] == mat.Data()[i];
+        }
+
+        Check(same, "Multiply by Identity into an empty output changed the matrix");
+
+        // A naive i-k-j loop gives the baseline the packed kernels are measured against
+        const size_t size = 512;
+        MatrixN<float> a = RandomMatrixN<float>(size, size);
+        MatrixN<float> b = RandomMatrixN<float>(size, size);
+        MatrixN<float> c = MatrixN<float>(size, size);
+        Timer timer = Timer();
+
+        for (size_t i = 0; i < size; i++)
+        {
+            for (size_t p = 0; p < size; p++)
+            {
+                float scale = a[i][p];
+
+                for (size_t j = 0; j < size; j++)
+                {
+                    c[i][j] += scale * b[p][j];
+                }
+            }
+        }
+
+        Report("naive float 512", 2.0 * size * size * size, timer.Seconds(), "FLOP");
+        TimeGemm<float>("Multiply float 512", 512);
+        TimeGemm<float>("Multiply float 1024", 1024);
+        TimeGemm<double>("Multiply double 1024", 1024);
+
+        MatrixN<double> lu = RandomMatrixN<double>(1024, 1024);
+        std::vector<size_t> pivots = std::vector<size_t>();
+        timer.Restart();
+        MatrixN<double>::LUFactor(lu, pivots);
+        Report("LUFactor double 1024", 2.0 / 3.0 * 1024.0 * 1024.0 * 1024.0, timer.Seconds(), "FLOP");
+    }
+}
\ No newline at end of file
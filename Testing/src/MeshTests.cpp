@@ -0,0 +1,305 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // width x height vertex grid in the z = 0 plane with uv = (x, y) scaled by uvSign, counter clockwise seen from +z
+    static void PlaneGrid(const size_t width, const size_t height, const float uvSign, std::vector<Vector3>& positions, std::vector<Vector2>& uvs, std::vector<unsigned int>& indices)
+    {
+        positions.resize(width * height);
+        uvs.resize(width * height);
+        indices.clear();
+
+        for (size_t y = 0; y < height; y++)
+        {
+            for (size_t x = 0; x < width; x++)
+            {
+                // A little jitter so no two triangles are identical
+                positions[y * width + x] = Vector3(x + RandomFloat(-0.2f, 0.2f), y + RandomFloat(-0.2f, 0.2f), 0.0f);
+                uvs[y * width + x] = Vector2(positions[y * width + x].x * 0.1f, positions[y * width + x].y * 0.1f * uvSign);
+            }
+        }
+
+        for (size_t y = 0; y + 1 < height; y++)
+        {
+            for (size_t x = 0; x + 1 < width; x++)
+            {
+                unsigned int corner = static_cast<unsigned int>(y * width + x);
+                unsigned int quad[6] = { corner, corner + 1, corner + static_cast<unsigned int>(width) + 1,
+                                         corner, corner + static_cast<unsigned int>(width) + 1, corner + static_cast<unsigned int>(width) };
+                indices.insert(indices.end(), quad, quad + 6);
+            }
+        }
+    }
+
+    // Latitude longitude unit sphere with poles & seam vertices duplicated, uv = (longitude, latitude)
+    static void Sphere(const size_t slices, const size_t stacks, std::vector<Vector3>& positions, std::vector<Vector2>& uvs, std::vector<unsigned int>& indices)
+    {
+        positions.clear();
+        uvs.clear();
+        indices.clear();
+
+        for (size_t stack = 0; stack <= stacks; stack++)
+        {
+            float phi = Pi * stack / stacks;
+
+            for (size_t slice = 0; slice <= slices; slice++)
+            {
+                float theta = 2.0f * Pi * slice / slices;
+                positions.push_back(Vector3(sinf(phi) * cosf(theta), cosf(phi), -sinf(phi) * sinf(theta)));
+                uvs.push_back(Vector2(static_cast<float>(slice) / slices, 1.0f - static_cast<float>(stack) / stacks));
+            }
+        }
+
+        for (size_t stack = 0; stack < stacks; stack++)
+        {
+            for (size_t slice = 0; slice < slices; slice++)
+            {
+                unsigned int a = static_cast<unsigned int>(stack * (slices + 1) + slice);
+                unsigned int b = a + static_cast<unsigned int>(slices + 1);
+
+                // Skip the degenerate halves of the pole quads
+                if (stack != 0)
+                {
+                    unsigned int top[3] = { a, b, a + 1 };
+                    indices.insert(indices.end(), top, top + 3);
+                }
+
+                if (stack != stacks - 1)
+                {
+                    unsigned int bottom[3] = { a + 1, b, b + 1 };
+                    indices.insert(indices.end(), bottom, bottom + 3);
+                }
+            }
+        }
+    }
+
+    // Weld by brute force: each vertex joins the first earlier kept vertex within epsilon, & keeps itself otherwise
+    static size_t ReferenceWeld(const std::vector<Vector3>& positions, const float epsilon, std::vector<unsigned int>& remap)
+    {
+        std::vector<unsigned int> kept;
+        remap.resize(positions.size());
+
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            remap[i] = static_cast<unsigned int>(kept.size());
+
+            for (size_t k = 0; k < kept.size(); k++)
+            {
+                const Vector3& other = positions[kept[k]];
+                float dx = positions[i].x - other.x, dy = positions[i].y - other.y, dz = positions[i].z - other.z;
+
+                if ((epsilon <= 0.0f) ? (dx == 0.0f && dy == 0.0f && dz == 0.0f) : (dx * dx + dy * dy + dz * dz <= epsilon * epsilon))
+                {
+                    remap[i] = static_cast<unsigned int>(k);
+                    break;
+                }
+            }
+
+            if (remap[i] == kept.size())
+            {
+                kept.push_back(static_cast<unsigned int>(i));
+            }
+        }
+
+        return kept.size();
+    }
+
+    void TestMesh()
+    {
+        printf("Mesh\n");
+
+        // Face & vertex normals against a scalar accumulation, with one vertex no triangle uses.  Enough vertices for several threads' ranges,
+        // with corners scattered so most triangles straddle ranges
+        const size_t used = 20000;
+        std::vector<Vector3> positions = std::vector<Vector3>(used + 1);
+        std::vector<unsigned int> indices = std::vector<unsigned int>(3 * 60001);
+
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            positions[i] = RandomVector3(-5.0f, 5.0f);
+        }
+
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            indices[i] = static_cast<unsigned int>((i * 7919) % used);
+        }
+
+        size_t triangleCount = indices.size() / 3;
+        std::vector<Vector3> faces = std::vector<Vector3>(triangleCount);
+        std::vector<Vector3> normals = std::vector<Vector3>(positions.size());
+        std::vector<double> expected = std::vector<double>(positions.size() * 3, 0.0);
+        Mesh::FaceNormals(positions.data(), indices.data(), triangleCount, faces.data());
+        Mesh::VertexNormals(positions.data(), positions.size(), indices.data(), triangleCount, normals.data());
+        float faceError = 0.0f, vertexError = 0.0f;
+
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            const Vector3& a = positions[indices[t * 3]];
+            const Vector3& b = positions[indices[t * 3 + 1]];
+            const Vector3& c = positions[indices[t * 3 + 2]];
+            double e1[3] = { b.x - a.x, b.y - a.y, b.z - a.z }, e2[3] = { c.x - a.x, c.y - a.y, c.z - a.z };
+            double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            faceError = fmaxf(faceError, static_cast<float>((fabs(faces[t].x - n[0]) + fabs(faces[t].y - n[1]) + fabs(faces[t].z - n[2])) / (1.0 + length)));
+
+            for (int corner = 0; corner < 3; corner++)
+            {
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    expected[indices[t * 3 + corner] * 3 + axis] += n[axis];
+                }
+            }
+        }
+
+        for (size_t v = 0; v < positions.size(); v++)
+        {
+            double* n = &expected[v * 3];
+            double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            length = (length > 0.0) ? length : 1.0;
+            vertexError = fmaxf(vertexError, static_cast<float>(fabs(normals[v].x - n[0] / length) + fabs(normals[v].y - n[1] / length) + fabs(normals[v].z - n[2] / length)));
+        }
+
+        Check(faceError < 1e-5f, "FaceNormals differ from the cross products by %g", faceError);
+        Check(vertexError < 1e-4f, "VertexNormals differ from the scalar sum by %g", vertexError);
+        Check(normals[used].x == 0.0f && normals[used].y == 0.0f && normals[used].z == 0.0f, "unused vertex got a normal");
+
+        // Sphere normals point outward & tangents are unit, orthogonal to the normal & follow increasing longitude
+        std::vector<Vector2> uvs;
+        std::vector<Vector4> tangents;
+        const size_t slices = 96;
+        Sphere(slices, 48, positions, uvs, indices);
+        triangleCount = indices.size() / 3;
+        normals.resize(positions.size());
+        tangents.resize(positions.size());
+        Mesh::VertexNormals(positions.data(), positions.size(), indices.data(), triangleCount, normals.data());
+        Mesh::Tangents(positions.data(), normals.data(), uvs.data(), positions.size(), indices.data(), triangleCount, tangents.data());
+        float radialError = 0.0f, tangentError = 0.0f;
+        int wrongDirection = 0;
+
+        for (size_t v = 0; v < positions.size(); v++)
+        {
+            // Away from the poles, where longitude is undefined & most pole copies are unused
+            if (fabsf(positions[v].y) < 0.95f)
+            {
+                // The unwelded seam copies only see the triangles on their own side
+                bool seam = v % (slices + 1) == 0 || v % (slices + 1) == slices;
+                radialError = seam ? radialError : fmaxf(radialError, fabsf(normals[v].x - positions[v].x) + fabsf(normals[v].y - positions[v].y) + fabsf(normals[v].z - positions[v].z));
+                float dot = normals[v].x * tangents[v].x + normals[v].y * tangents[v].y + normals[v].z * tangents[v].z;
+                float length = sqrtf(tangents[v].x * tangents[v].x + tangents[v].y * tangents[v].y + tangents[v].z * tangents[v].z);
+                tangentError = fmaxf(tangentError, fmaxf(fabsf(dot), fabsf(length - 1.0f)));
+
+                // d position / d longitude is (z, 0, -x) for this parameterization
+                float along = positions[v].z * tangents[v].x - positions[v].x * tangents[v].z;
+                wrongDirection += (along > 0.0f && fabsf(tangents[v].w) == 1.0f) ? 0 : 1;
+            }
+        }
+
+        Check(radialError < 2e-2f, "sphere normals are %g off radial", radialError);
+        Check(tangentError < 1e-4f, "sphere tangents are %g from unit & orthogonal", tangentError);
+        Check(wrongDirection == 0, "%d sphere tangents don't follow increasing u", wrongDirection);
+
+        // Flipping v has to flip only the bitangent sign
+        PlaneGrid(20, 20, 1.0f, positions, uvs, indices);
+        normals.resize(positions.size());
+        tangents.resize(positions.size());
+        Mesh::VertexNormals(positions.data(), positions.size(), indices.data(), indices.size() / 3, normals.data());
+        Mesh::Tangents(positions.data(), normals.data(), uvs.data(), positions.size(), indices.data(), indices.size() / 3, tangents.data());
+        bool upright = true;
+
+        for (size_t v = 0; v < positions.size(); v++)
+        {
+            upright = upright && normals[v].z > 0.999f && tangents[v].x > 0.99f && tangents[v].w == 1.0f;
+        }
+
+        for (size_t v = 0; v < uvs.size(); v++)
+        {
+            uvs[v] = Vector2(uvs[v].x, -uvs[v].y);
+        }
+
+        Mesh::Tangents(positions.data(), normals.data(), uvs.data(), positions.size(), indices.data(), indices.size() / 3, tangents.data());
+        bool mirrored = true;
+
+        for (size_t v = 0; v < positions.size(); v++)
+        {
+            mirrored = mirrored && tangents[v].x > 0.99f && tangents[v].w == -1.0f;
+        }
+
+        Check(upright, "plane normals aren't +z or tangents +x with a positive sign");
+        Check(mirrored, "mirrored v didn't flip only the tangent sign");
+
+        // Clusters on a 1/256 grid, so every squared distance is exact & none falls close enough to epsilon squared for round off to decide a weld.
+        // Every fifth vertex repeats an earlier one, with some zero coordinates negated to check -0 welds to 0
+        const float gridStep = 1.0f / 256.0f;
+        std::vector<Vector3> welded = std::vector<Vector3>(4000);
+
+        for (size_t i = 0; i < welded.size(); i++)
+        {
+            if (i % 5 == 4)
+            {
+                welded[i] = welded[(i * 7) % i];
+                welded[i] = Vector3((welded[i].x == 0.0f) ? -welded[i].x : welded[i].x, welded[i].y, (welded[i].z == 0.0f) ? -welded[i].z : welded[i].z);
+                continue;
+            }
+
+            float center[3];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                int cluster = static_cast<int>((i * (axis + 3) * 2654435761u) % 20) - 10;
+                center[axis] = (cluster * 16 + static_cast<int>(RandomFloat(-8.0f, 8.0f))) * gridStep;
+            }
+
+            welded[i] = Vector3(center[0], (i % 7 == 0) ? 0.0f : center[1], (i % 11 == 0) ? 0.0f : center[2]);
+        }
+
+        const float epsilons[3] = { 0.0f, 0.01f, 0.05f };
+
+        for (int e = 0; e < 3; e++)
+        {
+            std::vector<unsigned int> remap = std::vector<unsigned int>(welded.size());
+            std::vector<unsigned int> expectedRemap;
+            std::vector<Vector3> unique;
+            size_t uniqueCount = Mesh::Weld(welded.data(), welded.size(), epsilons[e], remap.data(), unique);
+            size_t expectedCount = ReferenceWeld(welded, epsilons[e], expectedRemap);
+            int mismatches = 0;
+
+            for (size_t i = 0; i < welded.size(); i++)
+            {
+                mismatches += (remap[i] == expectedRemap[i]) ? 0 : 1;
+            }
+
+            Check(uniqueCount == expectedCount && unique.size() == expectedCount && mismatches == 0, "Weld epsilon %g kept %zu of %zu vertices against %zu by brute force, %d remaps differ",
+                  epsilons[e], uniqueCount, welded.size(), expectedCount, mismatches);
+            printf("  Weld epsilon %.2f keeps %zu of %zu vertices\n", epsilons[e], uniqueCount, welded.size());
+        }
+
+        // A 2M triangle grid
+        PlaneGrid(1001, 1001, 1.0f, positions, uvs, indices);
+        triangleCount = indices.size() / 3;
+        faces.resize(triangleCount);
+        normals.resize(positions.size());
+        tangents.resize(positions.size());
+
+        Timer timer = Timer();
+        Mesh::FaceNormals(positions.data(), indices.data(), triangleCount, faces.data());
+        Report("FaceNormals 2M triangles", static_cast<double>(triangleCount), timer.Seconds(), "tri");
+
+        timer.Restart();
+        Mesh::VertexNormals(positions.data(), positions.size(), indices.data(), triangleCount, normals.data());
+        Report("VertexNormals 2M triangles", static_cast<double>(triangleCount), timer.Seconds(), "tri");
+
+        timer.Restart();
+        Mesh::Tangents(positions.data(), normals.data(), uvs.data(), positions.size(), indices.data(), triangleCount, tangents.data());
+        Report("Tangents 2M triangles", static_cast<double>(triangleCount), timer.Seconds(), "tri");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static Vector3 Subtract(const Vector3& vec1, const Vector3& vec2)
+    {
+        return Vector3(vec1.x - vec2.x, vec1.y - vec2.y, vec1.z - vec2.z);
+    }
+
+    static Vector3 MultiplyAdd(const Vector3& vec, const float scale, const Vector3& offset)
+    {
+        return Vector3(vec.x * scale + offset.x, vec.y * scale + offset.y, vec.z * scale + offset.z);
+    }
+
+    static float Dot3(const Vector3& vec1, const Vector3& vec2)
+    {
+        return vec1.x * vec2.x + vec1.y * vec2.y + vec1.z * vec2.z;
+    }
+
+    static float Length(const Vector3& vec)
+    {
+        return sqrtf(Dot3(vec, vec));
+    }
+
+    static Quaternion RandomRotation()
+    {
+        Vector3 axis = RandomVector3(-1.0f, 1.0f);
+
+        while (Dot3(axis, axis) < 0.01f)
+        {
+            axis = RandomVector3(-1.0f, 1.0f);
+        }
+
+        return Quaternion(Vector3::Normalized(axis), RandomFloat(0.0f, 6.2831853f));
+    }
+
+    // Depth & normal, from the sphere into the box, of a sphere against a box by clamping into the box's frame.
+    // Returns false if they don't touch
+    static bool SphereBox(const Vector3& centre, const float radius, const ConvexShape& box, Vector3& normal, float& depth)
+    {
+        Vector3 offset = Subtract(centre, box.center);
+        float local[3];
+        float clamped[3];
+        bool inside = true;
+
+        for (int i = 0; i < 3; i++)
+        {
+            local[i] = Dot3(offset, box.axes[i]);
+            clamped[i] = fminf(fmaxf(local[i], -box.extents.elements[i]), box.extents.elements[i]);
+            inside = inside && clamped[i] == local[i];
+        }
+
+        if (inside)
+        {
+            // The shallowest face pushes the sphere out, the normal points from the sphere into the box so against that face's axis
+            int face = 0;
+
+            for (int i = 1; i < 3; i++)
+            {
+                face = (box.extents.elements[i] - fabsf(local[i]) < box.extents.elements[face] - fabsf(local[face])) ? i : face;
+            }
+
+            depth = radius + box.extents.elements[face] - fabsf(local[face]);
+            normal = MultiplyAdd(box.axes[face], (local[face] < 0.0f) ? 1.0f : -1.0f, Vector3());
+            return true;
+        }
+
+        Vector3 closest = box.center;
+
+        for (int i = 0; i < 3; i++)
+        {
+            closest = MultiplyAdd(box.axes[i], clamped[i], closest);
+        }
+
+        Vector3 toBox = Subtract(closest, centre);
+        float distance = Length(toBox);
+        depth = radius - distance;
+        normal = MultiplyAdd(toBox, 1.0f / distance, Vector3());
+        return depth >= 0.0f;
+    }
+
+    void TestNarrowPhase()
+    {
+        printf("NarrowPhase\n");
+
+        ContactManifold manifold = ContactManifold();
+
+        // Concentric & coincident rounded cores overlap by the sum of the radii along some unit normal off the segments
+        bool hit = NarrowPhase::Collide(ConvexShape::Sphere(Vector3(1.0f, 2.0f, 3.0f), 1.0f), ConvexShape::Sphere(Vector3(1.0f, 2.0f, 3.0f), 1.0f), manifold);
+        Check(hit && manifold.count == 1 && fabsf(manifold.depths[0] - 2.0f) < 1e-5f, "concentric unit spheres have depth %g", manifold.depths[0]);
+        Check(fabsf(Length(manifold.normal) - 1.0f) < 1e-5f, "concentric sphere normal has length %g", Length(manifold.normal));
+
+        ConvexShape capsule = ConvexShape::Capsule(Vector3(-2.0f, 0.0f, 0.0f), Vector3(2.0f, 0.0f, 0.0f), 0.5f);
+        hit = NarrowPhase::Collide(ConvexShape::Sphere(Vector3(0.7f, 0.0f, 0.0f), 0.25f), capsule, manifold);
+        Check(hit && fabsf(manifold.depths[0] - 0.75f) < 1e-5f && fabsf(manifold.normal.x) < 1e-5f && fabsf(Length(manifold.normal) - 1.0f) < 1e-5f,
+              "sphere on a capsule axis has depth %g & normal x %g", manifold.depths[0], manifold.normal.x);
+
+        hit = NarrowPhase::Collide(capsule, ConvexShape::Capsule(Vector3(0.0f, 0.0f, -2.0f), Vector3(0.0f, 0.0f, 2.0f), 0.5f), manifold);
+        Check(hit && fabsf(manifold.depths[0] - 1.0f) < 1e-5f && fabsf(fabsf(manifold.normal.y) - 1.0f) < 1e-5f,
+              "crossing capsules have depth %g & normal y %g", manifold.depths[0], manifold.normal.y);
+
+        hit = NarrowPhase::Collide(capsule, ConvexShape::Capsule(Vector3(-1.0f, 0.0f, 0.0f), Vector3(3.0f, 0.0f, 0.0f), 0.5f), manifold);
+        Check(hit && fabsf(manifold.depths[0] - 1.0f) < 1e-5f && fabsf(manifold.normal.x) < 1e-5f, "collinear capsules have depth %g", manifold.depths[0]);
+
+        // Sphere & capsule pairs against the closed form, down to cores a hair apart
+        int sphereMismatches = 0, capsuleMismatches = 0;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            Vector3 centre1 = RandomVector3(-5.0f, 5.0f);
+            Vector3 direction = Vector3::Normalized(RandomVector3(-1.0f, 1.0f));
+            float radius1 = RandomFloat(0.1f, 2.0f), radius2 = RandomFloat(0.1f, 2.0f);
+            float distance = (i % 4 == 0) ? RandomFloat(0.0f, 1e-4f) : RandomFloat(0.0f, (radius1 + radius2) * 1.2f);
+            Vector3 centre2 = MultiplyAdd(direction, distance, centre1);
+            distance = Length(Subtract(centre2, centre1));
+            hit = NarrowPhase::Collide(ConvexShape::Sphere(centre1, radius1), ConvexShape::Sphere(centre2, radius2), manifold);
+            float depth = radius1 + radius2 - distance;
+            bool normalRight = false;
+
+            if (hit != (depth >= 0.0f))
+            {
+                sphereMismatches++;
+            }
+            else if (hit)
+            {
+                Vector3 midway = MultiplyAdd(manifold.normal, (radius1 - radius2) * 0.5f, Vector3((centre1.x + centre2.x) * 0.5f, (centre1.y + centre2.y) * 0.5f, (centre1.z + centre2.z) * 0.5f));
+                normalRight = (distance > 1e-3f) ? Dot3(manifold.normal, Subtract(centre2, centre1)) > distance * 0.9999f : fabsf(Length(manifold.normal) - 1.0f) < 1e-5f;
+                sphereMismatches += (fabsf(manifold.depths[0] - depth) < 1e-4f && normalRight && Length(Subtract(manifold.points[0], midway)) < 1e-3f) ? 0 : 1;
+            }
+
+            // A capsule along a random axis with the sphere offset perpendicular from a point on its segment
+            Vector3 axis = Vector3::Normalized(RandomVector3(-1.0f, 1.0f));
+            Vector3 side = Vector3::Normalized(Vector3::Cross(axis, direction));
+            float along = RandomFloat(-1.0f, 1.0f);
+            ConvexShape segment = ConvexShape::Capsule(MultiplyAdd(axis, -1.0f, centre1), MultiplyAdd(axis, 1.0f, centre1), radius1);
+            Vector3 onSegment = MultiplyAdd(axis, along, centre1);
+            hit = NarrowPhase::Collide(segment, ConvexShape::Sphere(MultiplyAdd(side, distance, onSegment), radius2), manifold);
+            normalRight = (distance > 1e-3f) ? Dot3(manifold.normal, side) > 0.9999f : fabsf(Dot3(manifold.normal, axis)) < 1e-2f && fabsf(Length(manifold.normal) - 1.0f) < 1e-5f;
+            capsuleMismatches += (hit == (depth >= 0.0f) && (!hit || (fabsf(manifold.depths[0] - depth) < 1e-4f && normalRight))) ? 0 : 1;
+        }
+
+        Check(sphereMismatches == 0, "%d sphere pairs differ from the closed form", sphereMismatches);
+        Check(capsuleMismatches == 0, "%d capsule & sphere pairs differ from the closed form", capsuleMismatches);
+
+        // Spheres against rotated boxes, from outside & from inside, through GJK & EPA
+        int boxMismatches = 0;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            ConvexShape box = ConvexShape::Box(RandomVector3(-5.0f, 5.0f), RandomRotation(), RandomVector3(0.2f, 2.0f));
+            Vector3 centre = MultiplyAdd(RandomVector3(-2.5f, 2.5f), 1.0f, box.center);
+            float radius = RandomFloat(0.1f, 1.0f);
+            Vector3 normal;
+            float depth;
+            bool expected = SphereBox(centre, radius, box, normal, depth);
+
+            // Skip grazing contacts where either answer is right
+            if (fabsf(depth) < 1e-3f)
+            {
+                continue;
+            }
+
+            hit = NarrowPhase::Collide(ConvexShape::Sphere(centre, radius), box, manifold);
+            boxMismatches += (hit == expected && (!hit || (fabsf(manifold.depths[0] - depth) < 2e-3f * (1.0f + depth) && Dot3(manifold.normal, normal) > 0.999f))) ? 0 : 1;
+        }
+
+        Check(boxMismatches == 0, "%d sphere & box pairs differ from the clamped closed form", boxMismatches);
+
+        // Axis aligned boxes overlap by their shallowest axis.  For rotated ones the deepest contact has to agree with EPA within SAT's 5% face preference
+        int alignedMismatches = 0, rotatedMismatches = 0;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            Vector3 centre1 = RandomVector3(-1.0f, 1.0f), centre2 = RandomVector3(-1.0f, 1.0f);
+            Vector3 extents1 = RandomVector3(0.2f, 1.5f), extents2 = RandomVector3(0.2f, 1.5f);
+            float depth = FLT_MAX;
+            int axis = 0;
+
+            for (int a = 0; a < 3; a++)
+            {
+                float overlap = extents1.elements[a] + extents2.elements[a] - fabsf(centre2.elements[a] - centre1.elements[a]);
+                axis = (overlap < depth) ? a : axis;
+                depth = (overlap < depth) ? overlap : depth;
+            }
+
+            if (fabsf(depth) > 1e-3f)
+            {
+                hit = NarrowPhase::Collide(ConvexShape::Box(centre1, Quaternion(), extents1), ConvexShape::Box(centre2, Quaternion(), extents2), manifold);
+                float sign = (centre2.elements[axis] > centre1.elements[axis]) ? 1.0f : -1.0f;
+                alignedMismatches += (hit == (depth > 0.0f) && (!hit || (fabsf(manifold.depths[0] - depth) < 1e-4f && manifold.normal.elements[axis] * sign > 0.9999f))) ? 0 : 1;
+            }
+
+            ConvexShape box1 = ConvexShape::Box(centre1, RandomRotation(), extents1);
+            ConvexShape box2 = ConvexShape::Box(centre2, RandomRotation(), extents2);
+            Vector3 normal, point1, point2;
+            float epaDepth = 0.0f;
+            bool overlap = NarrowPhase::Penetration(box1, box2, normal, epaDepth, point1, point2);
+
+            if (!overlap || epaDepth > 1e-3f)
+            {
+                hit = NarrowPhase::Collide(box1, box2, manifold);
+                float satDepth = 0.0f;
+
+                for (int p = 0; p < manifold.count; p++)
+                {
+                    satDepth = fmaxf(satDepth, manifold.depths[p]);
+                }
+
+                rotatedMismatches += (hit == overlap && (!hit || (satDepth >= epaDepth - 1e-3f && satDepth <= (epaDepth + 1e-3f) / 0.95f))) ? 0 : 1;
+            }
+        }
+
+        Check(alignedMismatches == 0, "%d axis aligned box pairs differ from the shallowest axis", alignedMismatches);
+        Check(rotatedMismatches == 0, "%d rotated box pairs disagree between SAT & EPA", rotatedMismatches);
+
+        // 100k touching pairs of each kind through the batch Collide
+        const size_t pairCount = 100000;
+        const char* names[4] = { "Collide sphere pairs", "Collide capsule pairs", "Collide sphere & box pairs", "Collide box pairs" };
+        std::vector<ConvexShape> shapes = std::vector<ConvexShape>(pairCount * 2);
+        std::vector<unsigned int> pairs = std::vector<unsigned int>(pairCount * 2);
+        std::vector<ContactManifold> manifolds = std::vector<ContactManifold>(pairCount);
+
+        for (size_t i = 0; i < pairs.size(); i++)
+        {
+            pairs[i] = static_cast<unsigned int>(i);
+        }
+
+        for (int kind = 0; kind < 4; kind++)
+        {
+            for (size_t i = 0; i < pairCount; i++)
+            {
+                Vector3 centre = RandomVector3(-100.0f, 100.0f);
+                Vector3 offset = RandomVector3(-0.6f, 0.6f);
+                Vector3 other = Vector3(centre.x + offset.x, centre.y + offset.y, centre.z + offset.z);
+                ConvexShape box1 = ConvexShape::Box(centre, RandomRotation(), Vector3(0.5f, 0.5f, 0.5f));
+                ConvexShape box2 = ConvexShape::Box(other, RandomRotation(), Vector3(0.5f, 0.5f, 0.5f));
+                ConvexShape capsule1 = ConvexShape::Capsule(MultiplyAdd(box1.axes[1], -0.5f, centre), MultiplyAdd(box1.axes[1], 0.5f, centre), 0.4f);
+                ConvexShape capsule2 = ConvexShape::Capsule(MultiplyAdd(box2.axes[1], -0.5f, other), MultiplyAdd(box2.axes[1], 0.5f, other), 0.4f);
+                shapes[i * 2] = (kind == 0 || kind == 2) ? ConvexShape::Sphere(centre, 0.5f) : (kind == 1) ? capsule1 : box1;
+                shapes[i * 2 + 1] = (kind == 0) ? ConvexShape::Sphere(other, 0.5f) : (kind == 1) ? capsule2 : box2;
+            }
+
+            Timer timer = Timer();
+            NarrowPhase::Collide(shapes.data(), pairs.data(), pairCount, manifolds.data());
+            Report(names[kind], static_cast<double>(pairCount), timer.Seconds(), "pair");
+        }
+    }
+}
\ No newline at end of file
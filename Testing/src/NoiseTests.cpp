@@ -0,0 +1,189 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static __m128 Sample(const Noise& noise, const NoiseType type, const int dimensions, const __m128 x, const __m128 y, const __m128 z, const __m128 w)
+    {
+        if (type == NoiseType::Perlin)
+        {
+            return (dimensions == 2) ? noise.Perlin(x, y) : (dimensions == 3) ? noise.Perlin(x, y, z) : noise.Perlin(x, y, z, w);
+        }
+
+        return (dimensions == 2) ? noise.Simplex(x, y) : (dimensions == 3) ? noise.Simplex(x, y, z) : noise.Simplex(x, y, z, w);
+    }
+
+    static float Lane(const __m128 values, const int lane)
+    {
+        __declspec(align(16)) float lanes[4];
+        _mm_store_ps(lanes, values);
+        return lanes[lane];
+    }
+
+    // Range, spread, continuity, lane independence & seeding of one noise function
+    static void CheckNoise(const NoiseType type, const int dimensions)
+    {
+        const char* name = (type == NoiseType::Perlin) ? "Perlin" : "Simplex";
+        Noise noise = Noise(7);
+        Noise other = Noise(8);
+        float largest = 0.0f, jump = 0.0f;
+        double sum = 0.0, sumSqr = 0.0, otherSum = 0.0, otherSqr = 0.0, crossSum = 0.0;
+        int laneMismatches = 0, latticeNonZero = 0;
+        const int samples = 100000;
+
+        for (int i = 0; i < samples; i += 4)
+        {
+            __m128 x = _mm_setr_ps(RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f));
+            __m128 y = _mm_setr_ps(RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f));
+            __m128 z = _mm_setr_ps(RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f));
+            __m128 w = _mm_setr_ps(RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f));
+            __m128 values = Sample(noise, type, dimensions, x, y, z, w);
+            __m128 reseeded = Sample(other, type, dimensions, x, y, z, w);
+
+            // Each lane has to depend on its own point only
+            int lane = i % 4;
+            float alone = Lane(Sample(noise, type, dimensions, _mm_set1_ps(Lane(x, lane)), _mm_set1_ps(Lane(y, lane)), _mm_set1_ps(Lane(z, lane)), _mm_set1_ps(Lane(w, lane))), 0);
+            laneMismatches += (alone == Lane(values, lane)) ? 0 : 1;
+
+            for (int j = 0; j < 4; j++)
+            {
+                float value = Lane(values, j);
+                largest = fmaxf(largest, fabsf(value));
+                float reseededValue = Lane(reseeded, j);
+                sum += value;
+                sumSqr += static_cast<double>(value) * value;
+                otherSum += reseededValue;
+                otherSqr += static_cast<double>(reseededValue) * reseededValue;
+                crossSum += static_cast<double>(value) * reseededValue;
+            }
+
+            // Perlin noise is zero on every lattice point
+            __m128 lattice = _mm_round_ps(x, _MM_FROUND_TO_NEAREST_INT);
+            __m128 latticeY = _mm_round_ps(y, _MM_FROUND_TO_NEAREST_INT);
+            __m128 latticeZ = _mm_round_ps(z, _MM_FROUND_TO_NEAREST_INT);
+            __m128 latticeW = _mm_round_ps(w, _MM_FROUND_TO_NEAREST_INT);
+            __m128 atLattice = Sample(noise, type, dimensions, lattice, latticeY, latticeZ, latticeW);
+            latticeNonZero += (type == NoiseType::Perlin && _mm_movemask_ps(_mm_cmpneq_ps(atLattice, _mm_setzero_ps())) != 0) ? 1 : 0;
+        }
+
+        // Short steps along 4 lines crossing many cells, a seam between cells shows up as a jump far above the slope
+        __m128 start[4] = { _mm_setr_ps(0.1f, -7.3f, 13.7f, 2.9f), _mm_setr_ps(0.2f, 5.1f, -3.3f, 8.8f), _mm_setr_ps(0.3f, 1.7f, 6.2f, -4.4f), _mm_setr_ps(-0.4f, 9.9f, 0.6f, -2.2f) };
+        __m128 direction[4] = { _mm_setr_ps(0.7f, -0.3f, 0.5f, 0.2f), _mm_setr_ps(0.5f, 0.8f, -0.4f, 0.6f), _mm_setr_ps(0.3f, 0.4f, 0.7f, -0.7f), _mm_setr_ps(-0.4f, 0.3f, 0.3f, 0.3f) };
+        __m128 previous = _mm_setzero_ps();
+
+        for (int i = 0; i <= 250000; i++)
+        {
+            __m128 t = _mm_set1_ps(i * 2e-5f);
+            __m128 values = Sample(noise, type, dimensions, _mm_add_ps(start[0], _mm_mul_ps(direction[0], t)), _mm_add_ps(start[1], _mm_mul_ps(direction[1], t)),
+                                   _mm_add_ps(start[2], _mm_mul_ps(direction[2], t)), _mm_add_ps(start[3], _mm_mul_ps(direction[3], t)));
+
+            for (int j = 0; j < 4 && i > 0; j++)
+            {
+                jump = fmaxf(jump, fabsf(Lane(values, j) - Lane(previous, j)));
+            }
+
+            previous = values;
+        }
+
+        double mean = sum / samples;
+        double deviation = sqrt(sumSqr / samples - mean * mean);
+        double otherMean = otherSum / samples;
+        double correlation = (crossSum / samples - mean * otherMean) / (deviation * sqrt(otherSqr / samples - otherMean * otherMean));
+        Check(largest <= 1.1f, "%s %dD reached %g", name, dimensions, largest);
+        Check(fabs(mean) < 0.02 && deviation > 0.1, "%s %dD has mean %g & deviation %g", name, dimensions, mean, deviation);
+        Check(jump < 5e-4f, "%s %dD jumps by %g between samples 2e-5 apart", name, dimensions, jump);
+        Check(laneMismatches == 0, "%s %dD lanes depend on each other in %d samples", name, dimensions, laneMismatches);
+        Check(fabs(correlation) < 0.05, "%s %dD with different seeds correlates by %g", name, dimensions, correlation);
+        Check(latticeNonZero == 0, "%s %dD is not zero on %d lattice groups", name, dimensions, latticeNonZero);
+        printf("  %-8s %dD  max |n| %.3f  deviation %.3f  largest step %.2g\n", name, dimensions, largest, deviation, jump);
+    }
+
+    void TestNoise()
+    {
+        printf("Noise\n");
+
+        for (int dimensions = 2; dimensions <= 4; dimensions++)
+        {
+            CheckNoise(NoiseType::Perlin, dimensions);
+            CheckNoise(NoiseType::Simplex, dimensions);
+        }
+
+        // Grid & Evaluate have to match Fractal at the same points, with widths that leave a partial group
+        Noise noise = Noise(3);
+        FractalSettings settings = FractalSettings();
+        settings.octaves = 5;
+        settings.frequency = 0.05f;
+        const size_t width = 37, height = 11, depth = 5;
+        std::vector<float> grid2 = std::vector<float>(width * height);
+        std::vector<float> grid3 = std::vector<float>(width * height * depth);
+        std::vector<Vector3> points = std::vector<Vector3>(width * height * depth);
+        std::vector<float> evaluated = std::vector<float>(points.size());
+        noise.Grid(Vector2(-3.0f, 5.0f), Vector2(0.7f, 1.3f), width, height, settings, grid2.data());
+        settings.ridged = true;
+        noise.Grid(Vector3(-3.0f, 5.0f, 2.0f), Vector3(0.7f, 1.3f, 0.9f), width, height, depth, settings, grid3.data());
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            points[i] = Vector3(-3.0f + (i % width) * 0.7f, 5.0f + ((i / width) % height) * 1.3f, 2.0f + (i / (width * height)) * 0.9f);
+        }
+
+        noise.Evaluate(points.data(), points.size(), settings, evaluated.data());
+        float gridError = 0.0f, ridgedLow = 0.0f, ridgedHigh = 0.0f;
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            __m128 x = _mm_set1_ps(points[i].x), y = _mm_set1_ps(points[i].y), z = _mm_set1_ps(points[i].z);
+            float ridged = Lane(noise.Fractal(x, y, z, settings), 0);
+            gridError = fmaxf(gridError, fmaxf(fabsf(grid3[i] - ridged), fabsf(evaluated[i] - ridged)));
+            ridgedLow = fminf(ridgedLow, ridged);
+            ridgedHigh = fmaxf(ridgedHigh, ridged);
+
+            if (i < grid2.size())
+            {
+                settings.ridged = false;
+                gridError = fmaxf(gridError, fabsf(grid2[i] - Lane(noise.Fractal(x, y, settings), 0)));
+                settings.ridged = true;
+            }
+        }
+
+        Check(gridError < 1e-4f, "Grid & Evaluate differ from Fractal by %g", gridError);
+        Check(ridgedLow >= 0.0f && ridgedHigh <= 1.0f, "ridged fractal left [0, 1]: %g to %g", ridgedLow, ridgedHigh);
+
+        // Terrain sized grids
+        std::vector<float> heights = std::vector<float>(1024 * 1024);
+        std::vector<float> volume = std::vector<float>(128 * 128 * 128);
+        settings = FractalSettings();
+        settings.frequency = 0.01f;
+
+        for (int type = 0; type < 2; type++)
+        {
+            settings.type = (type == 0) ? NoiseType::Perlin : NoiseType::Simplex;
+            const char* names[2][3] = { { "Perlin 2D grid", "Perlin 2D grid, 6 octaves", "Perlin 3D grid" },
+                                        { "Simplex 2D grid", "Simplex 2D grid, 6 octaves", "Simplex 3D grid" } };
+
+            settings.octaves = 1;
+            Timer timer = Timer();
+            noise.Grid(Vector2(), Vector2(1.0f, 1.0f), 1024, 1024, settings, heights.data());
+            Report(names[type][0], 1024.0 * 1024.0, timer.Seconds(), "sample");
+
+            settings.octaves = 6;
+            timer.Restart();
+            noise.Grid(Vector2(), Vector2(1.0f, 1.0f), 1024, 1024, settings, heights.data());
+            Report(names[type][1], 1024.0 * 1024.0, timer.Seconds(), "sample");
+
+            settings.octaves = 1;
+            timer.Restart();
+            noise.Grid(Vector3(), Vector3(1.0f, 1.0f, 1.0f), 128, 128, 128, settings, volume.data());
+            Report(names[type][2], 128.0 * 128.0 * 128.0, timer.Seconds(), "sample");
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Marks reference pixels either rasterization rule may cover
+    static const double Ambiguous = -DBL_MAX;
+
+    // Reference depth in double with an identity view projection, so NDC & world space are the same.
+    // Pixels whose centre lies within edgeMargin of an edge are marked Ambiguous as either answer is right
+    static std::vector<double> ReferenceDepth(const std::vector<Vector3>& vertices, const int width, const int height, const double edgeMargin)
+    {
+        std::vector<double> toReturn = std::vector<double>(static_cast<size_t>(width) * height, FLT_MAX);
+
+        for (size_t t = 0; t + 2 < vertices.size(); t += 3)
+        {
+            const Vector3& a = vertices[t];
+            const Vector3& b = vertices[t + 1];
+            const Vector3& c = vertices[t + 2];
+            double area = (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) - (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+
+            if (fabs(area) < 1e-9)
+            {
+                continue;
+            }
+
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    double px = (x + 0.5) / width * 2.0 - 1.0;
+                    double py = 1.0 - (y + 0.5) / height * 2.0;
+                    double w0 = ((static_cast<double>(b.x) - px) * (static_cast<double>(c.y) - py) - (static_cast<double>(b.y) - py) * (static_cast<double>(c.x) - px)) / area;
+                    double w1 = ((static_cast<double>(c.x) - px) * (static_cast<double>(a.y) - py) - (static_cast<double>(c.y) - py) * (static_cast<double>(a.x) - px)) / area;
+                    double w2 = 1.0 - w0 - w1;
+                    double inner = fmin(w0, fmin(w1, w2));
+                    double& pixel = toReturn[static_cast<size_t>(y) * width + x];
+
+                    if (fabs(inner) < edgeMargin)
+                    {
+                        pixel = Ambiguous;
+                    }
+                    else if (inner > 0.0 && pixel != Ambiguous)
+                    {
+                        double z = w0 * a.z + w1 * b.z + w2 * c.z;
+                        pixel = (z < pixel) ? z : pixel;
+                    }
+                }
+            }
+        }
+
+        return toReturn;
+    }
+
+    void TestOcclusionBuffer()
+    {
+        printf("OcclusionBuffer\n");
+
+        // Not a multiple of the tile size so the padded edge tiles are exercised
+        const int width = 300, height = 200;
+        std::vector<Vector3> vertices = std::vector<Vector3>(60 * 3);
+
+        for (size_t t = 0; t < vertices.size(); t += 3)
+        {
+            Vector3 centre = RandomVector3(-1.0f, 1.0f);
+
+            for (int i = 0; i < 3; i++)
+            {
+                Vector3 offset = RandomVector3(-0.4f, 0.4f);
+                vertices[t + i] = Vector3(centre.x + offset.x, centre.y + offset.y, fminf(fmaxf(centre.z + offset.z * 0.5f, -0.95f), 0.95f));
+            }
+        }
+
+        OcclusionBuffer buffer = OcclusionBuffer(width, height);
+        buffer.Clear(Matrix4::Identity);
+        buffer.RenderOccluders(vertices.data(), vertices.size() / 3);
+        std::vector<double> reference = ReferenceDepth(vertices, width, height, 1e-4);
+        int stride = (width + OcclusionBuffer::TileWidth - 1) / OcclusionBuffer::TileWidth * OcclusionBuffer::TileWidth;
+        int depthMismatches = 0;
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                double expected = reference[static_cast<size_t>(y) * width + x];
+                double found = buffer.Depth()[static_cast<size_t>(y) * stride + x];
+                depthMismatches += (expected == Ambiguous || fabs(found - expected) <= 1e-4 * (1.0 + fabs(expected))) ? 0 : 1;
+            }
+        }
+
+        Check(buffer.Width() == width && buffer.Height() == height, "OcclusionBuffer is %d x %d", buffer.Width(), buffer.Height());
+        Check(depthMismatches == 0, "%d pixels differ from the reference rasterizer", depthMismatches);
+
+        // Occludees may be kept conservatively but never culled while the depth at a pixel inside them lies behind them
+        std::vector<AABB> boxes = std::vector<AABB>(4000);
+        std::vector<unsigned char> visible = std::vector<unsigned char>(boxes.size());
+
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            Vector3 centre = RandomVector3(-1.1f, 1.1f);
+            Vector3 extent = RandomVector3(0.005f, 0.1f);
+            boxes[i] = AABB(Vector3(centre.x - extent.x, centre.y - extent.y, centre.z - extent.z), Vector3(centre.x + extent.x, centre.y + extent.y, centre.z + extent.z));
+        }
+
+        buffer.TestOccludees(boxes.data(), visible.data(), boxes.size());
+        int wronglyCulled = 0, batchMismatches = 0, hidden = 0, culled = 0;
+
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            // Visible if the depth at any pixel centre inside the box lies behind it.  Hidden if every pixel the box's screen rectangle touches,
+            // widened a little for round off, holds depth in front of it.  Pixels on a triangle edge count toward neither answer
+            bool expected = false;
+            bool occluded = true;
+            int x0 = static_cast<int>(floor((boxes[i].min.x * 0.5 + 0.5) * width - 1e-3));
+            int x1 = static_cast<int>(floor((boxes[i].max.x * 0.5 + 0.5) * width + 1e-3));
+            int y0 = static_cast<int>(floor((0.5 - boxes[i].max.y * 0.5) * height - 1e-3));
+            int y1 = static_cast<int>(floor((0.5 - boxes[i].min.y * 0.5) * height + 1e-3));
+            bool onScreen = x1 >= 0 && y1 >= 0 && x0 < width && y0 < height;
+
+            for (int y = (y0 > 0) ? y0 : 0; y <= y1 && y < height; y++)
+            {
+                double py = 1.0 - (y + 0.5) / height * 2.0;
+
+                for (int x = (x0 > 0) ? x0 : 0; x <= x1 && x < width; x++)
+                {
+                    double px = (x + 0.5) / width * 2.0 - 1.0;
+                    double pixel = reference[static_cast<size_t>(y) * width + x];
+                    bool inside = px > boxes[i].min.x + 1e-4 && px < boxes[i].max.x - 1e-4 && py > boxes[i].min.y + 1e-4 && py < boxes[i].max.y - 1e-4;
+                    expected = expected || (inside && pixel > boxes[i].min.z + 1e-4);
+                    occluded = occluded && pixel != Ambiguous && pixel < boxes[i].min.z - 1e-4;
+                }
+            }
+
+            bool found = buffer.IsVisible(boxes[i]);
+            wronglyCulled += (expected && !found) ? 1 : 0;
+            batchMismatches += ((visible[i] != 0) == found) ? 0 : 1;
+            hidden += (onScreen && occluded) ? 1 : 0;
+            culled += (onScreen && occluded && !found) ? 1 : 0;
+        }
+
+        Check(wronglyCulled == 0, "%d visible boxes were culled", wronglyCulled);
+        Check(batchMismatches == 0, "%d TestOccludees results differ from IsVisible", batchMismatches);
+        Check(hidden > 0 && culled == hidden, "only %d of %d hidden boxes were culled", culled, hidden);
+
+        // Box behind & in front of a full screen occluder through a perspective projection
+        Matrix4 projection = Matrix4::Perspective(1.2f, 1280.0f, 720.0f, 0.1f, 1000.0f);
+        const Vector3 wall[6] = { Vector3(-100.0f, -100.0f, -10.0f), Vector3(100.0f, -100.0f, -10.0f), Vector3(100.0f, 100.0f, -10.0f),
+                                  Vector3(-100.0f, -100.0f, -10.0f), Vector3(100.0f, 100.0f, -10.0f), Vector3(-100.0f, 100.0f, -10.0f) };
+        buffer.Resize(1280, 720);
+        buffer.Clear(projection);
+        buffer.RenderOccluders(wall, 2);
+        Check(!buffer.IsVisible(AABB(Vector3(-1.0f, -1.0f, -30.0f), Vector3(1.0f, 1.0f, -20.0f))), "box behind a wall is visible");
+        Check(buffer.IsVisible(AABB(Vector3(-1.0f, -1.0f, -8.0f), Vector3(1.0f, 1.0f, -5.0f))), "box in front of a wall is hidden");
+        Check(buffer.IsVisible(AABB(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f))), "box around the camera is hidden");
+
+        // A city block style frame: 10k occluder triangles & 100k occludees at 1280 x 720
+        std::vector<Vector3> scene = std::vector<Vector3>(10000 * 3);
+        std::vector<AABB> occludees = std::vector<AABB>(100000);
+        visible.resize(occludees.size());
+
+        for (size_t t = 0; t < scene.size(); t += 3)
+        {
+            Vector3 centre = RandomVector3(-200.0f, 200.0f);
+            centre.z = RandomFloat(-400.0f, -5.0f);
+
+            for (int i = 0; i < 3; i++)
+            {
+                Vector3 offset = RandomVector3(-8.0f, 8.0f);
+                scene[t + i] = Vector3(centre.x + offset.x, centre.y + offset.y, centre.z + offset.z);
+            }
+        }
+
+        for (size_t i = 0; i < occludees.size(); i++)
+        {
+            Vector3 centre = RandomVector3(-200.0f, 200.0f);
+            centre.z = RandomFloat(-400.0f, -5.0f);
+            occludees[i] = AABB(Vector3(centre.x - 1.0f, centre.y - 1.0f, centre.z - 1.0f), Vector3(centre.x + 1.0f, centre.y + 1.0f, centre.z + 1.0f));
+        }
+
+        Timer timer = Timer();
+        buffer.Clear(projection);
+        buffer.RenderOccluders(scene.data(), scene.size() / 3);
+        Report("RenderOccluders 10k triangles", static_cast<double>(scene.size() / 3), timer.Seconds(), "tri");
+
+        timer.Restart();
+        buffer.TestOccludees(occludees.data(), visible.data(), occludees.size());
+        Report("TestOccludees 100k boxes", static_cast<double>(occludees.size()), timer.Seconds(), "box");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Owns the streams a ParticleStreams points into
+    struct ParticleSet
+    {
+        std::vector<float> position[3], velocity[3], acceleration[3], previous[3];
+
+        explicit ParticleSet(const size_t count)
+        {
+            for (int axis = 0; axis < 3; axis++)
+            {
+                position[axis].resize(count);
+                velocity[axis].resize(count);
+                acceleration[axis].resize(count);
+                previous[axis].resize(count);
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    position[axis][i] = RandomFloat(-10.0f, 10.0f);
+                    velocity[axis][i] = RandomFloat(-5.0f, 5.0f);
+                    acceleration[axis][i] = RandomFloat(-1.0f, 1.0f);
+                    previous[axis][i] = position[axis][i] - velocity[axis][i] * 0.01f;
+                }
+            }
+        }
+
+        ParticleStreams Streams()
+        {
+            ParticleStreams toReturn = ParticleStreams();
+            toReturn.positionX = position[0].data(), toReturn.positionY = position[1].data(), toReturn.positionZ = position[2].data();
+            toReturn.velocityX = velocity[0].data(), toReturn.velocityY = velocity[1].data(), toReturn.velocityZ = velocity[2].data();
+            toReturn.accelerationX = acceleration[0].data(), toReturn.accelerationY = acceleration[1].data(), toReturn.accelerationZ = acceleration[2].data();
+            toReturn.previousX = previous[0].data(), toReturn.previousY = previous[1].data(), toReturn.previousZ = previous[2].data();
+            toReturn.count = position[0].size();
+            return toReturn;
+        }
+    };
+
+    // Scalar version of every scheme, written from the documented equations rather than the SIMD code
+    static void ReferenceStep(ParticleSet& set, const int scheme, const float dt, const ParticleSettings& settings)
+    {
+        float keep = fmaxf(1.0f - settings.damping * dt, 0.0f);
+        const float gravity[3] = { settings.gravity.x, settings.gravity.y, settings.gravity.z };
+        const float normal[3] = { settings.plane.x, settings.plane.y, settings.plane.z };
+
+        for (size_t i = 0; i < set.position[0].size(); i++)
+        {
+            float p[3], v[3];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                float a = set.acceleration[axis][i] + gravity[axis];
+                p[axis] = set.position[axis][i];
+                v[axis] = set.velocity[axis][i];
+
+                if (scheme == 2)
+                {
+                    v[axis] = (p[axis] - set.previous[axis][i]) * keep + a * dt * dt;
+                    p[axis] += v[axis];
+                    continue;
+                }
+
+                p[axis] += (scheme == 0) ? v[axis] * dt : 0.0f;
+                v[axis] = (v[axis] + a * dt) * keep;
+                p[axis] += (scheme == 1) ? v[axis] * dt : 0.0f;
+            }
+
+            float depth = normal[0] * p[0] + normal[1] * p[1] + normal[2] * p[2] + settings.plane.w;
+            float approach = normal[0] * v[0] + normal[1] * v[1] + normal[2] * v[2];
+
+            for (int axis = 0; axis < 3 && settings.clampToPlane && depth < 0.0f; axis++)
+            {
+                p[axis] -= normal[axis] * depth;
+                v[axis] -= (approach < 0.0f) ? normal[axis] * approach * (1.0f + settings.restitution) : 0.0f;
+            }
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                set.previous[axis][i] = (scheme == 2) ? p[axis] - v[axis] : set.previous[axis][i];
+                set.position[axis][i] = p[axis];
+                set.velocity[axis][i] = (scheme == 2) ? v[axis] / dt : v[axis];
+            }
+        }
+    }
+
+    static float LargestDifference(const ParticleSet& set1, const ParticleSet& set2)
+    {
+        float toReturn = 0.0f;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (size_t i = 0; i < set1.position[axis].size(); i++)
+            {
+                toReturn = fmaxf(toReturn, fabsf(set1.position[axis][i] - set2.position[axis][i]) / (1.0f + fabsf(set2.position[axis][i])));
+                toReturn = fmaxf(toReturn, fabsf(set1.velocity[axis][i] - set2.velocity[axis][i]) / (1.0f + fabsf(set2.velocity[axis][i])));
+            }
+        }
+
+        return toReturn;
+    }
+
+    void TestParticleIntegrator()
+    {
+        printf("ParticleIntegrator\n");
+        printf("  kernel %s\n", HasAVX2() ? "AVX2 & FMA" : "SSE");
+
+        const char* names[3] = { "Euler", "SemiImplicitEuler", "Verlet" };
+        ParticleSettings settings = ParticleSettings();
+        settings.gravity = Vector3(0.0f, -9.81f, 0.0f);
+        settings.plane = Vector4(0.6f, 0.8f, 0.0f, 2.0f);
+        settings.damping = 0.3f;
+        settings.restitution = 0.5f;
+        settings.clampToPlane = true;
+
+        // 1003 particles leave a partial group of 3 at the end
+        for (int scheme = 0; scheme < 3; scheme++)
+        {
+            ParticleSet simd = ParticleSet(1003);
+            ParticleSet reference = simd;
+            ParticleStreams streams = simd.Streams();
+
+            for (int step = 0; step < 50; step++)
+            {
+                (scheme == 0) ? ParticleIntegrator::Euler(streams, 1.0f / 60.0f, settings) :
+                (scheme == 1) ? ParticleIntegrator::SemiImplicitEuler(streams, 1.0f / 60.0f, settings) :
+                                ParticleIntegrator::Verlet(streams, 1.0f / 60.0f, settings);
+                ReferenceStep(reference, scheme, 1.0f / 60.0f, settings);
+            }
+
+            float difference = LargestDifference(simd, reference);
+            Check(difference < 1e-4f, "%s differs from the scalar reference by %g", names[scheme], difference);
+
+            float lowest = 0.0f;
+
+            for (size_t i = 0; i < simd.position[0].size(); i++)
+            {
+                lowest = fminf(lowest, 0.6f * simd.position[0][i] + 0.8f * simd.position[1][i] + 2.0f);
+            }
+
+            Check(lowest > -1e-4f, "%s left a particle %g behind the plane", names[scheme], lowest);
+        }
+
+        // Every count up to two of the widest groups, so each tail length & a group followed by a tail are stepped once against the reference
+        int tailMisses = 0;
+
+        for (size_t count = 1; count <= 17; count++)
+        {
+            for (int scheme = 0; scheme < 3; scheme++)
+            {
+                ParticleSet simd = ParticleSet(count);
+                ParticleSet reference = simd;
+                ParticleStreams streams = simd.Streams();
+                (scheme == 0) ? ParticleIntegrator::Euler(streams, 1.0f / 60.0f, settings) :
+                (scheme == 1) ? ParticleIntegrator::SemiImplicitEuler(streams, 1.0f / 60.0f, settings) :
+                                ParticleIntegrator::Verlet(streams, 1.0f / 60.0f, settings);
+                ReferenceStep(reference, scheme, 1.0f / 60.0f, settings);
+                tailMisses += (LargestDifference(simd, reference) < 1e-5f) ? 0 : 1;
+            }
+        }
+
+        Check(tailMisses == 0, "%d of 51 short counts differ from the scalar reference", tailMisses);
+
+        // Position Verlet is exact under constant acceleration once previous is seeded from the same parabola, float round off aside
+        ParticleSettings freeFall = ParticleSettings();
+        freeFall.gravity = Vector3(0.0f, -9.81f, 0.0f);
+        float x0 = 1.0f, y0 = 0.0f, vx0 = 3.0f, vy0 = 12.0f, dt = 1.0f / 120.0f;
+        float px = x0, py = y0, oldX = x0 - vx0 * dt, oldY = y0 - vy0 * dt - 0.5f * 9.81f * dt * dt, pz = 0.0f, oldZ = 0.0f;
+        ParticleStreams single = ParticleStreams();
+        single.positionX = &px, single.positionY = &py, single.positionZ = &pz;
+        single.previousX = &oldX, single.previousY = &oldY, single.previousZ = &oldZ;
+        single.count = 1;
+
+        for (int step = 0; step < 120; step++)
+        {
+            ParticleIntegrator::Verlet(single, dt, freeFall);
+        }
+
+        float t = 120 * dt;
+        Check(fabsf(px - (x0 + vx0 * t)) < 1e-3f && fabsf(py - (y0 + vy0 * t - 0.5f * 9.81f * t * t)) < 1e-3f,
+              "Verlet free fall ended at (%g, %g), expected (%g, %g)", px, py, x0 + vx0 * t, y0 + vy0 * t - 0.5f * 9.81f * t * t);
+
+        // Throughput over streams far larger than the caches
+        ParticleSet large = ParticleSet(4000000);
+        ParticleStreams streams = large.Streams();
+
+        for (int scheme = 0; scheme < 3; scheme++)
+        {
+            Timer timer = Timer();
+
+            for (int step = 0; step < 10; step++)
+            {
+                (scheme == 0) ? ParticleIntegrator::Euler(streams, 1.0f / 60.0f, settings) :
+                (scheme == 1) ? ParticleIntegrator::SemiImplicitEuler(streams, 1.0f / 60.0f, settings) :
+                                ParticleIntegrator::Verlet(streams, 1.0f / 60.0f, settings);
+            }
+
+            Report(names[scheme], 4000000.0 * 10.0, timer.Seconds(), "particle");
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static Quaternion MakeQuaternion(const float w, const float x, const float y, const float z)
+    {
+        Quaternion toReturn = Quaternion();
+        toReturn.elementsSIMD = _mm_setr_ps(w, x, y, z);
+        return toReturn;
+    }
+
+    // Random direction in 4D with a length between 0.5 & 2, so Rotate has to normalize
+    static Quaternion RandomQuaternion()
+    {
+        Quaternion toReturn = MakeQuaternion(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+        float scale = RandomFloat(0.5f, 2.0f) / Quaternion::Magnitude(toReturn);
+        return MakeQuaternion(toReturn.w * scale, toReturn.x * scale, toReturn.y * scale, toReturn.z * scale);
+    }
+
+    // q * v * q^-1 in double for each basis vector, giving the columns of the rotation without the closed form Rotate uses
+    static void ReferenceRotation(const Quaternion& quat, double out[3][3])
+    {
+        double norm = sqrt(static_cast<double>(quat.w) * quat.w + static_cast<double>(quat.x) * quat.x +
+                           static_cast<double>(quat.y) * quat.y + static_cast<double>(quat.z) * quat.z);
+        double w = quat.w / norm, x = quat.x / norm, y = quat.y / norm, z = quat.z / norm;
+
+        for (int j = 0; j < 3; j++)
+        {
+            double v[3] = { (j == 0) ? 1.0 : 0.0, (j == 1) ? 1.0 : 0.0, (j == 2) ? 1.0 : 0.0 };
+
+            // t = q * (0, v)
+            double tw = -x * v[0] - y * v[1] - z * v[2];
+            double tx = w * v[0] + y * v[2] - z * v[1];
+            double ty = w * v[1] + z * v[0] - x * v[2];
+            double tz = w * v[2] + x * v[1] - y * v[0];
+
+            // t * conjugate(q), keeping the vector part
+            out[0][j] = -tw * x + tx * w - ty * z + tz * y;
+            out[1][j] = -tw * y + ty * w - tz * x + tx * z;
+            out[2][j] = -tw * z + tz * w - tx * y + ty * x;
+        }
+    }
+
+    static double MatrixError(const Matrix4& a, const Matrix4& b)
+    {
+        double toReturn = 0.0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                double error = fabs(static_cast<double>(a.matrix[i][j]) - b.matrix[i][j]);
+                toReturn = (error > toReturn) ? error : toReturn;
+            }
+        }
+
+        return toReturn;
+    }
+
+    // q & -q are the same rotation, so the error is taken against whichever sign is closer
+    static double QuaternionError(const Quaternion& a, const Quaternion& b)
+    {
+        double same = 0.0, flipped = 0.0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            double sameError = fabs(static_cast<double>(a.elements[i]) - b.elements[i]);
+            double flippedError = fabs(static_cast<double>(a.elements[i]) + b.elements[i]);
+            same = (sameError > same) ? sameError : same;
+            flipped = (flippedError > flipped) ? flippedError : flipped;
+        }
+
+        return (same < flipped) ? same : flipped;
+    }
+
+    void TestQuaternion()
+    {
+        printf("Quaternion\n");
+
+        // Every third rotation is close to a half turn, where w vanishes & FromMatrix has to pick a different pivot
+        const size_t count = 1003;
+        std::vector<Quaternion> quats = std::vector<Quaternion>(count);
+        std::vector<Matrix4> mats = std::vector<Matrix4>(count);
+        double rotateError = 0.0, orthoError = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            quats[i] = RandomQuaternion();
+
+            if (i % 3 == 0)
+            {
+                quats[i].elementsSIMD = _mm_setr_ps(RandomFloat(-1e-3f, 1e-3f), quats[i].x, quats[i].y, quats[i].z);
+            }
+
+            mats[i] = Matrix4::Rotate(quats[i]);
+            double reference[3][3];
+            ReferenceRotation(quats[i], reference);
+
+            for (int r = 0; r < 3; r++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    double error = fabs(mats[i].matrix[r][c] - reference[r][c]);
+                    rotateError = (error > rotateError) ? error : rotateError;
+
+                    // Rows of a rotation are orthonormal
+                    double dot = 0.0;
+
+                    for (int k = 0; k < 3; k++)
+                    {
+                        dot += static_cast<double>(mats[i].matrix[r][k]) * mats[i].matrix[c][k];
+                    }
+
+                    error = fabs(dot - ((r == c) ? 1.0 : 0.0));
+                    orthoError = (error > orthoError) ? error : orthoError;
+                }
+
+                rotateError = (fabsf(mats[i].matrix[r][3]) + fabsf(mats[i].matrix[3][r]) > rotateError) ? fabsf(mats[i].matrix[r][3]) + fabsf(mats[i].matrix[3][r]) : rotateError;
+            }
+        }
+
+        Check(rotateError < 2e-6, "Rotate(Quaternion) differs from q * v * q^-1 by %g", rotateError);
+        Check(orthoError < 2e-6, "Rotate(Quaternion) is not orthonormal, error %g", orthoError);
+
+        // FromMatrix has to recover the normalized quaternion up to sign, & the batch has to agree with the single matrix call
+        std::vector<Quaternion> recovered = std::vector<Quaternion>(count);
+        Quaternion::FromMatrix(mats.data(), recovered.data(), count);
+        double fromMatrixError = 0.0, fromMatrixBatch = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double error = QuaternionError(recovered[i], Quaternion::Normalized(quats[i]));
+            fromMatrixError = (error > fromMatrixError) ? error : fromMatrixError;
+            error = QuaternionError(recovered[i], Quaternion::FromMatrix(mats[i]));
+            fromMatrixBatch = (error > fromMatrixBatch) ? error : fromMatrixBatch;
+        }
+
+        Check(fromMatrixError < 5e-6, "FromMatrix(Rotate(q)) differs from q by %g", fromMatrixError);
+        Check(fromMatrixBatch < 1e-6, "batch FromMatrix differs from single by %g", fromMatrixBatch);
+
+        // FromEuler has to match the Euler Rotate, invert through ToEuler away from gimbal lock & agree with its batch
+        std::vector<Vector3> eulers = std::vector<Vector3>(count);
+        std::vector<Quaternion> fromEulers = std::vector<Quaternion>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            eulers[i] = Vector3(RandomFloat(-3.1f, 3.1f), RandomFloat(-1.5f, 1.5f), RandomFloat(-3.1f, 3.1f));
+        }
+
+        Quaternion::FromEuler(eulers.data(), fromEulers.data(), count);
+        double fromEulerError = 0.0, toEulerError = 0.0, fromEulerBatch = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Quaternion single = Quaternion::FromEuler(eulers[i]);
+            double error = MatrixError(Matrix4::Rotate(single), Matrix4::Rotate(eulers[i].x, eulers[i].y, eulers[i].z));
+            fromEulerError = (error > fromEulerError) ? error : fromEulerError;
+
+            Vector3 angles = Quaternion::ToEuler(single);
+            error = fabs(static_cast<double>(angles.x) - eulers[i].x) + fabs(static_cast<double>(angles.y) - eulers[i].y) + fabs(static_cast<double>(angles.z) - eulers[i].z);
+            toEulerError = (error > toEulerError) ? error : toEulerError;
+
+            error = QuaternionError(single, fromEulers[i]);
+            fromEulerBatch = (error > fromEulerBatch) ? error : fromEulerBatch;
+        }
+
+        Check(fromEulerError < 2e-6, "Rotate(FromEuler(e)) differs from Rotate(e.x, e.y, e.z) by %g", fromEulerError);
+        Check(toEulerError < 1e-4, "ToEuler(FromEuler(e)) differs from e by %g", toEulerError);
+        Check(fromEulerBatch < 1e-6, "batch FromEuler differs from single by %g", fromEulerBatch);
+        printf("  worst error: Rotate %.2g, FromMatrix %.2g, FromEuler %.2g, ToEuler %.2g\n", rotateError, fromMatrixError, fromEulerError, toEulerError);
+
+        // Integrate against the exponential map delta * q, delta turning by |omega| dt about omega.  Every tenth body is still, & one float
+        // past count in each stream has to survive the tail group
+        const float dt = 1.0f / 60.0f;
+        std::vector<float> w = std::vector<float>(count + 1, 7.0f), x = std::vector<float>(count + 1, 7.0f);
+        std::vector<float> y = std::vector<float>(count + 1, 7.0f), z = std::vector<float>(count + 1, 7.0f);
+        std::vector<float> angularX = std::vector<float>(count), angularY = std::vector<float>(count), angularZ = std::vector<float>(count);
+        std::vector<Matrix4> fused = std::vector<Matrix4>(count + 1, Matrix4::Identity);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Quaternion unit = Quaternion::Normalized(quats[i]);
+            w[i] = unit.w;
+            x[i] = unit.x;
+            y[i] = unit.y;
+            z[i] = unit.z;
+            Vector3 omega = (i % 10 == 0) ? Vector3(0.0f, 0.0f, 0.0f) : RandomVector3(-20.0f, 20.0f);
+            angularX[i] = omega.x;
+            angularY[i] = omega.y;
+            angularZ[i] = omega.z;
+        }
+
+        std::vector<float> startW = w, startX = x, startY = y, startZ = z;
+        Quaternion::Integrate(w.data(), x.data(), y.data(), z.data(), angularX.data(), angularY.data(), angularZ.data(), count, dt, fused.data());
+        double integrateError = 0.0, fusedError = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Vector3 omega = Vector3(angularX[i], angularY[i], angularZ[i]);
+            float speed = sqrtf(omega.x * omega.x + omega.y * omega.y + omega.z * omega.z);
+            Quaternion delta = (speed > 0.0f) ? Quaternion(omega, speed * dt) : MakeQuaternion(1.0f, 0.0f, 0.0f, 0.0f);
+            Quaternion expected = Quaternion::Normalized(delta * MakeQuaternion(startW[i], startX[i], startY[i], startZ[i]));
+            Quaternion result = MakeQuaternion(w[i], x[i], y[i], z[i]);
+            double error = QuaternionError(result, expected);
+            integrateError = (error > integrateError) ? error : integrateError;
+
+            // The matrices come out of the same pass & have to be the rotation of the stored quaternion
+            error = MatrixError(fused[i], Matrix4::Rotate(result));
+            fusedError = (error > fusedError) ? error : fusedError;
+        }
+
+        bool untouched = w[count] == 7.0f && x[count] == 7.0f && y[count] == 7.0f && z[count] == 7.0f && MatrixError(fused[count], Matrix4::Identity) == 0.0;
+        Check(integrateError < 2e-6, "Integrate differs from delta * q by %g", integrateError);
+        Check(fusedError < 2e-6, "Integrate matrices differ from Rotate of the integrated quaternion by %g", fusedError);
+        Check(untouched, "Integrate wrote past count");
+
+        // Steps compose, so 600 steps at a constant rate have to land on the single rotation by the total angle
+        float stepW = 1.0f, stepX = 0.0f, stepY = 0.0f, stepZ = 0.0f;
+        const float spinX = 0.3f, spinY = -1.1f, spinZ = 0.7f;
+
+        for (int step = 0; step < 600; step++)
+        {
+            Quaternion::Integrate(&stepW, &stepX, &stepY, &stepZ, &spinX, &spinY, &spinZ, 1, dt, nullptr);
+        }
+
+        float spin = sqrtf(spinX * spinX + spinY * spinY + spinZ * spinZ);
+        double driftError = QuaternionError(MakeQuaternion(stepW, stepX, stepY, stepZ), Quaternion(Vector3(spinX, spinY, spinZ), spin * dt * 600.0f));
+        Check(driftError < 1e-4, "600 Integrate steps drift %g from the total rotation", driftError);
+        printf("  worst Integrate error %.2g, matrices %.2g, 600 step drift %.2g\n", integrateError, fusedError, driftError);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Mean of each axis & the worst distance of a length from 1
+    static void Moments(const std::vector<Vector3>& vecs, double mean[3], double& lengthError)
+    {
+        mean[0] = mean[1] = mean[2] = 0.0;
+        lengthError = 0.0;
+
+        for (size_t i = 0; i < vecs.size(); i++)
+        {
+            mean[0] += vecs[i].x;
+            mean[1] += vecs[i].y;
+            mean[2] += vecs[i].z;
+            double length = sqrt(static_cast<double>(vecs[i].x) * vecs[i].x + static_cast<double>(vecs[i].y) * vecs[i].y + static_cast<double>(vecs[i].z) * vecs[i].z);
+            lengthError = (fabs(length - 1.0) > lengthError) ? fabs(length - 1.0) : lengthError;
+        }
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            mean[axis] /= static_cast<double>(vecs.size());
+        }
+    }
+
+    void TestRandom()
+    {
+        printf("Random\n");
+
+        // Every statistic below is checked to 5 standard errors of a 1M sample, so a correct generator fails about once in 3 million runs
+        const size_t count = 1000003;
+        const double samples = static_cast<double>(count);
+
+        // The same seed has to give the same stream, a different seed a different one, & a short fill the prefix of a long one
+        std::vector<float> first = std::vector<float>(count), second = std::vector<float>(count), prefix = std::vector<float>(777);
+        Random generator1 = Random(42), generator2 = Random(42), generator3 = Random(43), generator4 = Random(42);
+        generator1.Fill(first.data(), count);
+        generator2.Fill(second.data(), count);
+        generator4.Fill(prefix.data(), prefix.size());
+        bool repeatable = memcmp(first.data(), second.data(), count * sizeof(float)) == 0 && memcmp(first.data(), prefix.data(), prefix.size() * sizeof(float)) == 0;
+
+        generator1.Fill(first.data(), count);
+        generator2.Fill(second.data(), count);
+        repeatable = repeatable && memcmp(first.data(), second.data(), count * sizeof(float)) == 0;
+
+        std::vector<float> other = std::vector<float>(count);
+        generator3.Fill(other.data(), count);
+        size_t same = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            same += (other[i] == first[i]) ? 1 : 0;
+        }
+
+        Check(repeatable, "the same seed gave different streams");
+        Check(same < 100, "seeds 42 & 43 agree in %zu of %zu floats", same, count);
+
+        // Fill stays in [min, max) with the mean in the middle
+        generator1.Fill(first.data(), count, -3.0f, 5.0f);
+        double mean = 0.0;
+        bool inRange = true;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            inRange = inRange && first[i] >= -3.0f && first[i] < 5.0f;
+            mean += first[i];
+        }
+
+        mean /= samples;
+        Check(inRange, "Fill left [-3, 5)");
+        Check(fabs(mean - 1.0) < 5.0 * 8.0 / sqrt(12.0 * samples), "Fill mean %g, expected 1", mean);
+
+        // OnSphere is unit length with each axis averaging 0 at variance 1/3
+        std::vector<Vector3> vecs = std::vector<Vector3>(count);
+        generator1.OnSphere(vecs.data(), count);
+        double means[3], lengthError;
+        Moments(vecs, means, lengthError);
+        double bound = 5.0 * sqrt(1.0 / (3.0 * samples));
+        Check(lengthError < 1e-5, "OnSphere vectors are up to %g from unit length", lengthError);
+        Check(fabs(means[0]) < bound && fabs(means[1]) < bound && fabs(means[2]) < bound, "OnSphere mean (%g, %g, %g) is not 0", means[0], means[1], means[2]);
+
+        // Uniform in the ball makes (r / R)^3 uniform, so each tenth of it holds a tenth of the points
+        BoundingSphere sphere = BoundingSphere(Vector3(1.0f, -2.0f, 3.0f), 2.5f);
+        generator1.InSphere(sphere, vecs.data(), count);
+        double bins[10] = { 0.0 };
+        int outside = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double dx = vecs[i].x - sphere.center.x, dy = vecs[i].y - sphere.center.y, dz = vecs[i].z - sphere.center.z;
+            double volume = pow(sqrt(dx * dx + dy * dy + dz * dz) / sphere.radius, 3.0);
+            outside += (volume <= 1.0 + 1e-5) ? 0 : 1;
+            bins[(volume < 1.0) ? static_cast<int>(volume * 10.0) : 9] += 1.0;
+        }
+
+        double worstBin = 0.0;
+
+        for (int bin = 0; bin < 10; bin++)
+        {
+            double deviation = fabs(bins[bin] / samples - 0.1) / sqrt(0.09 / samples);
+            worstBin = (deviation > worstBin) ? deviation : worstBin;
+        }
+
+        Check(outside == 0, "%d InSphere points outside the sphere", outside);
+        Check(worstBin < 5.0, "InSphere radius distribution is %g standard errors off r^3", worstBin);
+
+        // A cosine weighted hemisphere has E[cos] = 2/3 with variance 1/2 - 4/9, & no drift across the tangent plane
+        Vector3 normal = Vector3::Normalized(Vector3(0.3f, -0.8f, 0.5f));
+        generator1.CosineHemisphere(normal, vecs.data(), count);
+        Moments(vecs, means, lengthError);
+        double cosine = means[0] * normal.x + means[1] * normal.y + means[2] * normal.z;
+        double tangential = sqrt(pow(means[0] - cosine * normal.x, 2.0) + pow(means[1] - cosine * normal.y, 2.0) + pow(means[2] - cosine * normal.z, 2.0));
+        int below = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            below += (vecs[i].x * normal.x + vecs[i].y * normal.y + vecs[i].z * normal.z >= 0.0f) ? 0 : 1;
+        }
+
+        Check(lengthError < 1e-5 && below == 0, "CosineHemisphere gave %d vectors below the surface & lengths up to %g from 1", below, lengthError);
+        Check(fabs(cosine - 2.0 / 3.0) < 5.0 * sqrt((0.5 - 4.0 / 9.0) / samples), "CosineHemisphere mean cosine %g, expected 2/3", cosine);
+        Check(tangential < 5.0 * sqrt(2.0 * 0.25 / samples), "CosineHemisphere mean leans %g across the tangent plane", tangential);
+
+        // Uniform rotations send any axis uniformly over the sphere
+        std::vector<Quaternion> rotations = std::vector<Quaternion>(count);
+        generator1.Rotations(rotations.data(), count);
+        double rotatedMean[3] = { 0.0, 0.0, 0.0 }, unitError = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const Quaternion& q = rotations[i];
+            double error = fabs(static_cast<double>(q.w) * q.w + static_cast<double>(q.x) * q.x + static_cast<double>(q.y) * q.y + static_cast<double>(q.z) * q.z - 1.0);
+            unitError = (error > unitError) ? error : unitError;
+
+            // First column of the rotation matrix, where the x axis goes
+            rotatedMean[0] += 1.0 - 2.0 * (q.y * q.y + q.z * q.z);
+            rotatedMean[1] += 2.0 * (q.x * q.y + q.w * q.z);
+            rotatedMean[2] += 2.0 * (q.x * q.z - q.w * q.y);
+        }
+
+        Check(unitError < 1e-5, "Rotations are up to %g from unit quaternions", unitError);
+        Check(fabs(rotatedMean[0]) / samples < bound && fabs(rotatedMean[1]) / samples < bound && fabs(rotatedMean[2]) / samples < bound,
+              "Rotations send x to a mean of (%g, %g, %g)", rotatedMean[0] / samples, rotatedMean[1] / samples, rotatedMean[2] / samples);
+
+        Timer timer = Timer();
+        generator1.Fill(first.data(), count);
+        Report("Fill 1M floats", samples, timer.Seconds(), "float");
+
+        timer.Restart();
+        generator1.OnSphere(vecs.data(), count);
+        Report("OnSphere 1M vectors", samples, timer.Seconds(), "vec");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <algorithm>
+#include <random>
+#include <stdlib.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Codes need every bit random, which RandomFloat can't give
+    static std::mt19937_64 codeGenerator = std::mt19937_64(271828);
+
+    // One bit at a time, x in the lowest bit of each triple
+    static unsigned long long ReferenceMorton(const unsigned int x, const unsigned int y, const unsigned int z, const int bits)
+    {
+        unsigned long long toReturn = 0;
+
+        for (int bit = 0; bit < bits; bit++)
+        {
+            toReturn |= static_cast<unsigned long long>((x >> bit) & 1) << (bit * 3);
+            toReturn |= static_cast<unsigned long long>((y >> bit) & 1) << (bit * 3 + 1);
+            toReturn |= static_cast<unsigned long long>((z >> bit) & 1) << (bit * 3 + 2);
+        }
+
+        return toReturn;
+    }
+
+    // Walks every cell of the side^3 cube at the origin, which the first side^3 codes of a Hilbert curve fill.
+    // Each code has to appear once & consecutive codes have to be face neighbours
+    template <typename Code>
+    static void CheckHilbertCube(const char* name, Code (*hilbert)(const unsigned int, const unsigned int, const unsigned int), const unsigned int side)
+    {
+        size_t cells = static_cast<size_t>(side) * side * side;
+        std::vector<unsigned int> cellOf = std::vector<unsigned int>(cells, 0xFFFFFFFF);
+        int outside = 0, repeated = 0, jumps = 0;
+
+        for (unsigned int z = 0; z < side; z++)
+        {
+            for (unsigned int y = 0; y < side; y++)
+            {
+                for (unsigned int x = 0; x < side; x++)
+                {
+                    Code code = hilbert(x, y, z);
+
+                    if (code >= cells)
+                    {
+                        outside++;
+                        continue;
+                    }
+
+                    repeated += (cellOf[static_cast<size_t>(code)] != 0xFFFFFFFF) ? 1 : 0;
+                    cellOf[static_cast<size_t>(code)] = (z * side + y) * side + x;
+                }
+            }
+        }
+
+        for (size_t code = 1; code < cells && outside == 0; code++)
+        {
+            int dx = static_cast<int>(cellOf[code] % side) - static_cast<int>(cellOf[code - 1] % side);
+            int dy = static_cast<int>(cellOf[code] / side % side) - static_cast<int>(cellOf[code - 1] / side % side);
+            int dz = static_cast<int>(cellOf[code] / side / side) - static_cast<int>(cellOf[code - 1] / side / side);
+            jumps += (abs(dx) + abs(dy) + abs(dz) == 1) ? 0 : 1;
+        }
+
+        Check(outside == 0 && repeated == 0, "%s codes of the %u^3 cube at the origin leave 0..%zu, %d outside & %d repeated", name, side, cells - 1, outside, repeated);
+        Check(jumps == 0, "%s has %d steps between non adjacent cells in the %u^3 cube", name, jumps, side);
+    }
+
+    // Sorted ascending, order a permutation pointing back at the original codes, & equal codes kept in input order
+    template <typename Key>
+    static void CheckSort(const char* name, const std::vector<Key>& original)
+    {
+        std::vector<Key> codes = original;
+        std::vector<unsigned int> order = std::vector<unsigned int>(original.size());
+        SpaceFillingCurve::Sort(codes.data(), order.data(), codes.size());
+
+        std::vector<Key> expected = original;
+        std::sort(expected.begin(), expected.end());
+        std::vector<bool> seen = std::vector<bool>(original.size(), false);
+        int wrong = 0, unstable = 0;
+
+        for (size_t i = 0; i < codes.size(); i++)
+        {
+            bool valid = order[i] < original.size() && !seen[order[i]];
+            wrong += (codes[i] == expected[i] && valid && original[order[i]] == codes[i]) ? 0 : 1;
+            seen[valid ? order[i] : 0] = true;
+            unstable += (i > 0 && codes[i] == codes[i - 1] && order[i] < order[i - 1]) ? 1 : 0;
+        }
+
+        // Without order the keys still have to come out sorted
+        std::vector<Key> keysOnly = original;
+        SpaceFillingCurve::Sort(keysOnly.data(), nullptr, keysOnly.size());
+
+        Check(wrong == 0 && keysOnly == expected, "%s Sort of %zu codes has %d misplaced entries", name, original.size(), wrong);
+        Check(unstable == 0, "%s Sort of %zu codes reordered %d runs of equal codes", name, original.size(), unstable);
+    }
+
+    void TestSpaceFillingCurve()
+    {
+        printf("SpaceFillingCurve\n");
+        printf("  scalar encoders %s\n", SpaceFillingCurve::HasBMI2() ? "BMI2" : "bit spreading");
+
+        // Morton against a bit by bit interleave, with bits past the 10 or 21 used set to make sure they are dropped
+        int mortonWrong = 0;
+
+        for (int i = 0; i < 100000; i++)
+        {
+            unsigned int x = static_cast<unsigned int>(codeGenerator()), y = static_cast<unsigned int>(codeGenerator()), z = static_cast<unsigned int>(codeGenerator());
+            mortonWrong += (SpaceFillingCurve::Morton30(x & 0x3FF, y & 0x3FF, z & 0x3FF) == ReferenceMorton(x, y, z, 10)) ? 0 : 1;
+            mortonWrong += (SpaceFillingCurve::Morton63(x, y, z) == ReferenceMorton(x, y, z, 21)) ? 0 : 1;
+        }
+
+        Check(mortonWrong == 0, "%d Morton codes differ from a bit by bit interleave", mortonWrong);
+        Check(SpaceFillingCurve::Morton30(1023, 1023, 1023) == 0x3FFFFFFF && SpaceFillingCurve::Morton63(0x1FFFFF, 0x1FFFFF, 0x1FFFFF) == 0x7FFFFFFFFFFFFFFFull,
+              "Morton codes of the far corner don't fill every bit");
+
+        CheckHilbertCube<unsigned int>("Hilbert30", SpaceFillingCurve::Hilbert30, 64);
+        CheckHilbertCube<unsigned long long>("Hilbert63", SpaceFillingCurve::Hilbert63, 64);
+        Check(SpaceFillingCurve::Hilbert30(0, 0, 0) == 0 && SpaceFillingCurve::Hilbert63(0, 0, 0) == 0, "Hilbert curves don't start at the origin");
+
+        // The batch encoders against the scalar codes of the cells each point sits in, with a tail group of 3
+        const size_t count = 10003;
+        std::vector<Vector3> points = std::vector<Vector3>(count);
+        std::vector<unsigned int> cells30 = std::vector<unsigned int>(count * 3);
+        std::vector<unsigned int> cells63 = std::vector<unsigned int>(count * 3);
+
+        for (size_t i = 0; i < count * 3; i++)
+        {
+            cells30[i] = static_cast<unsigned int>(codeGenerator() & 0x3FF);
+            cells63[i] = static_cast<unsigned int>(codeGenerator() & 0x1FFFFF);
+        }
+
+        // Cell centres of a 1024 unit cube are exact in float, & scaling the 63 bit cells down by 2048 keeps them exact too
+        AABB bounds = AABB(Vector3(0.0f, 0.0f, 0.0f), Vector3(1024.0f, 1024.0f, 1024.0f));
+        std::vector<unsigned int> codes30 = std::vector<unsigned int>(count);
+        std::vector<unsigned long long> codes63 = std::vector<unsigned long long>(count);
+        const CurveType curves[2] = { CurveType::Morton, CurveType::Hilbert };
+
+        for (int c = 0; c < 2; c++)
+        {
+            bool hilbert = curves[c] == CurveType::Hilbert;
+            int wrong30 = 0, wrong63 = 0;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                points[i] = Vector3(cells30[i * 3] + 0.5f, cells30[i * 3 + 1] + 0.5f, cells30[i * 3 + 2] + 0.5f);
+            }
+
+            SpaceFillingCurve::Encode30(points.data(), count, bounds, curves[c], codes30.data());
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const unsigned int* cell = &cells30[i * 3];
+                wrong30 += (codes30[i] == (hilbert ? SpaceFillingCurve::Hilbert30(cell[0], cell[1], cell[2]) : SpaceFillingCurve::Morton30(cell[0], cell[1], cell[2]))) ? 0 : 1;
+                points[i] = Vector3((cells63[i * 3] + 0.5f) / 2048.0f, (cells63[i * 3 + 1] + 0.5f) / 2048.0f, (cells63[i * 3 + 2] + 0.5f) / 2048.0f);
+            }
+
+            SpaceFillingCurve::Encode63(points.data(), count, bounds, curves[c], codes63.data());
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const unsigned int* cell = &cells63[i * 3];
+                wrong63 += (codes63[i] == (hilbert ? SpaceFillingCurve::Hilbert63(cell[0], cell[1], cell[2]) : SpaceFillingCurve::Morton63(cell[0], cell[1], cell[2]))) ? 0 : 1;
+            }
+
+            Check(wrong30 == 0 && wrong63 == 0, "%s batch encoders differ from the scalar codes in %d 30 bit & %d 63 bit lanes", hilbert ? "Hilbert" : "Morton", wrong30, wrong63);
+        }
+
+        // Full width codes, heavy duplicates for stability, & 63 bit codes whose high bytes are all zero so those passes are skipped
+        std::vector<unsigned int> wide32 = std::vector<unsigned int>(100003);
+        std::vector<unsigned int> repeats32 = std::vector<unsigned int>(100003);
+        std::vector<unsigned long long> wide64 = std::vector<unsigned long long>(100003);
+        std::vector<unsigned long long> narrow64 = std::vector<unsigned long long>(100003);
+
+        for (size_t i = 0; i < wide32.size(); i++)
+        {
+            wide32[i] = static_cast<unsigned int>(codeGenerator());
+            repeats32[i] = static_cast<unsigned int>(codeGenerator() % 1000) << 20;
+            wide64[i] = codeGenerator() >> 1;
+            narrow64[i] = codeGenerator() & 0x3FFFFFFF;
+        }
+
+        CheckSort("32 bit", wide32);
+        CheckSort("repeated 32 bit", repeats32);
+        CheckSort("63 bit", wide64);
+        CheckSort("30 bit in 64", narrow64);
+        CheckSort("single", std::vector<unsigned int>(1, 7));
+        CheckSort("empty", std::vector<unsigned long long>());
+
+        // SortPoints has to move each point to where order says it came from, in non decreasing curve order
+        std::vector<Vector3> cloud = std::vector<Vector3>(20001);
+
+        for (size_t i = 0; i < cloud.size(); i++)
+        {
+            cloud[i] = RandomVector3(-10.0f, 10.0f);
+        }
+
+        std::vector<Vector3> sorted = cloud;
+        std::vector<unsigned int> order = std::vector<unsigned int>(cloud.size());
+        SpaceFillingCurve::SortPoints(sorted.data(), sorted.size(), CurveType::Hilbert, order.data());
+        std::vector<unsigned long long> sortedCodes = std::vector<unsigned long long>(cloud.size());
+        SpaceFillingCurve::Encode63(sorted.data(), sorted.size(), AABB::FromPoints(cloud.data(), cloud.size()), CurveType::Hilbert, sortedCodes.data());
+        int misplaced = 0;
+
+        for (size_t i = 0; i < sorted.size(); i++)
+        {
+            const Vector3& from = cloud[order[i]];
+            misplaced += (from.x == sorted[i].x && from.y == sorted[i].y && from.z == sorted[i].z && (i == 0 || sortedCodes[i - 1] <= sortedCodes[i])) ? 0 : 1;
+        }
+
+        Check(misplaced == 0, "%d points out of Hilbert order or not matching order after SortPoints", misplaced);
+
+        std::vector<unsigned long long> timed = std::vector<unsigned long long>(4000000);
+
+        for (size_t i = 0; i < timed.size(); i++)
+        {
+            timed[i] = codeGenerator() >> 1;
+        }
+
+        Timer timer = Timer();
+        SpaceFillingCurve::Sort(timed.data(), nullptr, timed.size());
+        Report("Sort 4M 63 bit codes", static_cast<double>(timed.size()), timer.Seconds(), "key");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <algorithm>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static float GridDistanceSqr(const Vector3& point1, const Vector3& point2)
+    {
+        float x = point1.x - point2.x;
+        float y = point1.y - point2.y;
+        float z = point1.z - point2.z;
+        return x * x + y * y + z * z;
+    }
+
+    // Sorted brute force neighbours of point, dropping self & anything within float round off of the radius
+    static std::vector<unsigned int> BruteNeighbours(const std::vector<Vector3>& points, const Vector3& point, const float radius, const size_t self)
+    {
+        float radiusSqr = radius * radius;
+        std::vector<unsigned int> toReturn = std::vector<unsigned int>();
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            if (i != self && GridDistanceSqr(points[i], point) <= radiusSqr * (1.0f - 1e-5f))
+            {
+                toReturn.push_back(static_cast<unsigned int>(i));
+            }
+        }
+
+        return toReturn;
+    }
+
+    static std::vector<unsigned int> Trimmed(const std::vector<Vector3>& points, const Vector3& point, const float radius, std::vector<unsigned int> found)
+    {
+        float radiusSqr = radius * radius;
+        found.erase(std::remove_if(found.begin(), found.end(), [&](const unsigned int i)
+        {
+            return GridDistanceSqr(points[i], point) > radiusSqr * (1.0f - 1e-5f);
+        }), found.end());
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    void TestSpatialHashGrid()
+    {
+        printf("SpatialHashGrid\n");
+
+        // Spread far enough that distinct cells collide in the hash, with a count that isn't a multiple of 4 so the last bucket's loads run past the final point
+        std::vector<Vector3> points = std::vector<Vector3>(20001);
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            points[i] = RandomVector3(-500.0f, 500.0f);
+            points[i] = (i % 2 == 0) ? Vector3(points[i].x * 0.02f, points[i].y * 0.02f, points[i].z * 0.02f) : points[i];
+        }
+
+        SpatialHashGrid grid = SpatialHashGrid();
+        grid.Build(points.data(), points.size(), 1.0f);
+        Check(grid.Size() == points.size(), "SpatialHashGrid holds %zu points", grid.Size());
+
+        std::vector<unsigned int> ids = std::vector<unsigned int>(grid.SortedIds(), grid.SortedIds() + grid.Size());
+        std::sort(ids.begin(), ids.end());
+        bool permutation = true;
+
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            permutation = permutation && ids[i] == i && grid.SortedX()[i] == points[grid.SortedIds()[i]].x;
+        }
+
+        Check(permutation, "SortedIds is not a permutation matching the sorted positions");
+
+        // Radii smaller, equal & larger than a cell
+        const float radii[3] = { 0.4f, 1.0f, 2.5f };
+        std::vector<unsigned int> offsets = std::vector<unsigned int>();
+        std::vector<unsigned int> neighbours = std::vector<unsigned int>();
+
+        for (int r = 0; r < 3; r++)
+        {
+            int mismatches = 0;
+            grid.NeighbourLists(radii[r], offsets, neighbours);
+
+            for (size_t i = 0; i < points.size(); i += 40)
+            {
+                std::vector<unsigned int> expected = BruteNeighbours(points, points[i], radii[r], i);
+                std::vector<unsigned int> results = std::vector<unsigned int>();
+                grid.Neighbours(points[i], radii[r], results);
+                std::vector<unsigned int> withSelf = expected;
+                withSelf.insert(std::lower_bound(withSelf.begin(), withSelf.end(), static_cast<unsigned int>(i)), static_cast<unsigned int>(i));
+                std::vector<unsigned int> list = std::vector<unsigned int>(neighbours.begin() + offsets[i], neighbours.begin() + offsets[i + 1]);
+                mismatches += (Trimmed(points, points[i], radii[r], results) == withSelf && Trimmed(points, points[i], radii[r], list) == expected) ? 0 : 1;
+            }
+
+            Check(mismatches == 0, "%d neighbour queries at radius %.1f disagree with brute force", mismatches, radii[r]);
+        }
+
+        // Rebuild & neighbour list rates for a particle system sized workload
+        std::vector<Vector3> particles = std::vector<Vector3>(1000000);
+
+        for (size_t i = 0; i < particles.size(); i++)
+        {
+            particles[i] = RandomVector3(-50.0f, 50.0f);
+        }
+
+        Timer timer = Timer();
+
+        for (int frame = 0; frame < 10; frame++)
+        {
+            grid.Build(particles.data(), particles.size(), 1.0f);
+        }
+
+        Report("Build 1M points", static_cast<double>(particles.size()) * 10.0, timer.Seconds(), "point");
+
+        timer.Restart();
+        grid.NeighbourLists(1.0f, offsets, neighbours);
+        Report("NeighbourLists, ~4 neighbours", static_cast<double>(particles.size()), timer.Seconds(), "point");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,292 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static const SplineType SplineTypes[4] = { SplineType::Bezier, SplineType::CatmullRom, SplineType::Hermite, SplineType::BSpline };
+
+    static double Distance(const Vector3& vec, const double x, const double y, const double z)
+    {
+        return sqrt((vec.x - x) * (vec.x - x) + (vec.y - y) * (vec.y - y) + (vec.z - z) * (vec.z - z));
+    }
+
+    // The w lane batch results leave behind, which has to stay 0 like the single evaluation's
+    static float PaddingLane(const Vector3& vec)
+    {
+        return _mm_cvtss_f32(_mm_shuffle_ps(vec.elementsSIMD, vec.elementsSIMD, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+
+    // Bernstein form of the Bezier segment containing t, or its derivative with respect to t
+    static void BezierReference(const std::vector<Vector3>& points, const size_t segments, const double t, const bool derivative, double result[3])
+    {
+        size_t segment = static_cast<size_t>(t * segments);
+        segment = (segment < segments) ? segment : segments - 1;
+        double u = t * segments - segment;
+        double v = 1.0 - u;
+        const Vector3* p = &points[segment * 3];
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            double p0 = p[0].elements[axis], p1 = p[1].elements[axis], p2 = p[2].elements[axis], p3 = p[3].elements[axis];
+            result[axis] = derivative ? 3.0 * segments * (v * v * (p1 - p0) + 2.0 * v * u * (p2 - p1) + u * u * (p3 - p2)) :
+                                        v * v * v * p0 + 3.0 * v * v * u * p1 + 3.0 * v * u * u * p2 + u * u * u * p3;
+        }
+    }
+
+    // Hermite basis functions on the segment containing t, points alternating position & tangent
+    static void HermiteReference(const std::vector<Vector3>& points, const size_t segments, const double t, const bool derivative, double result[3])
+    {
+        size_t segment = static_cast<size_t>(t * segments);
+        segment = (segment < segments) ? segment : segments - 1;
+        double u = t * segments - segment;
+        const Vector3* p = &points[segment * 2];
+        double h00 = 2 * u * u * u - 3 * u * u + 1, h10 = u * u * u - 2 * u * u + u, h01 = -2 * u * u * u + 3 * u * u, h11 = u * u * u - u * u;
+        double d00 = 6 * u * u - 6 * u, d10 = 3 * u * u - 4 * u + 1, d01 = -6 * u * u + 6 * u, d11 = 3 * u * u - 2 * u;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            double p0 = p[0].elements[axis], m0 = p[1].elements[axis], p1 = p[2].elements[axis], m1 = p[3].elements[axis];
+            result[axis] = derivative ? segments * (d00 * p0 + d10 * m0 + d01 * p1 + d11 * m1) : h00 * p0 + h10 * m0 + h01 * p1 + h11 * m1;
+        }
+    }
+
+    static std::vector<Vector3> RandomPoints(const size_t count)
+    {
+        std::vector<Vector3> toReturn = std::vector<Vector3>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            toReturn[i] = RandomVector3(-10.0f, 10.0f);
+        }
+
+        return toReturn;
+    }
+
+    // Largest distance between single & batch results, & between either and the closed form when there is one
+    static void CheckClosedForms()
+    {
+        std::vector<Vector3> bezierPoints = RandomPoints(3 * 7 + 1);
+        std::vector<Vector3> hermitePoints = RandomPoints(2 * 9);
+        Spline bezier = Spline(bezierPoints.data(), bezierPoints.size(), SplineType::Bezier);
+        Spline hermite = Spline(hermitePoints.data(), hermitePoints.size(), SplineType::Hermite);
+        Check(bezier.Segments() == 7 && hermite.Segments() == 8, "Bezier has %zu segments & Hermite %zu", bezier.Segments(), hermite.Segments());
+
+        // A count that leaves a tail group, parameters unsorted so every lane of a group lands in a different segment
+        const size_t count = 1003;
+        std::vector<float> parameters = std::vector<float>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            parameters[i] = RandomFloat(0.0f, 1.0f);
+        }
+
+        parameters[0] = 0.0f;
+        parameters[1] = 1.0f;
+        parameters[2] = 3.0f / 7.0f;
+
+        const Spline* splines[2] = { &bezier, &hermite };
+        const char* names[2] = { "Bezier", "Hermite" };
+
+        for (int s = 0; s < 2; s++)
+        {
+            std::vector<Vector3> points = std::vector<Vector3>(count);
+            std::vector<Vector3> tangents = std::vector<Vector3>(count);
+            splines[s]->Evaluate(parameters.data(), count, points.data());
+            splines[s]->Derivative(parameters.data(), count, tangents.data());
+            double pointError = 0.0, tangentError = 0.0, batchError = 0.0;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                double expected[3], expectedTangent[3];
+                const std::vector<Vector3>& control = (s == 0) ? bezierPoints : hermitePoints;
+                (s == 0) ? BezierReference(control, splines[s]->Segments(), parameters[i], false, expected) : HermiteReference(control, splines[s]->Segments(), parameters[i], false, expected);
+                (s == 0) ? BezierReference(control, splines[s]->Segments(), parameters[i], true, expectedTangent) : HermiteReference(control, splines[s]->Segments(), parameters[i], true, expectedTangent);
+                Vector3 single = splines[s]->Evaluate(parameters[i]);
+                Vector3 singleTangent = splines[s]->Derivative(parameters[i]);
+
+                pointError = fmax(pointError, Distance(points[i], expected[0], expected[1], expected[2]));
+                tangentError = fmax(tangentError, Distance(tangents[i], expectedTangent[0], expectedTangent[1], expectedTangent[2]) / splines[s]->Segments());
+                batchError = fmax(batchError, fmax(Distance(points[i], single.x, single.y, single.z), Distance(tangents[i], singleTangent.x, singleTangent.y, singleTangent.z)));
+                batchError = (PaddingLane(points[i]) == 0.0f && PaddingLane(tangents[i]) == 0.0f) ? batchError : 1.0;
+            }
+
+            Check(pointError < 1e-4 && tangentError < 1e-4, "%s points %g & tangents %g off the closed form", names[s], pointError, tangentError);
+            Check(batchError < 1e-5, "%s batch differs from single evaluation by %g", names[s], batchError);
+        }
+
+        // The ends of a Bezier curve interpolate the first & last control points with tangents along the end legs
+        Vector3 start = bezier.Evaluate(0.0f);
+        Vector3 end = bezier.Evaluate(1.0f);
+        Check(Distance(start, bezierPoints.front().x, bezierPoints.front().y, bezierPoints.front().z) < 1e-5 &&
+              Distance(end, bezierPoints.back().x, bezierPoints.back().y, bezierPoints.back().z) < 1e-4, "Bezier does not interpolate its end points");
+    }
+
+    // Batch & multi-spline evaluation of every type against single evaluation, including parameters outside [0, 1] & a curve with no segments
+    static void CheckBatches()
+    {
+        std::vector<Vector3> points = RandomPoints(40);
+        std::vector<Spline> splines = std::vector<Spline>();
+
+        for (int type = 0; type < 4; type++)
+        {
+            splines.push_back(Spline(points.data(), points.size() - type, SplineTypes[type]));
+        }
+
+        splines.push_back(Spline(points.data(), 3, SplineType::CatmullRom));
+
+        const size_t count = 257;
+        std::vector<float> parameters = std::vector<float>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            parameters[i] = RandomFloat(-0.2f, 1.2f);
+        }
+
+        std::vector<Vector3> batch = std::vector<Vector3>(count * splines.size());
+        std::vector<Vector3> tangents = std::vector<Vector3>(count);
+        Spline::Evaluate(splines.data(), splines.size(), parameters.data(), count, batch.data());
+        double worst = 0.0;
+
+        for (size_t s = 0; s < splines.size(); s++)
+        {
+            splines[s].Derivative(parameters.data(), count, tangents.data());
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Vector3 expected = splines[s].Evaluate(parameters[i]);
+                Vector3 expectedTangent = splines[s].Derivative(parameters[i]);
+                double scale = 1.0 + Vector3::Magnitude(expected) + Vector3::Magnitude(expectedTangent);
+                worst = fmax(worst, Distance(batch[s * count + i], expected.x, expected.y, expected.z) / scale);
+                worst = fmax(worst, Distance(tangents[i], expectedTangent.x, expectedTangent.y, expectedTangent.z) / scale);
+            }
+        }
+
+        Check(worst < 1e-6, "multi-spline & batch Derivative differ from single evaluation by %g", worst);
+    }
+
+    static void CheckArcLength()
+    {
+        // Evenly spaced control points make a Bezier line with constant speed, so length is the chord & distance maps linearly to t
+        Vector3 from = Vector3(-3.0f, 1.0f, 2.0f);
+        Vector3 to = Vector3(5.0f, -2.0f, 7.0f);
+        std::vector<Vector3> line = std::vector<Vector3>(7);
+
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            float f = static_cast<float>(i) / 6.0f;
+            line[i] = Vector3(from.x + (to.x - from.x) * f, from.y + (to.y - from.y) * f, from.z + (to.z - from.z) * f);
+        }
+
+        Spline straight = Spline(line.data(), line.size(), SplineType::Bezier);
+        straight.BuildArcLengthTable(8);
+        float chord = Vector3::Magnitude(Vector3(to.x - from.x, to.y - from.y, to.z - from.z));
+        double parameterError = 0.0;
+
+        for (int i = 0; i <= 100; i++)
+        {
+            float distance = chord * static_cast<float>(i) / 100.0f;
+            parameterError = fmax(parameterError, fabs(straight.ParameterAtDistance(distance) - i / 100.0));
+        }
+
+        Check(fabs(straight.Length() - chord) < 1e-4 * chord && parameterError < 1e-5, "straight Bezier length %g against chord %g, parameter error %g",
+              straight.Length(), chord, parameterError);
+
+        // A helix against a fine polyline in double, & evenly spaced distances have to give evenly spaced points.  Its curvature is low enough
+        // that chords over one step stay within a fraction of a percent of the arc
+        std::vector<Vector3> points = std::vector<Vector3>(12);
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            points[i] = Vector3(5.0f * cosf(0.6f * i), 0.5f * i, 5.0f * sinf(0.6f * i));
+        }
+
+        Spline curve = Spline(points.data(), points.size(), SplineType::CatmullRom);
+        curve.BuildArcLengthTable(32);
+        const size_t steps = 1 << 20;
+        double polyline = 0.0;
+        Vector3 previous = curve.Evaluate(0.0f);
+
+        for (size_t i = 1; i <= steps; i++)
+        {
+            Vector3 next = curve.Evaluate(static_cast<float>(static_cast<double>(i) / steps));
+            polyline += Distance(next, previous.x, previous.y, previous.z);
+            previous = next;
+        }
+
+        Check(fabs(curve.Length() - polyline) < 1e-4 * polyline, "Catmull-Rom length %g against polyline %g", curve.Length(), polyline);
+
+        const size_t samples = 200;
+        std::vector<float> distances = std::vector<float>(samples + 1);
+        std::vector<Vector3> spaced = std::vector<Vector3>(samples + 1);
+
+        for (size_t i = 0; i <= samples; i++)
+        {
+            distances[i] = curve.Length() * static_cast<float>(i) / samples;
+        }
+
+        curve.EvaluateAtDistance(distances.data(), distances.size(), spaced.data());
+        double spacing = curve.Length() / samples;
+        double spacingError = 0.0;
+
+        for (size_t i = 1; i <= samples; i++)
+        {
+            // The chord is at most the arc, & only shorter by the curvature over one step
+            double step = Distance(spaced[i], spaced[i - 1].x, spaced[i - 1].y, spaced[i - 1].z);
+            spacingError = fmax(spacingError, fabs(step - spacing) / spacing);
+        }
+
+        Check(spacingError < 0.02, "EvaluateAtDistance steps vary by %g of the spacing", spacingError);
+    }
+
+    void TestSpline()
+    {
+        printf("Spline\n");
+
+        CheckClosedForms();
+        CheckBatches();
+        CheckArcLength();
+
+        // Batch against the single point loop it replaced, on random parameters so the segment changes in every lane
+        std::vector<Vector3> points = RandomPoints(3 * 64 + 1);
+        Spline spline = Spline(points.data(), points.size(), SplineType::Bezier);
+        const size_t count = 1 << 22;
+        std::vector<float> parameters = std::vector<float>(count);
+        std::vector<Vector3> out = std::vector<Vector3>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            parameters[i] = RandomFloat(0.0f, 1.0f);
+        }
+
+        Timer timer = Timer();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = spline.Evaluate(parameters[i]);
+        }
+
+        Report("Evaluate single", static_cast<double>(count), timer.Seconds(), "point");
+        timer.Restart();
+        spline.Evaluate(parameters.data(), count, out.data());
+        Report("Evaluate batch", static_cast<double>(count), timer.Seconds(), "point");
+        timer.Restart();
+        spline.Derivative(parameters.data(), count, out.data());
+        Report("Derivative batch", static_cast<double>(count), timer.Seconds(), "point");
+
+        std::vector<Spline> splines = std::vector<Spline>(1024, spline);
+        std::vector<Vector3> grid = std::vector<Vector3>(splines.size() * 1024);
+        timer.Restart();
+        Spline::Evaluate(splines.data(), splines.size(), parameters.data(), 1024, grid.data());
+        Report("Evaluate 1024 splines", static_cast<double>(grid.size()), timer.Seconds(), "point");
+    }
+}
\ No newline at end of file
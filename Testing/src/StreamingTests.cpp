@@ -0,0 +1,105 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static const size_t StreamingSweepBytes = static_cast<size_t>(1) << 30;
+
+    // Best of a few passes of Matrix4::Transform over count vectors, repeated until about StreamingSweepBytes have been written
+    static double TransformBandwidth(const Matrix4& mat, const std::vector<Vector4>& in, std::vector<Vector4>& out, const size_t count, const StoreMode mode)
+    {
+        size_t bytes = count * sizeof(Vector4);
+        size_t repeats = (StreamingSweepBytes / bytes > 0) ? StreamingSweepBytes / bytes : 1;
+        double best = 0.0;
+
+        for (int pass = 0; pass < 3; pass++)
+        {
+            Timer timer = Timer();
+
+            for (size_t r = 0; r < repeats; r++)
+            {
+                Matrix4::Transform(mat, in.data(), out.data(), count, mode);
+            }
+
+            double bandwidth = static_cast<double>(bytes) * repeats / timer.Seconds() / 1e9;
+            best = (bandwidth > best) ? bandwidth : best;
+        }
+
+        return best;
+    }
+
+    void TestStreaming()
+    {
+        printf("Streaming stores\n");
+
+        Matrix4 translate = Matrix4::Translate(1.0f, 2.0f, 3.0f);
+        Matrix4 mat = Matrix4::Rotate(0.3f, 0.7f, 1.1f) * translate;
+        size_t maxCount = (static_cast<size_t>(256) << 20) / sizeof(Vector4);
+        std::vector<Vector4> in = std::vector<Vector4>(maxCount);
+        std::vector<Vector4> cached = std::vector<Vector4>(maxCount);
+        std::vector<Vector4> streamed = std::vector<Vector4>(maxCount);
+
+        for (size_t i = 0; i < maxCount; i++)
+        {
+            in[i] = Vector4(static_cast<float>(i % 101), static_cast<float>(i % 37), static_cast<float>(i % 13), 1.0f);
+        }
+
+        // Both store paths must write exactly the same results
+        Matrix4::Transform(mat, in.data(), cached.data(), 1001, StoreMode::Cached);
+        Matrix4::Transform(mat, in.data(), streamed.data(), 1001, StoreMode::Streaming);
+        Check(memcmp(cached.data(), streamed.data(), 1001 * sizeof(Vector4)) == 0, "streamed Transform differs from cached");
+
+        std::vector<Matrix4> mats = std::vector<Matrix4>(257, mat);
+        std::vector<Matrix4> cachedMats = std::vector<Matrix4>(257);
+        std::vector<Matrix4> streamedMats = std::vector<Matrix4>(257);
+        Matrix4::Multiply(mat, mats.data(), cachedMats.data(), 257, StoreMode::Cached);
+        Matrix4::Multiply(mat, mats.data(), streamedMats.data(), 257, StoreMode::Streaming);
+        Check(memcmp(cachedMats.data(), streamedMats.data(), 257 * sizeof(Matrix4)) == 0, "streamed Multiply differs from cached");
+
+        // Output sizes from L1 to DRAM.  The crossover is the smallest size from which streaming stays ahead, where StreamingThreshold belongs
+        printf("  %12s %14s %14s\n", "output", "cached GB/s", "streamed GB/s");
+        size_t crossover = 0;
+
+        for (size_t bytes = 16 << 10; bytes <= maxCount * sizeof(Vector4); bytes *= 4)
+        {
+            size_t count = bytes / sizeof(Vector4);
+            double cachedBandwidth = TransformBandwidth(mat, in, cached, count, StoreMode::Cached);
+            double streamedBandwidth = TransformBandwidth(mat, in, streamed, count, StoreMode::Streaming);
+            crossover = (streamedBandwidth < cachedBandwidth) ? 0 : (crossover == 0) ? bytes : crossover;
+            printf("  %10zu K %14.2f %14.2f\n", bytes >> 10, cachedBandwidth, streamedBandwidth);
+        }
+
+        // With no crossover StoreMode::Auto must not stream anything the sweep measured
+        size_t lowest = (crossover == 0) ? maxCount * sizeof(Vector4) : crossover;
+        Check(StreamingThreshold >= lowest, "StreamingThreshold %zu K is below the measured crossover %zu K", StreamingThreshold >> 10, lowest >> 10);
+
+        if (crossover == 0)
+        {
+            printf("  no crossover up to %zu K, StreamingThreshold is %zu K\n", (maxCount * sizeof(Vector4)) >> 10, StreamingThreshold >> 10);
+        }
+        else
+        {
+            printf("  streaming pays off from %zu K, StreamingThreshold is %zu K\n", crossover >> 10, StreamingThreshold >> 10);
+        }
+
+        // Prefetch distance in elements ahead, measured at the largest size where every read comes from DRAM
+        size_t defaultDistance = PrefetchDistance;
+
+        for (size_t distance = 4; distance <= 128; distance *= 2)
+        {
+            PrefetchDistance = distance;
+            printf("  prefetch %3zu ahead %14.2f GB/s\n", distance, TransformBandwidth(mat, in, streamed, maxCount, StoreMode::Streaming));
+        }
+
+        PrefetchDistance = defaultDistance;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <stdarg.h>
+#include <random>
+#include <stdio.h>
+
+namespace Testing
+{
+    static int failures = 0;
+    static std::mt19937 generator = std::mt19937(12345);
+
+    bool Check(const bool condition, const char* format, ...)
+    {
+        if (!condition)
+        {
+            va_list args;
+            va_start(args, format);
+            printf("  FAILED: ");
+            vprintf(format, args);
+            printf("\n");
+            va_end(args);
+            failures++;
+        }
+
+        return condition;
+    }
+
+    int Failures()
+    {
+        return failures;
+    }
+
+    float RandomFloat(const float min, const float max)
+    {
+        return std::uniform_real_distribution<float>(min, max)(generator);
+    }
+
+    NullX::Vector3 RandomVector3(const float min, const float max)
+    {
+        float x = RandomFloat(min, max);
+        float y = RandomFloat(min, max);
+        float z = RandomFloat(min, max);
+        return NullX::Vector3(x, y, z);
+    }
+
+    void Report(const char* name, const double count, const double seconds, const char* unit)
+    {
+        printf("  %-40s %10.2f M%s/s\n", name, count / seconds / 1e6, unit);
+    }
+
+    Timer::Timer() : start(std::chrono::high_resolution_clock::now())
+    {
+    }
+
+    void Timer::Restart()
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    double Timer::Seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    static Transform RandomTransform(const bool mirrored)
+    {
+        Vector3 axis = RandomVector3(-1.0f, 1.0f);
+        Quaternion rotation = Quaternion();
+        rotation.elementsSIMD = _mm_setr_ps(RandomFloat(-1.0f, 1.0f), axis.x, axis.y, axis.z);
+        Vector3 scale = Vector3(RandomFloat(0.1f, 4.0f), RandomFloat(0.1f, 4.0f), RandomFloat(0.1f, 4.0f) * (mirrored ? -1.0f : 1.0f));
+        return Transform(RandomVector3(-50.0f, 50.0f), rotation, scale);
+    }
+
+    // Largest element difference relative to the largest element of expected
+    static double RelativeMatrixError(const Matrix4& actual, const Matrix4& expected)
+    {
+        double error = 0.0, magnitude = 1e-30;
+
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                error = fmax(error, fabs(static_cast<double>(actual.matrix[i][j]) - expected.matrix[i][j]));
+                magnitude = fmax(magnitude, fabs(static_cast<double>(expected.matrix[i][j])));
+            }
+        }
+
+        return error / magnitude;
+    }
+
+    // The TRS product built the long way
+    static Matrix4 Composed(const Transform& transform)
+    {
+        Matrix4 translation = Matrix4::Translate(transform.GetPosition());
+        Matrix4 rotation = Matrix4::Rotate(transform.GetRotation());
+        Matrix4 scale = Matrix4::Scale(transform.GetScale());
+        return translation * rotation * scale;
+    }
+
+    void TestTransform()
+    {
+        printf("Transform\n");
+
+        Transform identity = Transform();
+        Check(!identity.IsDirty() && RelativeMatrixError(identity.GetMatrix(), Matrix4::Identity) == 0.0 && RelativeMatrixError(identity.GetInverse(), Matrix4::Identity) == 0.0,
+              "default Transform isn't a clean identity");
+
+        // The cached matrix against Translate * Rotate * Scale, & the cached inverse against the identity product, mirrored scales included
+        const size_t count = 1001;
+        std::vector<Transform> transforms = std::vector<Transform>(count);
+        double matrixError = 0.0, inverseError = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            transforms[i] = RandomTransform(i % 2 == 1);
+            Matrix4 local = transforms[i].GetMatrix();
+            Matrix4 inverse = transforms[i].GetInverse();
+            matrixError = fmax(matrixError, RelativeMatrixError(local, Composed(transforms[i])));
+            Matrix4 product = local * inverse;
+            inverseError = fmax(inverseError, RelativeMatrixError(product, Matrix4::Identity));
+            product = inverse * local;
+            inverseError = fmax(inverseError, RelativeMatrixError(product, Matrix4::Identity));
+        }
+
+        // The inverse is exact up to the scale ratio, a 40 to 1 spread of scales & a translation of 50 leave a few ulps of 2000
+        Check(matrixError < 1e-6, "GetMatrix differs from Translate * Rotate * Scale by %g", matrixError);
+        Check(inverseError < 1e-4, "GetInverse * GetMatrix is %g from the identity", inverseError);
+        printf("  worst relative error: matrix %.2g, inverse %.2g\n", matrixError, inverseError);
+
+        // Each setter has to invalidate both caches, & a rebuilt matrix has to match the new TRS.  The inverse is read after the
+        // matrix so an inverse left stale by the matrix rebuild shows up
+        Transform transform = RandomTransform(false);
+        const Matrix4* cached = &transform.GetMatrix();
+        transform.GetInverse();
+        bool clean = !transform.IsDirty() && &transform.GetMatrix() == cached;
+        int stale = 0;
+
+        for (int edit = 0; edit < 6; edit++)
+        {
+            Matrix4 before = transform.GetMatrix();
+
+            switch (edit)
+            {
+                case 0: transform.SetPosition(RandomVector3(-5.0f, 5.0f)); break;
+                case 1: transform.SetRotation(RandomTransform(false).GetRotation()); break;
+                case 2: transform.SetScale(Vector3(2.0f, 0.5f, 3.0f)); break;
+                case 3: transform.Translate(Vector3(1.0f, -2.0f, 0.5f)); break;
+                case 4: transform.Rotate(Quaternion(Vector3(0.0f, 1.0f, 0.0f), 0.7f)); break;
+                default: transform.MarkDirty(); break;
+            }
+
+            bool dirty = transform.IsDirty();
+            Matrix4 after = transform.GetMatrix();
+            Matrix4 inverse = transform.GetInverse();
+            Matrix4 product = after * inverse;
+            bool changed = (edit == 5) || RelativeMatrixError(after, before) > 1e-3;
+            stale += (dirty && changed && !transform.IsDirty() && RelativeMatrixError(after, Composed(transform)) < 1e-6 && RelativeMatrixError(product, Matrix4::Identity) < 1e-5) ? 0 : 1;
+        }
+
+        Check(clean, "a rebuilt Transform is still dirty or moved its cached matrix");
+        Check(stale == 0, "%d Transform edits left a stale or wrong cached matrix", stale);
+
+        // Rotate applies on top of the current rotation, so it is the product quat * rotation
+        Quaternion start = Quaternion::Normalized(RandomTransform(false).GetRotation());
+        Quaternion turn = Quaternion(Vector3(1.0f, 2.0f, -1.0f), 1.3f);
+        Transform turned = Transform(Vector3(), start, Vector3(1.0f, 1.0f, 1.0f));
+        turned.Rotate(turn);
+        Quaternion expected = Quaternion::Normalized(Quaternion(turn) * start);
+        Check(fabsf(Quaternion::Dot(turned.GetRotation(), expected)) > 1.0f - 1e-6f, "Transform::Rotate isn't quat * rotation");
+
+        // UpdateMatrices leaves every Transform clean with the same matrices as the lazy path
+        for (size_t i = 0; i < count; i++)
+        {
+            transforms[i].SetScale(Vector3(1.5f, 1.5f, 1.5f));
+        }
+
+        Transform::UpdateMatrices(transforms.data(), count);
+        int mismatches = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            mismatches += (!transforms[i].IsDirty() && RelativeMatrixError(transforms[i].GetMatrix(), Composed(transforms[i])) < 1e-6) ? 0 : 1;
+        }
+
+        Check(mismatches == 0, "%d Transforms wrong or dirty after UpdateMatrices", mismatches);
+
+        const size_t timedCount = 1000000;
+        std::vector<Transform> timed = std::vector<Transform>(timedCount);
+
+        for (size_t i = 0; i < timedCount; i++)
+        {
+            timed[i] = transforms[i % count];
+            timed[i].MarkDirty();
+        }
+
+        Timer timer = Timer();
+        Transform::UpdateMatrices(timed.data(), timedCount);
+        Report("UpdateMatrices 1M transforms", static_cast<double>(timedCount), timer.Seconds(), "xform");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+/* ********************************** */
+/* NullX Accelerated C++ Math Library */
+/* Author: Kirk Hewitt                */
+/* Created: 6/12/2016                 */
+/* ********************************** */
+
+#include <Testing.h>
+#include <math.h>
+#include <stdio.h>
+
+using namespace NullX;
+
+namespace Testing
+{
+    // Unit roundoff of float
+    static const double FloatRoundoff = 1.0 / 16777216.0;
+
+    // Points that are hard to sum in float: x cancels ±1e4 pairs down to a small total, y sits on a 1e4 offset, z spans
+    // twenty binades
+    static std::vector<Vector3> IllConditionedPoints(const size_t count)
+    {
+        std::vector<Vector3> toReturn = std::vector<Vector3>(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            float large = (i % 2 == 0) ? 1e4f : -1e4f;
+            toReturn[i] = Vector3(large + RandomFloat(0.0f, 1.0f), 1e4f + RandomFloat(-1.0f, 1.0f), ldexpf(RandomFloat(1.0f, 2.0f), static_cast<int>(i % 20) - 10));
+        }
+
+        return toReturn;
+    }
+
+    // Largest error of each axis of actual against expected / scale, as a multiple of the Kahan bound (3u sum|x| + u|total|) / scale
+    static double SumErrorInBounds(const Vector3& actual, const double expected[3], const double absolute[3], const double scale)
+    {
+        double toReturn = 0.0;
+        const float elements[3] = { actual.x, actual.y, actual.z };
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            double bound = (3.0 * FloatRoundoff * absolute[axis] + FloatRoundoff * fabs(expected[axis])) / scale;
+            double error = fabs(elements[axis] - expected[axis] / scale) / bound;
+            toReturn = (error > toReturn) ? error : toReturn;
+        }
+
+        return toReturn;
+    }
+
+    // Largest element difference of the upper left 3x3 against a double covariance, relative to its largest variance
+    static double CovarianceError(const Matrix4& actual, const double expected[3][3])
+    {
+        double error = 0.0, magnitude = 0.0;
+
+        for (int i = 0; i < 3; i++)
+        {
+            magnitude = (expected[i][i] > magnitude) ? expected[i][i] : magnitude;
+
+            for (int j = 0; j < 3; j++)
+            {
+                double diff = fabs(actual.matrix[i][j] - expected[i][j]);
+                error = (diff > error) ? diff : error;
+            }
+        }
+
+        return error / magnitude;
+    }
+
+    // Two pass covariance in double about the double mean, each point scaled by its weight when there are weights
+    static void ReferenceCovariance(const std::vector<Vector3>& points, const float* weights, double covariance[3][3])
+    {
+        double mean[3] = { 0.0, 0.0, 0.0 }, total = 0.0;
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            double weight = weights ? weights[i] : 1.0;
+            mean[0] += weight * points[i].x;
+            mean[1] += weight * points[i].y;
+            mean[2] += weight * points[i].z;
+            total += weight;
+        }
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            mean[axis] /= total;
+
+            for (int j = 0; j < 3; j++)
+            {
+                covariance[axis][j] = 0.0;
+            }
+        }
+
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            double weight = weights ? weights[i] : 1.0;
+            const double diff[3] = { points[i].x - mean[0], points[i].y - mean[1], points[i].z - mean[2] };
+
+            for (int r = 0; r < 3; r++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    covariance[r][c] += weight * diff[r] * diff[c] / total;
+                }
+            }
+        }
+    }
+
+    void TestVector3()
+    {
+        printf("Vector3 reductions\n");
+
+        // Not a multiple of the 64K chunk so the last thread gets a partial range
+        const size_t count = 3000001;
+        std::vector<Vector3> points = IllConditionedPoints(count);
+        std::vector<float> weights = std::vector<float>(count);
+        double expected[3] = { 0.0, 0.0, 0.0 }, absolute[3] = { 0.0, 0.0, 0.0 };
+        double weighted[3] = { 0.0, 0.0, 0.0 }, weightedAbsolute[3] = { 0.0, 0.0, 0.0 }, totalWeight = 0.0;
+        float naive[3] = { 0.0f, 0.0f, 0.0f };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            // Every seventh point carries no weight at all
+            weights[i] = (i % 7 == 0) ? 0.0f : RandomFloat(0.0f, 2.0f);
+            totalWeight += weights[i];
+            const float elements[3] = { points[i].x, points[i].y, points[i].z };
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                expected[axis] += elements[axis];
+                absolute[axis] += fabs(elements[axis]);
+                weighted[axis] += static_cast<double>(weights[i]) * elements[axis];
+                weightedAbsolute[axis] += fabs(static_cast<double>(weights[i]) * elements[axis]);
+                naive[axis] += elements[axis];
+            }
+        }
+
+        Vector3 naiveSum = Vector3(naive[0], naive[1], naive[2]);
+        double sumError = SumErrorInBounds(Vector3::Sum(points.data(), count), expected, absolute, 1.0);
+        double meanError = SumErrorInBounds(Vector3::Mean(points.data(), count), expected, absolute, static_cast<double>(count));
+        double weightedError = SumErrorInBounds(Vector3::Mean(points.data(), weights.data(), count), weighted, weightedAbsolute, totalWeight);
+        Check(sumError <= 1.0, "Sum is %.2f times the compensated error bound", sumError);
+        Check(meanError <= 1.0, "Mean is %.2f times the compensated error bound", meanError);
+        Check(weightedError <= 1.0, "weighted Mean is %.2f times the compensated error bound", weightedError);
+        printf("  Sum %.2f, Mean %.2f, weighted Mean %.2f of the error bound, a plain float sum %.0f\n", sumError, meanError, weightedError,
+               SumErrorInBounds(naiveSum, expected, absolute, 1.0));
+
+        Vector3 empty = Vector3::Mean(points.data(), 0);
+        Check(empty.x == 0.0f && empty.y == 0.0f && empty.z == 0.0f, "Mean of no points isn't zero");
+
+        // Extremes placed at the first & last points, where a dropped head or tail would lose them
+        points[0].x = -2e4f;
+        points[count - 1].y = 3e4f;
+        points[count - 1].z = -1e6f;
+        Vector3 expectedMin = points[0], expectedMax = points[0];
+
+        for (size_t i = 1; i < count; i++)
+        {
+            expectedMin = Vector3(fminf(expectedMin.x, points[i].x), fminf(expectedMin.y, points[i].y), fminf(expectedMin.z, points[i].z));
+            expectedMax = Vector3(fmaxf(expectedMax.x, points[i].x), fmaxf(expectedMax.y, points[i].y), fmaxf(expectedMax.z, points[i].z));
+        }
+
+        Check(Vector3::Min(points.data(), count) == expectedMin, "Min differs from a scalar scan");
+        Check(Vector3::Max(points.data(), count) == expectedMax, "Max differs from a scalar scan");
+
+        // Correlated axes a thousand times smaller than their offset, where a one pass E[xx] - E[x]E[x] in float loses everything
+        double single[3][3] = { { 0.0 } };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            float a = RandomFloat(-1.0f, 1.0f);
+            points[i] = Vector3(1e3f + a, -2e3f + 0.5f * a + RandomFloat(-0.5f, 0.5f), 5e2f + RandomFloat(-0.25f, 0.25f));
+            const float elements[3] = { points[i].x, points[i].y, points[i].z };
+
+            for (int r = 0; r < 3; r++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    single[r][c] += elements[r] * elements[c];
+                }
+            }
+        }
+
+        double reference[3][3];
+        ReferenceCovariance(points, nullptr, reference);
+        double covarianceError = CovarianceError(Vector3::Covariance(points.data(), count), reference);
+        ReferenceCovariance(points, weights.data(), reference);
+        double weightedCovarianceError = CovarianceError(Vector3::Covariance(points.data(), weights.data(), count), reference);
+        Check(covarianceError < 1e-5, "Covariance relative error %g against double", covarianceError);
+        Check(weightedCovarianceError < 1e-5, "weighted Covariance relative error %g against double", weightedCovarianceError);
+
+        Vector3 mean = Vector3::Mean(points.data(), count);
+        const float meanElements[3] = { mean.x, mean.y, mean.z };
+        Matrix4 onePass = Matrix4();
+
+        for (int r = 0; r < 3; r++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                onePass.matrix[r][c] = static_cast<float>(single[r][c] / count) - meanElements[r] * meanElements[c];
+            }
+        }
+
+        ReferenceCovariance(points, nullptr, reference);
+        printf("  Covariance relative error %.2g, weighted %.2g, one pass float %.2g\n", covarianceError, weightedCovarianceError, CovarianceError(onePass, reference));
+
+        Timer timer = Timer();
+        Vector3::Sum(points.data(), count);
+        Report("Sum 3M points", static_cast<double>(count), timer.Seconds(), "point");
+        timer.Restart();
+        Vector3::Covariance(points.data(), count);
+        Report("Covariance 3M points", static_cast<double>(count), timer.Seconds(), "point");
+    }
+}
\ No newline at end of file
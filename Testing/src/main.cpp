@@ -4,11 +4,35 @@
 /* Created: 6/12/2016                 */
 /* ********************************** */
 
-#include <NullX.h>
-
-using namespace NullX;
+#include <Testing.h>
+#include <stdio.h>
 
 int main()
 {
-    return 0;
+    Testing::TestStreaming();
+    Testing::TestBVH();
+    Testing::TestKDTree();
+    Testing::TestSpatialHashGrid();
+    Testing::TestBounds();
+    Testing::TestDecomposition();
+    Testing::TestMatrixN();
+    Testing::TestOcclusionBuffer();
+    Testing::TestParticleIntegrator();
+    Testing::TestIKSolver();
+    Testing::TestNoise();
+    Testing::TestMesh();
+    Testing::TestBroadPhase();
+    Testing::TestNarrowPhase();
+    Testing::TestIntVectors();
+    Testing::TestColor();
+    Testing::TestSpline();
+    Testing::TestQuaternion();
+    Testing::TestSpaceFillingCurve();
+    Testing::TestMatrix4();
+    Testing::TestRandom();
+    Testing::TestTransform();
+    Testing::TestVector3();
+
+    printf("%d failed checks\n", Testing::Failures());
+    return (Testing::Failures() == 0) ? 0 : 1;
 }
\ No newline at end of file